@@ -59,6 +59,8 @@ namespace wsdb {
  * @a WSDB_DB_NOT_OPEN: database not open, client should open a specific database before operations
  * @a WSDB_TABLE_MISS: table handler not exists
  * @a WSDB_TABLE_EXIST: table already exists when attempting to create a new table
+ * @a WSDB_INDEX_MISS: index not exists
+ * @a WSDB_INDEX_EXIST: index already exists when attempting to create a new index
  * @a WSDB_GRAMMAR_ERROR: SQL grammar error, check semantic error
  * @a WSDB_FIELD_MISS: field not exists in the schema
  * @a WSDB_STRING_OVERFLOW: string overflow, used for string size check
@@ -66,6 +68,7 @@ namespace wsdb {
  * @a WSDB_UNSUPPORTED_OP: unsupported operation
  * @a WSDB_UNEXPECTED_NULL: unexpected null value after adequate check
  * @a WSDB_CLIENT_DOWN: client down, should close the client connection
+ * @a WSDB_TASK_CANCELLED: tasks of a query were skipped since their group was cancelled, e.g. another task failed
  */
 #define ENUM_ENTITIES          \
   ENUM(WSDB_EXCEPTION_EMPTY)   \
@@ -89,13 +92,16 @@ namespace wsdb {
   ENUM(WSDB_DB_NOT_OPEN)       \
   ENUM(WSDB_TABLE_MISS)        \
   ENUM(WSDB_TABLE_EXIST)       \
+  ENUM(WSDB_INDEX_MISS)        \
+  ENUM(WSDB_INDEX_EXIST)       \
   ENUM(WSDB_GRAMMAR_ERROR)     \
   ENUM(WSDB_FIELD_MISS)        \
   ENUM(WSDB_STRING_OVERFLOW)   \
   ENUM(WSDB_TYPE_MISSMATCH)    \
   ENUM(WSDB_UNSUPPORTED_OP)    \
   ENUM(WSDB_UNEXPECTED_NULL)   \
-  ENUM(WSDB_CLIENT_DOWN)
+  ENUM(WSDB_CLIENT_DOWN)       \
+  ENUM(WSDB_TASK_CANCELLED)
 #define ENUM(ent) ENUMENTRY(ent)
 DECLARE_ENUM(WSDBExceptionType)
 #undef ENUM
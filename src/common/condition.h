@@ -92,6 +92,21 @@ public:
 
   [[nodiscard]] auto GetOp() const -> CompOp { return op_; }
 
+  /**
+   * the same comparison of two columns with the columns swapped, e.g. a < b becomes b > a
+   */
+  [[nodiscard]] auto Swap() const -> Condition
+  {
+    WSDB_ASSERT(rval_type_ == kColumn, fmt::format("should be: {}", CondRvalTypeToString(rval_type_)));
+    switch (op_) {
+      case OP_LT: return {OP_GT, r_col_, l_col_};
+      case OP_GT: return {OP_LT, r_col_, l_col_};
+      case OP_LE: return {OP_GE, r_col_, l_col_};
+      case OP_GE: return {OP_LE, r_col_, l_col_};
+      default: return {op_, r_col_, l_col_};
+    }
+  }
+
   [[nodiscard]] auto GetSubqueryId() const -> int32_t
   {
     WSDB_ASSERT(rval_type_ == kSubquery, "should be subquery");
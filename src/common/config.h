@@ -28,18 +28,62 @@ constexpr size_t  BUFFER_POOL_SIZE = 8;
 const std::string REPLACER         = "LRUReplacer";
 // enable this to use LRUKReplacer
 const size_t REPLACER_LRU_K = 10;
+// the file header page of an index keeps the IndexHeader and the key schema in the first INDEX_HEADER_SIZE bytes, and
+// the header of the index structure, e.g. the root of a B+tree, in the rest of the page
+constexpr size_t INDEX_HEADER_SIZE = 1024;
 /// system
 constexpr size_t MAX_REC_SIZE = 1024;
+// fraction of the capacity of the B+tree nodes filled when CREATE INDEX packs the records of a table into a new tree,
+// the room left absorbs later insertions without splits
+constexpr double BPTREE_FILL_FACTOR = 0.9;
 /// executor
 // 64MB, used for sort executor's buffer
 constexpr size_t SORT_BUFFER_SIZE = 64 * 1024 * 1024;
 // 10-way merge sort, max tmp file to use in merge sort
 constexpr size_t SORT_WAY_NUM = 10;
+// 1MB, unit of reads and writes of the run files of sort executor
+constexpr size_t SORT_IO_BUFFER_SIZE = 1024 * 1024;
+// max number of workers of a parallel sort, each one sorts a chunk of the sort buffer
+constexpr size_t SORT_WORKER_NUM = 8;
+// 16MB, used for the block of outer records of nested loop join, the inner input is scanned once per block
+constexpr size_t NESTED_LOOP_BLOCK_SIZE = 16 * 1024 * 1024;
+// 64MB, used for the hash table of hash join, the build side is partitioned to files if it does not fit
+constexpr size_t HASH_JOIN_BUFFER_SIZE = 64 * 1024 * 1024;
+// each partitioning pass of hash join splits the inputs into 2^HASH_JOIN_PARTITION_BITS partitions
+constexpr size_t HASH_JOIN_PARTITION_BITS = 4;
+// max number of partitioning passes of hash join, a partition still too large after them is joined in memory
+constexpr size_t HASH_JOIN_MAX_PARTITION_LEVEL = 4;
+// max number of workers of a parallel hash join, each one builds and probes a range of radix partitions
+constexpr size_t HASH_JOIN_WORKER_NUM = 8;
+// 256KB, target size of a radix partition of parallel hash join, so that the table of a partition stays in the cache
+constexpr size_t HASH_JOIN_CACHE_PARTITION_SIZE = 256 * 1024;
+// max number of bits of the hash used to choose the radix partitions
+constexpr size_t HASH_JOIN_MAX_RADIX_BITS = 12;
+// number of probe records joined by the workers of parallel hash join at a time
+constexpr size_t HASH_JOIN_PROBE_BATCH_SIZE = 64 * 1024;
+// bits of the Bloom filter of the build keys pushed from hash join into the scan of the probe side, per build key
+constexpr size_t HASH_JOIN_FILTER_BITS_PER_KEY = 16;
+// 16MB, max size of the Bloom filter of hash join, a larger build side is not filtered
+constexpr size_t HASH_JOIN_FILTER_MAX_SIZE = 16 * 1024 * 1024;
+// 64MB, used for the groups of hash aggregation, the records of the groups not fitting are partitioned to files
+constexpr size_t AGGREGATE_BUFFER_SIZE = 64 * 1024 * 1024;
+// each partitioning pass of hash aggregation splits the spilled records into 2^AGGREGATE_PARTITION_BITS partitions
+constexpr size_t AGGREGATE_PARTITION_BITS = 4;
+// max number of partitioning passes of hash aggregation, the groups of a partition after them are kept in memory
+constexpr size_t AGGREGATE_MAX_PARTITION_LEVEL = 4;
+// max number of records whose index entries are deleted or updated together by a DELETE or an UPDATE, in the order of
+// their keys, the records of a statement are buffered and flushed to the indexes in batches of this size
+constexpr size_t DML_INDEX_BATCH_SIZE = 4096;
+// number of pages in a morsel, the unit of work handed out to the workers of a parallel scan
+constexpr size_t SCAN_MORSEL_SIZE = 16;
+// max number of workers of a parallel scan, each worker pins one page at a time
+constexpr size_t SCAN_WORKER_NUM = BUFFER_POOL_SIZE / 2;
 
 const std::string DB_SUFFIX  = ".db";
 const std::string TAB_SUFFIX = ".tab";
 const std::string IDX_SUFFIX = ".idx";
 const std::string TMP_SUFFIX = ".tmp";
+const std::string ZMP_SUFFIX = ".zmp";
 
 const std::string DB_DIR  = "db";
 const std::string TAB_DIR = "tab";
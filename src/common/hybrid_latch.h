@@ -0,0 +1,95 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+#ifndef WSDB_HYBRID_LATCH_H
+#define WSDB_HYBRID_LATCH_H
+
+#include <atomic>
+#include <cstdint>
+#include <shared_mutex>
+
+namespace wsdb {
+
+/**
+ * A reader-writer latch with a version, which allows optimistic reads besides shared and exclusive locking.
+ * The version is odd while the latch is exclusively locked, and is increased by both locking and unlocking it
+ * exclusively, so an optimistic reader remembers the version before reading the protected data, and the data it read
+ * is consistent only if the version is unchanged afterwards. The data may be modified concurrently while it is read
+ * optimistically, so the reader must not trust anything it read before it is validated.
+ */
+class HybridLatch
+{
+public:
+  HybridLatch() = default;
+
+  /**
+   * @return false if the latch is exclusively locked, otherwise the current version is stored in version
+   */
+  auto TryReadOptimistic(uint64_t &version) const -> bool
+  {
+    version = version_.load(std::memory_order_acquire);
+    return (version & 1) == 0;
+  }
+
+  /**
+   * @return true if the latch has not been exclusively locked since version was read
+   */
+  [[nodiscard]] auto Validate(uint64_t version) const -> bool
+  {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return version_.load(std::memory_order_relaxed) == version;
+  }
+
+  void LockShared() { mutex_.lock_shared(); }
+
+  auto TryLockShared() -> bool { return mutex_.try_lock_shared(); }
+
+  void UnlockShared() { mutex_.unlock_shared(); }
+
+  void LockExclusive()
+  {
+    mutex_.lock();
+    version_.fetch_add(1, std::memory_order_acq_rel);
+  }
+
+  auto TryLockExclusive() -> bool
+  {
+    if (!mutex_.try_lock()) {
+      return false;
+    }
+    version_.fetch_add(1, std::memory_order_acq_rel);
+    return true;
+  }
+
+  void UnlockExclusive()
+  {
+    version_.fetch_add(1, std::memory_order_release);
+    mutex_.unlock();
+  }
+
+private:
+  std::shared_mutex     mutex_;
+  std::atomic<uint64_t> version_{0};
+};
+
+}  // namespace wsdb
+
+#endif  // WSDB_HYBRID_LATCH_H
@@ -95,4 +95,16 @@ struct TableHeader
   size_t    nullmap_size_{0};  // null map size == BITMAP_SIZE(n_field)
 };
 
+/**
+ * Index header is at the beginning of the first page of an index, it contains the meta information of the index, and
+ * is followed by the name of the table and the key and included fields of the index
+ */
+struct IndexHeader
+{
+  IndexType index_type_{};
+  size_t    key_field_num_{0};
+  size_t    include_field_num_{0};
+  size_t    entry_num_{0};  // number of entries when the index was closed
+};
+
 #endif  // WSDB_META_H
@@ -24,6 +24,7 @@
 
 #include "../../common/micro.h"
 #include "config.h"
+#include "hybrid_latch.h"
 #include "types.h"
 #include "../../common/error.h"
 
@@ -88,6 +89,9 @@ public:
     *reinterpret_cast<size_t *>(data_ + PAGE_RECORD_NUM_OFFSET) = record_num;
   }
 
+  /// latch of the page for its user, it is only meaningful while the page is pinned, and is kept by Clear
+  auto GetLatch() -> wsdb::HybridLatch & { return latch_; }
+
   void Clear()
   {
     fid_ = INVALID_FILE_ID;
@@ -99,6 +103,8 @@ private:
   file_id_t fid_{INVALID_FILE_ID};
   page_id_t pid_{INVALID_PAGE_ID};
   char      data_[PAGE_SIZE]{};
+
+  wsdb::HybridLatch latch_;
 };
 
 #endif  // WSDB_PAGE_H
@@ -40,6 +40,7 @@ typedef size_t timestamp_t;
 constexpr int32_t INVALID_PAGE_ID  = -1;
 constexpr int32_t INVALID_SLOT_ID  = -1;
 constexpr int32_t INVALID_TABLE_ID = -1;
+constexpr int32_t INVALID_IDX_ID   = -1;
 constexpr int32_t INVALID_FRAME_ID = -1;
 constexpr int32_t INVALID_TXN_ID   = -1;
 constexpr int32_t INVALID_FILE_ID  = -1;
@@ -109,7 +110,9 @@ ENUM_TO_STRING_BODY(JoinType)
 
 #define ENUM_ENTITIES \
   ENUM(NESTED_LOOP)   \
-  ENUM(SORT_MERGE)
+  ENUM(SORT_MERGE)    \
+  ENUM(HASH)          \
+  ENUM(INDEX_NESTED_LOOP)
 #define ENUM(ent) ENUMENTRY(ent)
 DECLARE_ENUM(JoinStrategy)
 #undef ENUM
@@ -156,4 +159,22 @@ inline auto CompOpToString(CompOp op) -> const char *{
   }
 }
 
+enum class IndexType
+{
+  NONE,
+  BPTREE,
+  HASH,
+  ART,
+};
+
+inline auto IndexTypeToString(IndexType type) -> const char *
+{
+  switch (type) {
+    case IndexType::BPTREE: return "BPTREE";
+    case IndexType::HASH: return "HASH";
+    case IndexType::ART: return "ART";
+    default: return "NONE";
+  }
+}
+
 #endif  // WSDB_TYPES_H
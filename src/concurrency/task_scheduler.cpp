@@ -0,0 +1,260 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+#include "task_scheduler.h"
+
+#include <algorithm>
+
+namespace wsdb {
+
+// the scheduler and worker id of the calling thread, set for the worker threads only
+static thread_local TaskScheduler *tls_scheduler = nullptr;
+static thread_local size_t         tls_worker_id = 0;
+// the group of the task running in the calling thread
+static thread_local TaskGroup *tls_group = nullptr;
+
+static constexpr auto WAIT_HELP_INTERVAL = std::chrono::milliseconds(1);
+
+TaskScheduler::TaskScheduler(size_t worker_num) : next_queue_(0), task_num_(0), stop_(false)
+{
+  worker_num = std::max(worker_num, static_cast<size_t>(1));
+  for (size_t i = 0; i < worker_num; ++i) {
+    queues_.push_back(std::make_unique<WorkerQueue>());
+  }
+  for (size_t i = 0; i < worker_num; ++i) {
+    workers_.emplace_back([this, i]() { WorkerLoop(i); });
+  }
+}
+
+TaskScheduler::~TaskScheduler()
+{
+  {
+    std::lock_guard<std::mutex> lock(sleep_latch_);
+    stop_ = true;
+  }
+  sleep_cv_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+auto TaskScheduler::GetInstance() -> TaskScheduler *
+{
+  static TaskScheduler instance(std::thread::hardware_concurrency());
+  return &instance;
+}
+
+void TaskScheduler::Submit(Task task, TaskPriority priority, const TaskGroup *group)
+{
+  auto worker_id = GetWorkerId();
+  auto queue_id  = worker_id < queues_.size() ? worker_id : next_queue_++ % queues_.size();
+  {
+    // count the task before it can be popped, so that task_num_ never goes below zero. hold the latch so that a worker
+    // going to sleep cannot miss the new task
+    std::lock_guard<std::mutex> lock(sleep_latch_);
+    task_num_++;
+  }
+  {
+    std::lock_guard<std::mutex> lock(queues_[queue_id]->latch_);
+    queues_[queue_id]->tasks_[static_cast<size_t>(priority)].push_back({std::move(task), group});
+  }
+  sleep_cv_.notify_one();
+}
+
+auto TaskScheduler::RunPendingTask() -> bool
+{
+  Task task;
+  if (!PopTask(GetWorkerId(), task)) {
+    return false;
+  }
+  task();
+  return true;
+}
+
+auto TaskScheduler::RunPendingTask(const TaskGroup *group, TaskPriority priority) -> bool
+{
+  Task task;
+  if (!PopGroupTask(group, priority, task)) {
+    return false;
+  }
+  task();
+  return true;
+}
+
+void TaskScheduler::WorkerLoop(size_t worker_id)
+{
+  tls_scheduler = this;
+  tls_worker_id = worker_id;
+  while (true) {
+    Task task;
+    if (PopTask(worker_id, task)) {
+      task();
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleep_latch_);
+    sleep_cv_.wait(lock, [this]() { return stop_ || task_num_ > 0; });
+    if (stop_ && task_num_ == 0) {
+      return;
+    }
+  }
+}
+
+auto TaskScheduler::PopTask(size_t worker_id, Task &task) -> bool
+{
+  if (task_num_ == 0) {
+    return false;
+  }
+  auto queue_num = queues_.size();
+  for (size_t p = 0; p < TASK_PRIORITY_NUM; ++p) {
+    if (worker_id < queue_num) {
+      auto                       &queue = *queues_[worker_id];
+      std::lock_guard<std::mutex> lock(queue.latch_);
+      if (!queue.tasks_[p].empty()) {
+        task = std::move(queue.tasks_[p].back().task_);
+        queue.tasks_[p].pop_back();
+        task_num_--;
+        return true;
+      }
+    }
+    // steal from the other workers, starting from the next one to spread the stealers
+    for (size_t i = 1; i <= queue_num; ++i) {
+      auto victim = (worker_id + i) % queue_num;
+      if (victim == worker_id) {
+        continue;
+      }
+      auto                       &queue = *queues_[victim];
+      std::lock_guard<std::mutex> lock(queue.latch_);
+      if (!queue.tasks_[p].empty()) {
+        task = std::move(queue.tasks_[p].front().task_);
+        queue.tasks_[p].pop_front();
+        task_num_--;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+auto TaskScheduler::PopGroupTask(const TaskGroup *group, TaskPriority priority, Task &task) -> bool
+{
+  if (task_num_ == 0) {
+    return false;
+  }
+  for (auto &queue : queues_) {
+    std::lock_guard<std::mutex> lock(queue->latch_);
+    auto                       &tasks = queue->tasks_[static_cast<size_t>(priority)];
+    auto it = std::find_if(tasks.begin(), tasks.end(), [group](const QueuedTask &t) { return t.group_ == group; });
+    if (it != tasks.end()) {
+      task = std::move(it->task_);
+      tasks.erase(it);
+      task_num_--;
+      return true;
+    }
+  }
+  return false;
+}
+
+auto TaskScheduler::GetWorkerId() const -> size_t { return tls_scheduler == this ? tls_worker_id : queues_.size(); }
+
+TaskGroup::TaskGroup(TaskPriority priority, TaskGroup *parent, TaskScheduler *scheduler)
+    : scheduler_(scheduler), priority_(priority), parent_(parent), cancelled_(false), pending_(0)
+{}
+
+TaskGroup::~TaskGroup()
+{
+  Cancel();
+  WaitAll();
+}
+
+auto TaskGroup::Current() -> TaskGroup * { return tls_group; }
+
+void TaskGroup::Submit(Task task)
+{
+  {
+    std::lock_guard<std::mutex> lock(latch_);
+    pending_++;
+  }
+  scheduler_->Submit([this, task = std::move(task)]() { Run(task); }, priority_, this);
+}
+
+void TaskGroup::Cancel() { cancelled_ = true; }
+
+auto TaskGroup::IsCancelled() const -> bool { return cancelled_ || (parent_ != nullptr && parent_->IsCancelled()); }
+
+void TaskGroup::Wait()
+{
+  WaitAll();
+  std::lock_guard<std::mutex> lock(latch_);
+  if (error_ != nullptr) {
+    auto error = error_;
+    error_     = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+auto TaskGroup::RunOwnPendingTask() -> bool { return scheduler_->RunPendingTask(this, priority_); }
+
+void TaskGroup::Run(const Task &task)
+{
+  if (!IsCancelled()) {
+    TaskScope scope(this);
+    try {
+      task();
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(latch_);
+      if (error_ == nullptr) {
+        error_ = std::current_exception();
+      }
+      cancelled_ = true;
+    }
+  }
+  // the group may be destroyed by the waiter as soon as the latch is released
+  std::lock_guard<std::mutex> lock(latch_);
+  if (--pending_ == 0) {
+    done_cv_.notify_all();
+  }
+}
+
+void TaskGroup::WaitAll()
+{
+  while (true) {
+    {
+      std::lock_guard<std::mutex> lock(latch_);
+      if (pending_ == 0) {
+        return;
+      }
+    }
+    // help with the tasks of this group, they may be queued behind the task running in this thread. the tasks of other
+    // groups are left to the workers, one of them may block the waiter for as long as it runs
+    if (RunOwnPendingTask()) {
+      continue;
+    }
+    // wake up now and then to help with the tasks of this group submitted after the check above
+    std::unique_lock<std::mutex> lock(latch_);
+    done_cv_.wait_for(lock, WAIT_HELP_INTERVAL, [this]() { return pending_ == 0; });
+  }
+}
+
+TaskScope::TaskScope(TaskGroup *group) : prev_(tls_group) { tls_group = group; }
+
+TaskScope::~TaskScope() { tls_group = prev_; }
+
+}  // namespace wsdb
@@ -0,0 +1,227 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+/**
+ * @brief A process-wide work-stealing task scheduler shared by all queries.
+ * Each worker owns a deque of tasks per priority. A worker pops its own tasks in LIFO order for cache locality and
+ * steals the oldest tasks of other workers when it runs out of work. Tasks of higher priority are always taken before
+ * tasks of lower priority. Tasks are submitted through a TaskGroup, which tracks the tasks of one query (or one
+ * operator of a query), so that they can be waited and cancelled as a whole.
+ * Tasks should not block on other tasks except through TaskGroup::Wait, which runs the pending tasks of the group while
+ * waiting, so the workers can never be exhausted by tasks waiting for each other.
+ */
+
+#ifndef WSDB_TASK_SCHEDULER_H
+#define WSDB_TASK_SCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../../common/micro.h"
+
+namespace wsdb {
+
+enum class TaskPriority
+{
+  HIGH   = 0,  // latency sensitive work, e.g. scans a client is waiting for
+  NORMAL = 1,  // query execution, e.g. sort runs, joins, index builds
+  LOW    = 2   // background work, e.g. flushing and prefetching
+};
+
+static constexpr size_t TASK_PRIORITY_NUM = 3;
+
+using Task = std::function<void()>;
+
+class TaskGroup;
+
+class TaskScheduler
+{
+public:
+  explicit TaskScheduler(size_t worker_num);
+
+  ~TaskScheduler();
+
+  DISABLE_COPY_MOVE_AND_ASSIGN(TaskScheduler)
+
+  /**
+   * the scheduler shared by the whole process, sized to the number of cores
+   * @return
+   */
+  static auto GetInstance() -> TaskScheduler *;
+
+  [[nodiscard]] auto GetWorkerNum() const -> size_t { return workers_.size(); }
+
+  /**
+   * submit a task, a task submitted by a worker goes to its own deque, otherwise the deques are used in turn
+   * @param task
+   * @param priority
+   * @param group the group the task belongs to, nullptr if there is none
+   */
+  void Submit(Task task, TaskPriority priority, const TaskGroup *group = nullptr);
+
+  /**
+   * run one pending task in the calling thread
+   * @return false if there is no pending task
+   */
+  auto RunPendingTask() -> bool;
+
+  /**
+   * run the oldest pending task of a group in the calling thread
+   * @param group
+   * @param priority the priority the tasks of the group are submitted with
+   * @return false if the group has no pending task
+   */
+  auto RunPendingTask(const TaskGroup *group, TaskPriority priority) -> bool;
+
+private:
+  struct QueuedTask
+  {
+    Task             task_;
+    const TaskGroup *group_;
+  };
+
+  struct WorkerQueue
+  {
+    std::mutex             latch_;
+    std::deque<QueuedTask> tasks_[TASK_PRIORITY_NUM];
+  };
+
+  void WorkerLoop(size_t worker_id);
+
+  /**
+   * take the task of the highest priority, first from the back of the own deque, then from the front of the others
+   * @param worker_id the worker taking the task, or the number of workers for a thread outside the scheduler
+   * @param task
+   * @return
+   */
+  auto PopTask(size_t worker_id, Task &task) -> bool;
+
+  /**
+   * take the oldest task of a group from any deque
+   * @param group
+   * @param priority
+   * @param task
+   * @return
+   */
+  auto PopGroupTask(const TaskGroup *group, TaskPriority priority, Task &task) -> bool;
+
+  /**
+   * @return the id of the calling thread in this scheduler, or the number of workers if it is not a worker
+   */
+  [[nodiscard]] auto GetWorkerId() const -> size_t;
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread>                  workers_;
+  std::atomic<size_t>                       next_queue_;  // deque for the next task submitted from outside
+  std::atomic<size_t>                       task_num_;    // number of queued tasks, counted before they are queued
+
+  std::mutex              sleep_latch_;
+  std::condition_variable sleep_cv_;
+  bool                    stop_;
+};
+
+/**
+ * @brief A set of tasks that are waited and cancelled together, e.g. all the tasks of a query.
+ * Groups form a tree: a group is cancelled when its parent is cancelled. By default the parent is the group of the
+ * task running in the calling thread (see TaskScope), so the tasks spawned by a query are cancelled with the query.
+ * A cancelled group skips its tasks that have not started, running tasks can check IsCancelled to stop early.
+ */
+class TaskGroup
+{
+public:
+  explicit TaskGroup(TaskPriority priority = TaskPriority::NORMAL, TaskGroup *parent = Current(),
+      TaskScheduler *scheduler = TaskScheduler::GetInstance());
+
+  /**
+   * cancel the tasks that have not started and wait for the running ones
+   */
+  ~TaskGroup();
+
+  DISABLE_COPY_MOVE_AND_ASSIGN(TaskGroup)
+
+  /**
+   * the group of the task running in the calling thread, nullptr if there is none
+   * @return
+   */
+  static auto Current() -> TaskGroup *;
+
+  void Submit(Task task);
+
+  void Cancel();
+
+  [[nodiscard]] auto IsCancelled() const -> bool;
+
+  /**
+   * wait until all the submitted tasks finish, the calling thread runs the pending tasks of this group meanwhile.
+   * the first exception thrown by a task is rethrown here, and the group is cancelled when a task throws.
+   */
+  void Wait();
+
+  /**
+   * run one pending task of this group in the calling thread, the tasks of other groups are left to the workers
+   * @return false if the group has no pending task
+   */
+  auto RunOwnPendingTask() -> bool;
+
+private:
+  friend class TaskScope;
+
+  void Run(const Task &task);
+
+  void WaitAll();
+
+  TaskScheduler *scheduler_;
+  TaskPriority   priority_;
+  TaskGroup     *parent_;
+
+  std::atomic<bool>       cancelled_;
+  std::mutex              latch_;
+  std::condition_variable done_cv_;
+  size_t                  pending_;
+  std::exception_ptr      error_;
+};
+
+/**
+ * @brief Make a group the current group of the calling thread until the scope ends.
+ */
+class TaskScope
+{
+public:
+  explicit TaskScope(TaskGroup *group);
+
+  ~TaskScope();
+
+  DISABLE_COPY_MOVE_AND_ASSIGN(TaskScope)
+
+private:
+  TaskGroup *prev_;
+};
+
+}  // namespace wsdb
+
+#endif  // WSDB_TASK_SCHEDULER_H
@@ -26,6 +26,18 @@
 
 namespace wsdb {
 
+static auto MakeSeqScan(const std::shared_ptr<ScanPlan> &scan, DatabaseHandle *db) -> std::unique_ptr<SeqScanExecutor>
+{
+  auto tab = db->GetTable(scan->table_name_);
+  if (tab == nullptr) {
+    WSDB_THROW(WSDB_TABLE_MISS, scan->table_name_);
+  }
+  if (scan->fields_.empty() && scan->conds_.empty() && scan->join_filter_ == nullptr) {
+    return std::make_unique<SeqScanExecutor>(tab);
+  }
+  return std::make_unique<SeqScanExecutor>(tab, scan->fields_, scan->conds_, scan->join_filter_);
+}
+
 // translate the plan to executor
 auto Executor::Translate(const std::shared_ptr<AbstractPlan> &plan, DatabaseHandle *db) -> AbstractExecutorUptr
 {
@@ -42,6 +54,14 @@ auto Executor::Translate(const std::shared_ptr<AbstractPlan> &plan, DatabaseHand
     return std::make_unique<DescTableExecutor>(db->GetTable(desc_table->table_name_));
   } else if (const auto show_table = std::dynamic_pointer_cast<ShowTablesPlan>(plan)) {
     return std::make_unique<ShowTablesExecutor>(db);
+  } else if (const auto create_index = std::dynamic_pointer_cast<CreateIndexPlan>(plan)) {
+    return std::make_unique<CreateIndexExecutor>(create_index->table_name_,
+        std::move(create_index->key_schema_),
+        create_index->index_type_,
+        std::move(create_index->include_schema_),
+        db);
+  } else if (const auto drop_index = std::dynamic_pointer_cast<DropIndexPlan>(plan)) {
+    return std::make_unique<DropIndexExecutor>(drop_index->table_name_, drop_index->index_name_, db);
   } else if (const auto insert = std::dynamic_pointer_cast<InsertPlan>(plan)) {
     if (db->GetTable(insert->table_name_) == nullptr) {
       WSDB_THROW(WSDB_TABLE_MISS, insert->table_name_);
@@ -69,19 +89,25 @@ auto Executor::Translate(const std::shared_ptr<AbstractPlan> &plan, DatabaseHand
     };
     return std::make_unique<FilterExecutor>(Translate(filter->child_, db), std::move(filter_func));
   } else if (const auto scan = std::dynamic_pointer_cast<ScanPlan>(plan)) {
-    auto tab = db->GetTable(scan->table_name_);
-    if (tab == nullptr) {
-      WSDB_THROW(WSDB_TABLE_MISS, scan->table_name_);
-    }
-    return std::make_unique<SeqScanExecutor>(tab);
+    return MakeSeqScan(scan, db);
+  } else if (const auto gather = std::dynamic_pointer_cast<GatherPlan>(plan)) {
+    return std::make_unique<GatherExecutor>(MakeSeqScan(gather->child_, db), gather->worker_num_);
   } else if (const auto idx_scan = std::dynamic_pointer_cast<IdxScanPlan>(plan)) {
     return std::make_unique<IdxScanExecutor>(db->GetTable(idx_scan->table_name_),
         db->GetIndex(idx_scan->idx_id_),
         idx_scan->conds_,
-        idx_scan->matched_fields_);
+        idx_scan->matched_fields_,
+        idx_scan->index_only_);
   } else if (const auto sort_plan = std::dynamic_pointer_cast<SortPlan>(plan)) {
-    return std::make_unique<SortExecutor>(
-        Translate(sort_plan->child_, db), std::move(sort_plan->key_schema_), sort_plan->is_desc_);
+    return std::make_unique<SortExecutor>(Translate(sort_plan->child_, db),
+        std::move(sort_plan->key_schema_),
+        sort_plan->is_desc_,
+        sort_plan->worker_num_);
+  } else if (const auto top_n_plan = std::dynamic_pointer_cast<TopNPlan>(plan)) {
+    return std::make_unique<TopNExecutor>(Translate(top_n_plan->child_, db),
+        std::move(top_n_plan->key_schema_),
+        top_n_plan->is_desc_,
+        top_n_plan->limit_);
   } else if (const auto proj_plan = std::dynamic_pointer_cast<ProjectPlan>(plan)) {
     return std::make_unique<ProjectionExecutor>(Translate(proj_plan->child_, db), std::move(proj_plan->schema_));
   } else if (const auto join_plan = std::dynamic_pointer_cast<JoinPlan>(plan)) {
@@ -94,10 +120,37 @@ auto Executor::Translate(const std::shared_ptr<AbstractPlan> &plan, DatabaseHand
           Translate(join_plan->right_, db),
           std::move(join_plan->left_key_schema_),
           std::move(join_plan->right_key_schema_));
+    } else if (join_plan->strategy_ == HASH) {
+      return std::make_unique<HashJoinExecutor>(join_plan->type_,
+          Translate(join_plan->left_, db),
+          Translate(join_plan->right_, db),
+          std::move(join_plan->left_key_schema_),
+          std::move(join_plan->right_key_schema_),
+          join_plan->build_left_,
+          join_plan->worker_num_,
+          join_plan->join_filter_);
+    } else if (join_plan->strategy_ == INDEX_NESTED_LOOP) {
+      auto scan = std::dynamic_pointer_cast<ScanPlan>(join_plan->right_);
+      WSDB_ASSERT(scan != nullptr, "right input of index join should be a table scan");
+      return std::make_unique<IndexNestedLoopJoinExecutor>(join_plan->type_,
+          Translate(join_plan->left_, db),
+          MakeSeqScan(scan, db),
+          join_plan->conds_,
+          std::move(join_plan->left_key_schema_),
+          db->GetTable(scan->table_name_),
+          db->GetIndex(join_plan->index_id_),
+          scan->conds_);
     }
   } else if (const auto agg_plan = std::dynamic_pointer_cast<AggregatePlan>(plan)) {
     auto agg_schema   = std::make_unique<RecordSchema>(agg_plan->agg_fields);
     auto group_schema = std::make_unique<RecordSchema>(agg_plan->group_fields_);
+    const auto gather = std::dynamic_pointer_cast<GatherPlan>(agg_plan->child_);
+    if (agg_plan->worker_num_ > 1 && gather != nullptr) {
+      return std::make_unique<AggregateExecutor>(MakeSeqScan(gather->child_, db),
+          std::move(agg_schema),
+          std::move(group_schema),
+          agg_plan->worker_num_);
+    }
     return std::make_unique<AggregateExecutor>(
         Translate(agg_plan->child_, db), std::move(agg_schema), std::move(group_schema));
   } else if (const auto lim = std::dynamic_pointer_cast<LimitPlan>(plan)) {
@@ -20,29 +20,136 @@
 //
 
 #include "executor_aggregate.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include "common/bitmap.h"
+#include "common/config.h"
+
+static std::atomic<long long> aggregate_fresh_id_ = 0;
+#define AGGREGATE_FILE_PATH(obj_name) FILE_NAME(TMP_DIR, obj_name, TMP_SUFFIX)
 
 namespace wsdb {
 
-AggregateExecutor::AggregateValue::AggregateValue(RecordSchema *schema) : schema_(schema) { WSDB_STUDENT_TODO(l3, t3); }
-AggregateExecutor::AggregateValue::AggregateValue(RecordSchema *schema, const Record &record)
+static constexpr size_t AGGREGATE_PARTITION_NUM = static_cast<size_t>(1) << AGGREGATE_PARTITION_BITS;
+// the partitions are merged by more tasks than workers, so that a worker done early can take another range
+static constexpr size_t AGGREGATE_TASKS_PER_WORKER = 4;
+
+static auto AlignUp(size_t size) -> size_t { return (size + sizeof(int64_t) - 1) / sizeof(int64_t) * sizeof(int64_t); }
+
+/// write a number to a field of an output record, a float is truncated for an int field as ValueFactory::CastTo does
+template <typename T>
+static void WriteNumber(FieldType type, char *data, T value)
 {
-  WSDB_STUDENT_TODO(l3, t3);
+  if (type == TYPE_FLOAT) {
+    *reinterpret_cast<float *>(data) = static_cast<float>(value);
+  } else {
+    *reinterpret_cast<int32_t *>(data) = static_cast<int32_t>(value);
+  }
 }
-void AggregateExecutor::AggregateValue::CombineWith(const AggregateExecutor::AggregateValue &other)
+
+static auto CompareField(FieldType type, size_t size, const char *lhs, const char *rhs) -> int
 {
-  WSDB_STUDENT_TODO(l3, t3);
+  switch (type) {
+    case TYPE_INT: {
+      auto l = *reinterpret_cast<const int32_t *>(lhs);
+      auto r = *reinterpret_cast<const int32_t *>(rhs);
+      return (l > r) - (l < r);
+    }
+    case TYPE_FLOAT: {
+      auto l = *reinterpret_cast<const float *>(lhs);
+      auto r = *reinterpret_cast<const float *>(rhs);
+      return (l > r) - (l < r);
+    }
+    case TYPE_BOOL: {
+      auto l = *reinterpret_cast<const bool *>(lhs);
+      auto r = *reinterpret_cast<const bool *>(rhs);
+      return static_cast<int>(l) - static_cast<int>(r);
+    }
+    case TYPE_STRING: return std::strncmp(lhs, rhs, size);
+    default: WSDB_FETAL(fmt::format("unsupported field type {}", FieldTypeToString(type)));
+  }
 }
 
-auto AggregateExecutor::AggregateValue::Values() const -> const std::vector<ValueSptr> & { return values_; }
+AggregateExecutor::GroupTable::GroupTable(size_t key_size, size_t row_size)
+    : key_size_(key_size), row_size_(row_size), slot_mask_(0)
+{}
 
-void AggregateExecutor::AggregateValue::Finalize() { WSDB_STUDENT_TODO(l3, t3); }
+auto AggregateExecutor::GroupTable::Find(const char *key, size_t hash) const -> size_t
+{
+  if (slots_.empty()) {
+    return INVALID_ROW;
+  }
+  for (auto idx = hash & slot_mask_;; idx = (idx + 1) & slot_mask_) {
+    const auto &slot = slots_[idx];
+    if (slot.row_ == INVALID_ROW) {
+      return INVALID_ROW;
+    }
+    if (slot.hash_ == hash && std::memcmp(GetRow(slot.row_), key, key_size_) == 0) {
+      return slot.row_;
+    }
+  }
+}
+
+auto AggregateExecutor::GroupTable::Add(const char *key, size_t hash) -> size_t
+{
+  // keep the load factor under 0.5 so that probe sequences stay short
+  if (2 * (hashes_.size() + 1) > slots_.size()) {
+    Grow();
+  }
+  auto row = hashes_.size();
+  hashes_.push_back(hash);
+  rows_.resize(hashes_.size() * row_size_, 0);
+  std::memcpy(GetRow(row), key, key_size_);
+  for (auto idx = hash & slot_mask_;; idx = (idx + 1) & slot_mask_) {
+    if (slots_[idx].row_ == INVALID_ROW) {
+      slots_[idx] = Slot{hash, row};
+      return row;
+    }
+  }
+}
 
-AggregateExecutor::AggregateExecutor(
-    AbstractExecutorUptr child, RecordSchemaUptr agg_schema, RecordSchemaUptr group_schema)
+void AggregateExecutor::GroupTable::Grow()
+{
+  auto slot_num = std::max(slots_.size() * 2, static_cast<size_t>(16));
+  slots_.assign(slot_num, Slot{0, INVALID_ROW});
+  slot_mask_ = slot_num - 1;
+  for (size_t row = 0; row < hashes_.size(); ++row) {
+    for (auto idx = hashes_[row] & slot_mask_;; idx = (idx + 1) & slot_mask_) {
+      if (slots_[idx].row_ == INVALID_ROW) {
+        slots_[idx] = Slot{hashes_[row], row};
+        break;
+      }
+    }
+  }
+}
+
+void AggregateExecutor::GroupTable::Clear()
+{
+  rows_.clear();
+  hashes_.clear();
+  slots_.clear();
+  slot_mask_ = 0;
+}
+
+AggregateExecutor::AggregateExecutor(AbstractExecutorUptr child, RecordSchemaUptr agg_schema,
+    RecordSchemaUptr group_schema, size_t worker_num, size_t buffer_size)
     : AbstractExecutor(Basic),
       child_(std::move(child)),
       agg_schema_(std::move(agg_schema)),
-      group_schema_(std::move(group_schema))
+      group_schema_(std::move(group_schema)),
+      key_encoder_(child_->GetOutSchema(), group_schema_.get(), false),
+      key_size_(key_encoder_.GetKeySize()),
+      table_(0, 0),
+      file_prefix_(fmt::format("aggregate_{}", aggregate_fresh_id_++)),
+      tmp_file_num_(0),
+      worker_num_(std::max(worker_num, static_cast<size_t>(1))),
+      scan_(nullptr),
+      radix_bits_(0),
+      out_table_(0),
+      out_row_(0),
+      is_end_(true)
 {
   std::vector<RTField> fields;
   for (const auto &field : group_schema_->GetFields()) {
@@ -52,12 +159,522 @@ AggregateExecutor::AggregateExecutor(
     fields.push_back(field);
   }
   out_schema_ = std::make_unique<RecordSchema>(fields);
+
+  const auto *child_schema = child_->GetOutSchema();
+  for (const auto &field : group_schema_->GetFields()) {
+    group_idxes_.push_back(child_schema->GetFieldIndex(field.field_.table_id_, field.field_.field_name_));
+    WSDB_ASSERT(group_idxes_.back() < child_schema->GetFieldCount(), "group field not found in the child");
+  }
+  // a row is the group key, the null map and the data of the group fields, and the states of the aggregates
+  group_offset_ = key_size_;
+  state_offset_ = AlignUp(
+      group_offset_ + BITMAP_SIZE(group_schema_->GetFieldCount()) + group_schema_->GetRecordLength());
+  size_t state_size = 0;
+  for (size_t i = 0; i < agg_schema_->GetFieldCount(); ++i) {
+    const auto &field = agg_schema_->GetFieldAt(i);
+    AggField    agg{};
+    agg.type_         = field.agg_type_;
+    agg.out_type_     = field.field_.field_type_;
+    agg.out_offset_   = out_schema_->GetFieldOffset(group_schema_->GetFieldCount() + i);
+    agg.state_offset_ = state_offset_ + state_size;
+    state_size += sizeof(int64_t);
+    if (agg.type_ != AGG_COUNT_STAR) {
+      agg.in_idx_ = child_schema->GetFieldIndex(field.field_.table_id_, field.field_.field_name_);
+      WSDB_ASSERT(agg.in_idx_ < child_schema->GetFieldCount(), "aggregate field not found in the child");
+      const auto &in_field = child_schema->GetFieldAt(agg.in_idx_);
+      agg.in_type_         = in_field.field_.field_type_;
+      agg.in_size_         = in_field.field_.field_size_;
+      agg.in_offset_       = child_schema->GetFieldOffset(agg.in_idx_);
+    }
+    if (agg.type_ == AGG_SUM || agg.type_ == AGG_AVG) {
+      if (agg.in_type_ != TYPE_INT && agg.in_type_ != TYPE_FLOAT) {
+        WSDB_THROW(WSDB_TYPE_MISSMATCH,
+            fmt::format("{} of a {} field", AggTypeToString(agg.type_), FieldTypeToString(agg.in_type_)));
+      }
+      state_size += sizeof(int64_t);  // int64_t sum of ints or double sum of floats
+    } else if (agg.type_ == AGG_MIN || agg.type_ == AGG_MAX) {
+      state_size += AlignUp(agg.in_size_);
+    }
+    agg_fields_.push_back(agg);
+  }
+  row_size_ = state_offset_ + state_size;
+  table_    = GroupTable(key_size_, row_size_);
+  // a group is charged with its row, its hash and up to 4 slots of the table
+  max_group_num_ = std::max(buffer_size / (row_size_ + 9 * sizeof(size_t)), static_cast<size_t>(1));
+  if (worker_num_ > 1) {
+    scan_ = dynamic_cast<SeqScanExecutor *>(child_.get());
+    WSDB_ASSERT(scan_ != nullptr, "parallel aggregation reads the morsels of a scan");
+  }
 }
 
-void AggregateExecutor::Init() { WSDB_STUDENT_TODO(l3, t3); }
+AggregateExecutor::~AggregateExecutor()
+{
+  try {
+    RemovePartitions();
+  } catch (...) {
+    // the partition files are left in TMP_DIR, which is not fatal
+  }
+}
+
+void AggregateExecutor::Init()
+{
+  RemovePartitions();
+  table_.Clear();
+  merged_.clear();
+  out_table_ = 0;
+  out_row_   = 0;
+  if (worker_num_ > 1) {
+    AggregateParallel();
+    is_end_ = merged_.empty() && !LoadNextPartition();
+    record_ = is_end_ ? nullptr : MakeRecord(GetOutRow());
+    return;
+  }
+  std::vector<char> key(key_size_);
+  for (child_->Init(); !child_->IsEnd(); child_->Next()) {
+    auto record = child_->GetRecord();
+    key_encoder_.Encode(*record, key.data());
+    AddRecord(key.data(), *record, 0);
+  }
+  FinishSpill();
+  if (table_.GetGroupNum() == 0 && group_schema_->GetFieldCount() == 0) {
+    // aggregates without groups produce one record, count is 0 and the others are null
+    InitGroup(table_.GetRow(table_.Add(key.data(), HashKey(key.data()))), Record(child_->GetOutSchema()));
+  }
+  is_end_ = table_.GetGroupNum() == 0 && !LoadNextPartition();
+  record_ = is_end_ ? nullptr : MakeRecord(GetOutRow());
+}
+
+void AggregateExecutor::Next()
+{
+  if (IsEnd()) {
+    WSDB_FETAL("AggregateExecutor is end");
+  }
+  if (AdvanceOutRow()) {
+    record_ = MakeRecord(GetOutRow());
+    return;
+  }
+  table_.Clear();
+  merged_.clear();
+  is_end_ = true;
+  record_ = nullptr;
+}
+
+auto AggregateExecutor::IsEnd() const -> bool { return is_end_; }
+
+auto AggregateExecutor::HashKey(const char *key) const -> size_t
+{
+  return KeyEncoder::Hash(key, key_size_);
+}
+
+void AggregateExecutor::InitGroup(char *row, const Record &record) const
+{
+  auto *nullmap    = row + group_offset_;
+  auto *group_data = nullmap + BITMAP_SIZE(group_schema_->GetFieldCount());
+  for (size_t i = 0; i < group_idxes_.size(); ++i) {
+    auto idx = group_idxes_[i];
+    if (BitMap::GetBit(record.GetNullMap(), idx)) {
+      BitMap::SetBit(nullmap, i, true);
+    }
+    std::memcpy(group_data + group_schema_->GetFieldOffset(i),
+        record.GetData() + record.GetSchema()->GetFieldOffset(idx),
+        group_schema_->GetFieldAt(i).field_.field_size_);
+  }
+}
+
+void AggregateExecutor::AddRecord(const char *key, const Record &record, size_t level)
+{
+  auto hash = HashKey(key);
+  auto row  = table_.Find(key, hash);
+  if (row == INVALID_ROW) {
+    // a partition of the last level is aggregated in memory whatever its size
+    if (table_.GetGroupNum() < max_group_num_ || level >= AGGREGATE_MAX_PARTITION_LEVEL) {
+      row = table_.Add(key, hash);
+      InitGroup(table_.GetRow(row), record);
+    } else {
+      if (spill_writers_.empty()) {
+        for (size_t i = 0; i < AGGREGATE_PARTITION_NUM; ++i) {
+          auto file = GetPartitionFileName(tmp_file_num_++);
+          spill_writers_.push_back(std::make_unique<RunWriter>(file, child_->GetOutSchema(), key_size_));
+          spilled_.push_back(Partition{file, 0, level});
+        }
+      }
+      auto idx = GetPartitionIdx(hash, level);
+      spill_writers_[idx]->Append(key, record);
+      spilled_[idx].rec_num_++;
+      return;
+    }
+  }
+  Accumulate(table_.GetRow(row), record);
+}
 
-void AggregateExecutor::Next() { WSDB_STUDENT_TODO(l3, t3); }
+void AggregateExecutor::Accumulate(char *row, const Record &record) const
+{
+  for (const auto &agg : agg_fields_) {
+    auto *state = row + agg.state_offset_;
+    auto &count = *reinterpret_cast<int64_t *>(state);
+    if (agg.type_ == AGG_COUNT_STAR) {
+      count++;
+      continue;
+    }
+    // null values are ignored by all the aggregates but count(*)
+    if (BitMap::GetBit(record.GetNullMap(), agg.in_idx_)) {
+      continue;
+    }
+    const auto *value = record.GetData() + agg.in_offset_;
+    auto       *acc   = state + sizeof(int64_t);
+    switch (agg.type_) {
+      case AGG_SUM:
+      case AGG_AVG:
+        if (agg.in_type_ == TYPE_FLOAT) {
+          *reinterpret_cast<double *>(acc) += *reinterpret_cast<const float *>(value);
+        } else {
+          *reinterpret_cast<int64_t *>(acc) += *reinterpret_cast<const int32_t *>(value);
+        }
+        break;
+      case AGG_MIN:
+      case AGG_MAX: {
+        auto cmp = count == 0 ? 0 : CompareField(agg.in_type_, agg.in_size_, value, acc);
+        if (count == 0 || (agg.type_ == AGG_MIN ? cmp < 0 : cmp > 0)) {
+          std::memcpy(acc, value, agg.in_size_);
+        }
+        break;
+      }
+      default: break;
+    }
+    count++;
+  }
+}
 
-auto AggregateExecutor::IsEnd() const -> bool { WSDB_STUDENT_TODO(l3, t3); }
+void AggregateExecutor::Merge(char *row, const char *partial) const
+{
+  for (const auto &agg : agg_fields_) {
+    auto       *state         = row + agg.state_offset_;
+    const auto *partial_state = partial + agg.state_offset_;
+    auto       &count         = *reinterpret_cast<int64_t *>(state);
+    auto        partial_count = *reinterpret_cast<const int64_t *>(partial_state);
+    if (partial_count == 0) {
+      continue;
+    }
+    auto       *acc         = state + sizeof(int64_t);
+    const auto *partial_acc = partial_state + sizeof(int64_t);
+    switch (agg.type_) {
+      case AGG_SUM:
+      case AGG_AVG:
+        if (agg.in_type_ == TYPE_FLOAT) {
+          *reinterpret_cast<double *>(acc) += *reinterpret_cast<const double *>(partial_acc);
+        } else {
+          *reinterpret_cast<int64_t *>(acc) += *reinterpret_cast<const int64_t *>(partial_acc);
+        }
+        break;
+      case AGG_MIN:
+      case AGG_MAX: {
+        auto cmp = count == 0 ? 0 : CompareField(agg.in_type_, agg.in_size_, partial_acc, acc);
+        if (count == 0 || (agg.type_ == AGG_MIN ? cmp < 0 : cmp > 0)) {
+          std::memcpy(acc, partial_acc, agg.in_size_);
+        }
+        break;
+      }
+      default: break;
+    }
+    count += partial_count;
+  }
+}
+
+auto AggregateExecutor::GetPartitionIdx(size_t hash, size_t level) -> size_t
+{
+  auto shift = sizeof(size_t) * 8 - AGGREGATE_PARTITION_BITS * (level + 1);
+  return (hash >> shift) & (AGGREGATE_PARTITION_NUM - 1);
+}
+
+auto AggregateExecutor::GetPartitionFileName(size_t file_idx) const -> std::string
+{
+  return AGGREGATE_FILE_PATH(fmt::format("{}_{}", file_prefix_, file_idx));
+}
+
+void AggregateExecutor::FinishSpill()
+{
+  for (auto &writer : spill_writers_) {
+    writer->Close();
+  }
+  spill_writers_.clear();
+  for (auto &partition : spilled_) {
+    if (partition.rec_num_ == 0) {
+      std::filesystem::remove(partition.file_);
+    } else {
+      partitions_.push_back(partition);
+    }
+  }
+  spilled_.clear();
+}
+
+auto AggregateExecutor::LoadNextPartition() -> bool
+{
+  while (!partitions_.empty()) {
+    auto partition = partitions_.back();
+    partitions_.pop_back();
+    table_.Clear();
+    {
+      RunReader reader(partition.file_, child_->GetOutSchema(), key_size_);
+      while (reader.LoadNextRecord()) {
+        AddRecord(reader.GetKey(), *reader.GetRecord(), partition.level_ + 1);
+      }
+    }
+    std::filesystem::remove(partition.file_);
+    FinishSpill();
+    if (table_.GetGroupNum() > 0) {
+      out_row_ = 0;
+      return true;
+    }
+  }
+  return false;
+}
+
+auto AggregateExecutor::MakeRecord(const char *row) const -> RecordUptr
+{
+  const auto       *data = row;
+  std::vector<char> nullmap(BITMAP_SIZE(out_schema_->GetFieldCount()), 0);
+  std::vector<char> out(out_schema_->GetRecordLength(), 0);
+  // the group fields come first in the output, in the layout of group_schema_
+  const auto *group_nullmap = data + group_offset_;
+  for (size_t i = 0; i < group_schema_->GetFieldCount(); ++i) {
+    if (BitMap::GetBit(group_nullmap, i)) {
+      BitMap::SetBit(nullmap.data(), i, true);
+    }
+  }
+  std::memcpy(
+      out.data(), group_nullmap + BITMAP_SIZE(group_schema_->GetFieldCount()), group_schema_->GetRecordLength());
+  for (size_t i = 0; i < agg_fields_.size(); ++i) {
+    const auto &agg   = agg_fields_[i];
+    const auto *state = data + agg.state_offset_;
+    auto        count = *reinterpret_cast<const int64_t *>(state);
+    const auto *acc   = state + sizeof(int64_t);
+    auto       *value = out.data() + agg.out_offset_;
+    if (agg.type_ == AGG_COUNT || agg.type_ == AGG_COUNT_STAR) {
+      WriteNumber(agg.out_type_, value, count);
+      continue;
+    }
+    // the other aggregates of no value are null
+    if (count == 0) {
+      BitMap::SetBit(nullmap.data(), group_schema_->GetFieldCount() + i, true);
+      continue;
+    }
+    auto is_float = agg.in_type_ == TYPE_FLOAT;
+    switch (agg.type_) {
+      case AGG_SUM:
+        if (is_float) {
+          WriteNumber(agg.out_type_, value, *reinterpret_cast<const double *>(acc));
+        } else {
+          WriteNumber(agg.out_type_, value, *reinterpret_cast<const int64_t *>(acc));
+        }
+        break;
+      case AGG_AVG: {
+        auto sum = is_float ? *reinterpret_cast<const double *>(acc)
+                            : static_cast<double>(*reinterpret_cast<const int64_t *>(acc));
+        WriteNumber(agg.out_type_, value, sum / static_cast<double>(count));
+        break;
+      }
+      default: std::memcpy(value, acc, agg.in_size_); break;
+    }
+  }
+  return std::make_unique<Record>(out_schema_.get(), nullmap.data(), out.data(), INVALID_RID);
+}
+
+void AggregateExecutor::AggregateParallel()
+{
+  // enough partitions for each task of the merge to get several of them
+  radix_bits_ = 0;
+  while ((static_cast<size_t>(1) << radix_bits_) < worker_num_ * AGGREGATE_TASKS_PER_WORKER) {
+    radix_bits_++;
+  }
+  auto part_num = static_cast<size_t>(1) << radix_bits_;
+  tasks_        = std::make_unique<TaskGroup>();
+  // the files of the workers and then the ones of the merge tasks are reserved here, the tasks do not touch tmp_file_num_
+  std::vector<PartialGroups> partials(worker_num_);
+  for (auto &partial : partials) {
+    partial.tables_.assign(part_num, table_);
+    partial.spill_writers_.resize(part_num);
+    for (size_t p = 0; p < part_num; ++p) {
+      partial.spilled_.push_back(Partition{GetPartitionFileName(tmp_file_num_++), 0, 0});
+    }
+  }
+  auto file_base = tmp_file_num_;
+  tmp_file_num_ += part_num;
+  // phase 1: each worker pre-aggregates the morsels it takes into its own tables
+  std::atomic<size_t> next_morsel     = 0;
+  std::atomic<size_t> total_group_num = 0;
+  for (auto &partial : partials) {
+    tasks_->Submit([this, &partial, &next_morsel, &total_group_num]() {
+      PreAggregate(partial, next_morsel, total_group_num);
+    });
+  }
+  tasks_->Wait();
+  // phase 2: each task merges the partial groups and the spilled records of a range of partitions
+  merged_.assign(part_num, table_);
+  std::vector<Partition> leftovers(part_num);
+  std::atomic<size_t>    group_num = 0;
+  auto                   task_num  = worker_num_ * AGGREGATE_TASKS_PER_WORKER;
+  auto                   task_size = (part_num + task_num - 1) / task_num;
+  for (size_t begin = 0; begin < part_num; begin += task_size) {
+    tasks_->Submit([this, &partials, &leftovers, &group_num, file_base, begin,
+                       end = std::min(part_num, begin + task_size)]() {
+      for (auto p = begin; p < end; ++p) {
+        leftovers[p] = MergePartition(p, partials, file_base + p, group_num);
+      }
+    });
+  }
+  tasks_->Wait();
+  partials.clear();
+  // the groups left are aggregated serially, partition by partition, once the groups in merged_ are emitted
+  for (const auto &leftover : leftovers) {
+    if (leftover.rec_num_ > 0) {
+      partitions_.push_back(leftover);
+    }
+  }
+  if (group_schema_->GetFieldCount() == 0 && total_group_num == 0) {
+    // aggregates without groups produce one record, count is 0 and the others are null
+    InitGroup(merged_[0].GetRow(merged_[0].Add("", HashKey(""))), Record(child_->GetOutSchema()));
+  }
+  // skip the empty partitions so that GetOutRow always points to a group
+  merged_.erase(std::remove_if(merged_.begin(), merged_.end(), [](const GroupTable &table) {
+    return table.GetGroupNum() == 0;
+  }), merged_.end());
+}
+
+void AggregateExecutor::PreAggregate(
+    PartialGroups &partial, std::atomic<size_t> &next_morsel, std::atomic<size_t> &total_group_num) const
+{
+  std::vector<char> key(key_size_);
+  auto              morsel_num = scan_->GetMorselNum();
+  for (auto morsel_id = next_morsel++; morsel_id < morsel_num && !tasks_->IsCancelled(); morsel_id = next_morsel++) {
+    for (const auto &record : scan_->ScanMorsel(morsel_id, *tasks_)) {
+      key_encoder_.Encode(*record, key.data());
+      auto  hash  = HashKey(key.data());
+      auto  idx   = GetRadixIdx(hash);
+      auto &table = partial.tables_[idx];
+      auto  row   = table.Find(key.data(), hash);
+      if (row == INVALID_ROW) {
+        // the records of new groups are spilled once the groups of all the workers fill the buffer
+        if (total_group_num >= max_group_num_) {
+          auto &writer = partial.spill_writers_[idx];
+          if (writer == nullptr) {
+            writer = std::make_unique<RunWriter>(partial.spilled_[idx].file_, child_->GetOutSchema(), key_size_);
+          }
+          writer->Append(key.data(), *record);
+          partial.spilled_[idx].rec_num_++;
+          continue;
+        }
+        row = table.Add(key.data(), hash);
+        InitGroup(table.GetRow(row), *record);
+        total_group_num++;
+      }
+      Accumulate(table.GetRow(row), *record);
+    }
+  }
+  for (auto &writer : partial.spill_writers_) {
+    if (writer != nullptr) {
+      writer->Close();
+    }
+  }
+}
+
+auto AggregateExecutor::MergePartition(
+    size_t part_idx, std::vector<PartialGroups> &partials, size_t file_idx, std::atomic<size_t> &group_num) -> Partition
+{
+  auto &table = merged_[part_idx];
+  for (auto &partial : partials) {
+    auto &partial_table = partial.tables_[part_idx];
+    for (size_t row = 0; row < partial_table.GetGroupNum(); ++row) {
+      const auto *partial_row = partial_table.GetRow(row);
+      auto        found       = table.Find(partial_row, partial_table.GetHash(row));
+      if (found == INVALID_ROW) {
+        // the first partial group is copied with its group fields and states
+        std::memcpy(table.GetRow(table.Add(partial_row, partial_table.GetHash(row))), partial_row, row_size_);
+        group_num++;
+      } else {
+        Merge(table.GetRow(found), partial_row);
+      }
+    }
+    partial_table.Clear();
+  }
+  // the radix partitioning is the pass of level 0 of the records spilled again
+  Partition                  leftover{GetPartitionFileName(file_idx), 0, 0};
+  std::unique_ptr<RunWriter> writer;
+  for (auto &partial : partials) {
+    const auto &spilled = partial.spilled_[part_idx];
+    if (spilled.rec_num_ == 0) {
+      continue;
+    }
+    {
+      RunReader reader(spilled.file_, child_->GetOutSchema(), key_size_);
+      while (reader.LoadNextRecord()) {
+        const auto *key    = reader.GetKey();
+        const auto &record = *reader.GetRecord();
+        auto        hash   = HashKey(key);
+        auto        row    = table.Find(key, hash);
+        // the check races with the other tasks, which may exceed the buffer by a group each
+        if (row == INVALID_ROW && group_num < max_group_num_) {
+          row = table.Add(key, hash);
+          InitGroup(table.GetRow(row), record);
+          group_num++;
+        }
+        if (row != INVALID_ROW) {
+          Accumulate(table.GetRow(row), record);
+          continue;
+        }
+        if (writer == nullptr) {
+          writer = std::make_unique<RunWriter>(leftover.file_, child_->GetOutSchema(), key_size_);
+        }
+        writer->Append(key, record);
+        leftover.rec_num_++;
+      }
+    }
+    std::filesystem::remove(spilled.file_);
+  }
+  if (writer != nullptr) {
+    writer->Close();
+  }
+  return leftover;
+}
+
+auto AggregateExecutor::GetRadixIdx(size_t hash) const -> size_t
+{
+  auto shift = sizeof(size_t) * 8 - AGGREGATE_PARTITION_BITS * AGGREGATE_MAX_PARTITION_LEVEL - radix_bits_;
+  return (hash >> shift) & ((static_cast<size_t>(1) << radix_bits_) - 1);
+}
+
+auto AggregateExecutor::GetOutRow() const -> const char *
+{
+  return out_table_ < merged_.size() ? merged_[out_table_].GetRow(out_row_) : table_.GetRow(out_row_);
+}
+
+auto AggregateExecutor::AdvanceOutRow() -> bool
+{
+  if (!merged_.empty()) {
+    if (++out_row_ < merged_[out_table_].GetGroupNum()) {
+      return true;
+    }
+    out_row_ = 0;
+    if (++out_table_ < merged_.size()) {
+      return true;
+    }
+    // then the groups spilled by the merge
+    merged_.clear();
+    return LoadNextPartition();
+  }
+  return ++out_row_ < table_.GetGroupNum() || LoadNextPartition();
+}
+
+void AggregateExecutor::RemovePartitions()
+{
+  spill_writers_.clear();
+  spilled_.clear();
+  partitions_.clear();
+  // consumed files are removed already, the error of a missing file is ignored
+  std::error_code ec;
+  for (size_t i = 0; i < tmp_file_num_; ++i) {
+    std::filesystem::remove(GetPartitionFileName(i), ec);
+  }
+  tmp_file_num_ = 0;
+}
 
-}  // namespace wsdb
\ No newline at end of file
+}  // namespace wsdb
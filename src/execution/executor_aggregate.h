@@ -19,17 +19,38 @@
 // Created by ziqi on 2024/8/5.
 //
 
+/**
+ * @brief Group the records of the child by the group fields and compute the aggregates of each group by hashing, the
+ * records of the groups not fitting in the buffer are partitioned to TMP_DIR
+ */
+
 #ifndef WSDB_EXECUTOR_AGGREGATE_H
 #define WSDB_EXECUTOR_AGGREGATE_H
-#include <unordered_map>
+#include <atomic>
+#include <limits>
+#include "common/config.h"
+#include "concurrency/task_scheduler.h"
 #include "executor_abstract.h"
+#include "executor_seqscan.h"
+#include "run_file.h"
+#include "system/handle/key_encoder.h"
 
 namespace wsdb {
 
 class AggregateExecutor : public AbstractExecutor
 {
 public:
-  AggregateExecutor(AbstractExecutorUptr child, RecordSchemaUptr agg_schema, RecordSchemaUptr group_schema);
+  /**
+   * @param child
+   * @param agg_schema
+   * @param group_schema
+   * @param worker_num number of workers aggregating in parallel, the child should be a SeqScanExecutor if it is above 1
+   * @param buffer_size bytes of the groups kept in memory, the records of the other groups are partitioned to files
+   */
+  AggregateExecutor(AbstractExecutorUptr child, RecordSchemaUptr agg_schema, RecordSchemaUptr group_schema,
+      size_t worker_num = 1, size_t buffer_size = AGGREGATE_BUFFER_SIZE);
+
+  ~AggregateExecutor() override;
 
   void Init() override;
 
@@ -38,48 +59,206 @@ public:
   [[nodiscard]] auto IsEnd() const -> bool override;
 
 private:
-  // aggregate value behaves like a writable record
-  class AggregateValue
+  static constexpr size_t INVALID_ROW = std::numeric_limits<size_t>::max();
+
+  /// @brief An aggregate, the field it reads from the child records and the place of its state in a group row
+  struct AggField
+  {
+    AggType   type_;
+    FieldType in_type_;  // the input of count(*) is not read
+    size_t    in_size_;
+    size_t    in_idx_;
+    size_t    in_offset_;
+    FieldType out_type_;
+    size_t    out_offset_;
+    size_t    state_offset_;  // the state is a count of the values aggregated followed by the sum, min or max
+  };
+
+  /// @brief Open-addressing table of the groups, each group is a fixed-width row starting with its key
+  class GroupTable
   {
   public:
-    AggregateValue() : schema_(nullptr) {}
+    GroupTable(size_t key_size, size_t row_size);
 
     /**
-     * create aggregate initial value according to schema
-     * @param schema
+     * @param key
+     * @param hash
+     * @return row of the group of the key, INVALID_ROW if there is none
      */
-    explicit AggregateValue(RecordSchema *schema);
+    [[nodiscard]] auto Find(const char *key, size_t hash) const -> size_t;
 
     /**
-     * create aggregate value according to schema and record
-     * @param schema
-     * @param record
+     * add a group whose row is the key followed by zeros, i.e. nothing is aggregated
+     * @return row of the group
      */
-    AggregateValue(RecordSchema *schema, const Record &record);
+    auto Add(const char *key, size_t hash) -> size_t;
+
+    [[nodiscard]] auto GetRow(size_t row) -> char * { return rows_.data() + row * row_size_; }
 
-    void CombineWith(const AggregateValue &other);
+    [[nodiscard]] auto GetRow(size_t row) const -> const char * { return rows_.data() + row * row_size_; }
 
-    [[nodiscard]] auto Values() const -> const std::vector<ValueSptr> &;
+    [[nodiscard]] auto GetHash(size_t row) const -> size_t { return hashes_[row]; }
 
-    void Finalize();
+    [[nodiscard]] auto GetGroupNum() const -> size_t { return hashes_.size(); }
 
-    virtual ~AggregateValue() = default;
+    void Clear();
 
   private:
-    RecordSchema          *schema_;
-    std::vector<ValueSptr> values_;
-    bool                   summarized_ = false;
-    // count the number of non-null values for avg calculation to avoid adding repeated count(field)
-    // maybe redundant when count(field) exists in the schema, but better than reconstructing the schema
-    std::unordered_map<size_t, int> avg_count_map_;
+    struct Slot
+    {
+      size_t hash_;
+      size_t row_;  // INVALID_ROW if the slot is empty
+    };
+
+    /**
+     * double the slots of the table and insert the groups again
+     */
+    void Grow();
+
+    size_t              key_size_;
+    size_t              row_size_;
+    std::vector<char>   rows_;
+    std::vector<size_t> hashes_;
+    std::vector<Slot>   slots_;
+    size_t              slot_mask_;
+  };
+
+  /// @brief Records of the child spilled to a file, with their group keys
+  struct Partition
+  {
+    std::string file_;
+    size_t      rec_num_;
+    size_t      level_;  // number of partitioning passes the records went through
+  };
+
+  /// @brief Partial groups of a worker of parallel aggregation, and the records it spilled, per radix partition
+  struct PartialGroups
+  {
+    std::vector<GroupTable>                 tables_;
+    std::vector<Partition>                  spilled_;
+    std::vector<std::unique_ptr<RunWriter>> spill_writers_;  // created when the first record of a partition spills
   };
 
+  [[nodiscard]] auto HashKey(const char *key) const -> size_t;
+
+  /**
+   * copy the group fields of a record to a new row
+   */
+  void InitGroup(char *row, const Record &record) const;
+
+  /**
+   * aggregate a record into its group, or spill it to the partitions of the level if its group is not in the table and
+   * the table is full
+   * @param key group key of the record
+   * @param record
+   * @param level
+   */
+  void AddRecord(const char *key, const Record &record, size_t level);
+
+  void Accumulate(char *row, const Record &record) const;
+
+  /**
+   * combine the states of a partial group into another row of the same group
+   */
+  void Merge(char *row, const char *partial) const;
+
+  /**
+   * the partition of a hash at a level, each level takes the next AGGREGATE_PARTITION_BITS high bits of the hash,
+   * while the slots of the table are chosen by the low bits
+   */
+  [[nodiscard]] static auto GetPartitionIdx(size_t hash, size_t level) -> size_t;
+
+  [[nodiscard]] auto GetPartitionFileName(size_t file_idx) const -> std::string;
+
+  /**
+   * close the writers of the partitions spilled by the last pass and queue the partitions with records
+   */
+  void FinishSpill();
+
+  /**
+   * aggregate the next pending partition, spilling its records again if its groups do not fit
+   * @return false if there is no partition left
+   */
+  auto LoadNextPartition() -> bool;
+
+  [[nodiscard]] auto MakeRecord(const char *row) const -> RecordUptr;
+
+  /**
+   * aggregate the records of the child in two phases by the workers, the groups not fitting in memory are left in
+   * partitions_
+   */
+  void AggregateParallel();
+
+  /**
+   * the task of a worker pre-aggregating the morsels of the scan into its own tables
+   * @param partial groups of the worker
+   * @param next_morsel next morsel to scan, shared by the workers
+   * @param total_group_num number of groups of all the workers
+   */
+  void PreAggregate(
+      PartialGroups &partial, std::atomic<size_t> &next_morsel, std::atomic<size_t> &total_group_num) const;
+
+  /**
+   * merge the partial groups and then the spilled records of a radix partition from all the workers into merged_
+   * @param part_idx
+   * @param partials
+   * @param file_idx index of the file of the records whose groups do not fit
+   * @param group_num number of groups in merged_
+   * @return partition of the records whose groups do not fit
+   */
+  auto MergePartition(size_t part_idx, std::vector<PartialGroups> &partials, size_t file_idx,
+      std::atomic<size_t> &group_num) -> Partition;
+
+  /**
+   * the radix partition of a hash, taken from the bits under the ones used by the levels of spilling
+   */
+  [[nodiscard]] auto GetRadixIdx(size_t hash) const -> size_t;
+
+  /**
+   * the group being emitted, from the final tables of parallel aggregation or from table_
+   */
+  [[nodiscard]] auto GetOutRow() const -> const char *;
+
+  /**
+   * move to the next group to emit
+   * @return false if there is no group left
+   */
+  auto AdvanceOutRow() -> bool;
+
+  /**
+   * remove all the partition files created by this executor
+   */
+  void RemovePartitions();
+
 private:
-  AbstractExecutorUptr                                 child_;
-  RecordSchemaUptr                                     agg_schema_;
-  RecordSchemaUptr                                     group_schema_;
-  std::unordered_map<Record, AggregateValue>           group_map_;
-  std::unordered_map<Record, AggregateValue>::iterator group_iter_;
+  AbstractExecutorUptr  child_;
+  RecordSchemaUptr      agg_schema_;
+  RecordSchemaUptr      group_schema_;
+  KeyEncoder            key_encoder_;
+  size_t                key_size_;
+  std::vector<size_t>   group_idxes_;  // indexes of the group fields in the child records
+  std::vector<AggField> agg_fields_;
+  size_t                group_offset_;  // offset of the null map and then the data of the group fields in a row
+  size_t                state_offset_;  // offset of the states of the aggregates in a row
+  size_t                row_size_;
+  size_t                max_group_num_;  // max number of groups in the table
+  GroupTable            table_;
+  // partitions of the records of the groups not fitting in the table
+  std::string                             file_prefix_;
+  size_t                                  tmp_file_num_;
+  std::vector<Partition>                  partitions_;  // pending partitions, the last one is aggregated first
+  std::vector<Partition>                  spilled_;     // partitions being written
+  std::vector<std::unique_ptr<RunWriter>> spill_writers_;
+  // final groups of parallel aggregation, one table per radix partition
+  size_t                     worker_num_;
+  SeqScanExecutor           *scan_;
+  std::unique_ptr<TaskGroup> tasks_;
+  size_t                     radix_bits_;
+  std::vector<GroupTable>    merged_;
+  // group being emitted
+  size_t out_table_;  // index in merged_, or merged_.size() when the groups are in table_
+  size_t out_row_;
+  bool   is_end_;
 };
 
 }  // namespace wsdb
@@ -22,6 +22,8 @@
 #define MAX_TABNAME_LEN 128
 
 #include "executor_ddl.h"
+#include "executor_gather.h"
+#include "executor_sort.h"
 namespace wsdb {
 
 static auto MakeTableDescOutSchema(size_t sz_db_name, size_t sz_tb_name) -> std::unique_ptr<RecordSchema>
@@ -68,6 +70,39 @@ static auto MakeTableDescValue(const std::string &db_name, const std::string &tb
   return values;
 }
 
+static auto MakeIndexDescOutSchema(size_t sz_db_name, size_t sz_tb_name, size_t sz_idx_name)
+    -> std::unique_ptr<RecordSchema>
+{
+  std::vector<RTField> fields(4);
+  // 4 fields, db name, table name, index name, index type
+  fields[0] = RTField{.field_ = {.table_id_ = INVALID_TABLE_ID,
+                          .field_name_      = "Database",
+                          .field_size_      = sz_db_name,
+                          .field_type_      = TYPE_STRING}};
+  fields[1] = RTField{.field_ = {.table_id_ = INVALID_TABLE_ID,
+                          .field_name_      = "Table",
+                          .field_size_      = sz_tb_name,
+                          .field_type_      = TYPE_STRING}};
+  fields[2] = RTField{.field_ = {.table_id_ = INVALID_TABLE_ID,
+                          .field_name_      = "Index",
+                          .field_size_      = sz_idx_name,
+                          .field_type_      = TYPE_STRING}};
+  fields[3] = RTField{
+      .field_ = {.table_id_ = INVALID_TABLE_ID, .field_name_ = "Type", .field_size_ = 10, .field_type_ = TYPE_STRING}};
+  return std::make_unique<RecordSchema>(fields);
+}
+
+static auto MakeIndexDescValue(const std::string &db_name, const std::string &tb_name, const std::string &idx_name,
+    IndexType idx_type) -> std::vector<ValueSptr>
+{
+  std::vector<ValueSptr> values(4);
+  values[0] = ValueFactory::CreateStringValue(db_name.c_str(), db_name.size());
+  values[1] = ValueFactory::CreateStringValue(tb_name.c_str(), tb_name.size());
+  values[2] = ValueFactory::CreateStringValue(idx_name.c_str(), idx_name.size());
+  values[3] = ValueFactory::CreateStringValue(IndexTypeToString(idx_type), strlen(IndexTypeToString(idx_type)));
+  return values;
+}
+
 /// CreateTableExecutor
 CreateTableExecutor::CreateTableExecutor(
     std::string table_name, wsdb::RecordSchemaUptr schema, wsdb::DatabaseHandle *db, StorageModel storage)
@@ -208,4 +243,92 @@ void ShowTablesExecutor::Next()
 }
 auto ShowTablesExecutor::IsEnd() const -> bool { return is_end_; }
 
+/// CreateIndex Executor
+CreateIndexExecutor::CreateIndexExecutor(std::string table_name, RecordSchemaUptr key_schema, IndexType index_type,
+    RecordSchemaUptr include_schema, DatabaseHandle *db)
+    : AbstractExecutor(DDL),
+      tab_name_(std::move(table_name)),
+      key_schema_(std::move(key_schema)),
+      index_type_(index_type),
+      include_schema_(std::move(include_schema)),
+      db_(db),
+      is_end_(false)
+{
+  out_schema_ = MakeIndexDescOutSchema(db_->GetName().size(),
+      tab_name_.size(),
+      DatabaseHandle::MakeIndexName(tab_name_, *key_schema_).size());
+}
+
+void CreateIndexExecutor::Init() { WSDB_FETAL("CreateIndexExecutor does not support Init"); }
+void CreateIndexExecutor::Next()
+{
+  if (is_end_) {
+    WSDB_FETAL("CreateIndexExecutor is end");
+  }
+  if (index_type_ == IndexType::BPTREE) {
+    db_->CreateIndex(
+        tab_name_, *key_schema_, index_type_, include_schema_.get(), [this](IndexHandle &index) { BulkLoad(index); });
+  } else {
+    db_->CreateIndex(tab_name_, *key_schema_, index_type_, include_schema_.get());
+  }
+  auto values = MakeIndexDescValue(
+      db_->GetName(), tab_name_, DatabaseHandle::MakeIndexName(tab_name_, *key_schema_), index_type_);
+  record_ = std::make_unique<Record>(out_schema_.get(), values, INVALID_RID);
+  is_end_ = true;
+}
+auto CreateIndexExecutor::IsEnd() const -> bool { return is_end_; }
+
+void CreateIndexExecutor::BulkLoad(IndexHandle &index)
+{
+  auto scan = std::make_unique<SeqScanExecutor>(db_->GetTable(tab_name_));
+  // the workers of a parallel scan pin a page each, they are done before the sort returns the first record
+  auto worker_num =
+      std::min({static_cast<size_t>(std::thread::hardware_concurrency()), SCAN_WORKER_NUM, scan->GetMorselNum()});
+  AbstractExecutorUptr child;
+  if (worker_num > 1) {
+    child = std::make_unique<GatherExecutor>(std::move(scan), worker_num);
+  } else {
+    child = std::move(scan);
+  }
+  SortExecutor sort(std::move(child),
+      std::make_unique<RecordSchema>(key_schema_->GetFields()),
+      false,
+      std::min(static_cast<size_t>(std::thread::hardware_concurrency()), SORT_WORKER_NUM));
+  sort.Init();
+  index.BulkLoad(
+      [&sort]() -> RecordUptr {
+        if (sort.IsEnd()) {
+          return nullptr;
+        }
+        auto record = sort.GetRecord();
+        sort.Next();
+        return record;
+      },
+      BPTREE_FILL_FACTOR);
+}
+
+/// DropIndex Executor
+DropIndexExecutor::DropIndexExecutor(std::string table_name, std::string index_name, DatabaseHandle *db)
+    : AbstractExecutor(DDL), tab_name_(std::move(table_name)), idx_name_(std::move(index_name)), db_(db), is_end_(false)
+{
+  out_schema_ = MakeIndexDescOutSchema(db_->GetName().size(), tab_name_.size(), idx_name_.size());
+}
+
+void DropIndexExecutor::Init() { WSDB_FETAL("DropIndexExecutor does not support Init"); }
+void DropIndexExecutor::Next()
+{
+  if (is_end_) {
+    WSDB_FETAL("DropIndexExecutor is end");
+  }
+  auto index = db_->GetIndex(idx_name_);
+  if (index == nullptr) {
+    WSDB_THROW(WSDB_INDEX_MISS, idx_name_);
+  }
+  auto values = MakeIndexDescValue(db_->GetName(), tab_name_, idx_name_, index->GetIndexType());
+  db_->DropIndex(idx_name_);
+  record_ = std::make_unique<Record>(out_schema_.get(), values, INVALID_RID);
+  is_end_ = true;
+}
+auto DropIndexExecutor::IsEnd() const -> bool { return is_end_; }
+
 }  // namespace wsdb
@@ -106,6 +106,55 @@ private:
   size_t cursor_;
 };
 
+class CreateIndexExecutor : public AbstractExecutor
+{
+public:
+  CreateIndexExecutor(std::string table_name, RecordSchemaUptr key_schema, IndexType index_type,
+      RecordSchemaUptr include_schema, DatabaseHandle *db);
+
+  void Init() override;
+
+  void Next() override;
+
+  [[nodiscard]] auto IsEnd() const -> bool override;
+
+private:
+  /**
+   * sort the records of the table by the key with a sort executor over a parallel scan, and pack them into the
+   * empty B+tree bottom-up
+   */
+  void BulkLoad(IndexHandle &index);
+
+  std::string      tab_name_;
+  RecordSchemaUptr key_schema_;
+  IndexType        index_type_;
+  RecordSchemaUptr include_schema_;
+  DatabaseHandle  *db_;
+
+private:
+  bool is_end_;
+};
+
+class DropIndexExecutor : public AbstractExecutor
+{
+public:
+  DropIndexExecutor(std::string table_name, std::string index_name, DatabaseHandle *db);
+
+  void Init() override;
+
+  void Next() override;
+
+  [[nodiscard]] auto IsEnd() const -> bool override;
+
+private:
+  std::string     tab_name_;
+  std::string     idx_name_;
+  DatabaseHandle *db_;
+
+private:
+  bool is_end_;
+};
+
 }  // namespace wsdb
 
 #endif  // WSDB_EXECUTOR_DDL_H
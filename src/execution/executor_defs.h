@@ -26,14 +26,18 @@
 #include "executor_ddl.h"
 #include "executor_delete.h"
 #include "executor_filter.h"
+#include "executor_gather.h"
 #include "executor_idxscan.h"
 #include "executor_insert.h"
 #include "executor_join_nestedloop.h"
 #include "executor_join_sortmerge.h"
+#include "executor_join_hash.h"
+#include "executor_join_index.h"
 #include "executor_limit.h"
 #include "executor_projection.h"
 #include "executor_seqscan.h"
 #include "executor_sort.h"
+#include "executor_topn.h"
 #include "executor_update.h"
 
 #endif  // WSDB_EXECUTOR_DEFS_H
@@ -20,6 +20,7 @@
 //
 
 #include "executor_delete.h"
+#include "common/config.h"
 
 namespace wsdb {
 ;
@@ -41,12 +42,22 @@ void DeleteExecutor::Next()
   if (is_end_) {
     WSDB_FETAL("DeleteExecutor is end");
   }
+  // the deleted records are kept to delete their entries from the indexes in batches sorted by key
+  std::vector<RecordUptr> deleted;
   child_->Init();
   while (!child_->IsEnd()) {
-    tbl_->DeleteRecord(child_->GetRecord()->GetRID());
+    auto rec = child_->GetRecord();
+    tbl_->DeleteRecord(rec->GetRID());
+    if (!indexes_.empty()) {
+      deleted.push_back(std::move(rec));
+      if (deleted.size() >= DML_INDEX_BATCH_SIZE) {
+        DeleteIndexEntries(deleted);
+      }
+    }
     child_->Next();
     ++count;
   }
+  DeleteIndexEntries(deleted);
 
   std::vector<ValueSptr> values{ValueFactory::CreateIntValue(count)};
   record_ = std::make_unique<Record>(out_schema_.get(), values, INVALID_RID);
@@ -54,4 +65,20 @@ void DeleteExecutor::Next()
 }
 
 auto DeleteExecutor::IsEnd() const -> bool { return is_end_; }
+
+void DeleteExecutor::DeleteIndexEntries(std::vector<RecordUptr> &deleted)
+{
+  if (deleted.empty()) {
+    return;
+  }
+  std::vector<const Record *> recs;
+  recs.reserve(deleted.size());
+  for (const auto &rec : deleted) {
+    recs.push_back(rec.get());
+  }
+  for (auto idx : indexes_) {
+    idx->DeleteRecords(recs);
+  }
+  deleted.clear();
+}
 }  // namespace wsdb
\ No newline at end of file
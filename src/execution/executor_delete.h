@@ -44,6 +44,12 @@ public:
   [[nodiscard]] auto IsEnd() const -> bool override;
 
 private:
+  /**
+   * delete the entries of a batch of deleted records from the indexes, the batch is cleared
+   * @param deleted
+   */
+  void DeleteIndexEntries(std::vector<RecordUptr> &deleted);
+
   AbstractExecutorUptr     child_;
   TableHandle             *tbl_;
   std::list<IndexHandle *> indexes_;
@@ -0,0 +1,166 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+#include "executor_gather.h"
+
+#include <chrono>
+
+namespace wsdb {
+
+// max number of morsels buffered per worker before the consumer catches up
+static constexpr size_t MORSEL_WINDOW_PER_WORKER = 2;
+// interval of the consumer to check whether the tasks are cancelled while waiting for a morsel
+static constexpr auto CANCEL_CHECK_INTERVAL = std::chrono::milliseconds(1);
+
+GatherExecutor::GatherExecutor(std::unique_ptr<SeqScanExecutor> scan, size_t worker_num)
+    : AbstractExecutor(Basic),
+      scan_(std::move(scan)),
+      worker_num_(worker_num),
+      morsel_num_(0),
+      running_(0),
+      next_morsel_(0),
+      cur_morsel_(0),
+      cursor_(0),
+      is_end_(true)
+{
+  WSDB_ASSERT(worker_num_ > 0, "gather needs at least one worker");
+}
+
+GatherExecutor::~GatherExecutor() { StopTasks(); }
+
+void GatherExecutor::Init()
+{
+  StopTasks();
+  done_morsels_.clear();
+  morsel_records_.clear();
+  error_       = nullptr;
+  morsel_num_  = scan_->GetMorselNum();
+  running_     = 0;
+  next_morsel_ = 0;
+  cur_morsel_  = 0;
+  cursor_      = 0;
+  is_end_      = false;
+  // scans are what the client is waiting for, let them go before the background work
+  tasks_ = std::make_unique<TaskGroup>(TaskPriority::HIGH);
+  {
+    std::lock_guard<std::mutex> lock(latch_);
+    SubmitMorsels();
+  }
+  LoadRecord();
+}
+
+void GatherExecutor::Next()
+{
+  if (IsEnd()) {
+    WSDB_FETAL("GatherExecutor is end");
+  }
+  cursor_++;
+  LoadRecord();
+}
+
+auto GatherExecutor::IsEnd() const -> bool { return is_end_; }
+
+auto GatherExecutor::GetOutSchema() const -> const RecordSchema * { return scan_->GetOutSchema(); }
+
+void GatherExecutor::SubmitMorsels()
+{
+  while (error_ == nullptr && running_ < worker_num_ && next_morsel_ < morsel_num_ &&
+         next_morsel_ < cur_morsel_ + MORSEL_WINDOW_PER_WORKER * worker_num_) {
+    auto morsel_id = next_morsel_++;
+    running_++;
+    tasks_->Submit([this, morsel_id]() { RunMorsel(morsel_id); });
+  }
+}
+
+void GatherExecutor::StopTasks()
+{
+  if (tasks_ != nullptr) {
+    tasks_->Cancel();
+    tasks_.reset();
+  }
+}
+
+void GatherExecutor::RunMorsel(size_t morsel_id)
+{
+  std::vector<RecordUptr> records;
+  std::exception_ptr      error;
+  try {
+    records = scan_->ScanMorsel(morsel_id, *tasks_);
+  } catch (...) {
+    error = std::current_exception();
+  }
+  {
+    std::lock_guard<std::mutex> lock(latch_);
+    running_--;
+    if (error != nullptr) {
+      if (error_ == nullptr) {
+        error_ = error;
+      }
+    } else {
+      done_morsels_[morsel_id] = std::move(records);
+      SubmitMorsels();
+    }
+  }
+  done_cv_.notify_one();
+}
+
+void GatherExecutor::LoadRecord()
+{
+  while (cursor_ >= morsel_records_.size()) {
+    std::unique_lock<std::mutex> lock(latch_);
+    if (cur_morsel_ == morsel_num_) {
+      is_end_ = true;
+      record_ = nullptr;
+      return;
+    }
+    // a cancelled group skips the tasks that have not started, so the morsel may never be done. the group is also
+    // cancelled with its parents, which does not notify done_cv_, so the wait wakes up now and then to check it
+    auto is_ready = [this]() {
+      return error_ != nullptr || done_morsels_.count(cur_morsel_) > 0 || tasks_->IsCancelled();
+    };
+    while (!is_ready()) {
+      // scan a queued morsel of this gather if there is one, otherwise wait for the task scanning it. the tasks of other
+      // groups are left to the workers, so this scan does not wait for unrelated or lower priority work
+      lock.unlock();
+      bool helped = tasks_->RunOwnPendingTask();
+      lock.lock();
+      if (!helped) {
+        done_cv_.wait_for(lock, CANCEL_CHECK_INTERVAL, is_ready);
+      }
+    }
+    if (error_ != nullptr) {
+      is_end_ = true;
+      std::rethrow_exception(error_);
+    }
+    if (done_morsels_.count(cur_morsel_) == 0) {
+      is_end_ = true;
+      WSDB_THROW(WSDB_TASK_CANCELLED, fmt::format("morsel {} of the scan", cur_morsel_));
+    }
+    morsel_records_ = std::move(done_morsels_[cur_morsel_]);
+    done_morsels_.erase(cur_morsel_);
+    cur_morsel_++;
+    cursor_ = 0;
+    SubmitMorsels();
+  }
+  record_ = std::move(morsel_records_[cursor_]);
+}
+
+}  // namespace wsdb
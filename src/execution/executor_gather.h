@@ -0,0 +1,101 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+/**
+ * @brief Gather the records of a sequential scan executed by multiple workers.
+ * The pages of the table are split into morsels, each morsel is scanned by a task of the shared TaskScheduler, and a
+ * new task is submitted whenever one finishes, so the work is balanced even if the predicates pushed down to the scan
+ * filter pages unevenly. At most worker_num morsels are scanned at the same time. Records are emitted in morsel order,
+ * so the output is the same as a serial scan. No morsel is scanned when it is too far ahead of the consumer, which
+ * bounds the memory used by buffered morsels. Tasks never wait for the consumer, so they never hold a worker idle.
+ */
+
+#ifndef WSDB_EXECUTOR_GATHER_H
+#define WSDB_EXECUTOR_GATHER_H
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <unordered_map>
+
+#include "concurrency/task_scheduler.h"
+#include "executor_seqscan.h"
+
+namespace wsdb {
+class GatherExecutor : public AbstractExecutor
+{
+public:
+  GatherExecutor(std::unique_ptr<SeqScanExecutor> scan, size_t worker_num);
+
+  ~GatherExecutor() override;
+
+  void Init() override;
+
+  void Next() override;
+
+  [[nodiscard]] auto IsEnd() const -> bool override;
+
+  [[nodiscard]] auto GetOutSchema() const -> const RecordSchema * override;
+
+private:
+  /**
+   * submit tasks for the next morsels while there are fewer than worker_num running and the window is not full,
+   * the caller should hold latch_
+   */
+  void SubmitMorsels();
+
+  /**
+   * cancel the tasks that have not started and wait for the running ones
+   */
+  void StopTasks();
+
+  /**
+   * the task scanning a morsel
+   * @param morsel_id
+   */
+  void RunMorsel(size_t morsel_id);
+
+  /**
+   * set record_ to the record at cursor_, wait for the next morsels if the current morsel is exhausted
+   */
+  void LoadRecord();
+
+  std::unique_ptr<SeqScanExecutor> scan_;
+  size_t                           worker_num_;
+  std::unique_ptr<TaskGroup>       tasks_;
+
+  std::mutex              latch_;
+  std::condition_variable done_cv_;  // notified by tasks when a morsel is done
+  std::exception_ptr      error_;
+  size_t                  morsel_num_;
+  size_t                  running_;      // number of submitted morsels that are not done
+  size_t                  next_morsel_;  // next morsel to be submitted
+  size_t                  cur_morsel_;   // next morsel to be emitted by the consumer
+  // records of finished morsels that are not emitted yet
+  std::unordered_map<size_t, std::vector<RecordUptr>> done_morsels_;
+
+  std::vector<RecordUptr> morsel_records_;
+  size_t                  cursor_;
+  bool                    is_end_;
+};
+}  // namespace wsdb
+
+#endif  // WSDB_EXECUTOR_GATHER_H
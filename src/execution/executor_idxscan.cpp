@@ -23,14 +23,105 @@
 
 namespace wsdb {
 
-IdxScanExecutor::IdxScanExecutor(TableHandle *tbl, IndexHandle *idx, ConditionVec conds, int cmp_field_num)
-    : AbstractExecutor(Basic), tbl_(tbl), idx_(idx), conds_(std::move(conds)), cmp_field_num_(cmp_field_num)
+IdxScanExecutor::IdxScanExecutor(
+    TableHandle *tbl, IndexHandle *idx, ConditionVec conds, int cmp_field_num, bool index_only)
+    : AbstractExecutor(Basic),
+      tbl_(tbl),
+      idx_(idx),
+      conds_(std::move(conds)),
+      cmp_field_num_(cmp_field_num),
+      index_only_(index_only)
 {
-  // TODO: generate low key and high key using conds, conds has been rearranged to match the index key prefix
+  const auto &key_schema = idx_->GetKeySchema();
+  auto        eq_num     = static_cast<size_t>(
+      std::count_if(conds_.begin(), conds_.end(), [](const Condition &cond) { return cond.GetOp() == OP_EQ; }));
+  WSDB_ASSERT(eq_num <= static_cast<size_t>(cmp_field_num_) && static_cast<size_t>(cmp_field_num_) <= eq_num + 1 &&
+                  static_cast<size_t>(cmp_field_num_) <= key_schema.GetFieldCount(),
+      "Invalid index conditions");
+  // the tightest bounds of the range conditions on the field after the equality prefix
+  ValueSptr low_val;
+  ValueSptr high_val;
+  bool      low_inclusive  = true;
+  bool      high_inclusive = true;
+  for (size_t i = eq_num; i < conds_.size(); ++i) {
+    const auto &val = conds_[i].GetRVal();
+    switch (conds_[i].GetOp()) {
+      case OP_GT:
+      case OP_GE:
+        if (low_val == nullptr || *val > *low_val || (!(*val < *low_val) && conds_[i].GetOp() == OP_GT)) {
+          low_val       = val;
+          low_inclusive = conds_[i].GetOp() == OP_GE;
+        }
+        break;
+      case OP_LT:
+      case OP_LE:
+        if (high_val == nullptr || *val < *high_val || (!(*val > *high_val) && conds_[i].GetOp() == OP_LT)) {
+          high_val       = val;
+          high_inclusive = conds_[i].GetOp() == OP_LE;
+        }
+        break;
+      default: WSDB_FETAL(fmt::format("Invalid index condition {}", conds_[i].ToString()));
+    }
+  }
+  // the fields of the key not compared are left null
+  auto make_key = [&](const ValueSptr &range_val) {
+    std::vector<ValueSptr> values(key_schema.GetFieldCount());
+    for (size_t i = 0; i < values.size(); ++i) {
+      if (i < eq_num) {
+        values[i] = conds_[i].GetRVal();
+      } else if (i == eq_num && range_val != nullptr) {
+        values[i] = range_val;
+      } else {
+        values[i] = ValueFactory::CreateNullValue(key_schema.GetFieldAt(i).field_.field_type_);
+      }
+    }
+    return std::make_unique<Record>(&key_schema, values, INVALID_RID);
+  };
+  low_  = make_key(low_val);
+  high_ = make_key(high_val);
+  // nulls come first in the index and never satisfy a range condition, so a range without a low bound starts after
+  // the null key
+  low_bound_ = {.key_ = low_.get(), .cmp_field_num_ = eq_num, .inclusive_ = true};
+  if (low_val != nullptr || high_val != nullptr) {
+    low_bound_ = {.key_ = low_.get(), .cmp_field_num_ = eq_num + 1, .inclusive_ = low_val != nullptr && low_inclusive};
+  }
+  high_bound_ = {.key_ = high_.get(), .cmp_field_num_ = eq_num, .inclusive_ = true};
+  if (high_val != nullptr) {
+    high_bound_ = {.key_ = high_.get(), .cmp_field_num_ = eq_num + 1, .inclusive_ = high_inclusive};
+  }
+}
+
+void IdxScanExecutor::Init()
+{
+  if (index_only_) {
+    records_ = idx_->SearchRangeRecords(low_bound_, high_bound_);
+  } else {
+    rids_ = idx_->SearchRange(low_bound_, high_bound_);
+  }
+  cursor_ = 0;
+  is_end_ = false;
+  Next();
+}
+
+void IdxScanExecutor::Next()
+{
+  if (cursor_ >= (index_only_ ? records_.size() : rids_.size())) {
+    is_end_ = true;
+    record_ = nullptr;
+    return;
+  }
+  if (index_only_) {
+    record_ = std::move(records_[cursor_++]);
+  } else {
+    record_ = tbl_->GetRecord(rids_[cursor_++]);
+  }
+}
+
+auto IdxScanExecutor::IsEnd() const -> bool { return is_end_; }
+
+auto IdxScanExecutor::GetOutSchema() const -> const RecordSchema *
+{
+  return index_only_ ? &idx_->GetEntrySchema() : &tbl_->GetSchema();
 }
-// TODO(ziqi): implement the following functions to support index scan
-void IdxScanExecutor::Init() {}
-void IdxScanExecutor::Next() {}
-auto IdxScanExecutor::IsEnd() const -> bool { return false; }
 
 }  // namespace wsdb
\ No newline at end of file
@@ -36,7 +36,7 @@ namespace wsdb {
 class IdxScanExecutor : public AbstractExecutor
 {
 public:
-  IdxScanExecutor(TableHandle *tbl, IndexHandle *idx, ConditionVec conds, int cmp_field_num);
+  IdxScanExecutor(TableHandle *tbl, IndexHandle *idx, ConditionVec conds, int cmp_field_num, bool index_only = false);
 
   void Init() override;
 
@@ -44,20 +44,27 @@ public:
 
   [[nodiscard]] auto IsEnd() const -> bool override;
 
+  [[nodiscard]] auto GetOutSchema() const -> const RecordSchema * override;
+
 private:
-  /// Index scan should find all the records in the range [low, high),
-  /// where the comparison is based on the first cmp_field_num fields.
-  /// low, high should be generated using conds. Both the schema of
-  /// record low and record high are the same as the index key
-  /// schema. Store the record fetched from the table handle with the
-  /// indexed rid into AbstractExecutor::record_. Remove [[maybe_unused]]
-  /// when you implement this executor
-  TableHandle *tbl_;            // table handle
-  IndexHandle *idx_;            // index handle
-  ConditionVec conds_;          // conditions
-  RecordUptr   low_;            // low key
-  RecordUptr   high_;           // high key
-  int          cmp_field_num_;  // number of field to be compared from the 0th field
+  /// Index scan finds all the records in the range [low, high], where the comparison is based on the first
+  /// cmp_field_num fields. conds have been rearranged by the optimizer, the equality conditions on the key prefix come
+  /// first, and the rest are range conditions on the next key field. The rids are collected by Init before any record
+  /// is returned, so that the updates of the parent do not affect the scan. An index only scan collects the records
+  /// built from the index entries instead, whose schema is the entry schema of the index
+  TableHandle            *tbl_;            // table handle
+  IndexHandle            *idx_;            // index handle
+  ConditionVec            conds_;          // conditions
+  RecordUptr              low_;            // low key
+  RecordUptr              high_;           // high key
+  IndexBound              low_bound_;
+  IndexBound              high_bound_;
+  int                     cmp_field_num_;  // number of field to be compared from the 0th field
+  bool                    index_only_;
+  std::vector<RID>        rids_;
+  std::vector<RecordUptr> records_;  // records of an index only scan
+  size_t                  cursor_{0};
+  bool                    is_end_{true};
 };
 }  // namespace wsdb
 
@@ -41,10 +41,16 @@ void InsertExecutor::Next()
   if (is_end_) {
     WSDB_FETAL("InsertExecutor is end");
   }
+  std::vector<const Record *> inserted;
   for (auto &rec : inserts_) {
-    tbl_->InsertRecord(*rec);
+    rec->SetRID(tbl_->InsertRecord(*rec));
+    inserted.push_back(rec.get());
     ++count;
   }
+  // the indexes are maintained once for the whole statement, in the order of their keys
+  for (auto idx : indexes_) {
+    idx->InsertRecords(inserted);
+  }
 
   std::vector<ValueSptr> values{ValueFactory::CreateIntValue(count)};
   record_ = std::make_unique<Record>(out_schema_.get(), values, INVALID_RID);
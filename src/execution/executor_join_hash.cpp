@@ -0,0 +1,659 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+#include "executor_join_hash.h"
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include "common/config.h"
+
+static std::atomic<long long> hash_join_fresh_id_ = 0;
+#define HASH_JOIN_FILE_PATH(obj_name) FILE_NAME(TMP_DIR, obj_name, TMP_SUFFIX)
+
+namespace wsdb {
+
+static constexpr size_t HASH_JOIN_PARTITION_NUM = static_cast<size_t>(1) << HASH_JOIN_PARTITION_BITS;
+// the partitions are split into more ranges than workers, so that a worker done early can take another range
+static constexpr size_t HASH_JOIN_TASKS_PER_WORKER = 4;
+
+/// a build record is charged with its record, its key, its hash, its chain link and up to 4 slots of the table
+static auto GetBuildRecordSize(const RecordSchema *schema, size_t key_size) -> size_t
+{
+  return sizeof(Record) + sizeof(RecordUptr) + BITMAP_SIZE(schema->GetFieldCount()) + schema->GetRecordLength() +
+         key_size + 2 * sizeof(size_t) + 4 * 2 * sizeof(size_t);
+}
+
+HashJoinExecutor::HashTable::HashTable(size_t key_size) : key_size_(key_size), slot_mask_(0) {}
+
+void HashJoinExecutor::HashTable::Append(const char *key, size_t hash, RecordUptr record)
+{
+  keys_.insert(keys_.end(), key, key + key_size_);
+  hashes_.push_back(hash);
+  records_.push_back(std::move(record));
+}
+
+void HashJoinExecutor::HashTable::Build()
+{
+  // keep the load factor under 0.5 so that probe sequences stay short
+  size_t slot_num = 16;
+  while (slot_num < 2 * records_.size()) {
+    slot_num <<= 1;
+  }
+  slots_.assign(slot_num, Slot{0, INVALID_ROW});
+  slot_mask_ = slot_num - 1;
+  next_.assign(records_.size(), INVALID_ROW);
+  // insert the rows backwards, so that the chain of a key lists its rows in build order
+  for (size_t row = records_.size(); row-- > 0;) {
+    auto hash = hashes_[row];
+    for (auto idx = hash & slot_mask_;; idx = (idx + 1) & slot_mask_) {
+      auto &slot = slots_[idx];
+      if (slot.head_ == INVALID_ROW) {
+        slot.hash_ = hash;
+        slot.head_ = row;
+        break;
+      }
+      if (slot.hash_ == hash && std::memcmp(GetKey(slot.head_), GetKey(row), key_size_) == 0) {
+        next_[row] = slot.head_;
+        slot.head_ = row;
+        break;
+      }
+    }
+  }
+}
+
+auto HashJoinExecutor::HashTable::Find(const char *key, size_t hash) const -> size_t
+{
+  if (slots_.empty()) {
+    return INVALID_ROW;
+  }
+  for (auto idx = hash & slot_mask_;; idx = (idx + 1) & slot_mask_) {
+    const auto &slot = slots_[idx];
+    if (slot.head_ == INVALID_ROW) {
+      return INVALID_ROW;
+    }
+    if (slot.hash_ == hash && std::memcmp(GetKey(slot.head_), key, key_size_) == 0) {
+      return slot.head_;
+    }
+  }
+}
+
+void HashJoinExecutor::HashTable::Clear()
+{
+  keys_.clear();
+  hashes_.clear();
+  records_.clear();
+  next_.clear();
+  slots_.clear();
+  slot_mask_ = 0;
+}
+
+HashJoinExecutor::HashJoinExecutor(JoinType join_type, AbstractExecutorUptr left, AbstractExecutorUptr right,
+    RecordSchemaUptr left_key_schema, RecordSchemaUptr right_key_schema, bool build_left, size_t worker_num,
+    JoinFilterSptr join_filter, size_t buffer_size)
+    // condition vec is not used in hash join, it has been converted to key schemas
+    : JoinExecutor(join_type, std::move(left), std::move(right), {}),
+      build_left_(build_left),
+      build_(build_left ? left_.get() : right_.get()),
+      probe_(build_left ? right_.get() : left_.get()),
+      build_key_schema_(build_left ? std::move(left_key_schema) : std::move(right_key_schema)),
+      probe_key_schema_(build_left ? std::move(right_key_schema) : std::move(left_key_schema)),
+      build_encoder_(build_->GetOutSchema(), build_key_schema_.get(), false),
+      probe_encoder_(probe_->GetOutSchema(), probe_key_schema_.get(), false),
+      key_size_(build_encoder_.GetKeySize()),
+      max_build_rec_num_(std::max(
+          buffer_size / GetBuildRecordSize(build_->GetOutSchema(), key_size_), static_cast<size_t>(1))),
+      join_filter_(std::move(join_filter)),
+      null_right_(std::make_unique<Record>(right_->GetOutSchema())),
+      table_(key_size_),
+      unmatched_row_(0),
+      probe_key_(key_size_),
+      probe_hash_(0),
+      match_row_(HashTable::INVALID_ROW),
+      probe_started_(false),
+      file_prefix_(fmt::format("hash_join_{}", hash_join_fresh_id_++)),
+      tmp_file_num_(0),
+      is_end_(false),
+      table_rec_num_(0),
+      worker_num_(std::max(worker_num, static_cast<size_t>(1))),
+      radix_bits_(0),
+      unmatched_emitted_(false),
+      output_task_(0),
+      output_idx_(0)
+{
+  WSDB_ASSERT(probe_encoder_.GetKeySize() == key_size_, "join keys should have the same types and sizes");
+  WSDB_ASSERT(join_filter_ == nullptr || (join_type_ == INNER_JOIN || build_left_),
+      "the records of the probe side without a match are output, they cannot be filtered");
+}
+
+HashJoinExecutor::~HashJoinExecutor()
+{
+  try {
+    RemovePartitions();
+  } catch (...) {
+    // the partition files are left in TMP_DIR, which is not fatal
+  }
+}
+
+void HashJoinExecutor::InitInnerJoin() { InitJoin(); }
+
+void HashJoinExecutor::NextInnerJoin() { Advance(); }
+
+auto HashJoinExecutor::IsEndInnerJoin() const -> bool { return is_end_; }
+
+void HashJoinExecutor::InitOuterJoin() { InitJoin(); }
+
+void HashJoinExecutor::NextOuterJoin() { Advance(); }
+
+auto HashJoinExecutor::IsEndOuterJoin() const -> bool { return is_end_; }
+
+void HashJoinExecutor::InitJoin()
+{
+  RemovePartitions();
+  table_.Clear();
+  matched_.clear();
+  unmatched_row_ = 0;
+  probe_rec_     = nullptr;
+  match_row_     = HashTable::INVALID_ROW;
+  probe_started_ = false;
+  is_end_        = false;
+  part_tables_.clear();
+  part_matched_.clear();
+  unmatched_emitted_ = true;  // there is no radix partition until the table is indexed
+  outputs_.clear();
+  output_task_ = 0;
+  output_idx_  = 0;
+  if (worker_num_ > 1) {
+    tasks_ = std::make_unique<TaskGroup>();
+  }
+  Build();
+  if (table_rec_num_ == 0 && partitions_.empty() && (join_type_ == INNER_JOIN || build_left_)) {
+    // no record can be produced, skip the probe side
+    is_end_ = true;
+    record_ = nullptr;
+    return;
+  }
+  Advance();
+}
+
+auto HashJoinExecutor::HashKey(const char *key) const -> size_t
+{
+  return KeyEncoder::Hash(key, key_size_);
+}
+
+auto HashJoinExecutor::GetPartitionIdx(size_t hash, size_t level) -> size_t
+{
+  auto shift = sizeof(size_t) * 8 - HASH_JOIN_PARTITION_BITS * (level + 1);
+  return (hash >> shift) & (HASH_JOIN_PARTITION_NUM - 1);
+}
+
+auto HashJoinExecutor::GetPartitionFileName(size_t file_idx) const -> std::string
+{
+  return HASH_JOIN_FILE_PATH(fmt::format("{}_{}", file_prefix_, file_idx));
+}
+
+auto HashJoinExecutor::CreatePartitions(size_t level, std::vector<std::unique_ptr<RunWriter>> &build_writers,
+    std::vector<std::unique_ptr<RunWriter>> &probe_writers) -> std::vector<Partition>
+{
+  std::vector<Partition> partitions;
+  partitions.reserve(HASH_JOIN_PARTITION_NUM);
+  for (size_t i = 0; i < HASH_JOIN_PARTITION_NUM; ++i) {
+    auto build_file = GetPartitionFileName(tmp_file_num_++);
+    auto probe_file = GetPartitionFileName(tmp_file_num_++);
+    build_writers.push_back(std::make_unique<RunWriter>(build_file, build_->GetOutSchema(), key_size_));
+    probe_writers.push_back(std::make_unique<RunWriter>(probe_file, probe_->GetOutSchema(), key_size_));
+    partitions.push_back(Partition{build_file, probe_file, 0, 0, level});
+  }
+  return partitions;
+}
+
+void HashJoinExecutor::Build()
+{
+  std::vector<std::unique_ptr<RunWriter>> build_writers;
+  std::vector<std::unique_ptr<RunWriter>> probe_writers;
+  std::vector<char>                       key(key_size_);
+  size_t                                  build_rec_num = 0;
+  if (join_filter_ != nullptr) {
+    join_filter_->Reset();
+  }
+  for (build_->Init(); !build_->IsEnd(); build_->Next()) {
+    auto record = build_->GetRecord();
+    build_encoder_.Encode(*record, key.data());
+    auto hash = HashKey(key.data());
+    build_rec_num++;
+    if (build_writers.empty()) {
+      table_.Append(key.data(), hash, std::move(record));
+      if (table_.GetRecordNum() <= max_build_rec_num_) {
+        continue;
+      }
+      // the build side does not fit in memory, move the buffered records to the partitions, the keys of the records
+      // still to come are added to the filter as they are read, its size cannot depend on their number
+      if (join_filter_ != nullptr) {
+        join_filter_->Init(std::numeric_limits<size_t>::max());
+      }
+      partitions_ = CreatePartitions(0, build_writers, probe_writers);
+      for (size_t row = 0; row < table_.GetRecordNum(); ++row) {
+        if (join_filter_ != nullptr) {
+          join_filter_->Insert(table_.GetHash(row));
+        }
+        auto idx = GetPartitionIdx(table_.GetHash(row), 0);
+        build_writers[idx]->Append(table_.GetKey(row), table_.GetRecord(row));
+        partitions_[idx].build_rec_num_++;
+      }
+      table_.Clear();
+      continue;
+    }
+    if (join_filter_ != nullptr) {
+      join_filter_->Insert(hash);
+    }
+    auto idx = GetPartitionIdx(hash, 0);
+    build_writers[idx]->Append(key.data(), *record);
+    partitions_[idx].build_rec_num_++;
+  }
+  if (join_filter_ != nullptr) {
+    if (build_writers.empty()) {
+      // the build side fits in memory, the filter is sized for its keys, whose hashes are kept by the table
+      join_filter_->Init(table_.GetRecordNum());
+      for (size_t row = 0; row < table_.GetRecordNum(); ++row) {
+        join_filter_->Insert(table_.GetHash(row));
+      }
+    }
+    join_filter_->Finish(build_rec_num);
+  }
+  if (build_writers.empty()) {
+    IndexTable();
+    return;
+  }
+  table_rec_num_ = 0;
+  for (auto &writer : build_writers) {
+    writer->Close();
+  }
+  probe_started_ = true;
+  for (probe_->Init(); !probe_->IsEnd(); probe_->Next()) {
+    auto record = probe_->GetRecord();
+    probe_encoder_.Encode(*record, key.data());
+    auto idx = GetPartitionIdx(HashKey(key.data()), 0);
+    probe_writers[idx]->Append(key.data(), *record);
+    partitions_[idx].probe_rec_num_++;
+  }
+  for (auto &writer : probe_writers) {
+    writer->Close();
+  }
+}
+
+void HashJoinExecutor::SplitPartition(const Partition &partition)
+{
+  std::vector<std::unique_ptr<RunWriter>> build_writers;
+  std::vector<std::unique_ptr<RunWriter>> probe_writers;
+  auto partitions = CreatePartitions(partition.level_ + 1, build_writers, probe_writers);
+  RunReader build_reader(partition.build_file_, build_->GetOutSchema(), key_size_);
+  while (build_reader.LoadNextRecord()) {
+    auto idx = GetPartitionIdx(HashKey(build_reader.GetKey()), partition.level_ + 1);
+    build_writers[idx]->Append(build_reader.GetKey(), *build_reader.GetRecord());
+    partitions[idx].build_rec_num_++;
+  }
+  RunReader probe_reader(partition.probe_file_, probe_->GetOutSchema(), key_size_);
+  while (probe_reader.LoadNextRecord()) {
+    auto idx = GetPartitionIdx(HashKey(probe_reader.GetKey()), partition.level_ + 1);
+    probe_writers[idx]->Append(probe_reader.GetKey(), *probe_reader.GetRecord());
+    partitions[idx].probe_rec_num_++;
+  }
+  for (size_t i = 0; i < partitions.size(); ++i) {
+    build_writers[i]->Close();
+    probe_writers[i]->Close();
+  }
+  std::filesystem::remove(partition.build_file_);
+  std::filesystem::remove(partition.probe_file_);
+  partitions_.insert(partitions_.end(), partitions.begin(), partitions.end());
+}
+
+void HashJoinExecutor::IndexTable()
+{
+  table_rec_num_ = table_.GetRecordNum();
+  unmatched_row_ = 0;
+  if (worker_num_ > 1) {
+    PartitionTable();
+    return;
+  }
+  table_.Build();
+  matched_.assign(table_.GetRecordNum(), false);
+}
+
+auto HashJoinExecutor::LoadNextPartition() -> bool
+{
+  probe_reader_ = nullptr;
+  if (!probe_file_.empty()) {
+    std::filesystem::remove(probe_file_);
+    probe_file_.clear();
+  }
+  // records of the build side or the probe side are output without a match in outer join
+  auto keep_build = join_type_ == OUTER_JOIN && build_left_;
+  auto keep_probe = join_type_ == OUTER_JOIN && !build_left_;
+  while (!partitions_.empty()) {
+    auto partition = partitions_.back();
+    partitions_.pop_back();
+    if ((partition.build_rec_num_ == 0 && !keep_probe) || (partition.probe_rec_num_ == 0 && !keep_build)) {
+      std::filesystem::remove(partition.build_file_);
+      std::filesystem::remove(partition.probe_file_);
+      continue;
+    }
+    // a partition of records with the same key cannot be split, it is joined in memory after the last level
+    if (partition.build_rec_num_ > max_build_rec_num_ && partition.level_ + 1 < HASH_JOIN_MAX_PARTITION_LEVEL) {
+      SplitPartition(partition);
+      continue;
+    }
+    table_.Clear();
+    RunReader build_reader(partition.build_file_, build_->GetOutSchema(), key_size_);
+    while (build_reader.LoadNextRecord()) {
+      table_.Append(build_reader.GetKey(), HashKey(build_reader.GetKey()), std::move(build_reader.GetRecord()));
+    }
+    std::filesystem::remove(partition.build_file_);
+    IndexTable();
+    probe_reader_  = std::make_unique<RunReader>(partition.probe_file_, probe_->GetOutSchema(), key_size_);
+    probe_file_    = partition.probe_file_;
+    return true;
+  }
+  return false;
+}
+
+auto HashJoinExecutor::FetchProbeRecord() -> bool
+{
+  if (probe_reader_ != nullptr) {
+    if (!probe_reader_->LoadNextRecord()) {
+      return false;
+    }
+    probe_rec_ = std::move(probe_reader_->GetRecord());
+    std::memcpy(probe_key_.data(), probe_reader_->GetKey(), key_size_);
+  } else {
+    if (!probe_started_) {
+      probe_->Init();
+      probe_started_ = true;
+    } else if (!probe_->IsEnd()) {
+      probe_->Next();
+    }
+    if (probe_->IsEnd()) {
+      return false;
+    }
+    probe_rec_ = probe_->GetRecord();
+    probe_encoder_.Encode(*probe_rec_, probe_key_.data());
+  }
+  probe_hash_ = HashKey(probe_key_.data());
+  return true;
+}
+
+auto HashJoinExecutor::MakeRecord(const Record &build, const Record &probe) const -> RecordUptr
+{
+  if (build_left_) {
+    return std::make_unique<Record>(out_schema_.get(), build, probe);
+  }
+  return std::make_unique<Record>(out_schema_.get(), probe, build);
+}
+
+void HashJoinExecutor::Advance()
+{
+  if (worker_num_ > 1) {
+    AdvanceParallel();
+    return;
+  }
+  while (true) {
+    // the rest of the records matching the probe record
+    if (match_row_ != HashTable::INVALID_ROW) {
+      if (build_left_) {
+        matched_[match_row_] = true;
+      }
+      record_    = MakeRecord(table_.GetRecord(match_row_), *probe_rec_);
+      match_row_ = table_.GetNext(match_row_);
+      return;
+    }
+    if (FetchProbeRecord()) {
+      match_row_ = table_.Find(probe_key_.data(), probe_hash_);
+      if (match_row_ == HashTable::INVALID_ROW && join_type_ == OUTER_JOIN && !build_left_) {
+        record_ = std::make_unique<Record>(out_schema_.get(), *probe_rec_, *null_right_);
+        return;
+      }
+      continue;
+    }
+    // the probe side of the table is exhausted, emit the left records without a match
+    if (join_type_ == OUTER_JOIN && build_left_) {
+      while (unmatched_row_ < table_.GetRecordNum() && matched_[unmatched_row_]) {
+        unmatched_row_++;
+      }
+      if (unmatched_row_ < table_.GetRecordNum()) {
+        record_ = std::make_unique<Record>(out_schema_.get(), table_.GetRecord(unmatched_row_++), *null_right_);
+        return;
+      }
+    }
+    if (!LoadNextPartition()) {
+      is_end_ = true;
+      record_ = nullptr;
+      return;
+    }
+  }
+}
+
+void HashJoinExecutor::RemovePartitions()
+{
+  probe_reader_ = nullptr;
+  partitions_.clear();
+  probe_file_.clear();
+  // consumed files are removed already, the error of a missing file is ignored
+  std::error_code ec;
+  for (size_t i = 0; i < tmp_file_num_; ++i) {
+    std::filesystem::remove(GetPartitionFileName(i), ec);
+  }
+  tmp_file_num_ = 0;
+}
+
+auto HashJoinExecutor::GetRadixIdx(size_t hash) const -> size_t
+{
+  auto shift = sizeof(size_t) * 8 - HASH_JOIN_PARTITION_BITS * HASH_JOIN_MAX_PARTITION_LEVEL - radix_bits_;
+  return (hash >> shift) & ((static_cast<size_t>(1) << radix_bits_) - 1);
+}
+
+void HashJoinExecutor::RadixPartition(
+    const std::vector<size_t> &hashes, std::vector<size_t> &order, std::vector<size_t> &bounds)
+{
+  auto part_num   = static_cast<size_t>(1) << radix_bits_;
+  auto chunk_num  = worker_num_;
+  auto chunk_size = (hashes.size() + chunk_num - 1) / chunk_num;
+  // histograms[c][p] is the number of rows of chunk c in partition p, and then the position of its next row
+  std::vector<std::vector<size_t>> histograms(chunk_num, std::vector<size_t>(part_num, 0));
+  for (size_t c = 0; c < chunk_num; ++c) {
+    tasks_->Submit([this, &hashes, &histograms, c, chunk_size]() {
+      auto end = std::min(hashes.size(), (c + 1) * chunk_size);
+      for (auto row = c * chunk_size; row < end; ++row) {
+        histograms[c][GetRadixIdx(hashes[row])]++;
+      }
+    });
+  }
+  tasks_->Wait();
+  bounds.assign(part_num + 1, 0);
+  size_t pos = 0;
+  for (size_t p = 0; p < part_num; ++p) {
+    bounds[p] = pos;
+    for (auto &histogram : histograms) {
+      auto count   = histogram[p];
+      histogram[p] = pos;
+      pos += count;
+    }
+  }
+  bounds[part_num] = pos;
+  order.resize(hashes.size());
+  for (size_t c = 0; c < chunk_num; ++c) {
+    tasks_->Submit([this, &hashes, &histograms, &order, c, chunk_size]() {
+      auto end = std::min(hashes.size(), (c + 1) * chunk_size);
+      for (auto row = c * chunk_size; row < end; ++row) {
+        order[histograms[c][GetRadixIdx(hashes[row])]++] = row;
+      }
+    });
+  }
+  tasks_->Wait();
+}
+
+void HashJoinExecutor::RunPartitionTasks(const std::function<void(size_t, size_t, size_t)> &func)
+{
+  auto part_num  = part_tables_.size();
+  auto task_num  = std::min(part_num, worker_num_ * HASH_JOIN_TASKS_PER_WORKER);
+  auto task_size = (part_num + task_num - 1) / task_num;
+  outputs_.clear();
+  outputs_.resize(task_num);
+  output_task_ = 0;
+  output_idx_  = 0;
+  for (size_t i = 0; i < task_num; ++i) {
+    auto begin = std::min(part_num, i * task_size);
+    auto end   = std::min(part_num, begin + task_size);
+    tasks_->Submit([&func, i, begin, end]() { func(i, begin, end); });
+  }
+  tasks_->Wait();
+}
+
+void HashJoinExecutor::PartitionTable()
+{
+  // enough partitions for the table of each one to fit in the cache, and for each worker to get several of them
+  auto table_size = table_.GetRecordNum() * GetBuildRecordSize(build_->GetOutSchema(), key_size_);
+  radix_bits_     = 0;
+  while (radix_bits_ < HASH_JOIN_MAX_RADIX_BITS &&
+         ((HASH_JOIN_CACHE_PARTITION_SIZE << radix_bits_) < table_size ||
+             (static_cast<size_t>(1) << radix_bits_) < worker_num_ * HASH_JOIN_TASKS_PER_WORKER)) {
+    radix_bits_++;
+  }
+  std::vector<size_t> order;
+  std::vector<size_t> bounds;
+  RadixPartition(table_.GetHashes(), order, bounds);
+  auto part_num = static_cast<size_t>(1) << radix_bits_;
+  part_tables_.clear();
+  part_tables_.reserve(part_num);
+  for (size_t p = 0; p < part_num; ++p) {
+    part_tables_.emplace_back(key_size_);
+  }
+  part_matched_.clear();
+  part_matched_.resize(part_num);
+  unmatched_emitted_ = false;
+  RunPartitionTasks([this, &order, &bounds](size_t, size_t begin, size_t end) {
+    for (auto p = begin; p < end; ++p) {
+      auto &table = part_tables_[p];
+      for (auto i = bounds[p]; i < bounds[p + 1]; ++i) {
+        auto row = order[i];
+        table.Append(table_.GetKey(row), table_.GetHash(row), table_.TakeRecord(row));
+      }
+      table.Build();
+      part_matched_[p].assign(table.GetRecordNum(), false);
+    }
+  });
+  table_.Clear();
+}
+
+auto HashJoinExecutor::ProbeBatch() -> bool
+{
+  batch_records_.clear();
+  batch_keys_.clear();
+  batch_hashes_.clear();
+  while (batch_records_.size() < HASH_JOIN_PROBE_BATCH_SIZE && FetchProbeRecord()) {
+    batch_records_.push_back(std::move(probe_rec_));
+    batch_keys_.insert(batch_keys_.end(), probe_key_.begin(), probe_key_.end());
+    batch_hashes_.push_back(probe_hash_);
+  }
+  if (batch_records_.empty()) {
+    return false;
+  }
+  std::vector<size_t> order;
+  std::vector<size_t> bounds;
+  RadixPartition(batch_hashes_, order, bounds);
+  auto keep_probe = join_type_ == OUTER_JOIN && !build_left_;
+  RunPartitionTasks([this, &order, &bounds, keep_probe](size_t task, size_t begin, size_t end) {
+    auto &output = outputs_[task];
+    for (auto p = begin; p < end; ++p) {
+      const auto &table = part_tables_[p];
+      for (auto i = bounds[p]; i < bounds[p + 1]; ++i) {
+        auto        row   = order[i];
+        const auto &probe = *batch_records_[row];
+        auto        match = table.Find(batch_keys_.data() + row * key_size_, batch_hashes_[row]);
+        if (match == HashTable::INVALID_ROW && keep_probe) {
+          output.push_back(std::make_unique<Record>(out_schema_.get(), probe, *null_right_));
+        }
+        for (; match != HashTable::INVALID_ROW; match = table.GetNext(match)) {
+          if (build_left_) {
+            part_matched_[p][match] = true;
+          }
+          output.push_back(MakeRecord(table.GetRecord(match), probe));
+        }
+      }
+    }
+  });
+  return true;
+}
+
+void HashJoinExecutor::EmitUnmatched()
+{
+  RunPartitionTasks([this](size_t task, size_t begin, size_t end) {
+    auto &output = outputs_[task];
+    for (auto p = begin; p < end; ++p) {
+      const auto &table = part_tables_[p];
+      for (size_t row = 0; row < table.GetRecordNum(); ++row) {
+        if (!part_matched_[p][row]) {
+          output.push_back(std::make_unique<Record>(out_schema_.get(), table.GetRecord(row), *null_right_));
+        }
+      }
+    }
+  });
+}
+
+auto HashJoinExecutor::PopOutput() -> bool
+{
+  while (output_task_ < outputs_.size()) {
+    auto &output = outputs_[output_task_];
+    if (output_idx_ < output.size()) {
+      record_ = std::move(output[output_idx_++]);
+      return true;
+    }
+    output.clear();
+    output_task_++;
+    output_idx_ = 0;
+  }
+  return false;
+}
+
+void HashJoinExecutor::AdvanceParallel()
+{
+  while (true) {
+    if (PopOutput()) {
+      return;
+    }
+    if (ProbeBatch()) {
+      continue;
+    }
+    // the probe side of the partitions is exhausted, emit the left records without a match
+    if (join_type_ == OUTER_JOIN && build_left_ && !unmatched_emitted_) {
+      unmatched_emitted_ = true;
+      EmitUnmatched();
+      continue;
+    }
+    if (!LoadNextPartition()) {
+      part_tables_.clear();
+      part_matched_.clear();
+      is_end_ = true;
+      record_ = nullptr;
+      return;
+    }
+  }
+}
+
+}  // namespace wsdb
@@ -0,0 +1,310 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+/**
+ * @brief Join two tables on equality conditions by hash join, the inputs are partitioned to TMP_DIR (Grace hash join)
+ * when the build side does not fit in the buffer
+ */
+
+#ifndef WSDB_EXECUTOR_JOIN_HASH_H
+#define WSDB_EXECUTOR_JOIN_HASH_H
+
+#include <functional>
+#include <limits>
+#include "common/config.h"
+#include "concurrency/task_scheduler.h"
+#include "executor_join.h"
+#include "expr/join_filter.h"
+#include "run_file.h"
+#include "system/handle/key_encoder.h"
+
+namespace wsdb {
+class HashJoinExecutor : public JoinExecutor
+{
+public:
+  /**
+   * @param join_type
+   * @param left
+   * @param right
+   * @param left_key_schema
+   * @param right_key_schema the fields should have the same types and sizes as the fields of left_key_schema
+   * @param build_left build the hash table on the left input instead of the right one
+   * @param worker_num number of workers building and probing the radix partitions in parallel
+   * @param join_filter filter of the build keys pushed into the scan of the probe side, nullptr if there is none
+   * @param buffer_size bytes of the build side kept in the hash table, the inputs are partitioned if it does not fit
+   */
+  HashJoinExecutor(JoinType join_type, AbstractExecutorUptr left, AbstractExecutorUptr right,
+      RecordSchemaUptr left_key_schema, RecordSchemaUptr right_key_schema, bool build_left, size_t worker_num = 1,
+      JoinFilterSptr join_filter = nullptr, size_t buffer_size = HASH_JOIN_BUFFER_SIZE);
+
+  ~HashJoinExecutor() override;
+
+private:
+  /// @brief Open-addressing hash table over the records of the build side
+  class HashTable
+  {
+  public:
+    static constexpr size_t INVALID_ROW = std::numeric_limits<size_t>::max();
+
+    explicit HashTable(size_t key_size);
+
+    /**
+     * append a record of the build side, the records are indexed by Build once all of them are appended
+     * @param key
+     * @param hash
+     * @param record
+     */
+    void Append(const char *key, size_t hash, RecordUptr record);
+
+    void Build();
+
+    /**
+     * the first record with the key
+     * @param key
+     * @param hash
+     * @return row of the record, INVALID_ROW if no record has the key
+     */
+    [[nodiscard]] auto Find(const char *key, size_t hash) const -> size_t;
+
+    /**
+     * the next record with the same key as a row
+     * @param row
+     * @return INVALID_ROW if row is the last one
+     */
+    [[nodiscard]] auto GetNext(size_t row) const -> size_t { return next_[row]; }
+
+    [[nodiscard]] auto GetRecord(size_t row) const -> const Record & { return *records_[row]; }
+
+    [[nodiscard]] auto GetKey(size_t row) const -> const char * { return keys_.data() + row * key_size_; }
+
+    [[nodiscard]] auto GetHash(size_t row) const -> size_t { return hashes_[row]; }
+
+    [[nodiscard]] auto GetHashes() const -> const std::vector<size_t> & { return hashes_; }
+
+    /**
+     * move the record of a row out of the table, used to move the records into the tables of the radix partitions
+     */
+    auto TakeRecord(size_t row) -> RecordUptr { return std::move(records_[row]); }
+
+    [[nodiscard]] auto GetRecordNum() const -> size_t { return records_.size(); }
+
+    void Clear();
+
+  private:
+    struct Slot
+    {
+      size_t hash_;
+      size_t head_;  // first row with the key, INVALID_ROW if the slot is empty
+    };
+
+    size_t                  key_size_;
+    std::vector<char>       keys_;
+    std::vector<size_t>     hashes_;
+    std::vector<RecordUptr> records_;
+    std::vector<size_t>     next_;
+    std::vector<Slot>       slots_;
+    size_t                  slot_mask_;
+  };
+
+  /// @brief A pair of partitions of the inputs with the same hash bits
+  struct Partition
+  {
+    std::string build_file_;
+    std::string probe_file_;
+    size_t      build_rec_num_;
+    size_t      probe_rec_num_;
+    size_t      level_;  // number of partitioning passes the records went through
+  };
+
+  void InitInnerJoin() override;
+
+  void NextInnerJoin() override;
+
+  [[nodiscard]] auto IsEndInnerJoin() const -> bool override;
+
+  void InitOuterJoin() override;
+
+  void NextOuterJoin() override;
+
+  [[nodiscard]] auto IsEndOuterJoin() const -> bool override;
+
+  /**
+   * inner join and outer join share the same steps, they only differ in the records without a match
+   */
+  void InitJoin();
+
+  [[nodiscard]] auto HashKey(const char *key) const -> size_t;
+
+  /**
+   * the partition of a hash at a level, each level takes the next HASH_JOIN_PARTITION_BITS high bits of the hash,
+   * while the slots of the hash table are chosen by the low bits
+   */
+  [[nodiscard]] static auto GetPartitionIdx(size_t hash, size_t level) -> size_t;
+
+  [[nodiscard]] auto GetPartitionFileName(size_t file_idx) const -> std::string;
+
+  /**
+   * create the partitions of a level with new file names and their writers
+   * @param level
+   * @param build_writers
+   * @param probe_writers
+   * @return
+   */
+  auto CreatePartitions(size_t level, std::vector<std::unique_ptr<RunWriter>> &build_writers,
+      std::vector<std::unique_ptr<RunWriter>> &probe_writers) -> std::vector<Partition>;
+
+  /**
+   * read the build side into the hash table, spill the table and the rest of the build side to partitions of level 0
+   * if it does not fit in memory, the probe side is partitioned as well in that case. The join filter is built before
+   * the probe side is read
+   */
+  void Build();
+
+  /**
+   * split a partition that does not fit in memory into partitions of the next level
+   * @param partition
+   */
+  void SplitPartition(const Partition &partition);
+
+  /**
+   * index the records loaded into the table, they are moved to the tables of the radix partitions in parallel join
+   */
+  void IndexTable();
+
+  /**
+   * load the build side of the next pending partition into the hash table and open its probe side
+   * @return false if there is no partition left
+   */
+  auto LoadNextPartition() -> bool;
+
+  /**
+   * fetch the next record of the probe side, from the probe executor or from the probe file of the partition
+   * @return false if the probe side is exhausted
+   */
+  auto FetchProbeRecord() -> bool;
+
+  /**
+   * the joined record of a build record and a probe record (or nulls), in the order of the output schema
+   */
+  [[nodiscard]] auto MakeRecord(const Record &build, const Record &probe) const -> RecordUptr;
+
+  /**
+   * find the next joined record and store it in record_
+   */
+  void Advance();
+
+  /**
+   * remove all the partition files created by this executor
+   */
+  void RemovePartitions();
+
+  /**
+   * the radix partition of a hash, taken from the bits under the ones used by the levels of Grace hash join
+   */
+  [[nodiscard]] auto GetRadixIdx(size_t hash) const -> size_t;
+
+  /**
+   * order rows by their radix partitions, each worker counts and then scatters a chunk of the rows
+   * @param hashes hashes of the rows
+   * @param order rows in the order of their partitions
+   * @param bounds the rows of partition p are order[bounds[p]] to order[bounds[p + 1] - 1]
+   */
+  void RadixPartition(const std::vector<size_t> &hashes, std::vector<size_t> &order, std::vector<size_t> &bounds);
+
+  /**
+   * split the radix partitions into ranges run by the workers in parallel, task i writes its records to outputs_[i]
+   * @param func called with the task index and the range [begin, end) of the partitions
+   */
+  void RunPartitionTasks(const std::function<void(size_t, size_t, size_t)> &func);
+
+  /**
+   * move the records in table_ to the tables of the radix partitions and build them in parallel
+   */
+  void PartitionTable();
+
+  /**
+   * read the next batch of the probe side and join it with the radix partitions in parallel
+   * @return false if the probe side is exhausted
+   */
+  auto ProbeBatch() -> bool;
+
+  /**
+   * emit the records of the radix partitions without a match, used when the left input is the build side
+   */
+  void EmitUnmatched();
+
+  /**
+   * take the next record produced by the workers
+   * @return false if all the records are taken
+   */
+  auto PopOutput() -> bool;
+
+  /**
+   * find the next joined record of the parallel join and store it in record_
+   */
+  void AdvanceParallel();
+
+private:
+  bool                build_left_;
+  AbstractExecutor   *build_;
+  AbstractExecutor   *probe_;
+  RecordSchemaUptr    build_key_schema_;
+  RecordSchemaUptr    probe_key_schema_;
+  KeyEncoder          build_encoder_;
+  KeyEncoder          probe_encoder_;
+  size_t              key_size_;
+  size_t              max_build_rec_num_;  // max number of build records in the hash table
+  JoinFilterSptr      join_filter_;
+  RecordUptr          null_right_;         // right side of the unmatched left records of outer join
+  HashTable           table_;
+  std::vector<bool>   matched_;  // records of the table matched, only used when the left input is the build side
+  size_t              unmatched_row_;
+  // the probe record being joined and the next record of the table it matches
+  RecordUptr        probe_rec_;
+  std::vector<char> probe_key_;
+  size_t            probe_hash_;
+  size_t            match_row_;
+  bool              probe_started_;
+  // partitions of Grace hash join
+  std::string                file_prefix_;
+  size_t                     tmp_file_num_;
+  std::vector<Partition>     partitions_;  // pending partitions, the last one is joined first
+  std::unique_ptr<RunReader> probe_reader_;
+  std::string                probe_file_;  // probe file of the partition being probed
+  bool                       is_end_;
+  size_t                     table_rec_num_;  // number of records loaded into the table
+  // radix partitions of parallel join
+  size_t                               worker_num_;
+  std::unique_ptr<TaskGroup>           tasks_;
+  size_t                               radix_bits_;
+  std::vector<HashTable>               part_tables_;
+  std::vector<std::vector<bool>>       part_matched_;
+  bool                                 unmatched_emitted_;
+  std::vector<RecordUptr>              batch_records_;  // batch of the probe side with its keys and hashes
+  std::vector<char>                    batch_keys_;
+  std::vector<size_t>                  batch_hashes_;
+  std::vector<std::vector<RecordUptr>> outputs_;  // records produced by each task
+  size_t                               output_task_;
+  size_t                               output_idx_;
+};
+}  // namespace wsdb
+
+#endif  // WSDB_EXECUTOR_JOIN_HASH_H
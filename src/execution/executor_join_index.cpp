@@ -0,0 +1,125 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+#include "executor_join_index.h"
+#include <cstring>
+
+namespace wsdb {
+IndexNestedLoopJoinExecutor::IndexNestedLoopJoinExecutor(JoinType join_type, AbstractExecutorUptr left,
+    AbstractExecutorUptr right, ConditionVec conditions, RecordSchemaUptr left_key_schema, TableHandle *tbl,
+    IndexHandle *idx, const ConditionVec &tbl_conds)
+    : JoinExecutor(join_type, std::move(left), std::move(right), std::move(conditions)),
+      left_key_schema_(std::move(left_key_schema)),
+      tbl_(tbl),
+      idx_(idx),
+      tbl_conds_(tbl_conds, &tbl->GetSchema(), nullptr),
+      compiled_conds_(conditions_, left_->GetOutSchema(), right_->GetOutSchema()),
+      null_right_(std::make_unique<Record>(right_->GetOutSchema())),
+      key_nullmap_(BITMAP_SIZE(idx->GetKeySchema().GetFieldCount()), 0),
+      key_data_(idx->GetKeySchema().GetRecordLength(), 0)
+{
+  WSDB_ASSERT(left_key_schema_->GetFieldCount() <= idx_->GetKeySchema().GetFieldCount(), "index key is too short");
+}
+
+void IndexNestedLoopJoinExecutor::InitInnerJoin() { InitJoin(); }
+
+void IndexNestedLoopJoinExecutor::NextInnerJoin() { Advance(); }
+
+auto IndexNestedLoopJoinExecutor::IsEndInnerJoin() const -> bool { return is_end_; }
+
+void IndexNestedLoopJoinExecutor::InitOuterJoin() { InitJoin(); }
+
+void IndexNestedLoopJoinExecutor::NextOuterJoin() { Advance(); }
+
+auto IndexNestedLoopJoinExecutor::IsEndOuterJoin() const -> bool { return is_end_; }
+
+void IndexNestedLoopJoinExecutor::InitJoin()
+{
+  is_end_ = false;
+  left_->Init();
+  if (left_->IsEnd()) {
+    is_end_ = true;
+    record_ = nullptr;
+    return;
+  }
+  Probe();
+  Advance();
+}
+
+void IndexNestedLoopJoinExecutor::Probe()
+{
+  left_rec_ = left_->GetRecord();
+  // the fields of the index key not matched by the join are not compared, leave them null
+  const auto &key_schema = idx_->GetKeySchema();
+  std::memset(key_nullmap_.data(), 0xff, key_nullmap_.size());
+  std::memset(key_data_.data(), 0, key_data_.size());
+  const auto *left_schema = left_rec_->GetSchema();
+  for (size_t i = 0; i < left_key_schema_->GetFieldCount(); ++i) {
+    auto left_idx = left_schema->GetRTFieldIndex(left_key_schema_->GetFieldAt(i));
+    if (left_idx == left_schema->GetFieldCount()) {
+      WSDB_THROW(WSDB_FIELD_MISS, left_key_schema_->GetFieldAt(i).ToString());
+    }
+    if (!BitMap::GetBit(left_rec_->GetNullMap(), left_idx)) {
+      BitMap::SetBit(key_nullmap_.data(), i, false);
+    }
+    std::memcpy(key_data_.data() + key_schema.GetFieldOffset(i),
+        left_rec_->GetData() + left_schema->GetFieldOffset(left_idx),
+        key_schema.GetFieldAt(i).field_.field_size_);
+  }
+  Record key(&key_schema, key_nullmap_.data(), key_data_.data(), INVALID_RID);
+  rids_    = idx_->Search(key, left_key_schema_->GetFieldCount());
+  rid_idx_ = 0;
+  matched_ = false;
+}
+
+void IndexNestedLoopJoinExecutor::Advance()
+{
+  while (true) {
+    while (rid_idx_ < rids_.size()) {
+      auto tbl_rec = tbl_->GetRecord(rids_[rid_idx_++]);
+      if (!tbl_conds_.Eval(*tbl_rec)) {
+        continue;
+      }
+      Record right_rec(right_->GetOutSchema(), *tbl_rec);
+      // the index only matches the key, the join conditions are checked as a whole
+      if (!compiled_conds_.Eval(*left_rec_, right_rec)) {
+        continue;
+      }
+      matched_ = true;
+      record_  = std::make_unique<Record>(out_schema_.get(), *left_rec_, right_rec);
+      return;
+    }
+    if (join_type_ == OUTER_JOIN && !matched_) {
+      matched_ = true;
+      record_  = std::make_unique<Record>(out_schema_.get(), *left_rec_, *null_right_);
+      return;
+    }
+    left_->Next();
+    if (left_->IsEnd()) {
+      is_end_ = true;
+      record_ = nullptr;
+      return;
+    }
+    Probe();
+  }
+}
+
+}  // namespace wsdb
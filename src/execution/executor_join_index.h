@@ -0,0 +1,102 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+/**
+ * @brief Join a table by probing its index with the key of each record of the left input, for outer join, the left
+ * input is the outer one. The records of the right table are fetched by the rids found in the index, filtered by the
+ * predicates of the right scan and projected to its columns, and then checked against all the join conditions.
+ * The right executor only provides the output schema, it is never scanned.
+ */
+
+#ifndef WSDB_EXECUTOR_JOIN_INDEX_H
+#define WSDB_EXECUTOR_JOIN_INDEX_H
+
+#include "executor_join.h"
+#include "expr/compiled_condition.h"
+#include "system/handle/index_handle.h"
+#include "system/handle/table_handle.h"
+
+namespace wsdb {
+class IndexNestedLoopJoinExecutor : public JoinExecutor
+{
+public:
+  /**
+   * @param join_type
+   * @param left
+   * @param right scan of the right table
+   * @param conditions join conditions
+   * @param left_key_schema fields of the left input copied into the first fields of the index key
+   * @param tbl right table
+   * @param idx index of the right table
+   * @param tbl_conds predicates of the right scan
+   */
+  IndexNestedLoopJoinExecutor(JoinType join_type, AbstractExecutorUptr left, AbstractExecutorUptr right,
+      ConditionVec conditions, RecordSchemaUptr left_key_schema, TableHandle *tbl, IndexHandle *idx,
+      const ConditionVec &tbl_conds);
+
+private:
+  void InitInnerJoin() override;
+
+  void NextInnerJoin() override;
+
+  [[nodiscard]] auto IsEndInnerJoin() const -> bool override;
+
+  void InitOuterJoin() override;
+
+  void NextOuterJoin() override;
+
+  [[nodiscard]] auto IsEndOuterJoin() const -> bool override;
+
+  /**
+   * inner join and outer join share the same steps, they only differ in the records without a match
+   */
+  void InitJoin();
+
+  /**
+   * take the current record of the left input and find the rids of its matches in the index
+   */
+  void Probe();
+
+  /**
+   * find the next joined record and store it in record_
+   */
+  void Advance();
+
+private:
+  RecordSchemaUptr  left_key_schema_;
+  TableHandle      *tbl_;
+  IndexHandle      *idx_;
+  CompiledCondition tbl_conds_;
+  CompiledCondition compiled_conds_;
+  RecordUptr        null_right_;  // right side of the unmatched left records of outer join
+  // key of the left record in the index key format, the fields after the left key are left null
+  std::vector<char> key_nullmap_;
+  std::vector<char> key_data_;
+  // the left record being joined and the rids of its matches
+  RecordUptr       left_rec_;
+  std::vector<RID> rids_;
+  size_t           rid_idx_{0};
+  bool             matched_{false};
+  bool             is_end_{false};
+};
+}  // namespace wsdb
+
+#endif  // WSDB_EXECUTOR_JOIN_INDEX_H
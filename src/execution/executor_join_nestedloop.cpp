@@ -20,38 +20,110 @@
 //
 
 #include "executor_join_nestedloop.h"
-#include "expr/condition_expr.h"
+#include "common/config.h"
 
 namespace wsdb {
-NestedLoopJoinExecutor::NestedLoopJoinExecutor(
-    JoinType join_type, AbstractExecutorUptr left, AbstractExecutorUptr right, ConditionVec conditions)
-    : JoinExecutor(join_type, std::move(left), std::move(right), std::move(conditions))
+
+/// an outer record in a block is charged with its record, its null map and its data
+static auto GetBlockRecordSize(const RecordSchema *schema) -> size_t
+{
+  return sizeof(Record) + sizeof(RecordUptr) + BITMAP_SIZE(schema->GetFieldCount()) + schema->GetRecordLength();
+}
+
+NestedLoopJoinExecutor::NestedLoopJoinExecutor(JoinType join_type, AbstractExecutorUptr left,
+    AbstractExecutorUptr right, ConditionVec conditions, size_t block_size)
+    : JoinExecutor(join_type, std::move(left), std::move(right), std::move(conditions)),
+      compiled_conds_(conditions_, left_->GetOutSchema(), right_->GetOutSchema()),
+      max_block_rec_num_(std::max(block_size / GetBlockRecordSize(left_->GetOutSchema()), static_cast<size_t>(1))),
+      null_right_(std::make_unique<Record>(right_->GetOutSchema())),
+      block_idx_(0),
+      unmatched_idx_(0)
 {}
 
 /// inner join
-void NestedLoopJoinExecutor::InitInnerJoin()
+void NestedLoopJoinExecutor::InitInnerJoin() { InitJoin(); }
+
+void NestedLoopJoinExecutor::NextInnerJoin() { Advance(); }
+
+auto NestedLoopJoinExecutor::IsEndInnerJoin() const -> bool { return is_end_; }
+
+/// outer join
+void NestedLoopJoinExecutor::InitOuterJoin() { InitJoin(); }
+
+void NestedLoopJoinExecutor::NextOuterJoin() { Advance(); }
+
+auto NestedLoopJoinExecutor::IsEndOuterJoin() const -> bool { return is_end_; }
+
+void NestedLoopJoinExecutor::InitJoin()
 {
-  WSDB_STUDENT_TODO(l2, f1);
-  WSDB_STUDENT_TODO(l3, t1);
+  block_.clear();
+  matched_.clear();
+  inner_rec_ = nullptr;
+  is_end_    = false;
+  left_->Init();
+  if (!LoadBlock()) {
+    is_end_ = true;
+    record_ = nullptr;
+    return;
+  }
+  Advance();
 }
 
-void NestedLoopJoinExecutor::NextInnerJoin()
+auto NestedLoopJoinExecutor::LoadBlock() -> bool
 {
-  WSDB_STUDENT_TODO(l2, f1);
-  WSDB_STUDENT_TODO(l3, t1);
+  block_.clear();
+  for (; !left_->IsEnd() && block_.size() < max_block_rec_num_; left_->Next()) {
+    block_.push_back(left_->GetRecord());
+  }
+  if (block_.empty()) {
+    return false;
+  }
+  matched_.assign(block_.size(), false);
+  unmatched_idx_ = 0;
+  right_->Init();
+  FetchInner();
+  return true;
 }
 
-auto NestedLoopJoinExecutor::IsEndInnerJoin() const -> bool
+void NestedLoopJoinExecutor::FetchInner()
 {
-  WSDB_STUDENT_TODO(l2, f1);
-  WSDB_STUDENT_TODO(l3, t1);
+  inner_rec_ = right_->IsEnd() ? nullptr : right_->GetRecord();
+  block_idx_ = 0;
 }
 
-/// outer join
-void NestedLoopJoinExecutor::InitOuterJoin() { WSDB_STUDENT_TODO(l3, t2); }
-
-void NestedLoopJoinExecutor::NextOuterJoin() { WSDB_STUDENT_TODO(l3, t2); }
-
-auto NestedLoopJoinExecutor::IsEndOuterJoin() const -> bool { WSDB_STUDENT_TODO(l3, t2); }
+void NestedLoopJoinExecutor::Advance()
+{
+  while (true) {
+    if (inner_rec_ != nullptr) {
+      // join the inner record with the rest of the block
+      while (block_idx_ < block_.size()) {
+        auto idx = block_idx_++;
+        if (compiled_conds_.Eval(*block_[idx], *inner_rec_)) {
+          matched_[idx] = true;
+          record_       = std::make_unique<Record>(out_schema_.get(), *block_[idx], *inner_rec_);
+          return;
+        }
+      }
+      right_->Next();
+      FetchInner();
+      continue;
+    }
+    // the inner table is exhausted for the block, emit the outer records without a match
+    if (join_type_ == OUTER_JOIN) {
+      while (unmatched_idx_ < block_.size() && matched_[unmatched_idx_]) {
+        unmatched_idx_++;
+      }
+      if (unmatched_idx_ < block_.size()) {
+        record_ = std::make_unique<Record>(out_schema_.get(), *block_[unmatched_idx_++], *null_right_);
+        return;
+      }
+    }
+    if (!LoadBlock()) {
+      is_end_ = true;
+      record_ = nullptr;
+      return;
+    }
+  }
+}
 
-}  // namespace wsdb
\ No newline at end of file
+}  // namespace wsdb
@@ -21,21 +21,29 @@
 
 /**
  * @brief Make a nested loop join between two tables, for outer join, the left table is the outer table
- * 
+ * The records of the outer table are buffered in blocks of at most NESTED_LOOP_BLOCK_SIZE bytes by default, and the
+ * inner table is scanned once per block instead of once per outer record. Each inner record is joined with all the
+ * records of the block by the conditions compiled against the schemas of both sides. Outer join emits the records of
+ * a block without a match, padded with nulls, once the inner table is exhausted for the block.
  */
 
 #ifndef WSDB_EXECUTOR_JOIN_NESTEDLOOP_H
 #define WSDB_EXECUTOR_JOIN_NESTEDLOOP_H
 
+#include "common/config.h"
 #include "executor_join.h"
+#include "expr/compiled_condition.h"
 
 namespace wsdb {
 
 class NestedLoopJoinExecutor : public JoinExecutor
 {
 public:
-  NestedLoopJoinExecutor(
-      JoinType join_type, AbstractExecutorUptr left, AbstractExecutorUptr right, ConditionVec conditions);
+  /**
+   * @param block_size bytes of the block of outer records, the inner table is scanned once per block
+   */
+  NestedLoopJoinExecutor(JoinType join_type, AbstractExecutorUptr left, AbstractExecutorUptr right,
+      ConditionVec conditions, size_t block_size = NESTED_LOOP_BLOCK_SIZE);
 
 private:
   void InitInnerJoin() override;
@@ -50,11 +58,37 @@ private:
 
   [[nodiscard]] auto IsEndOuterJoin() const -> bool override;
 
+  /**
+   * inner join and outer join share the same steps, they only differ in the records without a match
+   */
+  void InitJoin();
+
+  /**
+   * buffer the next block of outer records and restart the inner table
+   * @return false if the outer table is exhausted
+   */
+  auto LoadBlock() -> bool;
+
+  /**
+   * fetch the current record of the inner table, nullptr if the inner table is exhausted for the block
+   */
+  void FetchInner();
+
+  /**
+   * find the next joined record and store it in record_
+   */
+  void Advance();
+
 private:
-  // temporarily store record from the left executor
-  RecordUptr left_rec_ = nullptr;
-  // for outer join, indicates whether a valid right value is found
-  bool need_gen_null_{false};
+  CompiledCondition       compiled_conds_;
+  size_t                  max_block_rec_num_;  // max number of outer records in a block
+  RecordUptr              null_right_;         // right side of the unmatched left records of outer join
+  std::vector<RecordUptr> block_;
+  std::vector<bool>       matched_;  // records of the block matched by at least one inner record
+  size_t                  block_idx_;
+  size_t                  unmatched_idx_;
+  RecordUptr              inner_rec_;
+  bool                    is_end_{false};
 };
 
 }  // namespace wsdb
@@ -34,8 +34,10 @@ ProjectionExecutor::ProjectionExecutor(AbstractExecutorUptr child, RecordSchemaU
 void ProjectionExecutor::Init() { 
   //WSDB_STUDENT_TODO(l2, t1); 
   child_->Init();
-  auto child_record = child_->GetRecord();
-  record_ = std::make_unique<Record>(out_schema_.get(), *child_record);
+  if (!child_->IsEnd()) {
+    auto child_record = child_->GetRecord();
+    record_ = std::make_unique<Record>(out_schema_.get(), *child_record);
+  }
 }
 
 void ProjectionExecutor::Next() { 
@@ -44,8 +46,10 @@ void ProjectionExecutor::Next() {
     WSDB_FETAL("ProjectionExecutor is end");
   }
   child_->Next();
-  auto child_record = child_->GetRecord();
-  record_ = std::make_unique<Record>(out_schema_.get(), *child_record);
+  if (!child_->IsEnd()) {
+    auto child_record = child_->GetRecord();
+    record_ = std::make_unique<Record>(out_schema_.get(), *child_record);
+  }
 }
 
 auto ProjectionExecutor::IsEnd() const -> bool { 
@@ -20,36 +20,152 @@
 //
 
 #include "executor_seqscan.h"
+#include <thread>
+#include "expr/condition_expr.h"
 
 namespace wsdb {
 
-SeqScanExecutor::SeqScanExecutor(TableHandle *tab) : AbstractExecutor(Basic), tab_(tab) {}
+// max times to retry a morsel when there is no free frame in the buffer pool
+static constexpr int NO_FREE_FRAME_RETRY = 1000;
+
+SeqScanExecutor::SeqScanExecutor(TableHandle *tab)
+    : AbstractExecutor(Basic), tab_(tab), page_id_(INVALID_PAGE_ID), cursor_(0)
+{}
+
+SeqScanExecutor::SeqScanExecutor(
+    TableHandle *tab, const std::vector<RTField> &fields, ConditionVec conds, JoinFilterSptr join_filter)
+    : AbstractExecutor(Basic),
+      tab_(tab),
+      conds_(std::move(conds)),
+      join_filter_(std::move(join_filter)),
+      page_id_(INVALID_PAGE_ID),
+      cursor_(0)
+{
+  if (!fields.empty()) {
+    out_schema_ = std::make_unique<RecordSchema>(fields);
+  }
+  if (conds_.empty() && join_filter_ == nullptr) {
+    return;
+  }
+  std::vector<RTField> filter_fields;
+  for (const auto &field : tab_->GetSchema().GetFields()) {
+    auto same    = [&field](const RTField &col) {
+      return col.field_.table_id_ == field.field_.table_id_ && col.field_.field_name_ == field.field_.field_name_;
+    };
+    auto is_read = std::any_of(conds_.begin(), conds_.end(), [&same](const Condition &cond) {
+      return same(cond.GetLCol()) || (cond.GetRhsType() == kColumn && same(cond.GetRCol()));
+    });
+    if (join_filter_ != nullptr) {
+      const auto &key_fields = join_filter_->GetKeySchema()->GetFields();
+      is_read                = is_read || std::any_of(key_fields.begin(), key_fields.end(), same);
+    }
+    if (is_read) {
+      filter_fields.push_back(field);
+    }
+  }
+  filter_schema_ = std::make_unique<RecordSchema>(filter_fields);
+  if (!conds_.empty()) {
+    filter_ = [this](const Record &record) { return ConditionExpr::Eval(conds_, record); };
+  }
+  if (join_filter_ != nullptr) {
+    // the records of pax tables are filtered with only the columns of filter_schema_
+    auto filter_schema = tab_->GetStorageModel() == PAX_MODEL ? filter_schema_.get() : &tab_->GetSchema();
+    join_encoder_      = std::make_unique<KeyEncoder>(filter_schema, join_filter_->GetKeySchema(), false);
+  }
+}
 
 void SeqScanExecutor::Init()
 {
-  rid_ = tab_->GetFirstRID();
-  
-  //WSDB_STUDENT_TODO(l2, t1);
-  if (!IsEnd()) {
-    record_ = tab_->GetRecord(rid_);
-  } 
+  page_id_ = FILE_HEADER_PAGE_ID;
+  LoadNextPage();
 }
 
-void SeqScanExecutor::Next() { 
-  //WSDB_STUDENT_TODO(l2, t1); 
+void SeqScanExecutor::Next()
+{
   if (IsEnd()) {
     WSDB_FETAL("SeqScanExecutor is end");
   }
-  rid_ = tab_->GetNextRID(rid_);
-  if (!IsEnd()) {
-    record_ = tab_->GetRecord(rid_);
-  }  
+  if (++cursor_ == page_records_.size()) {
+    LoadNextPage();
+  } else {
+    record_ = std::move(page_records_[cursor_]);
+  }
+}
+
+auto SeqScanExecutor::IsEnd() const -> bool { return page_id_ == INVALID_PAGE_ID; }
+
+auto SeqScanExecutor::GetOutSchema() const -> const RecordSchema *
+{
+  return out_schema_ != nullptr ? out_schema_.get() : &tab_->GetSchema();
 }
 
-auto SeqScanExecutor::IsEnd() const -> bool { 
-  //WSDB_STUDENT_TODO(l2, t1); 
-  return rid_ == INVALID_RID;
+void SeqScanExecutor::LoadNextPage()
+{
+  auto page_num = static_cast<page_id_t>(tab_->GetTableHeader().page_num_);
+  for (page_id_++; page_id_ < page_num; page_id_++) {
+    page_records_ = ScanPage(page_id_);
+    if (!page_records_.empty()) {
+      cursor_ = 0;
+      record_ = std::move(page_records_[cursor_]);
+      return;
+    }
+  }
+  page_id_ = INVALID_PAGE_ID;
+  record_  = nullptr;
 }
 
-auto SeqScanExecutor::GetOutSchema() const -> const RecordSchema * { return &tab_->GetSchema(); }
-}  // namespace wsdb
\ No newline at end of file
+auto SeqScanExecutor::GetMorselNum() const -> size_t
+{
+  auto page_num = tab_->GetTableHeader().page_num_ - (FILE_HEADER_PAGE_ID + 1);
+  return (page_num + SCAN_MORSEL_SIZE - 1) / SCAN_MORSEL_SIZE;
+}
+
+auto SeqScanExecutor::ScanMorsel(size_t morsel_id) const -> std::vector<RecordUptr>
+{
+  auto page_num = static_cast<page_id_t>(tab_->GetTableHeader().page_num_);
+  auto begin    = static_cast<page_id_t>(FILE_HEADER_PAGE_ID + 1 + morsel_id * SCAN_MORSEL_SIZE);
+  auto end      = std::min(static_cast<page_id_t>(begin + SCAN_MORSEL_SIZE), page_num);
+
+  std::vector<RecordUptr> records;
+  for (auto pid = begin; pid < end; ++pid) {
+    auto page_records = ScanPage(pid);
+    std::move(page_records.begin(), page_records.end(), std::back_inserter(records));
+  }
+  return records;
+}
+
+auto SeqScanExecutor::ScanMorsel(size_t morsel_id, const TaskGroup &tasks) const -> std::vector<RecordUptr>
+{
+  for (int retry = 0;; ++retry) {
+    try {
+      return ScanMorsel(morsel_id);
+    } catch (WSDBException_ &e) {
+      if (e.type_ != WSDB_NO_FREE_FRAME || tasks.IsCancelled() || retry == NO_FREE_FRAME_RETRY) {
+        throw;
+      }
+      std::this_thread::yield();
+    }
+  }
+}
+
+auto SeqScanExecutor::ScanPage(page_id_t pid) const -> std::vector<RecordUptr>
+{
+  // skip the pages whose zone map shows that no record can pass the predicates
+  if (!conds_.empty() && !tab_->GetZoneMap().MayMatch(pid, conds_)) {
+    return {};
+  }
+  if (join_filter_ == nullptr) {
+    return tab_->GetPageRecords(pid, out_schema_.get(), filter_schema_.get(), filter_);
+  }
+  // the key buffer is local to the page, pages are scanned by the workers of a parallel scan at the same time
+  std::vector<char> key(join_encoder_->GetKeySize());
+  auto              filter = [this, &key](const Record &record) {
+    join_encoder_->Encode(record, key.data());
+    if (!join_filter_->MayContain(KeyEncoder::Hash(key.data(), key.size()))) {
+      return false;
+    }
+    return !filter_ || filter_(record);
+  };
+  return tab_->GetPageRecords(pid, out_schema_.get(), filter_schema_.get(), filter);
+}
+}  // namespace wsdb
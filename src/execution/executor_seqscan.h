@@ -28,6 +28,10 @@
 #define WSDB_EXECUTOR_SEQSCAN_H
 #include "executor_abstract.h"
 #include "system/handle/table_handle.h"
+#include "system/handle/key_encoder.h"
+#include "common/condition.h"
+#include "concurrency/task_scheduler.h"
+#include "expr/join_filter.h"
 
 namespace wsdb {
 class SeqScanExecutor : public AbstractExecutor
@@ -35,6 +39,18 @@ class SeqScanExecutor : public AbstractExecutor
 public:
   explicit SeqScanExecutor(TableHandle *tab);
 
+  /**
+   * Scan with projection and predicates pushed down, records are read page by page, pages are skipped if their zone
+   * maps cannot satisfy the predicates, and for pax tables only the columns in fields and conds are loaded
+   * @param tab
+   * @param fields columns to output, subset of the table schema, empty means all columns
+   * @param conds predicates on the table
+   * @param join_filter filter of the keys of a hash join that reads this scan as its probe side, the records whose keys
+   * cannot match are dropped with the ones failing conds
+   */
+  SeqScanExecutor(
+      TableHandle *tab, const std::vector<RTField> &fields, ConditionVec conds, JoinFilterSptr join_filter = nullptr);
+
   void Init() override;
 
   void Next() override;
@@ -43,9 +59,47 @@ public:
 
   [[nodiscard]] auto GetOutSchema() const -> const RecordSchema * override;
 
+  /**
+   * Number of morsels when the pages of the table are split for a parallel scan,
+   * each morsel contains SCAN_MORSEL_SIZE pages except the last one
+   */
+  [[nodiscard]] auto GetMorselNum() const -> size_t;
+
+  /**
+   * Scan the pages of a morsel, it does not change the state of the executor so that
+   * different morsels can be scanned by multiple workers at the same time
+   * @param morsel_id
+   * @return qualified records in the morsel
+   */
+  [[nodiscard]] auto ScanMorsel(size_t morsel_id) const -> std::vector<RecordUptr>;
+
+  /**
+   * Scan a morsel in a task, retry if the buffer pool is temporarily full of pages pinned by other workers
+   * @param morsel_id
+   * @param tasks group of the task, the retries stop once it is cancelled
+   * @return qualified records in the morsel
+   */
+  [[nodiscard]] auto ScanMorsel(size_t morsel_id, const TaskGroup &tasks) const -> std::vector<RecordUptr>;
+
 private:
+  /**
+   * load the qualified records of the next non-empty page into page_records_
+   */
+  void LoadNextPage();
+
+  [[nodiscard]] auto ScanPage(page_id_t pid) const -> std::vector<RecordUptr>;
+
   TableHandle *tab_;
-  RID          rid_;
+  ConditionVec conds_;
+  // columns read by conds_ and the join filter, in table order
+  RecordSchemaUptr                    filter_schema_;
+  std::function<bool(const Record &)> filter_;
+  JoinFilterSptr                      join_filter_;
+  std::unique_ptr<KeyEncoder>         join_encoder_;  // encodes the join keys of the records passed to the filter
+
+  page_id_t               page_id_;
+  std::vector<RecordUptr> page_records_;
+  size_t                  cursor_;
 };
 }  // namespace wsdb
 
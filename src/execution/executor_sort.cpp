@@ -19,85 +19,224 @@
 // Created by ziqi on 2024/8/5.
 //
 #include <unistd.h>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
 #include "common/config.h"
 #include "executor_sort.h"
 
-static long long sort_result_fresh_id_ = 0;
+static std::atomic<long long> sort_result_fresh_id_ = 0;
 #define SORT_FILE_PATH(obj_name) FILE_NAME(TMP_DIR, obj_name, TMP_SUFFIX)
 
 namespace wsdb {
-SortExecutor::SortExecutor(AbstractExecutorUptr child, RecordSchemaUptr key_schema, bool is_desc)
+
+// ranges with fewer entries are sorted by insertion sort instead of another radix pass
+static constexpr size_t RADIX_SORT_THRESHOLD = 32;
+// number of keys sampled from each chunk to choose the splitters of the parallel merge
+static constexpr size_t MERGE_SAMPLE_NUM = 64;
+
+/**
+ * sort the entries by their keys with insertion sort, the first depth bytes of the keys are known to be equal
+ * @param tmp room for one entry
+ */
+static void InsertionSort(char *entries, size_t entry_num, size_t entry_size, size_t key_size, size_t depth, char *tmp)
+{
+  for (size_t i = 1; i < entry_num; ++i) {
+    std::memcpy(tmp, entries + i * entry_size, entry_size);
+    auto j = i;
+    while (j > 0 && std::memcmp(entries + (j - 1) * entry_size + depth, tmp + depth, key_size - depth) > 0) {
+      j--;
+    }
+    std::memmove(entries + (j + 1) * entry_size, entries + j * entry_size, (i - j) * entry_size);
+    std::memcpy(entries + j * entry_size, tmp, entry_size);
+  }
+}
+
+/**
+ * MSD radix sort of the entries by their keys, the first depth bytes of the keys are known to be equal
+ * @param tmp room for entry_num entries
+ */
+static void RadixSort(char *entries, size_t entry_num, size_t entry_size, size_t key_size, size_t depth, char *tmp)
+{
+  if (entry_num <= RADIX_SORT_THRESHOLD) {
+    InsertionSort(entries, entry_num, entry_size, key_size, depth, tmp);
+    return;
+  }
+  for (; depth < key_size; ++depth) {
+    size_t counts[256] = {0};
+    for (size_t i = 0; i < entry_num; ++i) {
+      counts[static_cast<uint8_t>(entries[i * entry_size + depth])]++;
+    }
+    // skip the bytes shared by all the entries, e.g. null flags and high bytes of small ints
+    if (counts[static_cast<uint8_t>(entries[depth])] == entry_num) {
+      continue;
+    }
+    size_t offsets[256];
+    size_t offset = 0;
+    for (size_t b = 0; b < 256; ++b) {
+      offsets[b] = offset;
+      offset += counts[b];
+    }
+    for (size_t i = 0; i < entry_num; ++i) {
+      auto bucket = static_cast<uint8_t>(entries[i * entry_size + depth]);
+      std::memcpy(tmp + offsets[bucket]++ * entry_size, entries + i * entry_size, entry_size);
+    }
+    std::memcpy(entries, tmp, entry_num * entry_size);
+    offset = 0;
+    for (size_t b = 0; b < 256; ++b) {
+      if (counts[b] > 1) {
+        RadixSort(entries + offset * entry_size, counts[b], entry_size, key_size, depth + 1, tmp);
+      }
+      offset += counts[b];
+    }
+    return;
+  }
+}
+
+SortExecutor::LoserTree::LoserTree(size_t leaf_num, std::function<bool(size_t, size_t)> less)
+    : leaf_num_(leaf_num), tree_(leaf_num, leaf_num), less_(std::move(less))
+{
+  WSDB_ASSERT(leaf_num_ > 0, "loser tree needs at least one leaf");
+  // leaf_num_ stands for a virtual leaf beating every run, so each real leaf settles in as it is replayed
+  for (size_t leaf = leaf_num_; leaf-- > 0;) {
+    Adjust(leaf);
+  }
+}
+
+void SortExecutor::LoserTree::Adjust(size_t leaf)
+{
+  auto winner = leaf;
+  for (auto node = (leaf + leaf_num_) / 2; node > 0; node /= 2) {
+    auto loser = tree_[node];
+    if (loser == leaf_num_ || (winner != leaf_num_ && less_(loser, winner))) {
+      std::swap(tree_[node], winner);
+    }
+  }
+  tree_[0] = winner;
+}
+
+SortExecutor::SortExecutor(AbstractExecutorUptr child, RecordSchemaUptr key_schema, bool is_desc, size_t worker_num,
+    size_t buffer_size)
     : AbstractExecutor(Basic),
       child_(std::move(child)),
       key_schema_(std::move(key_schema)),
+      key_encoder_(child_->GetOutSchema(), key_schema_.get(), is_desc),
+      entry_size_(key_encoder_.GetKeySize() + sizeof(RecordUptr *)),
+      worker_num_(std::max(worker_num, static_cast<size_t>(1))),
       buf_idx_(0),
       is_desc_(is_desc),
       is_sorted_(false),
       is_merge_sort_(false),
-      max_rec_num_(SORT_BUFFER_SIZE / child_->GetOutSchema()->GetRecordLength()),
+      // an entry and its room in the radix sort are charged to the buffer as well
+      max_rec_num_(std::max(
+          buffer_size / (child_->GetOutSchema()->GetRecordLength() + 2 * entry_size_), static_cast<size_t>(1))),
       tmp_file_num_(0),
       merge_result_file_(fmt::format("sort_result_{}", sort_result_fresh_id_++))
 {
   // comment the line below after testing
   //  max_rec_num_ = 10;
+  max_chunk_num_  = worker_num_;
+  chunk_capacity_ = std::max(max_rec_num_ / max_chunk_num_, static_cast<size_t>(1));
 }
 
 SortExecutor::~SortExecutor()
 {
-  if (is_merge_sort_) {
-    // TODO: do some clean up, e.g. close the result file
-    WSDB_STUDENT_TODO(l2, f1);
+  try {
+    RemoveRuns();
+  } catch (...) {
+    // the run files are left in TMP_DIR, which is not fatal
   }
 }
 
 void SortExecutor::Init()
 {
-  // TODO: decide whether to use merge sort according to the cardinality of the child. 
-  // leave is_merge_sort_ as false if you just want to use in-memory sort
+  RemoveRuns();
+  chunks_.clear();
+  out_entries_.clear();
+  buf_idx_       = 0;
+  is_sorted_     = false;
   is_merge_sort_ = false;
-  if (is_merge_sort_) {
-    WSDB_STUDENT_TODO(l2, f1);
+  tmp_file_num_  = 0;
+  if (worker_num_ > 1) {
+    tasks_ = std::make_unique<TaskGroup>();
+  }
+  chunks_.push_back(std::make_shared<SortChunk>());
+  for (child_->Init(); !child_->IsEnd(); child_->Next()) {
+    if (chunks_.back()->records_.size() == chunk_capacity_) {
+      if (!is_merge_sort_ && chunks_.size() == max_chunk_num_) {
+        // the child does not fit in memory, spill the buffer as sorted runs
+        is_merge_sort_ = true;
+        SpillChunks();
+      }
+      // sort the full chunk in the background while filling the next one
+      SealChunk();
+      chunks_.push_back(std::make_shared<SortChunk>());
+    }
+    AppendToChunk(child_->GetRecord());
+  }
+  if (chunks_.back()->records_.empty()) {
+    chunks_.pop_back();
+  } else {
+    SealChunk();
   }
-  //WSDB_STUDENT_TODO(l2, t1);
-  child_->Init();
-  while (!child_->IsEnd()) {
-    sort_buffer_.push_back(child_->GetRecord());
-    child_->Next();
+  WaitTasks();
+  if (!is_merge_sort_) {
+    MergeChunks();
+    if (out_entries_.empty()) {
+      is_sorted_ = true;
+      record_    = nullptr;
+      return;
+    }
+    record_ = std::move(GetEntryRecord(out_entries_.data() + entry_size_ * buf_idx_++));
+    return;
   }
-  SortBuffer();
-  buf_idx_ = 0;
-  record_ = std::move(sort_buffer_[buf_idx_++]);
+  Merge();
+  OpenRuns();
+  is_sorted_ = !PopMergedRecord();
 }
 
 void SortExecutor::Next()
 {
-  if (is_merge_sort_) {
-    WSDB_STUDENT_TODO(L2, f1);
-  }
-  //WSDB_STUDENT_TODO(L2, t1);
   if (IsEnd()) {
     WSDB_FETAL("SortExecutor is end");
   }
-  if (buf_idx_ < sort_buffer_.size()) 
-    record_ = std::move(sort_buffer_[buf_idx_++]);
+  if (is_merge_sort_) {
+    is_sorted_ = !PopMergedRecord();
+    if (is_sorted_) {
+      CloseRuns();
+    }
+    return;
+  }
+  if (buf_idx_ * entry_size_ < out_entries_.size())
+    record_ = std::move(GetEntryRecord(out_entries_.data() + entry_size_ * buf_idx_++));
   else
     is_sorted_ = true;
 }
 
-auto SortExecutor::IsEnd() const -> bool
+auto SortExecutor::IsEnd() const -> bool { return is_sorted_; }
+
+auto SortExecutor::Compare(const char *lkey, const char *rkey) const -> bool
 {
-  if (is_merge_sort_) {
-    WSDB_STUDENT_TODO(L2, f1);
-  }
-  //WSDB_STUDENT_TODO(L2, t1);
-  return is_sorted_;
+  // the order, including is_desc_, is encoded in the keys
+  return std::memcmp(lkey, rkey, key_encoder_.GetKeySize()) < 0;
+}
+
+auto SortExecutor::GetEntryRecord(const char *entry) const -> RecordUptr &
+{
+  RecordUptr *record;
+  std::memcpy(&record, entry + key_encoder_.GetKeySize(), sizeof(RecordUptr *));
+  return *record;
 }
 
-auto SortExecutor::Compare(const Record &lhs, const Record &rhs) const -> bool
+void SortExecutor::AppendToChunk(RecordUptr record)
 {
-  auto lkey = std::make_unique<Record>(key_schema_.get(), lhs);
-  auto rkey = std::make_unique<Record>(key_schema_.get(), rhs);
-  return is_desc_ ? Record::Compare(*lkey, *rkey) > 0 : lkey->Compare(*lkey, *rkey) < 0;
+  auto &chunk = *chunks_.back();
+  chunk.records_.push_back(std::move(record));
+  auto record_ptr = &chunk.records_.back();
+  chunk.entries_.resize(chunk.entries_.size() + entry_size_);
+  auto entry = chunk.entries_.data() + chunk.entries_.size() - entry_size_;
+  key_encoder_.Encode(**record_ptr, entry);
+  std::memcpy(entry + key_encoder_.GetKeySize(), &record_ptr, sizeof(RecordUptr *));
 }
 
 auto SortExecutor::GetOutSchema() const -> const RecordSchema * { return child_->GetOutSchema(); }
@@ -109,24 +248,264 @@ auto SortExecutor::GetSortFileName(size_t file_group, size_t file_idx) const ->
   return fmt::format("{}_{}_{}", merge_result_file_, file_group, file_idx);
 }
 
-void SortExecutor::SortBuffer() { 
-  //WSDB_STUDENT_TODO(L2, t1); 
-  std::sort(sort_buffer_.begin(), sort_buffer_.end(), [this](const RecordUptr &lhs, const RecordUptr &rhs) {
-    return Compare(*lhs, *rhs);
+void SortExecutor::SealChunk()
+{
+  auto chunk = chunks_.back();
+  if (!is_merge_sort_) {
+    Submit([this, chunk]() { SortEntries(*chunk); });
+    return;
+  }
+  auto file_name = SORT_FILE_PATH(GetSortFileName(0, tmp_file_num_++));
+  runs_.push_back(file_name);
+  tmp_files_.push_back(file_name);
+  chunks_.pop_back();
+  // the chunk is released by the task once written
+  Submit([this, chunk, file_name]() {
+    SortEntries(*chunk);
+    WriteRun(*chunk, file_name);
+  });
+  if (runs_.size() % max_chunk_num_ == 0) {
+    // bound the memory of the chunks being spilled
+    WaitTasks();
+  }
+}
+
+void SortExecutor::SpillChunks()
+{
+  WaitTasks();
+  auto last = chunks_.back();
+  chunks_.pop_back();
+  for (auto &chunk : chunks_) {
+    auto file_name = SORT_FILE_PATH(GetSortFileName(0, tmp_file_num_++));
+    runs_.push_back(file_name);
+    tmp_files_.push_back(file_name);
+    Submit([this, chunk, file_name]() { WriteRun(*chunk, file_name); });
+  }
+  chunks_.clear();
+  chunks_.push_back(last);
+  WaitTasks();
+}
+
+void SortExecutor::SortEntries(SortChunk &chunk) const
+{
+  std::vector<char> tmp(chunk.entries_.size());
+  RadixSort(chunk.entries_.data(), chunk.records_.size(), entry_size_, key_encoder_.GetKeySize(), 0, tmp.data());
+}
+
+void SortExecutor::WriteRun(const SortChunk &chunk, const std::string &file_name) const
+{
+  RunWriter writer(file_name, GetOutSchema(), key_encoder_.GetKeySize());
+  for (size_t i = 0; i < chunk.records_.size(); ++i) {
+    auto entry = chunk.entries_.data() + i * entry_size_;
+    writer.Append(entry, *GetEntryRecord(entry));
+  }
+  writer.Close();
+}
+
+void SortExecutor::MergeChunks()
+{
+  if (chunks_.size() <= 1) {
+    if (!chunks_.empty()) {
+      out_entries_ = std::move(chunks_.front()->entries_);
+    }
+    return;
+  }
+  auto key_size = key_encoder_.GetKeySize();
+  auto less     = [this](const char *lhs, const char *rhs) { return Compare(lhs, rhs); };
+  // sample keys evenly from every chunk and take the quantiles as splitters
+  std::vector<const char *> samples;
+  size_t                    entry_num = 0;
+  for (const auto &chunk : chunks_) {
+    auto rec_num = chunk->records_.size();
+    for (size_t i = 0; i < MERGE_SAMPLE_NUM; ++i) {
+      samples.push_back(chunk->entries_.data() + (rec_num * i / MERGE_SAMPLE_NUM) * entry_size_);
+    }
+    entry_num += rec_num;
+  }
+  std::sort(samples.begin(), samples.end(), less);
+  auto                      part_num = worker_num_;
+  std::vector<const char *> splitters;
+  for (size_t p = 1; p < part_num; ++p) {
+    splitters.push_back(samples[samples.size() * p / part_num]);
+  }
+  // cut every chunk at the splitters, entries equal to a splitter go to the range on its right
+  std::vector<std::vector<std::pair<const char *, const char *>>> parts(part_num);
+  std::vector<size_t>                                             part_offsets(part_num + 1, 0);
+  for (const auto &chunk : chunks_) {
+    auto begin = chunk->entries_.data();
+    auto end   = begin + chunk->entries_.size();
+    auto lo    = begin;
+    for (size_t p = 0; p < part_num; ++p) {
+      auto hi = end;
+      if (p + 1 < part_num) {
+        // binary search over the entries of the chunk
+        size_t left = (lo - begin) / entry_size_, right = chunk->records_.size();
+        while (left < right) {
+          auto mid = (left + right) / 2;
+          if (std::memcmp(begin + mid * entry_size_, splitters[p], key_size) < 0) {
+            left = mid + 1;
+          } else {
+            right = mid;
+          }
+        }
+        hi = begin + left * entry_size_;
+      }
+      parts[p].emplace_back(lo, hi);
+      part_offsets[p + 1] += (hi - lo) / entry_size_;
+      lo = hi;
+    }
+  }
+  for (size_t p = 0; p < part_num; ++p) {
+    part_offsets[p + 1] += part_offsets[p];
+  }
+  out_entries_.resize(entry_num * entry_size_);
+  for (size_t p = 0; p < part_num; ++p) {
+    auto out = out_entries_.data() + part_offsets[p] * entry_size_;
+    Submit([this, range = std::move(parts[p]), out]() { MergeEntries(range, out); });
+  }
+  WaitTasks();
+}
+
+void SortExecutor::MergeEntries(const std::vector<std::pair<const char *, const char *>> &ranges, char *out) const
+{
+  auto heads = ranges;
+  LoserTree tree(heads.size(), [this, &heads](size_t lhs, size_t rhs) {
+    if (heads[lhs].first == heads[lhs].second || heads[rhs].first == heads[rhs].second) {
+      return heads[lhs].first != heads[lhs].second;
+    }
+    return Compare(heads[lhs].first, heads[rhs].first);
+  });
+  while (true) {
+    auto  winner = tree.GetWinner();
+    auto &head   = heads[winner];
+    if (head.first == head.second) {
+      return;
+    }
+    std::memcpy(out, head.first, entry_size_);
+    out += entry_size_;
+    head.first += entry_size_;
+    tree.Adjust(winner);
+  }
+}
+
+void SortExecutor::MergeRuns(const std::vector<std::string> &inputs, const std::string &output) const
+{
+  std::vector<std::unique_ptr<RunReader>> readers;
+  for (const auto &file_name : inputs) {
+    readers.push_back(std::make_unique<RunReader>(file_name, GetOutSchema(), key_encoder_.GetKeySize()));
+    readers.back()->LoadNextRecord();
+  }
+  LoserTree tree(readers.size(), [this, &readers](size_t lhs, size_t rhs) {
+    auto lkey = readers[lhs]->GetKey();
+    auto rkey = readers[rhs]->GetKey();
+    if (lkey == nullptr || rkey == nullptr) {
+      return lkey != nullptr;
+    }
+    return Compare(lkey, rkey);
+  });
+  RunWriter writer(output, GetOutSchema(), key_encoder_.GetKeySize());
+  while (true) {
+    auto &reader = readers[tree.GetWinner()];
+    if (reader->GetKey() == nullptr) {
+      break;
+    }
+    writer.Append(reader->GetKey(), *reader->GetRecord());
+    reader->LoadNextRecord();
+    tree.Adjust(tree.GetWinner());
+  }
+  writer.Close();
+  readers.clear();
+  for (const auto &file_name : inputs) {
+    std::filesystem::remove(file_name);
+  }
+}
+
+void SortExecutor::Submit(Task task)
+{
+  if (tasks_ == nullptr) {
+    task();
+    return;
+  }
+  tasks_->Submit(std::move(task));
+}
+
+void SortExecutor::WaitTasks()
+{
+  if (tasks_ != nullptr) {
+    tasks_->Wait();
+  }
+}
+
+void SortExecutor::OpenRuns()
+{
+  for (const auto &file_name : runs_) {
+    run_readers_.push_back(std::make_unique<RunReader>(file_name, GetOutSchema(), key_encoder_.GetKeySize()));
+    run_readers_.back()->LoadNextRecord();
+  }
+  loser_tree_ = std::make_unique<LoserTree>(run_readers_.size(), [this](size_t lhs, size_t rhs) {
+    auto lkey = run_readers_[lhs]->GetKey();
+    auto rkey = run_readers_[rhs]->GetKey();
+    if (lkey == nullptr || rkey == nullptr) {
+      return lkey != nullptr;
+    }
+    return Compare(lkey, rkey);
   });
 }
 
-void SortExecutor::DumpBufferToFile(size_t file_idx) { WSDB_STUDENT_TODO(L2, f1); }
+void SortExecutor::CloseRuns()
+{
+  loser_tree_.reset();
+  run_readers_.clear();
+  for (const auto &file_name : runs_) {
+    std::filesystem::remove(file_name);
+  }
+  runs_.clear();
+}
 
-void SortExecutor::LoadMergeResult() { WSDB_STUDENT_TODO(L2, f1); }
+auto SortExecutor::PopMergedRecord() -> bool
+{
+  auto  winner = loser_tree_->GetWinner();
+  auto &head   = run_readers_[winner]->GetRecord();
+  if (head == nullptr) {
+    // exhausted runs lose against every run, so all the runs are exhausted
+    record_ = nullptr;
+    return false;
+  }
+  record_ = std::move(head);
+  run_readers_[winner]->LoadNextRecord();
+  loser_tree_->Adjust(winner);
+  return true;
+}
 
 void SortExecutor::Merge()
 {
-  // 1. create a heap according to is_desc_
-  // 2. read the first tuple from each file
-  // 3. pop the top of the heap and write to file: group 1, file: file_index
-  // run until all runs are exhausted, then read tuples from group 1, file 0, write to group 0, file 0 ...
-  WSDB_STUDENT_TODO(L2, f1);
+  for (size_t level = 1; runs_.size() > SORT_WAY_NUM; ++level) {
+    std::vector<std::string> merged;
+    for (size_t i = 0; i < runs_.size(); i += SORT_WAY_NUM) {
+      std::vector<std::string> inputs(runs_.begin() + static_cast<long>(i),
+          runs_.begin() + static_cast<long>(std::min(i + SORT_WAY_NUM, runs_.size())));
+      if (inputs.size() == 1) {
+        merged.push_back(inputs.front());
+        continue;
+      }
+      auto output = SORT_FILE_PATH(GetSortFileName(level, tmp_file_num_++));
+      merged.push_back(output);
+      tmp_files_.push_back(output);
+      Submit([this, inputs = std::move(inputs), output]() { MergeRuns(inputs, output); });
+    }
+    WaitTasks();
+    runs_ = std::move(merged);
+  }
+}
+
+void SortExecutor::RemoveRuns()
+{
+  tasks_.reset();
+  CloseRuns();
+  for (const auto &file_name : tmp_files_) {
+    std::filesystem::remove(file_name);
+  }
+  tmp_files_.clear();
 }
 
-}  // namespace wsdb
\ No newline at end of file
+}  // namespace wsdb
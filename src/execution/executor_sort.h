@@ -20,23 +20,31 @@
 //
 
 /**
- * @brief Sort the records returned by the child executor
- *
+ * @brief Sort the records returned by the child executor on their normalized keys, in memory or by merging sorted runs
+ * spilled to TMP_DIR when they do not fit in the sort buffer
  */
 
 #ifndef WSDB_EXECUTOR_SORT_H
 #define WSDB_EXECUTOR_SORT_H
+#include <deque>
 #include <functional>
-#include <fstream>
 #include <utility>
+#include "common/config.h"
+#include "concurrency/task_scheduler.h"
 #include "executor_abstract.h"
+#include "run_file.h"
+#include "system/handle/key_encoder.h"
 
 namespace wsdb {
 
 class SortExecutor : public AbstractExecutor
 {
 public:
-  SortExecutor(AbstractExecutorUptr child, RecordSchemaUptr key_schema, bool is_desc);
+  /**
+   * @param buffer_size bytes of records and entries kept in memory, the child is sorted in runs if it does not fit
+   */
+  SortExecutor(AbstractExecutorUptr child, RecordSchemaUptr key_schema, bool is_desc, size_t worker_num = 1,
+      size_t buffer_size = SORT_BUFFER_SIZE);
 
   ~SortExecutor() override;
 
@@ -49,100 +57,161 @@ public:
   [[nodiscard]] auto GetOutSchema() const -> const RecordSchema * override;
 
 private:
-  /// @brief  Sort heap node for merge sort algorithm, ignore it in l2.t1
-  class SortHeapNode
+  /**
+   * @brief Loser tree over the heads of k runs, each inner node keeps the loser of the match played there and node 0
+   * keeps the overall winner, so replacing the winner takes log(k) comparisons along a single leaf-to-root path.
+   * Exhausted runs lose against every run.
+   */
+  class LoserTree
   {
   public:
-    SortHeapNode() = delete;
-
-    SortHeapNode(std::shared_ptr<std::ifstream> file_handle, const RecordSchema *schema, size_t rec_idx)
-        : file_handle_(std::move(file_handle)), schema_(schema), rec_idx_(rec_idx), record_(nullptr)
-    {}
-
-    SortHeapNode(const SortHeapNode &other)
-    {
-      file_handle_ = other.file_handle_;
-      schema_      = other.schema_;
-      rec_idx_     = other.rec_idx_;
-      record_      = std::make_unique<Record>(*other.record_);
-    }
-
-    SortHeapNode(SortHeapNode &&other) noexcept
-    {
-      file_handle_ = std::move(other.file_handle_);
-      schema_      = other.schema_;
-      rec_idx_     = other.rec_idx_;
-      record_      = std::move(other.record_);
-    }
-
-    auto operator=(const SortHeapNode &other) -> SortHeapNode &
-    {
-      if (this == &other) {
-        return *this;
-      }
-      file_handle_ = other.file_handle_;
-      schema_      = other.schema_;
-      rec_idx_     = other.rec_idx_;
-      record_      = std::make_unique<Record>(*other.record_);
-      return *this;
-    }
-
     /**
-     * Load the next record from the file
-     * @param max_rec_num
-     * @return true if the record is loaded successfully, false if the file is end or idx exceeds the max record number
+     * @param leaf_num number of runs
+     * @param less less(i, j) is true if the head of run i should be emitted before the head of run j
      */
-    auto LoadNextRecord(size_t max_rec_num) -> bool
-    {
-      WSDB_ASSERT(file_handle_ != nullptr, "file_handle_ is nullptr");
-      WSDB_ASSERT(file_handle_->is_open(), "file_handle_ is not open");
-
-      WSDB_STUDENT_TODO(l2, f1);
-    }
+    LoserTree(size_t leaf_num, std::function<bool(size_t, size_t)> less);
 
-    [[nodiscard]] auto GetRecord() const -> const RecordUptr & { return record_; }
+    [[nodiscard]] auto GetWinner() const -> size_t { return tree_[0]; }
 
-    void CloseFile()
-    {
-      WSDB_ASSERT(file_handle_ != nullptr, "file_handle_ is nullptr");
-      file_handle_->close();
-      file_handle_ = nullptr;
-    }
+    /**
+     * replay the matches from a leaf whose head has changed
+     * @param leaf
+     */
+    void Adjust(size_t leaf);
 
   private:
-    std::shared_ptr<std::ifstream> file_handle_;
-    const RecordSchema            *schema_;   // schema of the record
-    size_t                         rec_idx_;  // index of the record in the file
-    RecordUptr                     record_;   // record
+    size_t                              leaf_num_;
+    std::vector<size_t>                 tree_;
+    std::function<bool(size_t, size_t)> less_;
   };
 
-private:
-  [[nodiscard]] inline auto GetSortFileName(size_t file_group, size_t file_idx) const -> std::string;
-
-  [[nodiscard]] inline auto Compare(const Record &lhs, const Record &rhs) const -> bool;
-
-  void SortBuffer();
+  /// @brief Records of the child buffered in memory and their sort entries | normalized key | RecordUptr * |
+  struct SortChunk
+  {
+    // a deque never moves its elements, so the entries can point to them
+    std::deque<RecordUptr> records_;
+    std::vector<char>      entries_;
+  };
 
-  void DumpBufferToFile(size_t file_idx);
+  using SortChunkSptr = std::shared_ptr<SortChunk>;
 
-  void LoadMergeResult();
+private:
+  [[nodiscard]] inline auto GetSortFileName(size_t file_group, size_t file_idx) const -> std::string;
 
-  inline void Merge();
+  [[nodiscard]] inline auto Compare(const char *lkey, const char *rkey) const -> bool;
+
+  /**
+   * the record an entry points to
+   * @param entry
+   * @return
+   */
+  [[nodiscard]] auto GetEntryRecord(const char *entry) const -> RecordUptr &;
+
+  /**
+   * encode the key of a record from the child and append the record to the last chunk
+   * @param record
+   */
+  void AppendToChunk(RecordUptr record);
+
+  /**
+   * sort the last chunk, and write it to a new run if the child does not fit in memory
+   */
+  void SealChunk();
+
+  /**
+   * write the buffered chunks, which are sorted, to new runs, used when the child turns out not to fit in memory
+   */
+  void SpillChunks();
+
+  void SortEntries(SortChunk &chunk) const;
+
+  void WriteRun(const SortChunk &chunk, const std::string &file_name) const;
+
+  /**
+   * merge the sorted chunks into out_entries_
+   */
+  void MergeChunks();
+
+  /**
+   * merge sorted ranges of entries into out
+   * @param ranges begin and end of each range
+   * @param out room for all the entries of the ranges
+   */
+  void MergeEntries(const std::vector<std::pair<const char *, const char *>> &ranges, char *out) const;
+
+  /**
+   * merge runs into a new run and remove them
+   * @param inputs
+   * @param output
+   */
+  void MergeRuns(const std::vector<std::string> &inputs, const std::string &output) const;
+
+  /**
+   * run a task by the workers if there are several, otherwise run it in place
+   * @param task
+   */
+  void Submit(Task task);
+
+  /**
+   * wait for the submitted tasks, rethrow the first error of them
+   */
+  void WaitTasks();
+
+  /**
+   * open the runs in runs_ and build a loser tree over their heads
+   */
+  void OpenRuns();
+
+  /**
+   * close the opened runs and remove their files
+   */
+  void CloseRuns();
+
+  /**
+   * emit the winner of the loser tree to record_ and load the next record of its run
+   * @return false if all the runs are exhausted
+   */
+  auto PopMergedRecord() -> bool;
+
+  /**
+   * merge the runs SORT_WAY_NUM at a time until at most SORT_WAY_NUM runs are left
+   */
+  void Merge();
+
+  /**
+   * stop the tasks, close the opened runs and remove all the files created by this executor
+   */
+  void RemoveRuns();
 
 private:
-  AbstractExecutorUptr    child_;
-  RecordSchemaUptr        key_schema_;
-  std::vector<RecordUptr> sort_buffer_;
-  size_t                  buf_idx_;
-  bool                    is_desc_;
-  bool                    is_sorted_;
-  // use for merge sort, if you want to use merge sort, set it to true if the record number is larger than max_rec_num_
+  AbstractExecutorUptr child_;
+  RecordSchemaUptr     key_schema_;
+  KeyEncoder           key_encoder_;
+  size_t               entry_size_;
+  size_t               worker_num_;
+  // buffered chunks, the last one is being filled
+  std::vector<SortChunkSptr> chunks_;
+  size_t                     chunk_capacity_;  // max number of records in a chunk
+  size_t                     max_chunk_num_;   // max number of chunks in memory
+  // entries of all the buffered records in order, for the in-memory sort
+  std::vector<char> out_entries_;
+  size_t            buf_idx_;
+  bool              is_desc_;
+  bool              is_sorted_;
+  // set if the records of the child do not fit in the sort buffer
   bool        is_merge_sort_;
   size_t      max_rec_num_;
   size_t      tmp_file_num_;
   std::string merge_result_file_;
+  // files of the runs that are not merged yet
+  std::vector<std::string> runs_;
+  // all the files created, removed when the executor is done
+  std::vector<std::string> tmp_files_;
   // we use file stream instead of disk manager to obtain faster sort speed;
-  std::unique_ptr<std::ifstream> merge_result_file_handle_;
+  std::vector<std::unique_ptr<RunReader>> run_readers_;
+  std::unique_ptr<LoserTree>              loser_tree_;
+  // sort and merge tasks, only used with multiple workers
+  std::unique_ptr<TaskGroup> tasks_;
 };
 
 }  // namespace wsdb
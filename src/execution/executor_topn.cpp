@@ -0,0 +1,101 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+#include "executor_topn.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace wsdb {
+
+TopNExecutor::TopNExecutor(AbstractExecutorUptr child, RecordSchemaUptr key_schema, bool is_desc, size_t limit)
+    : AbstractExecutor(Basic),
+      child_(std::move(child)),
+      key_schema_(std::move(key_schema)),
+      key_encoder_(child_->GetOutSchema(), key_schema_.get(), is_desc),
+      limit_(limit),
+      key_buf_(key_encoder_.GetKeySize()),
+      cursor_(0)
+{}
+
+void TopNExecutor::Init()
+{
+  records_.clear();
+  keys_.clear();
+  heap_.clear();
+  cursor_ = 0;
+  record_ = nullptr;
+  if (limit_ == 0) {
+    return;
+  }
+  for (child_->Init(); !child_->IsEnd(); child_->Next()) {
+    Offer(*child_->GetRecord());
+  }
+  auto key_size = key_encoder_.GetKeySize();
+  std::sort(heap_.begin(), heap_.end(), [this, key_size](size_t lhs, size_t rhs) {
+    return std::memcmp(GetKey(lhs), GetKey(rhs), key_size) < 0;
+  });
+  if (!heap_.empty()) {
+    record_ = std::move(records_[heap_[cursor_]]);
+  }
+}
+
+void TopNExecutor::Next()
+{
+  if (IsEnd()) {
+    WSDB_FETAL("TopNExecutor is end");
+  }
+  cursor_++;
+  record_ = cursor_ < heap_.size() ? std::move(records_[heap_[cursor_]]) : nullptr;
+}
+
+auto TopNExecutor::IsEnd() const -> bool { return cursor_ >= heap_.size(); }
+
+auto TopNExecutor::GetOutSchema() const -> const RecordSchema * { return child_->GetOutSchema(); }
+
+void TopNExecutor::Offer(const Record &record)
+{
+  auto key_size = key_encoder_.GetKeySize();
+  auto less     = [this, key_size](size_t lhs, size_t rhs) {
+    return std::memcmp(GetKey(lhs), GetKey(rhs), key_size) < 0;
+  };
+  if (heap_.size() < limit_) {
+    auto slot = records_.size();
+    records_.push_back(std::make_unique<Record>(record));
+    keys_.resize(keys_.size() + key_size);
+    key_encoder_.Encode(record, GetKey(slot));
+    heap_.push_back(slot);
+    std::push_heap(heap_.begin(), heap_.end(), less);
+    return;
+  }
+  key_encoder_.Encode(record, key_buf_.data());
+  if (std::memcmp(key_buf_.data(), GetKey(heap_.front()), key_size) >= 0) {
+    return;
+  }
+  // replace the worst kept record
+  std::pop_heap(heap_.begin(), heap_.end(), less);
+  auto slot = heap_.back();
+  *records_[slot] = record;
+  std::memcpy(GetKey(slot), key_buf_.data(), key_size);
+  std::push_heap(heap_.begin(), heap_.end(), less);
+}
+
+}  // namespace wsdb
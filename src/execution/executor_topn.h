@@ -0,0 +1,75 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+/**
+ * @brief Return the first limit records of the child executor in the order of the key, i.e. ORDER BY ... LIMIT n.
+ * The executor keeps the best limit records seen so far in a max-heap on their normalized keys (see KeyEncoder), so a
+ * record only takes one memcmp against the worst kept record to be discarded. Memory is O(limit) and time is
+ * O(rows * log(limit)).
+ */
+
+#ifndef WSDB_EXECUTOR_TOPN_H
+#define WSDB_EXECUTOR_TOPN_H
+
+#include "executor_abstract.h"
+#include "system/handle/key_encoder.h"
+
+namespace wsdb {
+
+class TopNExecutor : public AbstractExecutor
+{
+public:
+  TopNExecutor(AbstractExecutorUptr child, RecordSchemaUptr key_schema, bool is_desc, size_t limit);
+
+  void Init() override;
+
+  void Next() override;
+
+  [[nodiscard]] auto IsEnd() const -> bool override;
+
+  [[nodiscard]] auto GetOutSchema() const -> const RecordSchema * override;
+
+private:
+  [[nodiscard]] auto GetKey(size_t slot) -> char * { return keys_.data() + slot * key_encoder_.GetKeySize(); }
+
+  /**
+   * keep a record from the child if it is better than the worst kept record
+   * @param record
+   */
+  void Offer(const Record &record);
+
+  AbstractExecutorUptr child_;
+  RecordSchemaUptr     key_schema_;
+  KeyEncoder           key_encoder_;
+  size_t               limit_;
+
+  // kept records and their keys, the slot of a record indexes both
+  std::vector<RecordUptr> records_;
+  std::vector<char>       keys_;
+  // slots ordered as a max-heap on the keys during Init, and in output order after Init
+  std::vector<size_t> heap_;
+  std::vector<char>   key_buf_;
+  size_t              cursor_;
+};
+
+}  // namespace wsdb
+
+#endif  // WSDB_EXECUTOR_TOPN_H
@@ -21,6 +21,7 @@
 //
 
 #include "executor_update.h"
+#include "common/config.h"
 
 namespace wsdb {
 
@@ -46,6 +47,7 @@ void UpdateExecutor::Next()
   int count = 0;
 
   //WSDB_STUDENT_TODO(l2, t1);
+  std::vector<std::pair<RecordUptr, RecordUptr>> updates;
   child_->Init();
   while (!child_->IsEnd()) {
     auto rec = child_->GetRecord();
@@ -62,9 +64,17 @@ void UpdateExecutor::Next()
     }
     auto new_record = std::make_unique<Record>(rec->GetSchema(), new_values, rec->GetRID());
     tbl_->UpdateRecord(rec->GetRID(), *new_record);
+    // the indexes are maintained in batches sorted by key, the records are kept until their batch is full
+    if (!indexes_.empty()) {
+      updates.emplace_back(std::move(rec), std::move(new_record));
+      if (updates.size() >= DML_INDEX_BATCH_SIZE) {
+        UpdateIndexEntries(updates);
+      }
+    }
     child_->Next();
     ++count;
   }
+  UpdateIndexEntries(updates);
 
   std::vector<ValueSptr> values{ValueFactory::CreateIntValue(count)};
   record_ = std::make_unique<Record>(out_schema_.get(), values, INVALID_RID);
@@ -73,4 +83,20 @@ void UpdateExecutor::Next()
 
 auto UpdateExecutor::IsEnd() const -> bool { return is_end_; }
 
+void UpdateExecutor::UpdateIndexEntries(std::vector<std::pair<RecordUptr, RecordUptr>> &updates)
+{
+  if (updates.empty()) {
+    return;
+  }
+  std::vector<std::pair<const Record *, const Record *>> recs;
+  recs.reserve(updates.size());
+  for (const auto &[old_record, new_record] : updates) {
+    recs.emplace_back(old_record.get(), new_record.get());
+  }
+  for (auto idx : indexes_) {
+    idx->UpdateRecords(recs);
+  }
+  updates.clear();
+}
+
 }  // namespace wsdb
\ No newline at end of file
@@ -44,6 +44,12 @@ public:
   [[nodiscard]] auto IsEnd() const -> bool override;
 
 private:
+  /**
+   * update the entries of a batch of updated records in the indexes, the batch is cleared
+   * @param updates pairs of the old record and the new record
+   */
+  void UpdateIndexEntries(std::vector<std::pair<RecordUptr, RecordUptr>> &updates);
+
   AbstractExecutorUptr                       child_;
   TableHandle                               *tbl_;
   std::list<IndexHandle *>                   indexes_;
@@ -0,0 +1,138 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+#include "run_file.h"
+#include <cstring>
+#include "common/config.h"
+
+namespace wsdb {
+
+/// a record in a run file is its key, its null map, its data and its rid
+static auto GetRunRecordSize(const RecordSchema *schema, size_t key_size) -> size_t
+{
+  return key_size + BITMAP_SIZE(schema->GetFieldCount()) + schema->GetRecordLength() + sizeof(page_id_t) +
+         sizeof(slot_id_t);
+}
+
+/// a block of a run file holds whole records only
+static auto GetRunBufferSize(size_t rec_size) -> size_t
+{
+  return std::max(SORT_IO_BUFFER_SIZE / rec_size, static_cast<size_t>(1)) * rec_size;
+}
+
+RunWriter::RunWriter(const std::string &file_name, const RecordSchema *schema, size_t key_size)
+    : file_(file_name, std::ios::binary | std::ios::trunc),
+      schema_(schema),
+      key_size_(key_size),
+      rec_size_(GetRunRecordSize(schema, key_size)),
+      buf_size_(GetRunBufferSize(rec_size_)),
+      buffer_(new char[buf_size_]),
+      buf_len_(0)
+{
+  if (!file_.is_open()) {
+    WSDB_THROW(WSDB_FILE_NOT_OPEN, file_name);
+  }
+}
+
+void RunWriter::Append(const char *key, const Record &record)
+{
+  if (buf_len_ + rec_size_ > buf_size_) {
+    Flush();
+  }
+  auto null_map_size = BITMAP_SIZE(schema_->GetFieldCount());
+  auto data_size     = schema_->GetRecordLength();
+  auto page_id       = record.GetRID().PageID();
+  auto slot_id       = record.GetRID().SlotID();
+  auto buf           = buffer_.get() + buf_len_;
+  std::memcpy(buf, key, key_size_);
+  buf += key_size_;
+  std::memcpy(buf, record.GetNullMap(), null_map_size);
+  std::memcpy(buf + null_map_size, record.GetData(), data_size);
+  std::memcpy(buf + null_map_size + data_size, &page_id, sizeof(page_id_t));
+  std::memcpy(buf + null_map_size + data_size + sizeof(page_id_t), &slot_id, sizeof(slot_id_t));
+  buf_len_ += rec_size_;
+}
+
+void RunWriter::Close()
+{
+  Flush();
+  file_.close();
+}
+
+void RunWriter::Flush()
+{
+  if (buf_len_ == 0) {
+    return;
+  }
+  file_.write(buffer_.get(), static_cast<std::streamsize>(buf_len_));
+  if (!file_) {
+    WSDB_THROW(WSDB_FILE_WRITE_ERROR, "run file");
+  }
+  buf_len_ = 0;
+}
+
+RunReader::RunReader(const std::string &file_name, const RecordSchema *schema, size_t key_size)
+    : file_(file_name, std::ios::binary),
+      schema_(schema),
+      key_size_(key_size),
+      rec_size_(GetRunRecordSize(schema, key_size)),
+      buf_size_(GetRunBufferSize(rec_size_)),
+      buffer_(new char[buf_size_]),
+      buf_len_(0),
+      buf_pos_(0),
+      record_(nullptr),
+      key_(nullptr)
+{
+  if (!file_.is_open()) {
+    WSDB_THROW(WSDB_FILE_NOT_OPEN, file_name);
+  }
+}
+
+auto RunReader::LoadNextRecord() -> bool
+{
+  if (buf_pos_ == buf_len_) {
+    file_.read(buffer_.get(), static_cast<std::streamsize>(buf_size_));
+    buf_len_ = static_cast<size_t>(file_.gcount());
+    buf_pos_ = 0;
+    if (buf_len_ % rec_size_ != 0) {
+      WSDB_THROW(WSDB_FILE_READ_ERROR, "run file is truncated");
+    }
+    if (buf_len_ == 0) {
+      record_ = nullptr;
+      key_    = nullptr;
+      return false;
+    }
+  }
+  auto null_map_size = BITMAP_SIZE(schema_->GetFieldCount());
+  auto data_size     = schema_->GetRecordLength();
+  auto buf           = buffer_.get() + buf_pos_;
+  key_               = buf;
+  buf += key_size_;
+  page_id_t page_id;
+  slot_id_t slot_id;
+  std::memcpy(&page_id, buf + null_map_size + data_size, sizeof(page_id_t));
+  std::memcpy(&slot_id, buf + null_map_size + data_size + sizeof(page_id_t), sizeof(slot_id_t));
+  record_ = std::make_unique<Record>(schema_, buf, buf + null_map_size, RID(page_id, slot_id));
+  buf_pos_ += rec_size_;
+  return true;
+}
+
+}  // namespace wsdb
@@ -0,0 +1,101 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+/**
+ * @brief Binary files of records spilled by the executors to TMP_DIR, used for the runs of the external sort and the
+ * partitions of the hash join. A record in a run file is a fixed size key given by the writer, its null map, its data
+ * and its rid, records are buffered and read or written in blocks of SORT_IO_BUFFER_SIZE.
+ */
+
+#ifndef WSDB_RUN_FILE_H
+#define WSDB_RUN_FILE_H
+#include <fstream>
+#include <memory>
+#include <string>
+#include "system/handle/record_handle.h"
+
+namespace wsdb {
+
+/// @brief Append records to a run file
+class RunWriter
+{
+public:
+  RunWriter(const std::string &file_name, const RecordSchema *schema, size_t key_size);
+
+  void Append(const char *key, const Record &record);
+
+  /**
+   * flush the buffered records and close the file
+   */
+  void Close();
+
+private:
+  void Flush();
+
+  std::ofstream           file_;
+  const RecordSchema     *schema_;
+  size_t                  key_size_;
+  size_t                  rec_size_;
+  size_t                  buf_size_;
+  std::unique_ptr<char[]> buffer_;  // not zeroed, most partitions of the hash join never fill their buffers
+  size_t                  buf_len_;
+};
+
+/// @brief Read the records of a run file in order
+class RunReader
+{
+public:
+  RunReader(const std::string &file_name, const RecordSchema *schema, size_t key_size);
+
+  /**
+   * Load the next record from the file
+   * @return true if a record is loaded, false if the file is end
+   */
+  auto LoadNextRecord() -> bool;
+
+  /**
+   * the record loaded by LoadNextRecord, moved out by the caller
+   * @return
+   */
+  [[nodiscard]] auto GetRecord() -> RecordUptr & { return record_; }
+
+  /**
+   * the key of the record loaded by LoadNextRecord, valid until the next call of LoadNextRecord
+   * @return
+   */
+  [[nodiscard]] auto GetKey() const -> const char * { return key_; }
+
+private:
+  std::ifstream           file_;
+  const RecordSchema     *schema_;
+  size_t                  key_size_;
+  size_t                  rec_size_;
+  size_t                  buf_size_;
+  std::unique_ptr<char[]> buffer_;
+  size_t                  buf_len_;
+  size_t                  buf_pos_;
+  RecordUptr              record_;
+  const char             *key_;
+};
+
+}  // namespace wsdb
+
+#endif  // WSDB_RUN_FILE_H
@@ -0,0 +1,189 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+#include "compiled_condition.h"
+#include <cstring>
+#include <string_view>
+#include "condition_expr.h"
+
+namespace wsdb {
+
+template <typename T>
+static auto Load(const char *data) -> T
+{
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return value;
+}
+
+template <typename T>
+static auto CompareAs(CompOp op, const T &lhs, const T &rhs) -> bool
+{
+  switch (op) {
+    case OP_EQ: return lhs == rhs;
+    case OP_NE: return lhs != rhs;
+    case OP_LT: return lhs < rhs;
+    case OP_LE: return lhs <= rhs;
+    case OP_GT: return lhs > rhs;
+    case OP_GE: return lhs >= rhs;
+    default: WSDB_FETAL(CompOpToString(op));
+  }
+}
+
+CompiledCondition::CompiledCondition(
+    const ConditionVec &conds, const RecordSchema *left_schema, const RecordSchema *right_schema)
+    : left_schema_(left_schema), right_schema_(right_schema)
+{
+  comparisons_.reserve(conds.size());
+  for (const auto &cond : conds) {
+    WSDB_ASSERT(cond.GetRhsType() == kValue || cond.GetRhsType() == kColumn, "Invalid condition type");
+    Comparison cmp{cond.GetOp(),
+        CompareType::VALUE,
+        BindColumn(cond.GetLCol()),
+        cond.GetRhsType() == kValue ? BindValue(cond.GetRVal()) : BindColumn(cond.GetRCol())};
+    auto ltype = cmp.lhs_.type_;
+    auto rtype = cmp.rhs_.type_;
+    if (cmp.op_ == OP_IN) {
+      cmp.type_ = CompareType::VALUE;
+    } else if (ltype == TYPE_INT && rtype == TYPE_INT) {
+      cmp.type_ = CompareType::INT;
+    } else if (ltype == TYPE_FLOAT && rtype == TYPE_FLOAT) {
+      cmp.type_ = CompareType::FLOAT;
+    } else if (ltype == TYPE_BOOL && rtype == TYPE_BOOL) {
+      cmp.type_ = CompareType::BOOL;
+    } else if (ltype == TYPE_STRING && rtype == TYPE_STRING) {
+      cmp.type_ = CompareType::STRING;
+    }
+    // other types are left to the Values, which align an int with a float and report the other type mismatches
+    comparisons_.push_back(std::move(cmp));
+  }
+}
+
+auto CompiledCondition::Eval(const Record &left, const Record &right) const -> bool
+{
+  return std::all_of(comparisons_.begin(), comparisons_.end(), [&left, &right](const Comparison &cmp) {
+    return EvalComparison(cmp, left, right);
+  });
+}
+
+auto CompiledCondition::BindColumn(const RTField &field) const -> Operand
+{
+  Operand operand{true, false, left_schema_->GetRTFieldIndex(field), 0, field.field_.field_type_, 0, nullptr, {}};
+  if (operand.field_idx_ == left_schema_->GetFieldCount()) {
+    if (right_schema_ == nullptr || right_schema_->GetRTFieldIndex(field) == right_schema_->GetFieldCount()) {
+      WSDB_THROW(WSDB_FIELD_MISS, field.ToString());
+    }
+    operand.from_right_ = true;
+    operand.field_idx_  = right_schema_->GetRTFieldIndex(field);
+  }
+  const auto *schema = operand.from_right_ ? right_schema_ : left_schema_;
+  operand.offset_    = schema->GetFieldOffset(operand.field_idx_);
+  operand.size_      = schema->GetFieldAt(operand.field_idx_).field_.field_size_;
+  return operand;
+}
+
+auto CompiledCondition::BindValue(const ValueSptr &value) -> Operand
+{
+  Operand operand{false, false, 0, 0, value->GetType(), 0, value, {}};
+  if (value->IsNull()) {
+    return operand;
+  }
+  switch (value->GetType()) {
+    case TYPE_INT: {
+      auto v = std::dynamic_pointer_cast<IntValue>(value)->Get();
+      operand.data_.resize(sizeof(v));
+      std::memcpy(operand.data_.data(), &v, sizeof(v));
+      break;
+    }
+    case TYPE_FLOAT: {
+      auto v = std::dynamic_pointer_cast<FloatValue>(value)->Get();
+      operand.data_.resize(sizeof(v));
+      std::memcpy(operand.data_.data(), &v, sizeof(v));
+      break;
+    }
+    case TYPE_BOOL: {
+      auto v = std::dynamic_pointer_cast<BoolValue>(value)->Get();
+      operand.data_.resize(sizeof(v));
+      std::memcpy(operand.data_.data(), &v, sizeof(v));
+      break;
+    }
+    case TYPE_STRING: {
+      const auto &v = std::dynamic_pointer_cast<StringValue>(value)->Get();
+      // keep the terminating '\0', as an empty data_ stands for a null constant
+      operand.data_.assign(v.c_str(), v.c_str() + v.size() + 1);
+      break;
+    }
+    default: break;
+  }
+  operand.size_ = operand.data_.size();
+  return operand;
+}
+
+auto CompiledCondition::GetData(const Operand &operand, const Record &left, const Record &right) -> const char *
+{
+  if (!operand.is_column_) {
+    return operand.data_.empty() ? nullptr : operand.data_.data();
+  }
+  const auto &record = operand.from_right_ ? right : left;
+  if (BitMap::GetBit(record.GetNullMap(), operand.field_idx_)) {
+    return nullptr;
+  }
+  return record.GetData() + operand.offset_;
+}
+
+auto CompiledCondition::GetValue(const Operand &operand, const Record &left, const Record &right) -> ValueSptr
+{
+  if (!operand.is_column_) {
+    return operand.value_;
+  }
+  return (operand.from_right_ ? right : left).GetValueAt(operand.field_idx_);
+}
+
+auto CompiledCondition::EvalComparison(const Comparison &cmp, const Record &left, const Record &right) -> bool
+{
+  if (cmp.type_ == CompareType::VALUE) {
+    return ConditionExpr::Compare(cmp.op_, GetValue(cmp.lhs_, left, right), GetValue(cmp.rhs_, left, right));
+  }
+  auto lhs = GetData(cmp.lhs_, left, right);
+  auto rhs = GetData(cmp.rhs_, left, right);
+  if (lhs == nullptr || rhs == nullptr) {
+    // null equals null only, and is neither less nor greater than any value
+    auto both_null = lhs == nullptr && rhs == nullptr;
+    switch (cmp.op_) {
+      case OP_EQ: return both_null;
+      case OP_NE: return !both_null;
+      default: return false;
+    }
+  }
+  switch (cmp.type_) {
+    case CompareType::INT: return CompareAs(cmp.op_, Load<int32_t>(lhs), Load<int32_t>(rhs));
+    case CompareType::FLOAT: return CompareAs(cmp.op_, Load<float>(lhs), Load<float>(rhs));
+    case CompareType::BOOL: return CompareAs(cmp.op_, Load<bool>(lhs), Load<bool>(rhs));
+    case CompareType::STRING:
+      // strings end at the first '\0' as StringValue does
+      return CompareAs(cmp.op_,
+          std::string_view(lhs, strnlen(lhs, cmp.lhs_.size_)),
+          std::string_view(rhs, strnlen(rhs, cmp.rhs_.size_)));
+    default: WSDB_FETAL("Unknown compare type");
+  }
+}
+
+}  // namespace wsdb
@@ -0,0 +1,111 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+/**
+ * @brief Conditions bound to the schemas of the records they are evaluated on. The columns are resolved to their null
+ * bits and offsets once, and the comparison of each condition is chosen by the types of its operands, so evaluating a
+ * record compares the fields in place instead of building Values. Results are the same as ConditionExpr::Eval, an int
+ * compared with a float is left to the Values, which promote a null int to a float as well.
+ */
+
+#ifndef WSDB_COMPILED_CONDITION_H
+#define WSDB_COMPILED_CONDITION_H
+
+#include "common/condition.h"
+#include "system/handle/record_handle.h"
+
+namespace wsdb {
+
+class CompiledCondition
+{
+public:
+  /**
+   * bind the conditions to the schemas, a column is looked up in the left schema first and then in the right one
+   * @param conds
+   * @param left_schema
+   * @param right_schema nullptr if the conditions are evaluated on single records
+   */
+  CompiledCondition(const ConditionVec &conds, const RecordSchema *left_schema, const RecordSchema *right_schema);
+
+  /**
+   * evaluate the conditions on a record of the left schema
+   */
+  [[nodiscard]] auto Eval(const Record &record) const -> bool { return Eval(record, record); }
+
+  /**
+   * evaluate the conditions on a pair of records, e.g. the two sides of a join
+   */
+  [[nodiscard]] auto Eval(const Record &left, const Record &right) const -> bool;
+
+private:
+  enum class CompareType
+  {
+    INT,
+    FLOAT,
+    BOOL,
+    STRING,
+    VALUE,  // compared by Values, e.g. IN
+  };
+
+  struct Operand
+  {
+    bool      is_column_;
+    bool      from_right_;
+    size_t    field_idx_;
+    size_t    offset_;
+    FieldType type_;
+    size_t    size_;
+    ValueSptr value_;  // constant operand
+    // constant operand in the record format, empty if the constant is null
+    std::vector<char> data_;
+  };
+
+  struct Comparison
+  {
+    CompOp      op_;
+    CompareType type_;
+    Operand     lhs_;
+    Operand     rhs_;
+  };
+
+  [[nodiscard]] auto BindColumn(const RTField &field) const -> Operand;
+
+  [[nodiscard]] static auto BindValue(const ValueSptr &value) -> Operand;
+
+  /**
+   * the field of an operand in the record format
+   * @return nullptr if the operand is null
+   */
+  [[nodiscard]] static auto GetData(const Operand &operand, const Record &left, const Record &right) -> const char *;
+
+  [[nodiscard]] static auto GetValue(const Operand &operand, const Record &left, const Record &right) -> ValueSptr;
+
+  [[nodiscard]] static auto EvalComparison(const Comparison &cmp, const Record &left, const Record &right) -> bool;
+
+private:
+  const RecordSchema     *left_schema_;
+  const RecordSchema     *right_schema_;
+  std::vector<Comparison> comparisons_;
+};
+
+}  // namespace wsdb
+
+#endif  // WSDB_COMPILED_CONDITION_H
@@ -44,8 +44,13 @@ auto ConditionExpr::EvalCond(const Condition &condition, const wsdb::Record &rec
     WSDB_ASSERT(idx != record.GetSchema()->GetFieldCount(), "Invalid field");
     rhs = record.GetValueAt(idx);
   }
+  return Compare(condition.GetOp(), std::move(lhs), std::move(rhs));
+}
+
+auto ConditionExpr::Compare(CompOp op, ValueSptr lhs, ValueSptr rhs) -> bool
+{
   ValueFactory::AlignTypes(lhs, rhs);
-  switch (condition.GetOp()) {
+  switch (op) {
     case OP_EQ: return *lhs == *rhs;
     case OP_NE: return *lhs != *rhs;
     case OP_LT: return *lhs < *rhs;
@@ -53,7 +58,7 @@ auto ConditionExpr::EvalCond(const Condition &condition, const wsdb::Record &rec
     case OP_GT: return *lhs > *rhs;
     case OP_GE: return *lhs >= *rhs;
     case OP_IN: return std::dynamic_pointer_cast<ArrayValue>(rhs)->Contains(lhs);
-    default: WSDB_FETAL(CompOpToString(condition.GetOp()));
+    default: WSDB_FETAL(CompOpToString(op));
   }
   // should never reach here
 }
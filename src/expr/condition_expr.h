@@ -35,6 +35,15 @@ public:
 
   static auto Eval(const ConditionVec &condition, const Record &record)-> bool;
 
+  /**
+   * compare two values by op, int is compared with float as float
+   * @param op
+   * @param lhs
+   * @param rhs
+   * @return
+   */
+  static auto Compare(CompOp op, ValueSptr lhs, ValueSptr rhs) -> bool;
+
 private:
   static auto EvalCond(const Condition &condition, const Record &record) -> bool;
 };
@@ -0,0 +1,99 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+#include "join_filter.h"
+#include "common/config.h"
+
+namespace wsdb {
+
+// odd constants multiplied by the low bits of a hash to choose a bit in each word of a block
+static constexpr uint32_t BLOOM_SALTS[8] = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU, 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+JoinFilter::JoinFilter(const std::vector<RTField> &key_fields)
+    : key_schema_(std::make_unique<RecordSchema>(key_fields)), is_built_(false)
+{}
+
+auto JoinFilter::GetBlockMask(size_t hash) -> Block
+{
+  Block mask{};
+  auto  low = static_cast<uint32_t>(hash);
+  for (size_t i = 0; i < 8; ++i) {
+    mask.words_[i] = static_cast<uint64_t>(1) << ((low * BLOOM_SALTS[i]) >> 26);
+  }
+  return mask;
+}
+
+auto JoinFilter::GetBlockNum(size_t key_num) -> size_t
+{
+  return (key_num * HASH_JOIN_FILTER_BITS_PER_KEY + 511) / 512;
+}
+
+void JoinFilter::Init(size_t key_num)
+{
+  Reset();
+  // the key number is not known in advance when the build side is spilled, the filter is then as large as allowed
+  auto max_key_num = HASH_JOIN_FILTER_MAX_SIZE / sizeof(Block) * 512 / HASH_JOIN_FILTER_BITS_PER_KEY;
+  blocks_.assign(std::max(GetBlockNum(std::min(key_num, max_key_num)), static_cast<size_t>(1)), Block{});
+}
+
+void JoinFilter::Insert(size_t hash)
+{
+  auto  mask  = GetBlockMask(hash);
+  auto &block = blocks_[((hash >> 32) * blocks_.size()) >> 32];
+  for (size_t i = 0; i < 8; ++i) {
+    block.words_[i] |= mask.words_[i];
+  }
+}
+
+void JoinFilter::Finish(size_t key_num)
+{
+  if (GetBlockNum(key_num) > blocks_.size()) {
+    // too many keys to be filtered cheaply, the join is not selective anyway
+    Reset();
+    return;
+  }
+  is_built_ = true;
+}
+
+void JoinFilter::Reset()
+{
+  is_built_ = false;
+  blocks_.clear();
+  blocks_.shrink_to_fit();
+}
+
+auto JoinFilter::MayContain(size_t hash) const -> bool
+{
+  if (!is_built_) {
+    return true;
+  }
+  auto        mask  = GetBlockMask(hash);
+  const auto &block = blocks_[((hash >> 32) * blocks_.size()) >> 32];
+  for (size_t i = 0; i < 8; ++i) {
+    if ((block.words_[i] & mask.words_[i]) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace wsdb
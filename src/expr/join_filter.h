@@ -0,0 +1,98 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+/**
+ * @brief Filter of the join keys of a hash join, pushed down into the scan of its probe side (semi-join reduction).
+ * The join builds a blocked Bloom filter over the hashes of its build keys before it starts reading the probe side,
+ * and the scan tests the key of each record inside the page scan, so most of the records without a match are dropped
+ * before they are materialized. Keys are the normalized keys of KeyEncoder hashed by KeyEncoder::Hash, the same
+ * hashes as the hash table of the join, so a key in the table always passes the filter.
+ * Each key sets one bit in each of the 8 words of a single cache-line block, so a test reads one cache line. The filter
+ * lets every key pass until it is built, and when it would be larger than HASH_JOIN_FILTER_MAX_SIZE.
+ */
+
+#ifndef WSDB_JOIN_FILTER_H
+#define WSDB_JOIN_FILTER_H
+
+#include <atomic>
+#include "system/handle/record_handle.h"
+
+namespace wsdb {
+class JoinFilter
+{
+public:
+  /**
+   * @param key_fields join key fields of the probe side, in the order of the build key fields
+   */
+  explicit JoinFilter(const std::vector<RTField> &key_fields);
+
+  [[nodiscard]] auto GetKeySchema() const -> const RecordSchema * { return key_schema_.get(); }
+
+  /**
+   * start building the filter, the filter of the previous build is dropped and every key passes until Finish
+   * @param key_num expected number of build keys, the filter is sized for it up to HASH_JOIN_FILTER_MAX_SIZE
+   */
+  void Init(size_t key_num);
+
+  /**
+   * add the hash of a build key to the filter being built
+   * @param hash
+   */
+  void Insert(size_t hash);
+
+  /**
+   * finish building the filter, it is not used if it is too small for the keys inserted
+   * @param key_num number of build keys inserted
+   */
+  void Finish(size_t key_num);
+
+  /**
+   * let every key pass until the filter is built again
+   */
+  void Reset();
+
+  /**
+   * @param hash
+   * @return false if no build key has the hash
+   */
+  [[nodiscard]] auto MayContain(size_t hash) const -> bool;
+
+private:
+  struct alignas(64) Block
+  {
+    uint64_t words_[8];
+  };
+
+  [[nodiscard]] static auto GetBlockMask(size_t hash) -> Block;
+
+  [[nodiscard]] static auto GetBlockNum(size_t key_num) -> size_t;
+
+  RecordSchemaUptr   key_schema_;
+  std::vector<Block> blocks_;
+  // the filter is read by the workers of a parallel scan, which start after the join has built it
+  std::atomic<bool> is_built_;
+};
+
+using JoinFilterSptr = std::shared_ptr<JoinFilter>;
+
+}  // namespace wsdb
+
+#endif  // WSDB_JOIN_FILTER_H
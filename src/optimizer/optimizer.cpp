@@ -20,7 +20,14 @@
 //
 
 #include "optimizer.h"
+
+#include <thread>
+
 namespace wsdb {
+
+// estimated number of pages read by a probe of an index join: the inner nodes, the leaf and the record
+static constexpr size_t INDEX_PROBE_PAGE_NUM = 4;
+
 auto Optimizer::Optimize(std::shared_ptr<AbstractPlan> plan, DatabaseHandle *db) -> std::shared_ptr<AbstractPlan>
 {
   plan = LogicalOptimize(plan, db);
@@ -52,13 +59,13 @@ auto Optimizer::LogicalOptimize(std::shared_ptr<AbstractPlan> plan, DatabaseHand
   } else if (auto join = std::dynamic_pointer_cast<JoinPlan>(plan)) {
     join->left_  = LogicalOptimize(join->left_, db);
     join->right_ = LogicalOptimize(join->right_, db);
-    return LogicalOptimizeJoin(join);
+    return LogicalOptimizeJoin(join, db);
   } else if (auto agg = std::dynamic_pointer_cast<AggregatePlan>(plan)) {
     agg->child_ = LogicalOptimize(agg->child_, db);
     return agg;
   } else if (auto lim = std::dynamic_pointer_cast<LimitPlan>(plan)) {
     lim->child_ = LogicalOptimize(lim->child_, db);
-    return lim;
+    return LogicalOptimizeLimit(lim);
   }
   return plan;
 }
@@ -77,13 +84,18 @@ auto Optimizer::LogicalOptimizeScan(const std::shared_ptr<ScanPlan> &scan, Condi
   return new_scan;
 }
 
-auto Optimizer::LogicalOptimizeJoin(std::shared_ptr<JoinPlan> join) -> std::shared_ptr<AbstractPlan>
+auto Optimizer::LogicalOptimizeJoin(
+    std::shared_ptr<JoinPlan> join, DatabaseHandle *db) -> std::shared_ptr<AbstractPlan>
 {
+  // a strategy given by USING is kept, the index join only replaces the default one
+  if (!join->is_user_strategy_ && ChooseIndexJoin(join, db)) {
+    return join;
+  }
   if (join->strategy_ == NESTED_LOOP) {
     return join;
   }
-  WSDB_ASSERT(join->strategy_ == SORT_MERGE, "Unknown join strategy");
-  // try to generate SortMergeJoin
+  WSDB_ASSERT(join->strategy_ == SORT_MERGE || join->strategy_ == HASH, "Unknown join strategy");
+  // try to generate SortMergeJoin or HashJoin
   // check if all conditions are equality comparison
   auto all_eq =
       std::all_of(join->conds_.begin(), join->conds_.end(), [](const auto &cond) { return cond.GetOp() == OP_EQ; });
@@ -91,6 +103,17 @@ auto Optimizer::LogicalOptimizeJoin(std::shared_ptr<JoinPlan> join) -> std::shar
     join->strategy_ = NESTED_LOOP;
     return join;
   }
+  if (join->strategy_ == HASH) {
+    // keys are compared by their normalized bytes, so both sides of a condition should have the same type and size
+    auto same_type = std::all_of(join->conds_.begin(), join->conds_.end(), [](const auto &cond) {
+      return cond.GetLCol().field_.field_type_ == cond.GetRCol().field_.field_type_ &&
+             cond.GetLCol().field_.field_size_ == cond.GetRCol().field_.field_size_;
+    });
+    if (join->conds_.empty() || !same_type) {
+      join->strategy_ = NESTED_LOOP;
+      return join;
+    }
+  }
   // generate key schema from conditions
   std::vector<RTField> left_key_fields;
   std::vector<RTField> right_key_fields;
@@ -101,70 +124,478 @@ auto Optimizer::LogicalOptimizeJoin(std::shared_ptr<JoinPlan> join) -> std::shar
     left_key_fields.push_back(cond.GetLCol());
     right_key_fields.push_back(cond.GetRCol());
   }
-  std::shared_ptr<AbstractPlan> left = std::dynamic_pointer_cast<IdxScanPlan>(join->left_);
-  // generate sort plan
-  if (left == nullptr) {
+  join->left_key_schema_  = std::make_unique<RecordSchema>(left_key_fields);
+  join->right_key_schema_ = std::make_unique<RecordSchema>(right_key_fields);
+  if (join->strategy_ == HASH) {
+    // inputs are not required to be ordered, build the hash table on the smaller one
+    join->build_left_ = EstimateRecordNum(join->left_, db) < EstimateRecordNum(join->right_, db);
+    return join;
+  }
+  // generate sort plan if the input is not ordered by the keys
+  std::shared_ptr<AbstractPlan> left = join->left_;
+  if (!IsOrderedByIndex(left, left_key_fields, db)) {
     left = std::make_shared<SortPlan>(std::move(join->left_), std::make_unique<RecordSchema>(left_key_fields), false);
   }
-  std::shared_ptr<AbstractPlan> right = std::dynamic_pointer_cast<IdxScanPlan>(join->right_);
-  if (right == nullptr) {
+  std::shared_ptr<AbstractPlan> right = join->right_;
+  if (!IsOrderedByIndex(right, right_key_fields, db)) {
     right =
         std::make_shared<SortPlan>(std::move(join->right_), std::make_unique<RecordSchema>(right_key_fields), false);
   }
-  join->left_             = left;
-  join->right_            = right;
-  join->left_key_schema_  = std::make_unique<RecordSchema>(left_key_fields);
-  join->right_key_schema_ = std::make_unique<RecordSchema>(right_key_fields);
+  join->left_  = left;
+  join->right_ = right;
   return join;
 }
 
+auto Optimizer::LogicalOptimizeLimit(std::shared_ptr<LimitPlan> lim) -> std::shared_ptr<AbstractPlan>
+{
+  // the planner puts the projection between limit and sort, which keeps the number of records
+  auto proj = std::dynamic_pointer_cast<ProjectPlan>(lim->child_);
+  auto sort = std::dynamic_pointer_cast<SortPlan>(proj == nullptr ? lim->child_ : proj->child_);
+  if (sort == nullptr) {
+    return lim;
+  }
+  // only keep the first limit_ records of the sort, the limit plan is no longer needed
+  auto top_n = std::make_shared<TopNPlan>(sort->child_, std::move(sort->key_schema_), sort->is_desc_, lim->limit_);
+  if (proj == nullptr) {
+    return top_n;
+  }
+  proj->child_ = top_n;
+  return proj;
+}
+
 auto Optimizer::PhysicalOptimize(
     std::shared_ptr<AbstractPlan> plan, DatabaseHandle *db) -> std::shared_ptr<AbstractPlan>
 {
+  plan = PushDownScan(std::move(plan), nullptr, db);
+  plan = ParallelizeScan(std::move(plan), db);
+  PushDownJoinFilter(plan, db);
+  return plan;
+}
+
+// columns required by the parent plans together with the columns read by the conditions
+static auto AddCondFields(const std::vector<RTField> &required, const ConditionVec &conds) -> std::vector<RTField>
+{
+  auto fields = required;
+  for (const auto &cond : conds) {
+    fields.push_back(cond.GetLCol());
+    if (cond.GetRhsType() == kColumn) {
+      fields.push_back(cond.GetRCol());
+    }
+  }
+  return fields;
+}
+
+auto Optimizer::PushDownScan(std::shared_ptr<AbstractPlan> plan, const std::vector<RTField> *required,
+    DatabaseHandle *db) -> std::shared_ptr<AbstractPlan>
+{
+  if (auto upd = std::dynamic_pointer_cast<UpdatePlan>(plan)) {
+    // update and delete write back whole records
+    upd->child_ = PushDownScan(upd->child_, nullptr, db);
+    return upd;
+  } else if (auto del = std::dynamic_pointer_cast<DeletePlan>(plan)) {
+    del->child_ = PushDownScan(del->child_, nullptr, db);
+    return del;
+  } else if (auto filter = std::dynamic_pointer_cast<FilterPlan>(plan)) {
+    if (auto scan = std::dynamic_pointer_cast<ScanPlan>(filter->child_)) {
+      // evaluate the filter inside the scan, so that the scan can skip pages by zone maps,
+      // and for pax tables the other columns are only read for the qualified records
+      scan->conds_.insert(scan->conds_.end(), filter->conds_.begin(), filter->conds_.end());
+      return PushDownScan(scan, required, db);
+    }
+    if (required == nullptr) {
+      filter->child_ = PushDownScan(filter->child_, nullptr, db);
+    } else {
+      auto fields    = AddCondFields(*required, filter->conds_);
+      filter->child_ = PushDownScan(filter->child_, &fields, db);
+    }
+    return filter;
+  } else if (auto sort = std::dynamic_pointer_cast<SortPlan>(plan)) {
+    if (required == nullptr) {
+      sort->child_ = PushDownScan(sort->child_, nullptr, db);
+    } else {
+      auto fields = *required;
+      fields.insert(fields.end(), sort->key_schema_->GetFields().begin(), sort->key_schema_->GetFields().end());
+      sort->child_ = PushDownScan(sort->child_, &fields, db);
+    }
+    return sort;
+  } else if (auto top_n = std::dynamic_pointer_cast<TopNPlan>(plan)) {
+    if (required == nullptr) {
+      top_n->child_ = PushDownScan(top_n->child_, nullptr, db);
+    } else {
+      auto fields = *required;
+      fields.insert(fields.end(), top_n->key_schema_->GetFields().begin(), top_n->key_schema_->GetFields().end());
+      top_n->child_ = PushDownScan(top_n->child_, &fields, db);
+    }
+    return top_n;
+  } else if (auto proj = std::dynamic_pointer_cast<ProjectPlan>(plan)) {
+    proj->child_ = PushDownScan(proj->child_, &proj->schema_->GetFields(), db);
+    return proj;
+  } else if (auto join = std::dynamic_pointer_cast<JoinPlan>(plan)) {
+    if (required == nullptr) {
+      join->left_  = PushDownScan(join->left_, nullptr, db);
+      join->right_ = PushDownScan(join->right_, nullptr, db);
+    } else {
+      auto fields  = AddCondFields(*required, join->conds_);
+      join->left_  = PushDownScan(join->left_, &fields, db);
+      join->right_ = PushDownScan(join->right_, &fields, db);
+    }
+    return join;
+  } else if (auto agg = std::dynamic_pointer_cast<AggregatePlan>(plan)) {
+    // aggregation only reads group by columns and the columns being aggregated
+    auto fields = agg->group_fields_;
+    for (const auto &field : agg->agg_fields) {
+      if (!field.field_.field_name_.empty()) {
+        fields.push_back(field);
+      }
+    }
+    agg->child_ = PushDownScan(agg->child_, &fields, db);
+    return agg;
+  } else if (auto lim = std::dynamic_pointer_cast<LimitPlan>(plan)) {
+    lim->child_ = PushDownScan(lim->child_, required, db);
+    return lim;
+  } else if (auto idx_scan = std::dynamic_pointer_cast<IdxScanPlan>(plan)) {
+    // the records are built from the index entries if the index stores all the required columns of the table
+    auto index = db->GetIndex(idx_scan->idx_id_);
+    if (required == nullptr || index->GetIndexType() == IndexType::HASH) {
+      return idx_scan;
+    }
+    auto        tid          = db->GetTable(idx_scan->table_name_)->GetTableId();
+    const auto &entry_fields = index->GetEntrySchema().GetFields();
+    idx_scan->index_only_    = std::all_of(required->begin(), required->end(), [&](const RTField &field) {
+      return field.field_.table_id_ != tid ||
+             std::any_of(entry_fields.begin(), entry_fields.end(), [&field](const RTField &entry_field) {
+               return entry_field.field_.field_name_ == field.field_.field_name_;
+             });
+    });
+    return idx_scan;
+  } else if (auto scan = std::dynamic_pointer_cast<ScanPlan>(plan)) {
+    auto tab = db->GetTable(scan->table_name_);
+    if (required == nullptr) {
+      return scan;
+    }
+    const auto &tab_fields = tab->GetSchema().GetFields();
+    scan->fields_.clear();
+    for (const auto &tab_field : tab_fields) {
+      auto is_required = std::any_of(required->begin(), required->end(), [&tab_field](const RTField &field) {
+        return field.field_.table_id_ == tab_field.field_.table_id_ &&
+               field.field_.field_name_ == tab_field.field_.field_name_;
+      });
+      if (is_required) {
+        scan->fields_.push_back(tab_field);
+      }
+    }
+    if (scan->fields_.size() == tab_fields.size()) {
+      scan->fields_.clear();
+    } else if (scan->fields_.empty()) {
+      // e.g. count(*), keep one column so that the scan still produces records
+      scan->fields_.push_back(tab_fields.front());
+    }
+    return scan;
+  }
   return plan;
 }
 
+auto Optimizer::ParallelizeScan(
+    std::shared_ptr<AbstractPlan> plan, DatabaseHandle *db) -> std::shared_ptr<AbstractPlan>
+{
+  if (std::dynamic_pointer_cast<UpdatePlan>(plan) != nullptr || std::dynamic_pointer_cast<DeletePlan>(plan) != nullptr) {
+    // records are modified while being scanned
+    return plan;
+  } else if (auto filter = std::dynamic_pointer_cast<FilterPlan>(plan)) {
+    filter->child_ = ParallelizeScan(filter->child_, db);
+  } else if (auto sort = std::dynamic_pointer_cast<SortPlan>(plan)) {
+    // the sort only splits its buffer among the workers once the input outgrows one chunk
+    sort->worker_num_ = std::min(static_cast<size_t>(std::thread::hardware_concurrency()), SORT_WORKER_NUM);
+    sort->child_      = ParallelizeScan(sort->child_, db);
+  } else if (auto top_n = std::dynamic_pointer_cast<TopNPlan>(plan)) {
+    top_n->child_ = ParallelizeScan(top_n->child_, db);
+  } else if (auto proj = std::dynamic_pointer_cast<ProjectPlan>(plan)) {
+    proj->child_ = ParallelizeScan(proj->child_, db);
+  } else if (auto join = std::dynamic_pointer_cast<JoinPlan>(plan)) {
+    if (join->strategy_ == HASH) {
+      join->worker_num_ = std::min(static_cast<size_t>(std::thread::hardware_concurrency()), HASH_JOIN_WORKER_NUM);
+    }
+    join->left_ = ParallelizeScan(join->left_, db);
+    // the right input is parallelized only if it is read once, by the hash join or by the sort of a sort merge join.
+    // the nested loop join reads it again for every block of left records, and the index join reads it by rids
+    if (join->strategy_ == HASH ||
+        (join->strategy_ == SORT_MERGE && std::dynamic_pointer_cast<SortPlan>(join->right_) != nullptr)) {
+      join->right_ = ParallelizeScan(join->right_, db);
+    }
+  } else if (auto agg = std::dynamic_pointer_cast<AggregatePlan>(plan)) {
+    agg->child_ = ParallelizeScan(agg->child_, db);
+    // the workers of the scan pre-aggregate their morsels instead of gathering the records
+    if (auto gather = std::dynamic_pointer_cast<GatherPlan>(agg->child_)) {
+      agg->worker_num_ = gather->worker_num_;
+    }
+  } else if (auto lim = std::dynamic_pointer_cast<LimitPlan>(plan)) {
+    lim->child_ = ParallelizeScan(lim->child_, db);
+  } else if (auto scan = std::dynamic_pointer_cast<ScanPlan>(plan)) {
+    auto page_num   = db->GetTable(scan->table_name_)->GetTableHeader().page_num_ - (FILE_HEADER_PAGE_ID + 1);
+    auto morsel_num = (page_num + SCAN_MORSEL_SIZE - 1) / SCAN_MORSEL_SIZE;
+    auto worker_num = std::min({static_cast<size_t>(std::thread::hardware_concurrency()), SCAN_WORKER_NUM, morsel_num});
+    if (worker_num > 1) {
+      return std::make_shared<GatherPlan>(scan, worker_num);
+    }
+  }
+  return plan;
+}
+
+void Optimizer::PushDownJoinFilter(const std::shared_ptr<AbstractPlan> &plan, DatabaseHandle *db)
+{
+  if (auto filter = std::dynamic_pointer_cast<FilterPlan>(plan)) {
+    PushDownJoinFilter(filter->child_, db);
+  } else if (auto sort = std::dynamic_pointer_cast<SortPlan>(plan)) {
+    PushDownJoinFilter(sort->child_, db);
+  } else if (auto top_n = std::dynamic_pointer_cast<TopNPlan>(plan)) {
+    PushDownJoinFilter(top_n->child_, db);
+  } else if (auto proj = std::dynamic_pointer_cast<ProjectPlan>(plan)) {
+    PushDownJoinFilter(proj->child_, db);
+  } else if (auto agg = std::dynamic_pointer_cast<AggregatePlan>(plan)) {
+    PushDownJoinFilter(agg->child_, db);
+  } else if (auto lim = std::dynamic_pointer_cast<LimitPlan>(plan)) {
+    PushDownJoinFilter(lim->child_, db);
+  } else if (auto join = std::dynamic_pointer_cast<JoinPlan>(plan)) {
+    PushDownJoinFilter(join->left_, db);
+    PushDownJoinFilter(join->right_, db);
+    // the records of the left input without a match are output by outer join
+    if (join->strategy_ != HASH || (join->type_ == OUTER_JOIN && !join->build_left_)) {
+      return;
+    }
+    auto probe = join->build_left_ ? join->right_ : join->left_;
+    if (auto probe_filter = std::dynamic_pointer_cast<FilterPlan>(probe)) {
+      probe = probe_filter->child_;
+    }
+    auto scan = std::dynamic_pointer_cast<ScanPlan>(probe);
+    if (auto gather = std::dynamic_pointer_cast<GatherPlan>(probe)) {
+      scan = gather->child_;
+    }
+    if (scan == nullptr || scan->join_filter_ != nullptr) {
+      return;
+    }
+    auto        tab        = db->GetTable(scan->table_name_);
+    const auto &key_schema = join->build_left_ ? join->right_key_schema_ : join->left_key_schema_;
+    const auto &key_fields = key_schema->GetFields();
+    if (std::any_of(key_fields.begin(), key_fields.end(), [tab](const RTField &field) {
+          return field.field_.table_id_ != tab->GetTableId();
+        })) {
+      return;
+    }
+    // every record of the table may find a match when the build side has as many keys
+    auto build_num = EstimateRecordNum(join->build_left_ ? join->left_ : join->right_, db);
+    if (build_num >= tab->GetTableHeader().rec_num_) {
+      return;
+    }
+    join->join_filter_ = std::make_shared<JoinFilter>(key_fields);
+    scan->join_filter_ = join->join_filter_;
+  }
+}
+
+auto Optimizer::ChooseIndexJoin(const std::shared_ptr<JoinPlan> &join, DatabaseHandle *db) -> bool
+{
+  // the right input should be a scan of a table, possibly with filters
+  auto scan = std::dynamic_pointer_cast<ScanPlan>(join->right_);
+  if (auto filter = std::dynamic_pointer_cast<FilterPlan>(join->right_)) {
+    scan = std::dynamic_pointer_cast<ScanPlan>(filter->child_);
+  }
+  if (scan == nullptr) {
+    return false;
+  }
+  // find the index whose longest key prefix is matched by equality conditions, the outer key is copied into the
+  // index key, so the fields should have the same types and sizes
+  IndexHandle         *best_index = nullptr;
+  std::vector<RTField> best_left_fields;
+  std::vector<RTField> best_right_fields;
+  for (const auto idx : db->GetIndexes(scan->table_name_)) {
+    std::vector<RTField> left_fields;
+    std::vector<RTField> right_fields;
+    for (const auto &field : idx->GetKeySchema().GetFields()) {
+      auto cond = std::find_if(join->conds_.begin(), join->conds_.end(), [&field](const Condition &c) {
+        if (c.GetOp() != OP_EQ || c.GetRhsType() != kColumn) {
+          return false;
+        }
+        const auto &rcol = c.GetRCol();
+        return rcol.field_.table_id_ == field.field_.table_id_ &&
+               rcol.field_.field_name_ == field.field_.field_name_ &&
+               c.GetLCol().field_.field_type_ == field.field_.field_type_ &&
+               c.GetLCol().field_.field_size_ == field.field_.field_size_;
+      });
+      if (cond == join->conds_.end()) {
+        break;
+      }
+      left_fields.push_back(cond->GetLCol());
+      right_fields.push_back(field);
+    }
+    // a hash index is probed by the whole key, and is preferred to a B+tree matched by as many fields
+    auto is_hash = idx->GetIndexType() == IndexType::HASH;
+    if (is_hash && left_fields.size() < idx->GetKeySchema().GetFieldCount()) {
+      continue;
+    }
+    if (left_fields.size() > best_left_fields.size() ||
+        (!left_fields.empty() && left_fields.size() == best_left_fields.size() && is_hash &&
+            best_index->GetIndexType() != IndexType::HASH)) {
+      best_index        = idx;
+      best_left_fields  = std::move(left_fields);
+      best_right_fields = std::move(right_fields);
+    }
+  }
+  if (best_index == nullptr) {
+    return false;
+  }
+  // each outer record descends the index and fetches the matched records, while the other strategies read every
+  // page of the inner table at least once
+  auto outer_num  = EstimateRecordNum(join->left_, db);
+  auto inner_cost = db->GetTable(scan->table_name_)->GetTableHeader().page_num_;
+  if (outer_num * INDEX_PROBE_PAGE_NUM >= inner_cost) {
+    return false;
+  }
+  join->strategy_         = INDEX_NESTED_LOOP;
+  join->index_id_         = best_index->GetIndexId();
+  join->left_key_schema_  = std::make_unique<RecordSchema>(best_left_fields);
+  join->right_key_schema_ = std::make_unique<RecordSchema>(best_right_fields);
+  return true;
+}
+
+// System R style default selectivities of the conditions whose values are unknown
+static auto EstimateSelectivity(const ConditionVec &conds) -> double
+{
+  double selectivity = 1.0;
+  for (const auto &cond : conds) {
+    selectivity *= cond.GetOp() == OP_EQ ? 0.1 : 1.0 / 3;
+  }
+  return selectivity;
+}
+
+auto Optimizer::EstimateRecordNum(const std::shared_ptr<AbstractPlan> &plan, DatabaseHandle *db) -> size_t
+{
+  if (auto filter = std::dynamic_pointer_cast<FilterPlan>(plan)) {
+    return static_cast<size_t>(static_cast<double>(EstimateRecordNum(filter->child_, db)) *
+                               EstimateSelectivity(filter->conds_));
+  } else if (auto scan = std::dynamic_pointer_cast<ScanPlan>(plan)) {
+    auto rec_num = db->GetTable(scan->table_name_)->GetTableHeader().rec_num_;
+    return static_cast<size_t>(static_cast<double>(rec_num) * EstimateSelectivity(scan->conds_));
+  } else if (auto idx_scan = std::dynamic_pointer_cast<IdxScanPlan>(plan)) {
+    auto rec_num = db->GetTable(idx_scan->table_name_)->GetTableHeader().rec_num_;
+    return static_cast<size_t>(static_cast<double>(rec_num) * EstimateSelectivity(idx_scan->conds_));
+  } else if (auto join = std::dynamic_pointer_cast<JoinPlan>(plan)) {
+    auto left_num  = EstimateRecordNum(join->left_, db);
+    auto right_num = EstimateRecordNum(join->right_, db);
+    if (join->conds_.empty()) {
+      return left_num * right_num;
+    }
+    if (std::all_of(join->conds_.begin(), join->conds_.end(), [](const auto &cond) { return cond.GetOp() == OP_EQ; })) {
+      // equi-joins are assumed to match a key of one input, e.g. a foreign key join
+      return std::max(left_num, right_num);
+    }
+    return static_cast<size_t>(
+        static_cast<double>(left_num) * static_cast<double>(right_num) * EstimateSelectivity(join->conds_));
+  } else if (auto sort = std::dynamic_pointer_cast<SortPlan>(plan)) {
+    return EstimateRecordNum(sort->child_, db);
+  } else if (auto top_n = std::dynamic_pointer_cast<TopNPlan>(plan)) {
+    return std::min(EstimateRecordNum(top_n->child_, db), top_n->limit_);
+  } else if (auto proj = std::dynamic_pointer_cast<ProjectPlan>(plan)) {
+    return EstimateRecordNum(proj->child_, db);
+  } else if (auto agg = std::dynamic_pointer_cast<AggregatePlan>(plan)) {
+    return agg->group_fields_.empty() ? 1 : EstimateRecordNum(agg->child_, db);
+  } else if (auto lim = std::dynamic_pointer_cast<LimitPlan>(plan)) {
+    return std::min(EstimateRecordNum(lim->child_, db), lim->limit_);
+  } else if (auto gather = std::dynamic_pointer_cast<GatherPlan>(plan)) {
+    return EstimateRecordNum(gather->child_, db);
+  }
+  return 0;
+}
+
+auto Optimizer::IsOrderedByIndex(
+    const std::shared_ptr<AbstractPlan> &plan, const std::vector<RTField> &key_fields, DatabaseHandle *db) -> bool
+{
+  auto idx_scan = std::dynamic_pointer_cast<IdxScanPlan>(plan);
+  if (idx_scan == nullptr || db->GetIndex(idx_scan->idx_id_)->GetIndexType() == IndexType::HASH) {
+    return false;
+  }
+  // the records of an index scan have equal values on the fields of equality conditions, and are ordered by the
+  // fields after them
+  const auto &key_schema = db->GetIndex(idx_scan->idx_id_)->GetKeySchema();
+  auto        offset     = static_cast<size_t>(std::count_if(idx_scan->conds_.begin(),
+      idx_scan->conds_.end(),
+      [](const Condition &cond) { return cond.GetOp() == OP_EQ; }));
+  if (offset + key_fields.size() > key_schema.GetFieldCount()) {
+    return false;
+  }
+  for (size_t i = 0; i < key_fields.size(); ++i) {
+    const auto &field = key_schema.GetFieldAt(offset + i).field_;
+    if (field.table_id_ != key_fields[i].field_.table_id_ || field.field_name_ != key_fields[i].field_.field_name_) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// conditions with a value of the key type bound the key field, other conditions are left to the filter
+static auto IsIndexBound(const Condition &cond, const RTField &field) -> bool
+{
+  const auto &lcol = cond.GetLCol();
+  return lcol.field_.table_id_ == field.field_.table_id_ && lcol.field_.field_name_ == field.field_.field_name_ &&
+         cond.GetRhsType() == kValue && !cond.GetRVal()->IsNull() &&
+         cond.GetRVal()->GetType() == field.field_.field_type_;
+}
+
 auto Optimizer::CanIndexScan(ConditionVec &conds, ConditionVec &index_conds, const std::list<IndexHandle *> &indexes,
     size_t &max_matched_fields) -> IndexHandle *
 {
   std::vector<int> best_conds_pos;
-  max_matched_fields      = 0;
-  IndexHandle *best_index = nullptr;
+  size_t           best_eq_num = 0;
+  max_matched_fields           = 0;
+  IndexHandle *best_index      = nullptr;
   for (const auto idx : indexes) {
+    // match equality conditions on the key prefix, and then range conditions on the next key field
     std::vector<int> tmp_conds_pos;
+    size_t           eq_num    = 0;
+    bool             has_range = false;
     for (const auto &field : idx->GetKeySchema().GetFields()) {
-      bool matched = false;
+      auto eq = std::find_if(conds.begin(), conds.end(), [&field](const Condition &cond) {
+        return cond.GetOp() == OP_EQ && IsIndexBound(cond, field);
+      });
+      if (eq != conds.end()) {
+        tmp_conds_pos.push_back(static_cast<int>(eq - conds.begin()));
+        eq_num++;
+        continue;
+      }
       for (int i = 0; i < static_cast<int>(conds.size()); ++i) {
-        auto       &cond = conds[i];
-        const auto &lcol = cond.GetLCol();
-        if (lcol.field_.table_id_ == field.field_.table_id_ && lcol.field_.field_name_ == field.field_.field_name_) {
-          matched = true;
-          if (cond.GetOp() != OP_EQ) {
-            matched = false;
-          }
+        auto op = conds[i].GetOp();
+        if ((op == OP_LT || op == OP_LE || op == OP_GT || op == OP_GE) && IsIndexBound(conds[i], field)) {
           tmp_conds_pos.push_back(i);
-          break;
+          has_range = true;
         }
       }
-      if (!matched) {
-        break;
-      }
+      break;
+    }
+    // a hash index locates only the whole key
+    auto is_hash = idx->GetIndexType() == IndexType::HASH;
+    if (is_hash && eq_num < idx->GetKeySchema().GetFieldCount()) {
+      continue;
     }
-    if (tmp_conds_pos.size() > best_conds_pos.size()) {
-      best_conds_pos = tmp_conds_pos;
-      best_index     = idx;
+    auto matched_fields = eq_num + (has_range ? 1 : 0);
+    // prefer more equality conditions, as they narrow the range more than a range condition, and then a hash index,
+    // which finds the key in a bucket or two instead of descending a tree
+    if (eq_num > best_eq_num || (eq_num == best_eq_num && matched_fields > max_matched_fields) ||
+        (eq_num == best_eq_num && matched_fields == max_matched_fields && is_hash && best_index != nullptr &&
+            best_index->GetIndexType() != IndexType::HASH)) {
+      best_conds_pos     = tmp_conds_pos;
+      best_eq_num        = eq_num;
+      max_matched_fields = matched_fields;
+      best_index         = idx;
     }
   }
-  max_matched_fields = best_conds_pos.size();
   if (max_matched_fields == 0) {
     return nullptr;
   }
   index_conds.clear();
-  // add index conds;
+  // add index conds, the equality conditions come first in the order of the key fields
   for (auto pos : best_conds_pos) {
     index_conds.push_back(conds[pos]);
   }
-  // erase index conds from conds
+  // erase index conds from conds, from back to front so that the positions are not shifted
+  std::sort(best_conds_pos.begin(), best_conds_pos.end(), std::greater<>());
   for (auto pos : best_conds_pos) {
     conds.erase(conds.begin() + pos);
   }
@@ -39,10 +39,70 @@ private:
   static auto LogicalOptimizeScan(const std::shared_ptr<ScanPlan> &scan, ConditionVec conds,
       wsdb::DatabaseHandle *db) -> std::shared_ptr<AbstractPlan>;
 
-  static auto LogicalOptimizeJoin(std::shared_ptr<JoinPlan> join) -> std::shared_ptr<AbstractPlan>;
+  static auto LogicalOptimizeJoin(std::shared_ptr<JoinPlan> join, DatabaseHandle *db) -> std::shared_ptr<AbstractPlan>;
+
+  /**
+   * turn a join into an index nested loop join if the right input is a table scan, an index of the table is matched
+   * by the equality conditions, and probing the index for each left record reads fewer pages than scanning the table
+   * @param join
+   * @param db
+   * @return true if the join is turned into an index nested loop join
+   */
+  static auto ChooseIndexJoin(const std::shared_ptr<JoinPlan> &join, DatabaseHandle *db) -> bool;
+
+  /**
+   * turn a limit over a sort into a top-n, which keeps only limit_ records in memory
+   * @param lim
+   * @return
+   */
+  static auto LogicalOptimizeLimit(std::shared_ptr<LimitPlan> lim) -> std::shared_ptr<AbstractPlan>;
 
   static auto PhysicalOptimize(std::shared_ptr<AbstractPlan> plan, DatabaseHandle *db) -> std::shared_ptr<AbstractPlan>;
 
+  /**
+   * push filters and the columns required by the parent plans down to the scans,
+   * so that the scans only read the pages and column stripes they need, and index scans whose index stores all the
+   * required columns do not read the table
+   * @param plan
+   * @param required columns required by the parent plans, nullptr means all columns are required
+   * @param db
+   * @return
+   */
+  static auto PushDownScan(std::shared_ptr<AbstractPlan> plan, const std::vector<RTField> *required,
+      DatabaseHandle *db) -> std::shared_ptr<AbstractPlan>;
+
+  /**
+   * run the scans of large tables and the sorts with multiple workers in read-only queries
+   * @param plan
+   * @param db
+   * @return
+   */
+  static auto ParallelizeScan(std::shared_ptr<AbstractPlan> plan, DatabaseHandle *db) -> std::shared_ptr<AbstractPlan>;
+
+  /**
+   * push a filter of the build keys of hash joins into the scan of their probe side, when the records of the probe side
+   * without a match are dropped and the build side is estimated to hold fewer keys than the probed table
+   * @param plan
+   * @param db
+   */
+  static void PushDownJoinFilter(const std::shared_ptr<AbstractPlan> &plan, DatabaseHandle *db);
+
+  /**
+   * estimate the number of records produced by a plan from the record numbers of the tables
+   * and default selectivities of the conditions
+   * @param plan
+   * @param db
+   * @return
+   */
+  static auto EstimateRecordNum(const std::shared_ptr<AbstractPlan> &plan, DatabaseHandle *db) -> size_t;
+
+  /**
+   * check if the output of the plan is an index scan ordered by the key fields, so that sort merge join can skip
+   * sorting it
+   */
+  static auto IsOrderedByIndex(
+      const std::shared_ptr<AbstractPlan> &plan, const std::vector<RTField> &key_fields, DatabaseHandle *db) -> bool;
+
   /**
    * check if there is an index that can be used to scan the table,
    * and return the index with the most matched fields, should store
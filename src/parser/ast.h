@@ -26,6 +26,7 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <optional>
 
 #include "common/types.h"
 
@@ -140,9 +141,15 @@ struct CreateIndex : public TreeNode
 {
   std::string              tab_name_;
   std::vector<std::string> col_names_;
-
-  CreateIndex(std::string tab_name, std::vector<std::string> col_names)
-      : tab_name_(std::move(tab_name)), col_names_(std::move(col_names))
+  std::vector<std::string> include_names_;  // columns stored in the index entries besides the key
+  IndexType                index_type_;
+
+  CreateIndex(std::string tab_name, std::vector<std::string> col_names, std::vector<std::string> include_names,
+      IndexType index_type)
+      : tab_name_(std::move(tab_name)),
+        col_names_(std::move(col_names)),
+        include_names_(std::move(include_names)),
+        index_type_(index_type)
   {}
 };
 
@@ -321,6 +328,7 @@ struct SelectStmt : public TreeNode
   std::vector<std::shared_ptr<Col>>        cols;
   std::vector<std::shared_ptr<TreeNode>>   tabs;
   std::vector<std::shared_ptr<BinaryExpr>> conds;
+  bool                                     has_join_strategy;
   JoinStrategy                             join_strategy;
 
   bool                     has_sort;
@@ -334,32 +342,33 @@ struct SelectStmt : public TreeNode
 
   SelectStmt(std::vector<std::shared_ptr<Col>> cols_, std::vector<std::shared_ptr<TreeNode>> tabs_,
       std::vector<std::shared_ptr<BinaryExpr>> conds_, std::shared_ptr<OrderBy> order_,
-      std::shared_ptr<GroupBy> groupby_, std::vector<std::shared_ptr<BinaryExpr>> having_, JoinStrategy join_st_,
-      int limit_)
+      std::shared_ptr<GroupBy> groupby_, std::vector<std::shared_ptr<BinaryExpr>> having_,
+      std::optional<JoinStrategy> join_st_, int limit_)
       : cols(std::move(cols_)),
         tabs(std::move(tabs_)),
         conds(std::move(conds_)),
-        join_strategy(join_st_),
+        join_strategy(join_st_.value_or(NESTED_LOOP)),
         order(std::move(order_)),
         groupby(std::move(groupby_)),
         having(std::move(having_)),
         limit(limit_)
   {
-    has_sort    = (bool)order;
-    has_groupby = (bool)groupby;
+    has_sort          = (bool)order;
+    has_groupby       = (bool)groupby;
+    has_join_strategy = join_st_.has_value();
   }
 };
 
 // Semantic value
 struct SemValue
 {
-  int                      sv_int;
-  float                    sv_float;
-  std::string              sv_str;
-  bool                     sv_bool;
-  OrderByDir               sv_orderby_dir;
-  JoinStrategy             sv_join_strategy;
-  std::vector<std::string> sv_strs;
+  int                         sv_int;
+  float                       sv_float;
+  std::string                 sv_str;
+  bool                        sv_bool;
+  OrderByDir                  sv_orderby_dir;
+  std::optional<JoinStrategy> sv_join_strategy;  // empty if the query does not choose a join strategy
+  std::vector<std::string>    sv_strs;
 
   std::shared_ptr<TreeNode> sv_node;
 
@@ -371,6 +380,8 @@ struct SemValue
 
   StorageModel sv_storage_model;
 
+  IndexType sv_index_type;
+
   std::shared_ptr<TypeLen> sv_type_len;
 
   std::shared_ptr<Field>              sv_field;
@@ -0,0 +1,131 @@
+#include "ast.h"
+#include "yacc.tab.h"
+#include "def.h"
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+struct yy_buffer_state { std::string s; size_t pos; };
+static yy_buffer_state *cur_buf = nullptr;
+
+static const std::unordered_map<std::string, int> &Keywords()
+{
+  static const std::unordered_map<std::string, int> kws = {
+    {"EXPLAIN", EXPLAIN},
+    {"SHOW", SHOW},
+    {"BEGIN", TXN_BEGIN},
+    {"COMMIT", TXN_COMMIT},
+    {"ABORT", TXN_ABORT},
+    {"ROLLBACK", TXN_ROLLBACK},
+    {"STATIC_CHECKPOINT", STATIC_CHECKPOINT},
+    {"TABLES", TABLES},
+    {"CREATE", CREATE},
+    {"OPEN", OPEN},
+    {"TABLE", TABLE},
+    {"DATABASE", DATABASE},
+    {"DROP", DROP},
+    {"DESC", DESC},
+    {"INSERT", INSERT},
+    {"INTO", INTO},
+    {"VALUES", VALUES},
+    {"DELETE", DELETE},
+    {"FROM", FROM},
+    {"WHERE", WHERE},
+    {"HAVING", HAVING},
+    {"UPDATE", UPDATE},
+    {"SET", SET},
+    {"SELECT", SELECT},
+    {"INT", INT},
+    {"CHAR", CHAR},
+    {"FLOAT", FLOAT},
+    {"INDEX", INDEX},
+    {"AND", AND},
+    {"JOIN", JOIN},
+    {"INNER", INNER},
+    {"OUTER", OUTER},
+    {"EXIT", EXIT},
+    {"HELP", HELP},
+    {"ORDER", ORDER},
+    {"GROUP", GROUP},
+    {"BY", BY},
+    {"AS", AS},
+    {"IN", IN},
+    {"ON", ON},
+    {"COUNT", COUNT},
+    {"ASC", ASC},
+    {"SUM", SUM},
+    {"MAX", MAX},
+    {"MIN", MIN},
+    {"AVG", AVG},
+    {"USING", USING},
+    {"NESTED_LOOP_JOIN", NESTED_LOOP_JOIN},
+    {"SORT_MERGE_JOIN", SORT_MERGE_JOIN},
+    {"HASH_JOIN", HASH_JOIN},
+    {"STORAGE", STORAGE},
+    {"NARY", NARY},
+    {"PAX", PAX},
+    {"LIMIT", LIMIT},
+    {"BPTREE", INDEX_BPTREE},
+    {"BTREE", INDEX_BPTREE},
+    {"HASH", INDEX_HASH},
+    {"ART", INDEX_ART},
+    {"INCLUDE", INCLUDE}
+  };
+  return kws;
+}
+
+int yylex(YYSTYPE *yylval, YYLTYPE *)
+{
+  auto &s = cur_buf->s;
+  auto &p = cur_buf->pos;
+  while (true) {
+    while (p < s.size() && std::isspace((unsigned char)s[p])) p++;
+    if (p + 1 < s.size() && s[p] == '-' && s[p + 1] == '-') { while (p < s.size() && s[p] != '\n') p++; continue; }
+    if (p + 1 < s.size() && s[p] == '/' && s[p + 1] == '*') { auto e = s.find("*/", p + 2); p = e == std::string::npos ? s.size() : e + 2; continue; }
+    break;
+  }
+  if (p >= s.size()) return T_EOF;
+  char c = s[p];
+  if (std::isalpha((unsigned char)c)) {
+    size_t b = p;
+    while (p < s.size() && (std::isalnum((unsigned char)s[p]) || s[p] == '_')) p++;
+    std::string w = s.substr(b, p - b), u;
+    for (char ch : w) u += (char)std::toupper((unsigned char)ch);
+    if (u == "TRUE" || u == "FALSE") { yylval->sv_bool = u == "TRUE"; return VALUE_BOOL; }
+    auto it = Keywords().find(u);
+    if (it != Keywords().end()) { yylval->sv_str = w; return it->second; }
+    yylval->sv_str = w;
+    return IDENTIFIER;
+  }
+  if (std::isdigit((unsigned char)c) || ((c == '+' || c == '-') && p + 1 < s.size() && std::isdigit((unsigned char)s[p + 1]))) {
+    size_t b = p++;
+    while (p < s.size() && std::isdigit((unsigned char)s[p])) p++;
+    if (p < s.size() && s[p] == '.') {
+      p++;
+      while (p < s.size() && std::isdigit((unsigned char)s[p])) p++;
+      yylval->sv_float = std::atof(s.substr(b, p - b).c_str());
+      return VALUE_FLOAT;
+    }
+    yylval->sv_int = std::atoi(s.substr(b, p - b).c_str());
+    return VALUE_INT;
+  }
+  if (c == '\'') {
+    auto e = s.find('\'', p + 1);
+    yylval->sv_str = s.substr(p + 1, e - p - 1);
+    p = e + 1;
+    return VALUE_STRING;
+  }
+  if (p + 1 < s.size()) {
+    auto two = s.substr(p, 2);
+    if (two == ">=") { p += 2; return GEQ; }
+    if (two == "<=") { p += 2; return LEQ; }
+    if (two == "<>" || two == "!=") { p += 2; return NEQ; }
+  }
+  p++;
+  return c;
+}
+
+YY_BUFFER_STATE yy_scan_string(const char *str) { cur_buf = new yy_buffer_state{str, 0}; return cur_buf; }
+void yy_delete_buffer(YY_BUFFER_STATE b) { if (cur_buf == b) cur_buf = nullptr; delete b; }
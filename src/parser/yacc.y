@@ -32,8 +32,10 @@ using namespace ast;
 %define parse.error verbose
 
 // keywords
-%token EXPLAIN SHOW TABLES CREATE TABLE DROP DESC INSERT INTO VALUES DELETE FROM OPEN DATABASE ON ASC AS ORDER GROUP BY SUM AVG MAX MIN COUNT IN STATIC_CHECKPOINT USING NESTED_LOOP_JOIN SORT_MERGE_JOIN
+%token EXPLAIN SHOW TABLES CREATE TABLE DROP DESC INSERT INTO VALUES DELETE FROM OPEN DATABASE ON ASC AS ORDER GROUP BY SUM AVG MAX MIN COUNT IN STATIC_CHECKPOINT USING NESTED_LOOP_JOIN SORT_MERGE_JOIN HASH_JOIN
 WHERE HAVING UPDATE SET SELECT INT CHAR FLOAT BOOL INDEX AND JOIN INNER OUTER EXIT HELP TXN_BEGIN TXN_COMMIT TXN_ABORT TXN_ROLLBACK ORDER_BY ENABLE_NESTLOOP ENABLE_SORTMERGE STORAGE PAX NARY LIMIT
+// keywords that are identifiers as well
+%token <sv_str> INDEX_BPTREE INDEX_HASH INDEX_ART INCLUDE
 // non-keywords
 %token LEQ NEQ GEQ T_EOF
 
@@ -51,12 +53,13 @@ WHERE HAVING UPDATE SET SELECT INT CHAR FLOAT BOOL INDEX AND JOIN INNER OUTER EX
 %type <sv_type_len> type
 %type <sv_comp_op> op
 %type <sv_storage_model> optStorageModel
+%type <sv_index_type> optIndexType
 %type <sv_int> optLimit
 %type <sv_expr> expr
 %type <sv_val> value
 %type <sv_vals> valueList
-%type <sv_str> tbName colName optAlias
-%type <sv_strs> colNameList
+%type <sv_str> tbName colName optAlias ident
+%type <sv_strs> colNameList optInclude
 %type <sv_node_arr> tableList
 %type <sv_col> col aggCol
 %type <sv_cols> colList selector colListWithoutAlias
@@ -168,9 +171,9 @@ ddl:
     {
         $$ = std::make_shared<DescTable>($2);
     }
-    |   CREATE INDEX tbName '(' colNameList ')'
+    |   CREATE INDEX tbName '(' colNameList ')' optInclude optIndexType
     {
-        $$ = std::make_shared<CreateIndex>($3, $5);
+        $$ = std::make_shared<CreateIndex>($3, $5, $7, $8);
     }
     |   DROP INDEX tbName '(' colNameList ')'
     {
@@ -186,6 +189,22 @@ optStorageModel:
     { $$ = PAX_MODEL; }
     ;
 
+optInclude:
+    /* epsilon */ { $$ = std::vector<std::string>{}; }
+    | INCLUDE '(' colNameList ')'
+    { $$ = $3; }
+    ;
+
+optIndexType:
+    /* epsilon */ { $$ = IndexType::BPTREE; }
+    | USING INDEX_BPTREE
+    { $$ = IndexType::BPTREE; }
+    | USING INDEX_HASH
+    { $$ = IndexType::HASH; }
+    | USING INDEX_ART
+    { $$ = IndexType::ART; }
+    ;
+
 dml:
         INSERT INTO tbName VALUES '(' valueList ')'
     {
@@ -350,11 +369,13 @@ optWhereClause:
     ;
 
 optUsingJoinClause:
-    /* epsilon */ {$$ = NESTED_LOOP;}
+    /* epsilon */ {$$ = std::nullopt;}
     |   USING NESTED_LOOP_JOIN
     {   $$ = NESTED_LOOP;  }
     |   USING SORT_MERGE_JOIN
     {   $$ = SORT_MERGE;}
+    |   USING HASH_JOIN
+    {   $$ = HASH;}
 
 conditionAgg:
         aggCol op value
@@ -591,7 +612,16 @@ opt_asc_desc:
     |               { $$ = OrderBy_ASC; }
     ;
 
-tbName: IDENTIFIER;
+tbName: ident;
+
+colName: ident;
 
-colName: IDENTIFIER;
+// the keywords of CREATE INDEX are not reserved, tables and columns may be named by them
+ident:
+        IDENTIFIER
+    |   INDEX_BPTREE
+    |   INDEX_HASH
+    |   INDEX_ART
+    |   INCLUDE
+    ;
 %%
@@ -25,6 +25,8 @@
 
 #include "system/handle/record_handle.h"
 #include "common/condition.h"
+#include "storage/index/index_abstract.h"
+#include "expr/join_filter.h"
 
 #define TAB_STR(level) std::string(2 * level, ' ')
 
@@ -113,6 +115,50 @@ class ShowTablesPlan : public AbstractPlan
   auto ToString(int level) const -> std::string override { return fmt::format("{}ShowTablesPlan", TAB_STR(level)); }
 };
 
+class CreateIndexPlan : public AbstractPlan
+{
+public:
+  CreateIndexPlan(
+      std::string table_name, RecordSchemaUptr key_schema, IndexType index_type, RecordSchemaUptr include_schema)
+      : table_name_(std::move(table_name)),
+        key_schema_(std::move(key_schema)),
+        index_type_(index_type),
+        include_schema_(std::move(include_schema))
+  {}
+
+  auto ToString(int level) const -> std::string override
+  {
+    auto include_str = include_schema_ == nullptr ? "" : fmt::format(" <include: {}>", include_schema_->ToString());
+    return fmt::format("{}CreateIndexPlan [{}] <{}>{} <{}>",
+        TAB_STR(level),
+        table_name_,
+        key_schema_->ToString(),
+        include_str,
+        IndexTypeToString(index_type_));
+  }
+
+  std::string      table_name_;
+  RecordSchemaUptr key_schema_;
+  IndexType        index_type_;
+  RecordSchemaUptr include_schema_;  // nullptr if the index has no included columns
+};
+
+class DropIndexPlan : public AbstractPlan
+{
+public:
+  DropIndexPlan(std::string table_name, std::string index_name)
+      : table_name_(std::move(table_name)), index_name_(std::move(index_name))
+  {}
+
+  auto ToString(int level) const -> std::string override
+  {
+    return fmt::format("{}DropIndexPlan [{}] <{}>", TAB_STR(level), table_name_, index_name_);
+  }
+
+  std::string table_name_;
+  std::string index_name_;
+};
+
 class InsertPlan : public AbstractPlan
 {
 public:
@@ -195,16 +241,56 @@ public:
   explicit ScanPlan(std::string table_name) : table_name_(std::move(table_name)) {}
   auto ToString(int level) const -> std::string override
   {
-    return fmt::format("{}ScanPlan [{}]", TAB_STR(level), table_name_);
+    std::string extra_str;
+    if (!fields_.empty()) {
+      extra_str += " <fields: " + fields_.front().ToString();
+      for (size_t i = 1; i < fields_.size(); i++) {
+        extra_str += ", " + fields_[i].ToString();
+      }
+      extra_str += ">";
+    }
+    if (!conds_.empty()) {
+      extra_str += " <conds: " + conds_.front().ToString();
+      for (size_t i = 1; i < conds_.size(); i++) {
+        extra_str += " AND " + conds_[i].ToString();
+      }
+      extra_str += ">";
+    }
+    if (join_filter_ != nullptr) {
+      extra_str += " <join filter: " + join_filter_->GetKeySchema()->ToString() + ">";
+    }
+    return fmt::format("{}ScanPlan [{}]{}", TAB_STR(level), table_name_, extra_str);
   }
   std::string table_name_;
+  // below is filled by the optimizer when predicates and projections are pushed down to the scan
+  // fields_ is a subset of the table schema in table order, empty means all columns
+  ConditionVec         conds_;
+  std::vector<RTField> fields_;
+  // filter of the keys of the hash join reading this scan as its probe side, shared with the JoinPlan
+  JoinFilterSptr join_filter_;
+};
+
+class GatherPlan : public AbstractPlan
+{
+public:
+  GatherPlan(std::shared_ptr<ScanPlan> child, size_t worker_num) : child_(std::move(child)), worker_num_(worker_num) {}
+  auto ToString(int level) const -> std::string override
+  {
+    return fmt::format("{}GatherPlan <workers: {}>\n{}", TAB_STR(level), worker_num_, child_->ToString(level + 1));
+  }
+  std::shared_ptr<ScanPlan> child_;
+  size_t                    worker_num_;
 };
 
 class IdxScanPlan : public AbstractPlan
 {
 public:
   IdxScanPlan(std::string table_name, idx_id_t idxId, ConditionVec conds, int matched_fields)
-      : table_name_(std::move(table_name)), idx_id_(idxId), conds_(std::move(conds)), matched_fields_(matched_fields)
+      : table_name_(std::move(table_name)),
+        idx_id_(idxId),
+        conds_(std::move(conds)),
+        matched_fields_(matched_fields),
+        index_only_(false)
   {}
   auto ToString(int level) const -> std::string override
   {
@@ -215,27 +301,54 @@ public:
         cond_str += " AND " + conds_[i].ToString();
       }
     }
-    return fmt::format("{}IdxScanPlan [{}] <{}>", TAB_STR(level), table_name_, cond_str);
+    auto index_only_str = index_only_ ? " <index only>" : "";
+    return fmt::format("{}IdxScanPlan [{}] <{}>{}", TAB_STR(level), table_name_, cond_str, index_only_str);
   }
   std::string  table_name_;
   idx_id_t     idx_id_;
   ConditionVec conds_;
   int          matched_fields_;
+  // set by the optimizer if the index stores all the columns required by the parent plans, then the records are
+  // built from the index entries, with the key and included columns only, and the table is not read
+  bool index_only_;
 };
 
 class SortPlan : public AbstractPlan
 {
 public:
   SortPlan(std::shared_ptr<AbstractPlan> child, RecordSchemaUptr key_schema, bool is_desc)
-      : child_(std::move(child)), key_schema_(std::move(key_schema)), is_desc_(is_desc)
+      : child_(std::move(child)), key_schema_(std::move(key_schema)), is_desc_(is_desc), worker_num_(1)
   {}
   auto ToString(int level) const -> std::string override
   {
-    return fmt::format("{}SortPlan <{}>\n{}", TAB_STR(level), key_schema_->ToString(), child_->ToString(level + 1));
+    auto workers = worker_num_ > 1 ? fmt::format(" <workers: {}>", worker_num_) : "";
+    return fmt::format(
+        "{}SortPlan <{}>{}\n{}", TAB_STR(level), key_schema_->ToString(), workers, child_->ToString(level + 1));
   }
   std::shared_ptr<AbstractPlan> child_;
   RecordSchemaUptr              key_schema_;
   bool                          is_desc_;
+  size_t                        worker_num_;  // number of workers sorting and merging in parallel
+};
+
+class TopNPlan : public AbstractPlan
+{
+public:
+  TopNPlan(std::shared_ptr<AbstractPlan> child, RecordSchemaUptr key_schema, bool is_desc, size_t limit)
+      : child_(std::move(child)), key_schema_(std::move(key_schema)), is_desc_(is_desc), limit_(limit)
+  {}
+  auto ToString(int level) const -> std::string override
+  {
+    return fmt::format("{}TopNPlan <{}> <limit to {}>\n{}",
+        TAB_STR(level),
+        key_schema_->ToString(),
+        limit_,
+        child_->ToString(level + 1));
+  }
+  std::shared_ptr<AbstractPlan> child_;
+  RecordSchemaUptr              key_schema_;
+  bool                          is_desc_;
+  size_t                        limit_;
 };
 
 class ProjectPlan : public AbstractPlan
@@ -256,8 +369,13 @@ class JoinPlan : public AbstractPlan
 {
 public:
   JoinPlan(std::shared_ptr<AbstractPlan> left, std::shared_ptr<AbstractPlan> right, ConditionVec &conds, JoinType type,
-      JoinStrategy strategy)
-      : left_(std::move(left)), right_(std::move(right)), conds_(std::move(conds)), type_(type), strategy_(strategy)
+      JoinStrategy strategy, bool is_user_strategy)
+      : left_(std::move(left)),
+        right_(std::move(right)),
+        conds_(std::move(conds)),
+        type_(type),
+        strategy_(strategy),
+        is_user_strategy_(is_user_strategy)
   {}
   auto ToString(int level) const -> std::string override
   {
@@ -268,11 +386,21 @@ public:
         cond_str += " AND " + conds_[i].ToString();
       }
     }
-    return fmt::format("{}JoinPlan <conds: {}, type: {}, strategy: {}>\n{}\n{}",
+    std::string extra_str;
+    if (strategy_ == HASH) {
+      extra_str = fmt::format(", build: {}", build_left_ ? "left" : "right");
+      if (worker_num_ > 1) {
+        extra_str += fmt::format(", workers: {}", worker_num_);
+      }
+    } else if (strategy_ == INDEX_NESTED_LOOP) {
+      extra_str = fmt::format(", index: {}", right_key_schema_->ToString());
+    }
+    return fmt::format("{}JoinPlan <conds: {}, type: {}, strategy: {}{}>\n{}\n{}",
         TAB_STR(level),
         cond_str,
         JoinTypeToString(type_),
         JoinStrategyToString(strategy_),
+        extra_str,
         left_->ToString(level + 1),
         right_->ToString(level + 1));
   }
@@ -281,9 +409,20 @@ public:
   ConditionVec                  conds_;
   JoinType                      type_;
   JoinStrategy                  strategy_;
-  // below is available when strategy == SortMerge
+  // the strategy is chosen by USING in the query, otherwise it is the default one the optimizer may replace
+  bool is_user_strategy_;
+  // below is available when strategy == SortMerge or Hash
   RecordSchemaUptr left_key_schema_;
   RecordSchemaUptr right_key_schema_;
+  // below is available when strategy == Hash, the hash table is built on the smaller input
+  bool build_left_{false};
+  // number of workers building and probing the radix partitions of the hash table in parallel
+  size_t worker_num_{1};
+  // filter of the build keys pushed down into the scan of the probe side
+  JoinFilterSptr join_filter_;
+  // below is available when strategy == IndexNestedLoop, the right input is a scan of a table with the index, which is
+  // probed by the left_key_schema_ fields of each left record, the right_key_schema_ fields are the matched index key
+  idx_id_t index_id_{INVALID_IDX_ID};
 };
 
 class AggregatePlan : public AbstractPlan
@@ -314,12 +453,18 @@ public:
       agg_fields_str.pop_back();
       agg_fields_str.pop_back();
     }
-    return fmt::format(
-        "{}AggregatePlan <{}> <{}>\n{}", TAB_STR(level), group_fields_str, agg_fields_str, child_->ToString(level + 1));
+    std::string workers_str = worker_num_ > 1 ? fmt::format(" <workers: {}>", worker_num_) : "";
+    return fmt::format("{}AggregatePlan <{}> <{}>{}\n{}",
+        TAB_STR(level),
+        group_fields_str,
+        agg_fields_str,
+        workers_str,
+        child_->ToString(level + 1));
   }
   std::shared_ptr<AbstractPlan> child_;
   std::vector<RTField>          group_fields_;
   std::vector<RTField>          agg_fields;
+  size_t                        worker_num_{1};  // workers aggregating the morsels of the child scan in parallel
 };
 
 class LimitPlan : public AbstractPlan
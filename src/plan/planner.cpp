@@ -101,9 +101,14 @@ std::shared_ptr<AbstractPlan> Planner::PlanAST(const std::shared_ptr<ast::TreeNo
   }
   /// index related
   if (const auto cidx = std::dynamic_pointer_cast<ast::CreateIndex>(ast)) {
-
+    auto key_schema     = MakeIndexKeySchema(cidx->tab_name_, cidx->col_names_, db);
+    auto include_schema = MakeIndexIncludeSchema(cidx->tab_name_, cidx->include_names_, *key_schema, db);
+    return std::make_shared<CreateIndexPlan>(
+        cidx->tab_name_, std::move(key_schema), cidx->index_type_, std::move(include_schema));
   } else if (const auto didx = std::dynamic_pointer_cast<ast::DropIndex>(ast)) {
-
+    auto key_schema = MakeIndexKeySchema(didx->tab_name_, didx->col_names_, db);
+    auto index_name = DatabaseHandle::MakeIndexName(didx->tab_name_, *key_schema);
+    return std::make_shared<DropIndexPlan>(didx->tab_name_, std::move(index_name));
   } else if (const auto sidx = std::dynamic_pointer_cast<ast::ShowIndexes>(ast)) {
   }
   /// transaction related
@@ -210,7 +215,7 @@ auto Planner::AnalyseSelect(const std::shared_ptr<ast::SelectStmt> &sel, wsdb::D
       std::shared_ptr<AbstractPlan> left_plan  = MakeFilterScanPlan(join_expr->left, left_cond);
       std::shared_ptr<AbstractPlan> right_plan = MakeFilterScanPlan(join_expr->right, right_cond);
       std::shared_ptr<AbstractPlan> sum_plan   = std::make_shared<JoinPlan>(
-          std::move(left_plan), std::move(right_plan), join_cond, join_expr->type, sel->join_strategy);
+          std::move(left_plan), std::move(right_plan), join_cond, join_expr->type, sel->join_strategy, sel->has_join_strategy);
       if (is_agg) {
         sum_plan = MakeAggregatePlan(sum_plan, group_fields, sel_fields, having);
       }
@@ -235,7 +240,7 @@ auto Planner::AnalyseSelect(const std::shared_ptr<ast::SelectStmt> &sel, wsdb::D
         auto left_cond = GetConditionsForTable(left_tab_name, where, db);
         auto left_plan = MakeFilterScanPlan(left_tab_name, left_cond);
         right_plan     = std::make_shared<JoinPlan>(
-            std::move(left_plan), std::move(right_plan), join_cond, INNER_JOIN, sel->join_strategy);
+            std::move(left_plan), std::move(right_plan), join_cond, INNER_JOIN, sel->join_strategy, sel->has_join_strategy);
         join_tabs.pop_back();
         right_tree_tables.push_back(left_tab_name);
       }
@@ -354,6 +359,49 @@ auto Planner::CreateRecordSchema(const std::vector<std::shared_ptr<ast::Field>>
   return std::make_unique<RecordSchema>(rt_fields);
 }
 
+auto Planner::MakeIndexKeySchema(
+    const std::string &tab_name, const std::vector<std::string> &col_names, DatabaseHandle *db) -> RecordSchemaUptr
+{
+  std::vector<RTField> key_fields;
+  key_fields.reserve(col_names.size());
+  for (const auto &col_name : col_names) {
+    auto name = tab_name;
+    CheckFieldTabName(name, col_name, db, {tab_name});
+    auto  tbl   = db->GetTable(tab_name);
+    auto &field = tbl->GetSchema().GetFieldByName(tbl->GetTableId(), col_name);
+    if (std::find(key_fields.begin(), key_fields.end(), field) != key_fields.end()) {
+      WSDB_THROW(WSDB_GRAMMAR_ERROR, fmt::format("Duplicate key field: {}", col_name));
+    }
+    key_fields.push_back(field);
+  }
+  if (key_fields.empty()) {
+    WSDB_THROW(WSDB_GRAMMAR_ERROR, "Index key cannot be empty");
+  }
+  return std::make_unique<RecordSchema>(key_fields);
+}
+
+auto Planner::MakeIndexIncludeSchema(const std::string &tab_name, const std::vector<std::string> &col_names,
+    const RecordSchema &key_schema, DatabaseHandle *db) -> RecordSchemaUptr
+{
+  if (col_names.empty()) {
+    return nullptr;
+  }
+  std::vector<RTField> include_fields;
+  include_fields.reserve(col_names.size());
+  for (const auto &col_name : col_names) {
+    auto name = tab_name;
+    CheckFieldTabName(name, col_name, db, {tab_name});
+    auto  tbl   = db->GetTable(tab_name);
+    auto &field = tbl->GetSchema().GetFieldByName(tbl->GetTableId(), col_name);
+    if (std::find(include_fields.begin(), include_fields.end(), field) != include_fields.end() ||
+        key_schema.GetRTFieldIndex(field) < key_schema.GetFieldCount()) {
+      WSDB_THROW(WSDB_GRAMMAR_ERROR, fmt::format("Duplicate index field: {}", col_name));
+    }
+    include_fields.push_back(field);
+  }
+  return std::make_unique<RecordSchema>(include_fields);
+}
+
 void Planner::CheckFieldTabName(
     std::string &tab_name, const std::string &field_name, DatabaseHandle *db, const std::vector<std::string> &cand_tabs)
 {
@@ -418,15 +466,18 @@ auto Planner::GetConditionsForJoin(
     const std::string &left, const std::string &right, ConditionVec &conds, DatabaseHandle *db) -> ConditionVec
 {
   ConditionVec ret;
+  auto         left_id  = db->GetTable(left)->GetTableId();
+  auto         right_id = db->GetTable(right)->GetTableId();
   // move the condition of the join to ret, should check if the rhs is column
   for (const auto &c : conds) {
-    if (c.GetLCol().field_.table_id_ == db->GetTable(left)->GetTableId()) {
-      if (c.GetRhsType() == kColumn) {
-        if (c.GetRCol().field_.table_id_ == db->GetTable(right)->GetTableId() &&
-            c.GetLCol().field_.table_id_ != c.GetRCol().field_.table_id_) {
-          ret.push_back(c);
-        }
-      }
+    if (c.GetRhsType() != kColumn || left_id == right_id) {
+      continue;
+    }
+    if (c.GetLCol().field_.table_id_ == left_id && c.GetRCol().field_.table_id_ == right_id) {
+      ret.push_back(c);
+    } else if (c.GetLCol().field_.table_id_ == right_id && c.GetRCol().field_.table_id_ == left_id) {
+      // the join reads the left column from the left input, e.g. t2.k = t1.k joining t1 and t2 becomes t1.k = t2.k
+      ret.push_back(c.Swap());
     }
   }
   return ret;
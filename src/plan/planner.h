@@ -56,6 +56,14 @@ private:
   static auto CreateRecordSchema(const std::vector<std::shared_ptr<ast::Field>> &fields, std::string &tab_name,
       DatabaseHandle *db) -> RecordSchemaUptr;
 
+  /// make key schema of an index from the key column names of the table
+  static auto MakeIndexKeySchema(
+      const std::string &tab_name, const std::vector<std::string> &col_names, DatabaseHandle *db) -> RecordSchemaUptr;
+
+  /// make the schema of the columns stored in the entries of an index besides the key, nullptr if there is none
+  static auto MakeIndexIncludeSchema(const std::string &tab_name, const std::vector<std::string> &col_names,
+      const RecordSchema &key_schema, DatabaseHandle *db) -> RecordSchemaUptr;
+
   /// check if the table has the specific field, if tab_name is empty string, fulfill tab_name by checking all tables in
   /// the database
   static void CheckFieldTabName(std::string &tab_name, const std::string &field_name, DatabaseHandle *db,
@@ -68,7 +76,7 @@ private:
   static auto AnalyseSelect(const std::shared_ptr<ast::SelectStmt> &stmt, DatabaseHandle *db,
       std::vector<std::string> &tabs) -> std::shared_ptr<AbstractPlan>;
 
-  /// Get join conditions from where clause
+  /// Get join conditions from where clause, conditions reading the right table on the left are swapped
   static auto GetConditionsForJoin(
       const std::string &left, const std::string &right, ConditionVec &conds, DatabaseHandle *db) -> ConditionVec;
 
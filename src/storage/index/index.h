@@ -22,6 +22,7 @@
 #ifndef WSDB_INDEX_H
 #define WSDB_INDEX_H
 
+#include "index_art.h"
 #include "index_bp_tree.h"
 #include "index_hash.h"
 
@@ -22,17 +22,19 @@
 #ifndef WSDB_INDEX_ABSTRACT_H
 #define WSDB_INDEX_ABSTRACT_H
 
+#include <functional>
 #include "storage/buffer/buffer_pool_manager.h"
 #include "storage/disk/disk_manager.h"
 #include "system/handle/record_handle.h"
 
 namespace wsdb {
 
-enum class IndexType
+/// @brief one side of the key range of an index scan
+struct IndexBound
 {
-  NONE,
-  BPTREE,
-  HASH,
+  const Record *key_{nullptr};     // record of the key schema, nullptr if the range is not bounded on this side
+  size_t        cmp_field_num_{0};  // only the first cmp_field_num fields of the key are compared
+  bool          inclusive_{true};
 };
 
 class Index
@@ -41,28 +43,83 @@ public:
   Index() = delete;
 
   Index(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, IndexType index_type, idx_id_t index_id,
-      RecordSchema *key_schema)
+      RecordSchema *key_schema, RecordSchema *include_schema)
       : disk_manager_(disk_manager),
         buffer_pool_manager_(buffer_pool_manager),
         index_type_(index_type),
         index_id_(index_id),
-        key_schema_(key_schema)
+        key_schema_(key_schema),
+        include_schema_(include_schema)
   {}
 
   virtual ~Index() = default;
 
-  virtual void Insert(const Record &key, const RID &rid) = 0;
+  /**
+   * @param key record of the key schema
+   * @param rid
+   * @param include record of the include schema stored with the entry, nullptr if the index has no included fields
+   */
+  virtual void Insert(const Record &key, const RID &rid, const Record *include = nullptr) = 0;
 
   virtual void Delete(const Record &key, const RID &rid) = 0;
 
+  /**
+   * find the records whose keys match the first cmp_field_num fields of the given key
+   * @param key record of the key schema, fields after the first cmp_field_num ones are ignored
+   * @param cmp_field_num
+   * @return rids of the matched records
+   */
+  virtual auto Search(const Record &key, size_t cmp_field_num) -> std::vector<RID> = 0;
+
+  /**
+   * find the records whose keys are in the range between low and high
+   * @param low
+   * @param high
+   * @return rids of the matched records in key order
+   */
+  virtual auto SearchRange(const IndexBound &low, const IndexBound &high) -> std::vector<RID> = 0;
+
+  /**
+   * find the entries whose keys are in the range between low and high, and build records from their keys and
+   * included fields, so that a query reading only these fields does not access the table
+   * @param low
+   * @param high
+   * @param schema the key fields followed by the included fields
+   * @return records of the schema in key order, with the rids of the table records
+   */
+  virtual auto SearchRangeRecords([[maybe_unused]] const IndexBound &low, [[maybe_unused]] const IndexBound &high,
+      [[maybe_unused]] const RecordSchema *schema) -> std::vector<RecordUptr>
+  {
+    WSDB_THROW(WSDB_NOT_IMPLEMENTED, fmt::format("{} index does not store records", IndexTypeToString(index_type_)));
+  }
+
+  /**
+   * fill an empty index with the records of its table, the records are inserted one by one by default
+   * @param next returns the next record of the table, in the order of the key if the index is ordered, or nullptr if
+   * no record is left
+   * @param fill_factor fraction of the capacity of the pages filled, for the indexes packing their pages
+   */
+  virtual void BulkLoad(const std::function<RecordUptr()> &next, [[maybe_unused]] double fill_factor)
+  {
+    for (auto record = next(); record != nullptr; record = next()) {
+      if (include_schema_ == nullptr) {
+        Insert(Record(key_schema_, *record), record->GetRID());
+      } else {
+        Record include(include_schema_, *record);
+        Insert(Record(key_schema_, *record), record->GetRID(), &include);
+      }
+    }
+  }
+
   [[nodiscard]] auto GetIndexType() const -> IndexType { return index_type_; }
 
-private:
+protected:
   DiskManager       *disk_manager_;
   BufferPoolManager *buffer_pool_manager_;
   IndexType          index_type_;
   idx_id_t           index_id_;
   RecordSchema      *key_schema_;
+  RecordSchema      *include_schema_;  // fields stored with the entries besides the key, nullptr if there is none
 };
 
 }  // namespace wsdb
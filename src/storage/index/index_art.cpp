@@ -0,0 +1,628 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+#include "index_art.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace wsdb {
+
+static constexpr size_t RID_SIZE = sizeof(uint32_t) * 2;
+
+static void StoreBigEndian(uint32_t value, char *dst)
+{
+  for (int i = 3; i >= 0; --i) {
+    dst[i] = static_cast<char>(value & 0xFF);
+    value >>= 8;
+  }
+}
+
+static auto LoadBigEndian(const char *src) -> uint32_t
+{
+  uint32_t value = 0;
+  for (int i = 0; i < 4; ++i) {
+    value = value << 8 | static_cast<uint8_t>(src[i]);
+  }
+  return value;
+}
+
+// the rid is encoded as in BPTreeIndex, so that the entries of equal keys are ordered by rid
+static void EncodeRID(const RID &rid, char *dst)
+{
+  StoreBigEndian(static_cast<uint32_t>(rid.PageID()) ^ 0x80000000U, dst);
+  StoreBigEndian(static_cast<uint32_t>(rid.SlotID()) ^ 0x80000000U, dst + sizeof(uint32_t));
+}
+
+static auto DecodeRID(const char *src) -> RID
+{
+  return {static_cast<page_id_t>(LoadBigEndian(src) ^ 0x80000000U),
+      static_cast<slot_id_t>(LoadBigEndian(src + sizeof(uint32_t)) ^ 0x80000000U)};
+}
+
+ARTIndex::ARTIndex(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, idx_id_t index_id,
+    RecordSchema *key_schema, RecordSchema *include_schema)
+    : Index(disk_manager, buffer_pool_manager, IndexType::ART, index_id, key_schema, include_schema),
+      key_encoder_(key_schema, key_schema, false),
+      key_size_(key_encoder_.GetKeySize()),
+      entry_key_size_(key_size_ + RID_SIZE),
+      entry_size_(entry_key_size_ + (include_schema == nullptr ? 0
+                                                               : BITMAP_SIZE(include_schema->GetFieldCount()) +
+                                                                     include_schema->GetRecordLength()))
+{}
+
+ARTIndex::~ARTIndex() { FreeNode(root_); }
+
+void ARTIndex::Insert(const Record &key, const RID &rid, const Record *include)
+{
+  WSDB_ASSERT((include == nullptr) == (include_schema_ == nullptr), "included fields mismatch the index");
+  auto leaf  = new Leaf(entry_size_);
+  auto entry = leaf->entry_.data();
+  key_encoder_.Encode(key, entry);
+  EncodeRID(rid, entry + key_size_);
+  if (include != nullptr) {
+    auto null_map_size = BITMAP_SIZE(include_schema_->GetFieldCount());
+    std::memcpy(entry + entry_key_size_, include->GetNullMap(), null_map_size);
+    std::memcpy(entry + entry_key_size_ + null_map_size, include->GetData(), include_schema_->GetRecordLength());
+  }
+  std::unique_lock lock(latch_);
+  try {
+    InsertLeaf(&root_, leaf, 0);
+  } catch (WSDBException_ &e) {
+    delete leaf;
+    throw;
+  }
+  entry_num_++;
+}
+
+void ARTIndex::Delete(const Record &key, const RID &rid)
+{
+  std::vector<char> entry_key(entry_key_size_);
+  key_encoder_.Encode(key, entry_key.data());
+  EncodeRID(rid, entry_key.data() + key_size_);
+  std::unique_lock lock(latch_);
+  if (!DeleteLeaf(&root_, reinterpret_cast<const uint8_t *>(entry_key.data()), 0)) {
+    WSDB_THROW(WSDB_RECORD_MISS, fmt::format("rid ({}, {})", rid.PageID(), rid.SlotID()));
+  }
+  entry_num_--;
+}
+
+auto ARTIndex::Search(const Record &key, size_t cmp_field_num) -> std::vector<RID>
+{
+  IndexBound bound{.key_ = &key, .cmp_field_num_ = cmp_field_num, .inclusive_ = true};
+  return SearchRange(bound, bound);
+}
+
+auto ARTIndex::SearchRange(const IndexBound &low, const IndexBound &high) -> std::vector<RID>
+{
+  std::vector<RID> rids;
+  ScanRange(low, high, [this, &rids](const char *entry) { rids.push_back(DecodeRID(entry + key_size_)); });
+  return rids;
+}
+
+auto ARTIndex::SearchRangeRecords(const IndexBound &low, const IndexBound &high, const RecordSchema *schema)
+    -> std::vector<RecordUptr>
+{
+  auto key_field_num     = key_schema_->GetFieldCount();
+  auto key_length        = key_schema_->GetRecordLength();
+  auto include_field_num = include_schema_ == nullptr ? 0 : include_schema_->GetFieldCount();
+  auto include_length    = include_schema_ == nullptr ? 0 : include_schema_->GetRecordLength();
+  WSDB_ASSERT(schema->GetFieldCount() == key_field_num + include_field_num &&
+                  schema->GetRecordLength() == key_length + include_length,
+      "schema of the records mismatches the index entries");
+  std::vector<RecordUptr> records;
+  std::vector<char>       null_map(BITMAP_SIZE(schema->GetFieldCount()));
+  std::vector<char>       data(schema->GetRecordLength());
+  ScanRange(low, high, [&](const char *entry) {
+    key_encoder_.Decode(entry, null_map.data(), data.data());
+    auto include_null_map = entry + entry_key_size_;
+    std::memcpy(data.data() + key_length, include_null_map + BITMAP_SIZE(include_field_num), include_length);
+    for (size_t i = 0; i < include_field_num; ++i) {
+      BitMap::SetBit(null_map.data(), key_field_num + i, BitMap::GetBit(include_null_map, i));
+    }
+    records.push_back(std::make_unique<Record>(schema, null_map.data(), data.data(), DecodeRID(entry + key_size_)));
+  });
+  return records;
+}
+
+auto ARTIndex::MakeBound(const IndexBound &bound) const -> KeyBound
+{
+  KeyBound key_bound;
+  key_bound.key_.resize(key_size_);
+  if (bound.key_ != nullptr) {
+    key_encoder_.Encode(*bound.key_, reinterpret_cast<char *>(key_bound.key_.data()));
+    key_bound.len_       = GetPrefixLength(bound.cmp_field_num_);
+    key_bound.inclusive_ = bound.inclusive_;
+  }
+  return key_bound;
+}
+
+auto ARTIndex::GetPrefixLength(size_t cmp_field_num) const -> size_t
+{
+  size_t len = 0;
+  for (size_t i = 0; i < std::min(cmp_field_num, key_schema_->GetFieldCount()); ++i) {
+    len += 1 + key_schema_->GetFieldAt(i).field_.field_size_;
+  }
+  return len;
+}
+
+void ARTIndex::ScanRange(
+    const IndexBound &low, const IndexBound &high, const std::function<void(const char *)> &collect)
+{
+  // the normalized key of the first cmp_field_num fields is a prefix of the normalized key
+  auto             low_bound  = MakeBound(low);
+  auto             high_bound = MakeBound(high);
+  std::shared_lock lock(latch_);
+  if (root_ != nullptr) {
+    ScanNode(root_, 0, low_bound, high_bound, low_bound.len_ > 0, high_bound.len_ > 0, collect);
+  }
+}
+
+void ARTIndex::ScanNode(const Node *node, size_t depth, const KeyBound &low, const KeyBound &high, bool low_tight,
+    bool high_tight, const std::function<void(const char *)> &collect) const
+{
+  if (node->type_ == NodeType::LEAF) {
+    auto leaf = static_cast<const Leaf *>(node);
+    if (InBound(leaf->GetKey(), low, high)) {
+      collect(leaf->entry_.data());
+    }
+    return;
+  }
+  // compare the byte of the path at pos with the bounds the path is equal to so far, false if the keys below the byte
+  // are out of the bounds
+  auto step = [&low, &high](uint8_t byte, size_t pos, bool &lt, bool &ht) {
+    if (lt) {
+      if (pos >= low.len_) {
+        if (!low.inclusive_) {
+          return false;
+        }
+        lt = false;
+      } else if (byte != low.key_[pos]) {
+        if (byte < low.key_[pos]) {
+          return false;
+        }
+        lt = false;
+      }
+    }
+    if (ht) {
+      if (pos >= high.len_) {
+        if (!high.inclusive_) {
+          return false;
+        }
+        ht = false;
+      } else if (byte != high.key_[pos]) {
+        if (byte > high.key_[pos]) {
+          return false;
+        }
+        ht = false;
+      }
+    }
+    return true;
+  };
+  if ((low_tight || high_tight) && node->prefix_size_ > 0) {
+    auto prefix = node->prefix_size_ > MAX_PREFIX_SIZE ? MinLeaf(node)->GetKey() + depth : node->prefix_;
+    for (size_t i = 0; i < node->prefix_size_ && (low_tight || high_tight); ++i) {
+      if (!step(prefix[i], depth + i, low_tight, high_tight)) {
+        return;
+      }
+    }
+  }
+  depth += node->prefix_size_;
+  ForEachChild(node, [&](uint8_t byte, const Node *child) {
+    auto lt = low_tight;
+    auto ht = high_tight;
+    if (step(byte, depth, lt, ht)) {
+      ScanNode(child, depth + 1, low, high, lt, ht, collect);
+    }
+    // the children after a byte above the high bound are above it as well
+    return !high_tight || depth >= high.len_ || byte <= high.key_[depth];
+  });
+}
+
+auto ARTIndex::InBound(const uint8_t *key, const KeyBound &low, const KeyBound &high) const -> bool
+{
+  auto cmp = std::memcmp(key, low.key_.data(), low.len_);
+  if (cmp < 0 || (cmp == 0 && !low.inclusive_)) {
+    return false;
+  }
+  cmp = std::memcmp(key, high.key_.data(), high.len_);
+  return cmp < 0 || (cmp == 0 && high.inclusive_);
+}
+
+auto ARTIndex::FindChild(Node *node, uint8_t byte) -> Node **
+{
+  switch (node->type_) {
+    case NodeType::NODE4: {
+      auto n = static_cast<Node4 *>(node);
+      for (size_t i = 0; i < n->child_num_; ++i) {
+        if (n->keys_[i] == byte) {
+          return &n->children_[i];
+        }
+      }
+      return nullptr;
+    }
+    case NodeType::NODE16: {
+      auto n   = static_cast<Node16 *>(node);
+      auto end = n->keys_ + n->child_num_;
+      auto it  = std::lower_bound(n->keys_, end, byte);
+      return it != end && *it == byte ? &n->children_[it - n->keys_] : nullptr;
+    }
+    case NodeType::NODE48: {
+      auto n = static_cast<Node48 *>(node);
+      return n->child_idx_[byte] == 0 ? nullptr : &n->children_[n->child_idx_[byte] - 1];
+    }
+    case NodeType::NODE256: {
+      auto n = static_cast<Node256 *>(node);
+      return n->children_[byte] == nullptr ? nullptr : &n->children_[byte];
+    }
+    default: WSDB_FETAL("leaf has no child");
+  }
+}
+
+void ARTIndex::ForEachChild(const Node *node, const std::function<bool(uint8_t, const Node *)> &visit)
+{
+  switch (node->type_) {
+    case NodeType::NODE4: {
+      auto n = static_cast<const Node4 *>(node);
+      for (size_t i = 0; i < n->child_num_ && visit(n->keys_[i], n->children_[i]); ++i) {}
+      break;
+    }
+    case NodeType::NODE16: {
+      auto n = static_cast<const Node16 *>(node);
+      for (size_t i = 0; i < n->child_num_ && visit(n->keys_[i], n->children_[i]); ++i) {}
+      break;
+    }
+    case NodeType::NODE48: {
+      auto n = static_cast<const Node48 *>(node);
+      for (size_t byte = 0; byte < 256; ++byte) {
+        if (n->child_idx_[byte] != 0 && !visit(byte, n->children_[n->child_idx_[byte] - 1])) {
+          break;
+        }
+      }
+      break;
+    }
+    case NodeType::NODE256: {
+      auto n = static_cast<const Node256 *>(node);
+      for (size_t byte = 0; byte < 256; ++byte) {
+        if (n->children_[byte] != nullptr && !visit(byte, n->children_[byte])) {
+          break;
+        }
+      }
+      break;
+    }
+    default: break;
+  }
+}
+
+void ARTIndex::CopyHeader(Node *dst, const Node *src)
+{
+  dst->child_num_   = src->child_num_;
+  dst->prefix_size_ = src->prefix_size_;
+  std::memcpy(dst->prefix_, src->prefix_, MAX_PREFIX_SIZE);
+}
+
+template <typename SortedNode>
+auto ARTIndex::InsertSorted(SortedNode *node, uint8_t byte, Node *child) -> bool
+{
+  auto capacity = sizeof(node->keys_);
+  if (node->child_num_ == capacity) {
+    return false;
+  }
+  auto num = node->child_num_;
+  auto pos = std::lower_bound(node->keys_, node->keys_ + num, byte) - node->keys_;
+  std::copy_backward(node->keys_ + pos, node->keys_ + num, node->keys_ + num + 1);
+  std::copy_backward(node->children_ + pos, node->children_ + num, node->children_ + num + 1);
+  node->keys_[pos]     = byte;
+  node->children_[pos] = child;
+  node->child_num_++;
+  return true;
+}
+
+template <typename SortedNode>
+void ARTIndex::EraseSorted(SortedNode *node, uint8_t byte)
+{
+  auto num = node->child_num_;
+  auto pos = std::find(node->keys_, node->keys_ + num, byte) - node->keys_;
+  std::copy(node->keys_ + pos + 1, node->keys_ + num, node->keys_ + pos);
+  std::copy(node->children_ + pos + 1, node->children_ + num, node->children_ + pos);
+  node->child_num_--;
+}
+
+void ARTIndex::AddChild(Node **ref, uint8_t byte, Node *child)
+{
+  switch ((*ref)->type_) {
+    case NodeType::NODE4: {
+      auto n = static_cast<Node4 *>(*ref);
+      if (InsertSorted(n, byte, child)) {
+        return;
+      }
+      auto n16 = new Node16();
+      CopyHeader(n16, n);
+      std::copy(n->keys_, n->keys_ + 4, n16->keys_);
+      std::copy(n->children_, n->children_ + 4, n16->children_);
+      delete n;
+      *ref = n16;
+      InsertSorted(n16, byte, child);
+      return;
+    }
+    case NodeType::NODE16: {
+      auto n = static_cast<Node16 *>(*ref);
+      if (InsertSorted(n, byte, child)) {
+        return;
+      }
+      auto n48 = new Node48();
+      CopyHeader(n48, n);
+      for (size_t i = 0; i < 16; ++i) {
+        n48->child_idx_[n->keys_[i]] = static_cast<uint8_t>(i + 1);
+        n48->children_[i]            = n->children_[i];
+      }
+      delete n;
+      *ref = n48;
+      AddChild(ref, byte, child);
+      return;
+    }
+    case NodeType::NODE48: {
+      auto n = static_cast<Node48 *>(*ref);
+      if (n->child_num_ < 48) {
+        // the positions of the removed children are reused
+        auto pos            = std::find(n->children_, n->children_ + 48, nullptr) - n->children_;
+        n->children_[pos]   = child;
+        n->child_idx_[byte] = static_cast<uint8_t>(pos + 1);
+        n->child_num_++;
+        return;
+      }
+      auto n256 = new Node256();
+      CopyHeader(n256, n);
+      for (size_t b = 0; b < 256; ++b) {
+        if (n->child_idx_[b] != 0) {
+          n256->children_[b] = n->children_[n->child_idx_[b] - 1];
+        }
+      }
+      delete n;
+      *ref = n256;
+      AddChild(ref, byte, child);
+      return;
+    }
+    case NodeType::NODE256: {
+      auto n             = static_cast<Node256 *>(*ref);
+      n->children_[byte] = child;
+      n->child_num_++;
+      return;
+    }
+    default: WSDB_FETAL("leaf has no child");
+  }
+}
+
+void ARTIndex::RemoveChild(Node **ref, size_t depth, uint8_t byte)
+{
+  switch ((*ref)->type_) {
+    case NodeType::NODE4: {
+      auto n = static_cast<Node4 *>(*ref);
+      EraseSorted(n, byte);
+      if (n->child_num_ == 1) {
+        // the only child takes the place of the node, with the prefix of the node and the key byte before its own
+        auto child = n->children_[0];
+        if (child->type_ != NodeType::LEAF) {
+          SetPrefix(child, MinLeaf(child)->GetKey(), depth, n->prefix_size_ + 1 + child->prefix_size_);
+        }
+        delete n;
+        *ref = child;
+      }
+      return;
+    }
+    case NodeType::NODE16: {
+      auto n = static_cast<Node16 *>(*ref);
+      EraseSorted(n, byte);
+      if (n->child_num_ == 3) {
+        auto n4 = new Node4();
+        CopyHeader(n4, n);
+        std::copy(n->keys_, n->keys_ + 3, n4->keys_);
+        std::copy(n->children_, n->children_ + 3, n4->children_);
+        delete n;
+        *ref = n4;
+      }
+      return;
+    }
+    case NodeType::NODE48: {
+      auto n                                = static_cast<Node48 *>(*ref);
+      n->children_[n->child_idx_[byte] - 1] = nullptr;
+      n->child_idx_[byte]                   = 0;
+      n->child_num_--;
+      if (n->child_num_ == 12) {
+        auto n16 = new Node16();
+        CopyHeader(n16, n);
+        size_t pos = 0;
+        for (size_t b = 0; b < 256; ++b) {
+          if (n->child_idx_[b] != 0) {
+            n16->keys_[pos]       = static_cast<uint8_t>(b);
+            n16->children_[pos++] = n->children_[n->child_idx_[b] - 1];
+          }
+        }
+        delete n;
+        *ref = n16;
+      }
+      return;
+    }
+    case NodeType::NODE256: {
+      auto n             = static_cast<Node256 *>(*ref);
+      n->children_[byte] = nullptr;
+      n->child_num_--;
+      if (n->child_num_ == 37) {
+        auto n48 = new Node48();
+        CopyHeader(n48, n);
+        size_t pos = 0;
+        for (size_t b = 0; b < 256; ++b) {
+          if (n->children_[b] != nullptr) {
+            n48->children_[pos] = n->children_[b];
+            n48->child_idx_[b]  = static_cast<uint8_t>(++pos);
+          }
+        }
+        delete n;
+        *ref = n48;
+      }
+      return;
+    }
+    default: WSDB_FETAL("leaf has no child");
+  }
+}
+
+auto ARTIndex::MinLeaf(const Node *node) -> const Leaf *
+{
+  while (node->type_ != NodeType::LEAF) {
+    ForEachChild(node, [&node](uint8_t, const Node *child) {
+      node = child;
+      return false;
+    });
+  }
+  return static_cast<const Leaf *>(node);
+}
+
+auto ARTIndex::MatchPrefix(const Node *node, const uint8_t *key, size_t depth) const -> size_t
+{
+  size_t i = 0;
+  for (; i < std::min<size_t>(node->prefix_size_, MAX_PREFIX_SIZE); ++i) {
+    if (node->prefix_[i] != key[depth + i]) {
+      return i;
+    }
+  }
+  if (node->prefix_size_ > MAX_PREFIX_SIZE) {
+    auto leaf_key = MinLeaf(node)->GetKey();
+    for (; i < node->prefix_size_; ++i) {
+      if (leaf_key[depth + i] != key[depth + i]) {
+        return i;
+      }
+    }
+  }
+  return i;
+}
+
+void ARTIndex::SetPrefix(Node *node, const uint8_t *key, size_t depth, size_t size)
+{
+  node->prefix_size_ = static_cast<uint32_t>(size);
+  std::memcpy(node->prefix_, key + depth, std::min(size, MAX_PREFIX_SIZE));
+}
+
+void ARTIndex::InsertLeaf(Node **ref, Leaf *leaf, size_t depth)
+{
+  auto key = leaf->GetKey();
+  while (true) {
+    auto node = *ref;
+    if (node == nullptr) {
+      *ref = leaf;
+      return;
+    }
+    if (node->type_ == NodeType::LEAF) {
+      // a new node holds both leaves, with the bytes they share as its prefix
+      auto other = static_cast<Leaf *>(node)->GetKey();
+      auto diff  = depth;
+      while (diff < entry_key_size_ && other[diff] == key[diff]) {
+        diff++;
+      }
+      if (diff == entry_key_size_) {
+        auto rid = DecodeRID(leaf->entry_.data() + key_size_);
+        WSDB_THROW(WSDB_RECORD_EXISTS, fmt::format("rid ({}, {})", rid.PageID(), rid.SlotID()));
+      }
+      Node *parent = new Node4();
+      SetPrefix(parent, key, depth, diff - depth);
+      AddChild(&parent, other[diff], node);
+      AddChild(&parent, key[diff], leaf);
+      *ref = parent;
+      return;
+    }
+    auto matched = MatchPrefix(node, key, depth);
+    if (matched < node->prefix_size_) {
+      // the prefix is split at the first byte that differs, the bytes after it are kept by the node
+      auto  node_key = MinLeaf(node)->GetKey();
+      Node *parent   = new Node4();
+      SetPrefix(parent, key, depth, matched);
+      AddChild(&parent, node_key[depth + matched], node);
+      AddChild(&parent, key[depth + matched], leaf);
+      SetPrefix(node, node_key, depth + matched + 1, node->prefix_size_ - matched - 1);
+      *ref = parent;
+      return;
+    }
+    depth += node->prefix_size_;
+    auto child = FindChild(node, key[depth]);
+    if (child == nullptr) {
+      AddChild(ref, key[depth], leaf);
+      return;
+    }
+    ref = child;
+    depth++;
+  }
+}
+
+auto ARTIndex::DeleteLeaf(Node **ref, const uint8_t *key, size_t depth) -> bool
+{
+  while (true) {
+    auto node = *ref;
+    if (node == nullptr) {
+      return false;
+    }
+    if (node->type_ == NodeType::LEAF) {
+      // only the root is reached as a leaf, the other leaves are removed from their parents
+      if (std::memcmp(static_cast<Leaf *>(node)->GetKey(), key, entry_key_size_) != 0) {
+        return false;
+      }
+      delete static_cast<Leaf *>(node);
+      *ref = nullptr;
+      return true;
+    }
+    if (MatchPrefix(node, key, depth) < node->prefix_size_) {
+      return false;
+    }
+    auto byte_pos = depth + node->prefix_size_;
+    auto child    = FindChild(node, key[byte_pos]);
+    if (child == nullptr) {
+      return false;
+    }
+    if ((*child)->type_ == NodeType::LEAF) {
+      if (std::memcmp(static_cast<Leaf *>(*child)->GetKey(), key, entry_key_size_) != 0) {
+        return false;
+      }
+      delete static_cast<Leaf *>(*child);
+      RemoveChild(ref, depth, key[byte_pos]);
+      return true;
+    }
+    ref   = child;
+    depth = byte_pos + 1;
+  }
+}
+
+void ARTIndex::FreeNode(Node *node)
+{
+  if (node == nullptr) {
+    return;
+  }
+  ForEachChild(node, [](uint8_t, const Node *child) {
+    FreeNode(const_cast<Node *>(child));
+    return true;
+  });
+  switch (node->type_) {
+    case NodeType::LEAF: delete static_cast<Leaf *>(node); break;
+    case NodeType::NODE4: delete static_cast<Node4 *>(node); break;
+    case NodeType::NODE16: delete static_cast<Node16 *>(node); break;
+    case NodeType::NODE48: delete static_cast<Node48 *>(node); break;
+    case NodeType::NODE256: delete static_cast<Node256 *>(node); break;
+  }
+}
+
+}  // namespace wsdb
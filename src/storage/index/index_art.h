@@ -0,0 +1,208 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+/**
+ * Adaptive radix tree index kept in memory, it is empty when opened and filled from the table by the database (see
+ * DatabaseHandle::Open)
+ */
+
+#ifndef WSDB_INDEX_ART_H
+#define WSDB_INDEX_ART_H
+
+#include <shared_mutex>
+#include "index_abstract.h"
+#include "system/handle/key_encoder.h"
+
+namespace wsdb {
+
+class ARTIndex : public Index
+{
+public:
+  ARTIndex(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, idx_id_t index_id,
+      RecordSchema *key_schema, RecordSchema *include_schema);
+
+  ~ARTIndex() override;
+
+  /**
+   * insert an entry, throw WSDB_RECORD_EXISTS if the key is already indexed with the rid
+   */
+  void Insert(const Record &key, const RID &rid, const Record *include = nullptr) override;
+
+  /**
+   * delete an entry, throw WSDB_RECORD_MISS if the key is not indexed with the rid
+   */
+  void Delete(const Record &key, const RID &rid) override;
+
+  auto Search(const Record &key, size_t cmp_field_num) -> std::vector<RID> override;
+
+  auto SearchRange(const IndexBound &low, const IndexBound &high) -> std::vector<RID> override;
+
+  auto SearchRangeRecords(const IndexBound &low, const IndexBound &high, const RecordSchema *schema)
+      -> std::vector<RecordUptr> override;
+
+  [[nodiscard]] auto GetEntryNum() const -> size_t { return entry_num_; }
+
+private:
+  static constexpr size_t MAX_PREFIX_SIZE = 8;
+
+  enum class NodeType : uint8_t
+  {
+    LEAF,
+    NODE4,
+    NODE16,
+    NODE48,
+    NODE256,
+  };
+
+  struct Node
+  {
+    explicit Node(NodeType type) : type_(type) {}
+
+    NodeType type_;
+    uint16_t child_num_{0};
+    uint32_t prefix_size_{0};
+    uint8_t  prefix_[MAX_PREFIX_SIZE]{};
+  };
+
+  struct Leaf : Node
+  {
+    explicit Leaf(size_t entry_size) : Node(NodeType::LEAF), entry_(entry_size) {}
+
+    [[nodiscard]] auto GetKey() const -> const uint8_t * { return reinterpret_cast<const uint8_t *>(entry_.data()); }
+
+    std::vector<char> entry_;
+  };
+
+  struct Node4 : Node
+  {
+    Node4() : Node(NodeType::NODE4) {}
+
+    uint8_t keys_[4]{};
+    Node   *children_[4]{};
+  };
+
+  struct Node16 : Node
+  {
+    Node16() : Node(NodeType::NODE16) {}
+
+    uint8_t keys_[16]{};
+    Node   *children_[16]{};
+  };
+
+  struct Node48 : Node
+  {
+    Node48() : Node(NodeType::NODE48) {}
+
+    uint8_t child_idx_[256]{};
+    Node   *children_[48]{};
+  };
+
+  struct Node256 : Node
+  {
+    Node256() : Node(NodeType::NODE256) {}
+
+    Node *children_[256]{};
+  };
+
+  /// one side of a range on the normalized key, only the first len_ bytes are compared
+  struct KeyBound
+  {
+    std::vector<uint8_t> key_;
+    size_t               len_{0};
+    bool                 inclusive_{true};
+  };
+
+  [[nodiscard]] auto MakeBound(const IndexBound &bound) const -> KeyBound;
+
+  [[nodiscard]] auto GetPrefixLength(size_t cmp_field_num) const -> size_t;
+
+  /**
+   * call collect with the entries whose keys are between low and high in key order
+   */
+  void ScanRange(const IndexBound &low, const IndexBound &high, const std::function<void(const char *)> &collect);
+
+  /**
+   * scan the subtree of node at depth, low_tight and high_tight tell whether the bytes of the path before depth are
+   * equal to the bound, so that the children out of the bound are skipped
+   */
+  void ScanNode(const Node *node, size_t depth, const KeyBound &low, const KeyBound &high, bool low_tight,
+      bool high_tight, const std::function<void(const char *)> &collect) const;
+
+  [[nodiscard]] auto InBound(const uint8_t *key, const KeyBound &low, const KeyBound &high) const -> bool;
+
+  /// the slot of the child of byte, nullptr if there is none
+  static auto FindChild(Node *node, uint8_t byte) -> Node **;
+
+  /**
+   * call visit with the key byte and the child of each child of node in key order, until visit returns false
+   */
+  static void ForEachChild(const Node *node, const std::function<bool(uint8_t, const Node *)> &visit);
+
+  static void CopyHeader(Node *dst, const Node *src);
+
+  /// insert the child of byte into a Node4 or Node16, false if it is full
+  template <typename SortedNode>
+  static auto InsertSorted(SortedNode *node, uint8_t byte, Node *child) -> bool;
+
+  template <typename SortedNode>
+  static void EraseSorted(SortedNode *node, uint8_t byte);
+
+  /// add the child of byte to the node in ref, which is replaced by a larger node if it is full
+  static void AddChild(Node **ref, uint8_t byte, Node *child);
+
+  /**
+   * remove the child of byte from the node in ref at depth, which is replaced by a smaller node if it holds few
+   * children, or by its only child
+   */
+  void RemoveChild(Node **ref, size_t depth, uint8_t byte);
+
+  /// the leaf of the smallest key below node, whose key holds the whole prefix of node
+  static auto MinLeaf(const Node *node) -> const Leaf *;
+
+  /**
+   * @return the number of bytes of the prefix of node at depth that match the key
+   */
+  auto MatchPrefix(const Node *node, const uint8_t *key, size_t depth) const -> size_t;
+
+  /// set the prefix of node to size bytes of key from depth
+  static void SetPrefix(Node *node, const uint8_t *key, size_t depth, size_t size);
+
+  void InsertLeaf(Node **ref, Leaf *leaf, size_t depth);
+
+  /**
+   * @return whether the entry of the key is found and deleted
+   */
+  auto DeleteLeaf(Node **ref, const uint8_t *key, size_t depth) -> bool;
+
+  static void FreeNode(Node *node);
+
+  KeyEncoder        key_encoder_;
+  size_t            key_size_;        // size of the normalized key
+  size_t            entry_key_size_;  // key and rid, which identify the entry
+  size_t            entry_size_;      // key, rid and included fields
+  Node             *root_{nullptr};
+  size_t            entry_num_{0};
+  std::shared_mutex latch_;  // shared by searches, exclusive for modifications
+};
+
+}  // namespace wsdb
+
+#endif  // WSDB_INDEX_ART_H
@@ -21,15 +21,1179 @@
 
 #include "index_bp_tree.h"
 
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
 namespace wsdb {
 
-// FIXME: BPTreeIndex initializer should include more BPTree parameters, like order, etc.
-BPTreeIndex::BPTreeIndex(
-    DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, idx_id_t index_id, RecordSchema *key_schema)
-    : Index(disk_manager, buffer_pool_manager, IndexType::BPTREE, index_id, key_schema)
+// a rid is encoded as its page id and slot id, big-endian with the sign bits flipped so that memcmp orders them
+static constexpr size_t RID_SIZE = 2 * sizeof(uint32_t);
+
+static constexpr size_t NODE_ENTRY_OFFSET = PAGE_HEADER_SIZE + sizeof(BPTreeNodeHeader);
+
+// bytes of a node for the slots, the entries and the prefix
+static constexpr size_t NODE_SIZE = PAGE_SIZE - NODE_ENTRY_OFFSET;
+
+static constexpr size_t SLOT_SIZE = sizeof(BPTreeSlot);
+
+static void StoreBigEndian(uint32_t value, char *dst)
+{
+  for (int i = 3; i >= 0; --i) {
+    dst[i] = static_cast<char>(value & 0xff);
+    value >>= 8;
+  }
+}
+
+static auto LoadBigEndian(const char *src) -> uint32_t
+{
+  uint32_t value = 0;
+  for (int i = 0; i < 4; ++i) {
+    value = value << 8 | static_cast<uint8_t>(src[i]);
+  }
+  return value;
+}
+
+/// size of the key without its trailing zeros
+static auto GetTrimmedSize(const char *key, size_t key_size) -> size_t
+{
+  while (key_size > 0 && key[key_size - 1] == 0) {
+    key_size--;
+  }
+  return key_size;
+}
+
+static auto GetCommonPrefixSize(const char *lhs, const char *rhs, size_t len) -> size_t
+{
+  return static_cast<size_t>(std::mismatch(lhs, lhs + len, rhs).first - lhs);
+}
+
+/// bytes taken by an entry with its slot in a node of the prefix, the trailing zeros of the key are left out if trim
+static auto ComputeStoredSize(const char *entry, size_t key_size, size_t entry_size, size_t prefix_size, bool trim)
+    -> size_t
+{
+  auto stored_key_size = trim ? GetTrimmedSize(entry, key_size) : key_size;
+  return SLOT_SIZE + entry_size - key_size + std::max(stored_key_size, prefix_size) - prefix_size;
+}
+
+auto BPTreeIndex::Node::GetSlot(size_t idx) const -> BPTreeSlot *
+{
+  return reinterpret_cast<BPTreeSlot *>(page_->GetData() + NODE_ENTRY_OFFSET) + idx;
+}
+
+auto BPTreeIndex::Node::GetStoredEntry(size_t idx, size_t prefix_size, size_t &key_size) const -> char *
+{
+  auto slot = GetSlot(idx);
+  key_size  = std::min<size_t>(slot->key_size_, key_size_ - prefix_size);
+  return page_->GetData() + std::min<size_t>(slot->offset_, PAGE_SIZE - (entry_size_ - key_size_) - key_size);
+}
+
+auto BPTreeIndex::Node::GetUsedSize() const -> size_t
+{
+  return GetEntryNum() * SLOT_SIZE + PAGE_SIZE - GetHeader()->entry_offset_;
+}
+
+auto BPTreeIndex::Node::GetFreeSize() const -> size_t
+{
+  return GetHeader()->entry_offset_ - NODE_ENTRY_OFFSET - GetEntryNum() * SLOT_SIZE;
+}
+
+auto BPTreeIndex::Node::GetStoredSize(const char *entry) const -> size_t
+{
+  return ComputeStoredSize(entry, key_size_, entry_size_, GetPrefixSize(), trim_keys_);
+}
+
+auto BPTreeIndex::Node::Compare(size_t idx, const char *target, size_t len) const -> int
+{
+  // the prefix size is read once, since the node may be read optimistically while it is modified
+  size_t stored_key_size;
+  auto   prefix_size = GetPrefixSize();
+  auto   stored      = GetStoredEntry(idx, prefix_size, stored_key_size);
+  auto   key_len     = std::min(len, key_size_);
+  auto   prefix_len  = std::min(prefix_size, key_len);
+  auto   cmp         = std::memcmp(page_->GetData() + PAGE_SIZE - prefix_size, target, prefix_len);
+  if (cmp != 0) {
+    return cmp;
+  }
+  auto stored_len = std::min(stored_key_size, key_len - prefix_len);
+  cmp             = std::memcmp(stored + entry_size_ - key_size_, target + prefix_len, stored_len);
+  if (cmp != 0) {
+    return cmp;
+  }
+  // the trailing zeros of the key are not greater than any byte of the target
+  for (auto i = prefix_len + stored_len; i < key_len; ++i) {
+    if (target[i] != 0) {
+      return -1;
+    }
+  }
+  return len > key_size_ ? std::memcmp(stored, target + key_size_, len - key_size_) : 0;
+}
+
+auto BPTreeIndex::Node::GetRID(size_t idx) const -> char *
+{
+  size_t stored_key_size;
+  return GetStoredEntry(idx, GetPrefixSize(), stored_key_size);
+}
+
+void BPTreeIndex::Node::ReadEntry(size_t idx, char *dst) const
+{
+  size_t stored_key_size;
+  auto   prefix_size = GetPrefixSize();
+  auto   stored      = GetStoredEntry(idx, prefix_size, stored_key_size);
+  auto   rest_size   = entry_size_ - key_size_;
+  std::memcpy(dst, page_->GetData() + PAGE_SIZE - prefix_size, prefix_size);
+  std::memcpy(dst + prefix_size, stored + rest_size, stored_key_size);
+  std::memset(dst + prefix_size + stored_key_size, 0, key_size_ - prefix_size - stored_key_size);
+  std::memcpy(dst + key_size_, stored, rest_size);
+}
+
+void BPTreeIndex::Node::InsertEntry(size_t idx, const char *entry)
+{
+  auto header      = GetHeader();
+  auto prefix_size = GetPrefixSize();
+  WSDB_ASSERT(std::memcmp(entry, page_->GetData() + PAGE_SIZE - prefix_size, prefix_size) == 0,
+      "key out of the fences of the node");
+  auto key_size         = trim_keys_ ? GetTrimmedSize(entry, key_size_) : key_size_;
+  auto stored_key_size  = std::max(key_size, prefix_size) - prefix_size;
+  auto rest_size        = entry_size_ - key_size_;
+  header->entry_offset_ = static_cast<uint16_t>(header->entry_offset_ - rest_size - stored_key_size);
+  auto stored           = page_->GetData() + header->entry_offset_;
+  std::memcpy(stored, entry + key_size_, rest_size);
+  std::memcpy(stored + rest_size, entry + prefix_size, stored_key_size);
+  auto entry_num = GetEntryNum();
+  std::memmove(GetSlot(idx + 1), GetSlot(idx), (entry_num - idx) * SLOT_SIZE);
+  *GetSlot(idx) = {header->entry_offset_, static_cast<uint16_t>(stored_key_size)};
+  SetEntryNum(entry_num + 1);
+}
+
+void BPTreeIndex::Node::RemoveEntries(size_t idx, size_t num)
+{
+  auto header    = GetHeader();
+  auto entry_num = GetEntryNum();
+  for (size_t i = 0; i < num; ++i, --entry_num) {
+    // the entries stored before the removed one are moved over it, so that the free space stays contiguous
+    auto removed = *GetSlot(idx);
+    auto size    = entry_size_ - key_size_ + removed.key_size_;
+    auto begin   = page_->GetData() + header->entry_offset_;
+    std::memmove(begin + size, begin, removed.offset_ - header->entry_offset_);
+    for (size_t j = 0; j < entry_num; ++j) {
+      if (GetSlot(j)->offset_ < removed.offset_) {
+        GetSlot(j)->offset_ = static_cast<uint16_t>(GetSlot(j)->offset_ + size);
+      }
+    }
+    header->entry_offset_ = static_cast<uint16_t>(header->entry_offset_ + size);
+    std::memmove(GetSlot(idx), GetSlot(idx + 1), (entry_num - idx - 1) * SLOT_SIZE);
+  }
+  SetEntryNum(entry_num);
+}
+
+void BPTreeIndex::Node::Reset(const char *prefix, size_t prefix_size)
+{
+  auto header           = GetHeader();
+  header->prefix_size_  = static_cast<uint16_t>(prefix_size);
+  header->entry_offset_ = static_cast<uint16_t>(PAGE_SIZE - prefix_size);
+  if (prefix_size > 0) {
+    std::memcpy(page_->GetData() + header->entry_offset_, prefix, prefix_size);
+  }
+  SetEntryNum(0);
+}
+
+BPTreeIndex::BPTreeIndex(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, idx_id_t index_id,
+    RecordSchema *key_schema, RecordSchema *include_schema, bool compress_keys)
+    : Index(disk_manager, buffer_pool_manager, IndexType::BPTREE, index_id, key_schema, include_schema),
+      key_encoder_(key_schema, key_schema, false),
+      key_size_(key_encoder_.GetKeySize()),
+      include_size_(include_schema == nullptr
+                        ? 0
+                        : BITMAP_SIZE(include_schema->GetFieldCount()) + include_schema->GetRecordLength()),
+      entry_key_size_(key_size_ + RID_SIZE),
+      leaf_entry_size_(entry_key_size_ + include_size_),
+      inner_entry_size_(entry_key_size_ + sizeof(page_id_t))
+{
+  // a split should leave at least two entries in each node, a node holds five uncompressed entries so that the entries
+  // of a full node and a new one fit in two nodes, whatever the prefixes are
+  if (NODE_SIZE / (SLOT_SIZE + std::max(leaf_entry_size_, inner_entry_size_)) < 5) {
+    WSDB_THROW(WSDB_RECLEN_ERROR, fmt::format("index entry of {} bytes", leaf_entry_size_));
+  }
+  auto page = buffer_pool_manager_->FetchPage(index_id_, FILE_HEADER_PAGE_ID);
+  std::memcpy(&header_, page->GetData() + INDEX_HEADER_SIZE, sizeof(BPTreeHeader));
+  buffer_pool_manager_->UnpinPage(index_id_, FILE_HEADER_PAGE_ID, false);
+  if (header_.page_num_ == 0) {
+    header_                = BPTreeHeader{};
+    header_.page_num_      = FILE_HEADER_PAGE_ID + 1;
+    header_.compress_keys_ = compress_keys;
+    WriteHeader();
+  }
+}
+
+void BPTreeIndex::Insert(const Record &key, const RID &rid, const Record *include)
+{
+  WSDB_ASSERT((include == nullptr) == (include_schema_ == nullptr), "included fields mismatch the index");
+  std::vector<char> entry(leaf_entry_size_);
+  key_encoder_.Encode(key, entry.data());
+  EncodeRID(rid, entry.data() + key_size_);
+  if (include != nullptr) {
+    EncodeInclude(*include, entry.data());
+  }
+  // insert into the leaf in place if the entry fits
+  while (true) {
+    std::optional<Node> leaf;
+    if (!FindLeafOptimistic(entry.data(), entry_key_size_, true, true, leaf)) {
+      std::this_thread::yield();
+      continue;
+    }
+    if (!leaf.has_value()) {
+      break;
+    }
+    auto idx = LowerBound(*leaf, 0, entry.data(), entry_key_size_);
+    if (idx < leaf->GetEntryNum() && leaf->Compare(idx, entry.data(), entry_key_size_) == 0) {
+      UnlatchLeaf(*leaf, true, false);
+      WSDB_THROW(WSDB_RECORD_EXISTS, fmt::format("rid ({}, {})", rid.PageID(), rid.SlotID()));
+    }
+    if (leaf->GetStoredSize(entry.data()) <= leaf->GetFreeSize()) {
+      leaf->InsertEntry(idx, entry.data());
+      UnlatchLeaf(*leaf, true, true);
+      return;
+    }
+    UnlatchLeaf(*leaf, true, false);
+    break;
+  }
+  std::lock_guard smo_lock(smo_latch_);
+  root_latch_.LockExclusive();
+  root_latched_ = true;
+  if (header_.root_page_ == INVALID_PAGE_ID) {
+    auto root = NewNode(0);
+    root.InsertEntry(0, entry.data());
+    header_.root_page_ = root.GetPageId();
+    header_.height_    = 1;
+    UnpinNode(root, true);
+    WriteHeader();
+    UnlatchNodes(0);
+    return;
+  }
+  std::vector<page_id_t> path;
+  std::vector<size_t>    child_idxes;
+  std::vector<Fences>    fences;
+  FindLeaf(entry.data(), true, path, child_idxes, fences);
+  auto leaf   = FetchNode(path.back());
+  auto idx    = LowerBound(leaf, 0, entry.data(), entry_key_size_);
+  auto exists = idx < leaf.GetEntryNum() && leaf.Compare(idx, entry.data(), entry_key_size_) == 0;
+  UnpinNode(leaf, false);
+  if (exists) {
+    UnlatchNodes(0);
+    WSDB_THROW(WSDB_RECORD_EXISTS, fmt::format("rid ({}, {})", rid.PageID(), rid.SlotID()));
+  }
+  InsertIntoNode(path, child_idxes, fences, path.size() - 1, idx, entry.data());
+  UnlatchNodes(0);
+}
+
+void BPTreeIndex::Delete(const Record &key, const RID &rid)
+{
+  std::vector<char> entry(entry_key_size_);
+  key_encoder_.Encode(key, entry.data());
+  EncodeRID(rid, entry.data() + key_size_);
+  // delete from the leaf in place if it stays at least half full, and the root leaf does not become empty
+  while (true) {
+    std::optional<Node> leaf;
+    if (!FindLeafOptimistic(entry.data(), entry_key_size_, true, true, leaf)) {
+      std::this_thread::yield();
+      continue;
+    }
+    if (!leaf.has_value()) {
+      WSDB_THROW(WSDB_RECORD_MISS, fmt::format("rid ({}, {})", rid.PageID(), rid.SlotID()));
+    }
+    auto idx = LowerBound(*leaf, 0, entry.data(), entry_key_size_);
+    if (idx == leaf->GetEntryNum() || leaf->Compare(idx, entry.data(), entry_key_size_) != 0) {
+      UnlatchLeaf(*leaf, true, false);
+      WSDB_THROW(WSDB_RECORD_MISS, fmt::format("rid ({}, {})", rid.PageID(), rid.SlotID()));
+    }
+    if (leaf->GetEntryNum() > 1 && leaf->GetUsedSize() - leaf->GetStoredSize(entry.data()) >= NODE_SIZE / 2) {
+      leaf->RemoveEntries(idx, 1);
+      UnlatchLeaf(*leaf, true, true);
+      return;
+    }
+    UnlatchLeaf(*leaf, true, false);
+    break;
+  }
+  std::lock_guard smo_lock(smo_latch_);
+  root_latch_.LockExclusive();
+  root_latched_ = true;
+  if (header_.root_page_ == INVALID_PAGE_ID) {
+    UnlatchNodes(0);
+    WSDB_THROW(WSDB_RECORD_MISS, fmt::format("rid ({}, {})", rid.PageID(), rid.SlotID()));
+  }
+  std::vector<page_id_t> path;
+  std::vector<size_t>    child_idxes;
+  std::vector<Fences>    fences;
+  FindLeaf(entry.data(), false, path, child_idxes, fences);
+  auto leaf = FetchNode(path.back());
+  auto idx  = LowerBound(leaf, 0, entry.data(), entry_key_size_);
+  if (idx == leaf.GetEntryNum() || leaf.Compare(idx, entry.data(), entry_key_size_) != 0) {
+    UnpinNode(leaf, false);
+    UnlatchNodes(0);
+    WSDB_THROW(WSDB_RECORD_MISS, fmt::format("rid ({}, {})", rid.PageID(), rid.SlotID()));
+  }
+  leaf.RemoveEntries(idx, 1);
+  UnpinNode(leaf, true);
+  Rebalance(path, child_idxes, fences, path.size() - 1);
+  UnlatchNodes(0);
+}
+
+auto BPTreeIndex::Search(const Record &key, size_t cmp_field_num) -> std::vector<RID>
+{
+  IndexBound bound{.key_ = &key, .cmp_field_num_ = cmp_field_num, .inclusive_ = true};
+  return SearchRange(bound, bound);
+}
+
+auto BPTreeIndex::SearchRange(const IndexBound &low, const IndexBound &high) -> std::vector<RID>
+{
+  std::vector<RID> rids;
+  ScanRange(low, high, [this, &rids](const char *entry) { rids.push_back(DecodeRID(entry + key_size_)); });
+  return rids;
+}
+
+auto BPTreeIndex::SearchRangeRecords(const IndexBound &low, const IndexBound &high, const RecordSchema *schema)
+    -> std::vector<RecordUptr>
+{
+  auto key_field_num     = key_schema_->GetFieldCount();
+  auto key_length        = key_schema_->GetRecordLength();
+  auto include_field_num = include_schema_ == nullptr ? 0 : include_schema_->GetFieldCount();
+  auto include_length    = include_schema_ == nullptr ? 0 : include_schema_->GetRecordLength();
+  WSDB_ASSERT(schema->GetFieldCount() == key_field_num + include_field_num &&
+                  schema->GetRecordLength() == key_length + include_length,
+      "schema of the records mismatches the index entries");
+  // the key fields come first in the records, so they are decoded in the layout of the key schema
+  std::vector<RecordUptr> records;
+  std::vector<char>       null_map(BITMAP_SIZE(schema->GetFieldCount()));
+  std::vector<char>       data(schema->GetRecordLength());
+  ScanRange(low, high, [&](const char *entry) {
+    key_encoder_.Decode(entry, null_map.data(), data.data());
+    auto include_null_map = entry + entry_key_size_;
+    std::memcpy(data.data() + key_length, include_null_map + BITMAP_SIZE(include_field_num), include_length);
+    for (size_t i = 0; i < include_field_num; ++i) {
+      BitMap::SetBit(null_map.data(), key_field_num + i, BitMap::GetBit(include_null_map, i));
+    }
+    records.push_back(std::make_unique<Record>(schema, null_map.data(), data.data(), DecodeRID(entry + key_size_)));
+  });
+  return records;
+}
+
+void BPTreeIndex::ScanRange(
+    const IndexBound &low, const IndexBound &high, const std::function<void(const char *)> &collect)
+{
+  // the normalized key of the first cmp_field_num fields is a prefix of the normalized key
+  auto              low_len  = low.key_ == nullptr ? 0 : GetPrefixLength(low.cmp_field_num_);
+  auto              high_len = high.key_ == nullptr ? 0 : GetPrefixLength(high.cmp_field_num_);
+  std::vector<char> low_key(key_size_);
+  std::vector<char> high_key(key_size_);
+  if (low.key_ != nullptr) {
+    key_encoder_.Encode(*low.key_, low_key.data());
+  }
+  if (high.key_ != nullptr) {
+    key_encoder_.Encode(*high.key_, high_key.data());
+  }
+  // if the scan is interrupted, it restarts from the root after the last entry collected
+  std::vector<char> last_entry(entry_key_size_);
+  std::vector<char> entry(leaf_entry_size_);
+  bool              resumed = false;
+  while (true) {
+    auto                target = resumed ? last_entry.data() : low_key.data();
+    auto                len    = resumed ? entry_key_size_ : low_len;
+    auto                upper  = resumed || (!low.inclusive_ && low.key_ != nullptr);
+    std::optional<Node> leaf;
+    if (!FindLeafOptimistic(target, len, upper, false, leaf)) {
+      std::this_thread::yield();
+      continue;
+    }
+    if (!leaf.has_value()) {
+      return;
+    }
+    auto   node           = *leaf;
+    auto   idx            = upper ? UpperBound(node, 0, target, len) : LowerBound(node, 0, target, len);
+    size_t leaf_collected = 0;
+    while (true) {
+      if (idx == node.GetEntryNum()) {
+        if (leaf_collected > 0) {
+          node.ReadEntry(idx - 1, entry.data());
+          std::memcpy(last_entry.data(), entry.data(), entry_key_size_);
+          resumed = true;
+        }
+        auto next = node.GetHeader()->next_page_;
+        if (next == INVALID_PAGE_ID) {
+          UnlatchLeaf(node, false, false);
+          return;
+        }
+        // the next leaf is not freed while this one is latched, since freeing it modifies the link of this one. Waiting
+        // for its latch could deadlock with a writer latching this one after it, so the scan restarts instead
+        auto next_page = FetchPage(next, false);
+        if (next_page == nullptr || !next_page->GetLatch().TryLockShared()) {
+          if (next_page != nullptr) {
+            buffer_pool_manager_->UnpinPage(index_id_, next, false);
+          }
+          UnlatchLeaf(node, false, false);
+          break;
+        }
+        UnlatchLeaf(node, false, false);
+        node           = Node(next_page, key_size_, leaf_entry_size_, header_.compress_keys_);
+        idx            = 0;
+        leaf_collected = 0;
+        continue;
+      }
+      auto cmp = node.Compare(idx, high_key.data(), high_len);
+      if (cmp > 0 || (cmp == 0 && !high.inclusive_ && high.key_ != nullptr)) {
+        UnlatchLeaf(node, false, false);
+        return;
+      }
+      node.ReadEntry(idx, entry.data());
+      collect(entry.data());
+      leaf_collected++;
+      idx++;
+    }
+    std::this_thread::yield();
+  }
+}
+
+void BPTreeIndex::BulkLoad(const std::function<RecordUptr()> &next, double fill_factor)
+{
+  std::lock_guard smo_lock(smo_latch_);
+  root_latch_.LockExclusive();
+  WSDB_ASSERT(header_.root_page_ == INVALID_PAGE_ID, "bulk load into a non-empty tree");
+  std::vector<char> entries;
+  try {
+    LevelBuilder      leaves(this, 0, fill_factor);
+    std::vector<char> entry(leaf_entry_size_);
+    // entries of equal keys are collected and sorted by rid before they are appended
+    std::vector<char> group;
+    auto              append_group = [&]() {
+      std::vector<const char *> group_entries;
+      for (size_t offset = 0; offset < group.size(); offset += leaf_entry_size_) {
+        group_entries.push_back(group.data() + offset);
+      }
+      std::sort(group_entries.begin(), group_entries.end(), [this](const char *lhs, const char *rhs) {
+        return std::memcmp(lhs, rhs, entry_key_size_) < 0;
+      });
+      for (auto group_entry : group_entries) {
+        leaves.Append(group_entry);
+      }
+      group.clear();
+    };
+    for (auto record = next(); record != nullptr; record = next()) {
+      key_encoder_.Encode(Record(key_schema_, *record), entry.data());
+      EncodeRID(record->GetRID(), entry.data() + key_size_);
+      if (include_schema_ != nullptr) {
+        EncodeInclude(Record(include_schema_, *record), entry.data());
+      }
+      if (!group.empty()) {
+        auto cmp = std::memcmp(group.data(), entry.data(), key_size_);
+        WSDB_ASSERT(cmp <= 0, "records of bulk load are not in key order");
+        if (cmp < 0) {
+          append_group();
+        }
+      }
+      group.insert(group.end(), entry.begin(), entry.end());
+    }
+    append_group();
+    entries = leaves.Finish();
+    // build the levels above until a level has a single node
+    size_t level = 0;
+    while (entries.size() > inner_entry_size_) {
+      LevelBuilder inner_nodes(this, ++level, fill_factor);
+      for (size_t offset = 0; offset < entries.size(); offset += inner_entry_size_) {
+        inner_nodes.Append(entries.data() + offset);
+      }
+      entries = inner_nodes.Finish();
+    }
+    if (!entries.empty()) {
+      std::memcpy(&header_.root_page_, entries.data() + entry_key_size_, sizeof(page_id_t));
+      header_.height_ = level + 1;
+      WriteHeader();
+    }
+  } catch (...) {
+    // any exception, e.g. bad_alloc from the buffers or an error of the child, must not leave the tree latched
+    root_latch_.UnlockExclusive();
+    throw;
+  }
+  root_latch_.UnlockExclusive();
+}
+
+BPTreeIndex::LevelBuilder::LevelBuilder(BPTreeIndex *tree, size_t level, double fill_factor)
+    : tree_(tree), level_(level), entry_size_(level == 0 ? tree->leaf_entry_size_ : tree->inner_entry_size_)
+{
+  // a node filled below half would be rebalanced by the first deletion from it
+  fill_size_ =
+      std::clamp(static_cast<size_t>(static_cast<double>(NODE_SIZE) * fill_factor), NODE_SIZE / 2, NODE_SIZE);
+}
+
+BPTreeIndex::LevelBuilder::~LevelBuilder()
+{
+  if (node_.has_value()) {
+    tree_->UnpinNode(*node_, true);
+  }
+}
+
+void BPTreeIndex::LevelBuilder::Append(const char *entry)
+{
+  // the prefix of the node is not longer than the common prefix of its low fence and the entry, with which the size of
+  // the node is estimated
+  auto prefix_size =
+      low_.empty() || !tree_->header_.compress_keys_ ? 0 : GetCommonPrefixSize(low_.data(), entry, tree_->key_size_);
+  if (prefix_size != prefix_size_) {
+    prefix_size_ = prefix_size;
+    size_        = tree_->GetNodeSize(entries_.data(), entries_.size() / entry_size_, entry_size_, prefix_size_);
+  }
+  auto entry_size =
+      ComputeStoredSize(entry, tree_->key_size_, entry_size_, prefix_size_, tree_->header_.compress_keys_);
+  if (!entries_.empty() && (size_ >= fill_size_ || size_ + entry_size > NODE_SIZE)) {
+    Flush(entry);
+    Append(entry);
+    return;
+  }
+  entries_.insert(entries_.end(), entry, entry + entry_size_);
+  size_ += entry_size;
+}
+
+void BPTreeIndex::LevelBuilder::Flush(const char *next)
+{
+  // the high fence separates the last entry of the node from the entry after it, and shortens the prefix of the node
+  // if they differ before it. without a next entry, the last pending entry is kept for the last node
+  auto   num = entries_.size() / entry_size_ - (next == nullptr ? 1 : 0);
+  Fences fences{low_, {}};
+  while (true) {
+    auto last    = entries_.data() + (num - 1) * entry_size_;
+    auto after   = num * entry_size_ == entries_.size() ? next : last + entry_size_;
+    fences.high_ = tree_->MakeSeparator(last, after, level_ == 0);
+    if (num == 1 ||
+        tree_->GetNodeSize(entries_.data(), num, entry_size_, tree_->GetNodePrefixSize(fences)) <= NODE_SIZE) {
+      break;
+    }
+    num--;
+  }
+  WriteNode(fences, num);
+  entries_.erase(entries_.begin(), entries_.begin() + static_cast<std::ptrdiff_t>(num * entry_size_));
+  low_  = std::move(fences.high_);
+  size_ = tree_->GetNodeSize(entries_.data(), entries_.size() / entry_size_, entry_size_, prefix_size_);
+}
+
+void BPTreeIndex::LevelBuilder::WriteNode(const Fences &fences, size_t num)
+{
+  auto node = tree_->NewNode(level_);
+  tree_->BuildNode(node, fences, entries_.data(), num);
+  if (node_.has_value()) {
+    if (level_ == 0) {
+      node_->GetHeader()->next_page_ = node.GetPageId();
+      node.GetHeader()->prev_page_   = node_->GetPageId();
+    }
+    tree_->UnpinNode(*node_, true);
+  }
+  node_     = node;
+  node_low_ = fences.low_;
+  // the low fence of the node separates it from the node before it in the level above, the first node has none
+  auto page_id = node.GetPageId();
+  auto offset  = parent_entries_.size();
+  parent_entries_.resize(offset + tree_->inner_entry_size_);
+  std::copy(fences.low_.begin(), fences.low_.end(), parent_entries_.begin() + static_cast<std::ptrdiff_t>(offset));
+  std::memcpy(parent_entries_.data() + offset + tree_->entry_key_size_, &page_id, sizeof(page_id_t));
+}
+
+auto BPTreeIndex::LevelBuilder::Finish() -> std::vector<char>
+{
+  if (entries_.empty()) {
+    return {};
+  }
+  // the last node has no high fence and so no prefix, the pending entries may not fit in it without the prefix with
+  // which their size is estimated
+  Fences fences{low_, {}};
+  while (tree_->GetNodeSize(entries_.data(), entries_.size() / entry_size_, entry_size_, 0) > NODE_SIZE) {
+    Flush(nullptr);
+    fences.low_ = low_;
+  }
+  // the last node is below half full, it is merged into the node before it if they fit in one node, otherwise the
+  // entries of both are split between them so that both of them are at least half full
+  if (node_.has_value() && tree_->GetNodeSize(entries_.data(),
+                               entries_.size() / entry_size_,
+                               entry_size_,
+                               tree_->GetNodePrefixSize(fences)) < NODE_SIZE / 2) {
+    auto entries = tree_->ReadEntries(*node_);
+    entries.insert(entries.end(), entries_.begin(), entries_.end());
+    Fences            merged{node_low_, {}};
+    std::vector<char> separator;
+    if (tree_->GetNodeSize(entries.data(), entries.size() / entry_size_, entry_size_,
+            tree_->GetNodePrefixSize(merged)) <= NODE_SIZE) {
+      tree_->BuildNode(*node_, merged, entries.data(), entries.size() / entry_size_);
+      entries_.clear();
+    } else if (auto left_num = tree_->SplitEntries(entries, level_ == 0, merged, separator); left_num > 0) {
+      tree_->BuildNode(*node_, {node_low_, separator}, entries.data(), left_num);
+      entries_.assign(entries.begin() + static_cast<std::ptrdiff_t>(left_num * entry_size_), entries.end());
+      fences.low_ = std::move(separator);
+    }
+  }
+  if (!entries_.empty()) {
+    WriteNode(fences, entries_.size() / entry_size_);
+  }
+  tree_->UnpinNode(*node_, true);
+  node_.reset();
+  return std::move(parent_entries_);
+}
+
+void BPTreeIndex::EncodeRID(const RID &rid, char *dst)
 {
-  WSDB_THROW(WSDB_NOT_IMPLEMENTED, "");
+  StoreBigEndian(static_cast<uint32_t>(rid.PageID()) ^ 0x80000000U, dst);
+  StoreBigEndian(static_cast<uint32_t>(rid.SlotID()) ^ 0x80000000U, dst + sizeof(uint32_t));
 }
-void BPTreeIndex::Insert(const Record &key, const RID &rid) {}
-void BPTreeIndex::Delete(const Record &key, const RID &rid) {}
-}  // namespace wsdb
\ No newline at end of file
+
+auto BPTreeIndex::DecodeRID(const char *src) -> RID
+{
+  return {static_cast<page_id_t>(LoadBigEndian(src) ^ 0x80000000U),
+      static_cast<slot_id_t>(LoadBigEndian(src + sizeof(uint32_t)) ^ 0x80000000U)};
+}
+
+void BPTreeIndex::EncodeInclude(const Record &include, char *entry) const
+{
+  auto null_map_size = BITMAP_SIZE(include_schema_->GetFieldCount());
+  std::memcpy(entry + entry_key_size_, include.GetNullMap(), null_map_size);
+  std::memcpy(entry + entry_key_size_ + null_map_size, include.GetData(), include_schema_->GetRecordLength());
+}
+
+auto BPTreeIndex::GetPrefixLength(size_t cmp_field_num) const -> size_t
+{
+  size_t len = 0;
+  for (size_t i = 0; i < std::min(cmp_field_num, key_schema_->GetFieldCount()); ++i) {
+    len += 1 + key_schema_->GetFieldAt(i).field_.field_size_;
+  }
+  return len;
+}
+
+auto BPTreeIndex::GetMaxStoredSize(const Node &node) const -> size_t
+{
+  return SLOT_SIZE + (node.IsLeaf() ? leaf_entry_size_ : inner_entry_size_);
+}
+
+auto BPTreeIndex::GetChild(const Node &node, size_t idx) const -> page_id_t
+{
+  page_id_t child;
+  std::memcpy(&child, node.GetRID(idx) + RID_SIZE, sizeof(page_id_t));
+  return child;
+}
+
+auto BPTreeIndex::GetNodePrefixSize(const Fences &fences) const -> size_t
+{
+  if (!header_.compress_keys_ || fences.low_.empty() || fences.high_.empty()) {
+    return 0;
+  }
+  return GetCommonPrefixSize(fences.low_.data(), fences.high_.data(), key_size_);
+}
+
+auto BPTreeIndex::GetChildFences(const Node &node, const Fences &fences, size_t idx) const -> Fences
+{
+  // the child is bounded by the key and rid of its entry and the entry after it, or the fences of the node at the ends
+  Fences            child_fences{fences.low_, fences.high_};
+  std::vector<char> entry(inner_entry_size_);
+  if (idx > 0) {
+    node.ReadEntry(idx, entry.data());
+    child_fences.low_.assign(entry.begin(), entry.begin() + static_cast<std::ptrdiff_t>(entry_key_size_));
+  }
+  if (idx + 1 < node.GetEntryNum()) {
+    node.ReadEntry(idx + 1, entry.data());
+    child_fences.high_.assign(entry.begin(), entry.begin() + static_cast<std::ptrdiff_t>(entry_key_size_));
+  }
+  return child_fences;
+}
+
+auto BPTreeIndex::GetNodeSize(const char *entries, size_t num, size_t entry_size, size_t prefix_size) const -> size_t
+{
+  auto size = prefix_size;
+  for (size_t i = 0; i < num; ++i) {
+    size += ComputeStoredSize(entries + i * entry_size, key_size_, entry_size, prefix_size, header_.compress_keys_);
+  }
+  return size;
+}
+
+auto BPTreeIndex::ReadEntries(const Node &node) const -> std::vector<char>
+{
+  auto              entry_size = node.IsLeaf() ? leaf_entry_size_ : inner_entry_size_;
+  std::vector<char> entries(node.GetEntryNum() * entry_size);
+  for (size_t i = 0; i < node.GetEntryNum(); ++i) {
+    node.ReadEntry(i, entries.data() + i * entry_size);
+  }
+  return entries;
+}
+
+void BPTreeIndex::BuildNode(Node &node, const Fences &fences, const char *entries, size_t num) const
+{
+  auto entry_size  = node.IsLeaf() ? leaf_entry_size_ : inner_entry_size_;
+  auto prefix_size = GetNodePrefixSize(fences);
+  WSDB_ASSERT(GetNodeSize(entries, num, entry_size, prefix_size) <= NODE_SIZE, "entries do not fit in the node");
+  node.Reset(fences.low_.data(), prefix_size);
+  for (size_t i = 0; i < num; ++i) {
+    node.InsertEntry(i, entries + i * entry_size);
+  }
+}
+
+auto BPTreeIndex::MakeSeparator(const char *last, const char *first, bool is_leaf) const -> std::vector<char>
+{
+  std::vector<char> separator(first, first + entry_key_size_);
+  if (is_leaf && header_.compress_keys_) {
+    // the entries are unique, so the first byte where they differ is kept, and the bytes after it are not needed
+    auto len = std::min(GetCommonPrefixSize(last, first, entry_key_size_) + 1, entry_key_size_);
+    std::fill(separator.begin() + static_cast<std::ptrdiff_t>(len), separator.end(), 0);
+  }
+  return separator;
+}
+
+auto BPTreeIndex::SplitEntries(const std::vector<char> &entries, bool is_leaf, const Fences &fences,
+    std::vector<char> &separator) const -> size_t
+{
+  auto entry_size = is_leaf ? leaf_entry_size_ : inner_entry_size_;
+  auto entry_num  = entries.size() / entry_size;
+  if (entry_num < 2) {
+    return 0;
+  }
+  // the sizes of the entries with the prefix of the fences, which is not longer than the prefixes of the two nodes,
+  // are balanced, and if the nodes do not fit, the split point moves away from the middle until they fit
+  auto                prefix_size = GetNodePrefixSize(fences);
+  std::vector<size_t> sizes(entry_num + 1, 0);
+  for (size_t i = 0; i < entry_num; ++i) {
+    auto entry   = entries.data() + i * entry_size;
+    sizes[i + 1] = sizes[i] + ComputeStoredSize(entry, key_size_, entry_size, prefix_size, header_.compress_keys_);
+  }
+  size_t middle = 1;
+  while (middle + 1 < entry_num && sizes[middle] * 2 < sizes[entry_num]) {
+    middle++;
+  }
+  for (size_t step = 0; step < entry_num; ++step) {
+    for (auto left_num : {middle - step, middle + step}) {
+      if (left_num == 0 || left_num >= entry_num) {
+        continue;
+      }
+      auto left_entries = entries.data() + left_num * entry_size;
+      separator         = MakeSeparator(left_entries - entry_size, left_entries, is_leaf);
+      if (GetNodeSize(entries.data(), left_num, entry_size, GetNodePrefixSize({fences.low_, separator})) <=
+              NODE_SIZE &&
+          GetNodeSize(left_entries, entry_num - left_num, entry_size, GetNodePrefixSize({separator, fences.high_})) <=
+              NODE_SIZE) {
+        return left_num;
+      }
+    }
+  }
+  return 0;
+}
+
+auto BPTreeIndex::LowerBound(const Node &node, size_t begin, const char *target, size_t len) const -> size_t
+{
+  auto lo = begin;
+  auto hi = std::min(node.GetEntryNum(), node.GetCapacity());
+  while (lo < hi) {
+    auto mid = lo + (hi - lo) / 2;
+    if (node.Compare(mid, target, len) < 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+auto BPTreeIndex::UpperBound(const Node &node, size_t begin, const char *target, size_t len) const -> size_t
+{
+  auto lo = begin;
+  auto hi = std::min(node.GetEntryNum(), node.GetCapacity());
+  while (lo < hi) {
+    auto mid = lo + (hi - lo) / 2;
+    if (node.Compare(mid, target, len) <= 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+auto BPTreeIndex::FindLeafOptimistic(
+    const char *target, size_t len, bool upper, bool exclusive, std::optional<Node> &leaf) -> bool
+{
+  HybridLatch *parent_latch = &root_latch_;
+  uint64_t     parent_version;
+  if (!root_latch_.TryReadOptimistic(parent_version)) {
+    return false;
+  }
+  auto page_id = header_.root_page_;
+  auto level   = header_.height_ - 1;
+  if (!root_latch_.Validate(parent_version)) {
+    return false;
+  }
+  if (page_id == INVALID_PAGE_ID) {
+    leaf.reset();
+    return true;
+  }
+  // the parent is kept pinned so that its version stays meaningful until the child is validated, and the entry size
+  // follows the level of the descent rather than the node header, which may be modified while it is read
+  std::optional<Node> parent;
+  auto                unpin_parent = [&]() {
+    if (parent.has_value()) {
+      UnpinNode(*parent, false);
+    }
+  };
+  while (true) {
+    auto page = FetchPage(page_id, false);
+    if (page == nullptr) {
+      unpin_parent();
+      return false;
+    }
+    Node  node(page, key_size_, level == 0 ? leaf_entry_size_ : inner_entry_size_, header_.compress_keys_);
+    auto &latch = page->GetLatch();
+    if (level == 0) {
+      // the leaf is not waited for, so that the pages pinned by the descent are not held while the frames are scarce
+      if (!(exclusive ? latch.TryLockExclusive() : latch.TryLockShared())) {
+        UnpinNode(node, false);
+        unpin_parent();
+        return false;
+      }
+      if (!parent_latch->Validate(parent_version)) {
+        UnlatchLeaf(node, exclusive, false);
+        unpin_parent();
+        return false;
+      }
+      unpin_parent();
+      leaf = node;
+      return true;
+    }
+    uint64_t version;
+    if (!latch.TryReadOptimistic(version) || !parent_latch->Validate(parent_version)) {
+      UnpinNode(node, false);
+      unpin_parent();
+      return false;
+    }
+    unpin_parent();
+    // the first entry not less than (or greater than, if upper) the target may be in the child before the first such
+    // separator
+    auto idx = (upper ? UpperBound(node, 1, target, len) : LowerBound(node, 1, target, len)) - 1;
+    page_id  = GetChild(node, idx);
+    if (!latch.Validate(version)) {
+      UnpinNode(node, false);
+      return false;
+    }
+    parent         = node;
+    parent_latch   = &latch;
+    parent_version = version;
+    level--;
+  }
+}
+
+void BPTreeIndex::UnlatchLeaf(const Node &leaf, bool exclusive, bool is_dirty)
+{
+  if (exclusive) {
+    leaf.GetPage()->GetLatch().UnlockExclusive();
+  } else {
+    leaf.GetPage()->GetLatch().UnlockShared();
+  }
+  UnpinNode(leaf, is_dirty);
+}
+
+void BPTreeIndex::FindLeaf(const char *entry, bool is_insert, std::vector<page_id_t> &path,
+    std::vector<size_t> &child_idxes, std::vector<Fences> &fences)
+{
+  path.clear();
+  child_idxes.clear();
+  fences.assign(1, Fences{});
+  auto page_id = header_.root_page_;
+  while (true) {
+    auto node = FetchNodeExclusive(page_id);
+    path.push_back(page_id);
+    // an insertion propagates above a node without space for an entry, and a deletion above a node that may fall below
+    // half full, or its minimum for the root, which is two entries for an inner root and one for a leaf root
+    bool safe;
+    if (is_insert) {
+      safe = node.GetFreeSize() >= GetMaxStoredSize(node);
+    } else if (path.size() == 1) {
+      safe = node.GetEntryNum() > (node.IsLeaf() ? 1 : 2);
+    } else {
+      safe = node.GetUsedSize() >= NODE_SIZE / 2 + GetMaxStoredSize(node);
+    }
+    if (safe) {
+      UnlatchNodes(1);
+    }
+    if (node.IsLeaf()) {
+      UnpinNode(node, false);
+      return;
+    }
+    auto idx = UpperBound(node, 1, entry, entry_key_size_) - 1;
+    child_idxes.push_back(idx);
+    fences.push_back(GetChildFences(node, fences.back(), idx));
+    page_id = GetChild(node, idx);
+    UnpinNode(node, false);
+  }
+}
+
+void BPTreeIndex::InsertIntoNode(const std::vector<page_id_t> &path, const std::vector<size_t> &child_idxes,
+    const std::vector<Fences> &fences, size_t depth, size_t idx, const char *entry)
+{
+  auto node = FetchNode(path[depth]);
+  if (node.GetStoredSize(entry) <= node.GetFreeSize()) {
+    node.InsertEntry(idx, entry);
+    UnpinNode(node, true);
+    return;
+  }
+  // split the entries with the new one into two nodes of about the same size, the separator of the nodes is their new
+  // fence, and is inserted into the parent
+  auto is_leaf    = node.IsLeaf();
+  auto entry_size = is_leaf ? leaf_entry_size_ : inner_entry_size_;
+  auto entries    = ReadEntries(node);
+  entries.insert(entries.begin() + static_cast<std::ptrdiff_t>(idx * entry_size), entry, entry + entry_size);
+  std::vector<char> separator;
+  auto              left_num = SplitEntries(entries, is_leaf, fences[depth], separator);
+  WSDB_ASSERT(left_num > 0, "entries of a split node do not fit in two nodes");
+  auto level = node.GetHeader()->level_;
+  auto right = NewNode(level);
+  BuildNode(node, {fences[depth].low_, separator}, entries.data(), left_num);
+  BuildNode(right,
+      {separator, fences[depth].high_},
+      entries.data() + left_num * entry_size,
+      entries.size() / entry_size - left_num);
+  if (is_leaf) {
+    right.GetHeader()->prev_page_ = node.GetPageId();
+    right.GetHeader()->next_page_ = node.GetHeader()->next_page_;
+    if (right.GetHeader()->next_page_ != INVALID_PAGE_ID) {
+      SetPrevPage(right.GetHeader()->next_page_, right.GetPageId());
+    }
+    node.GetHeader()->next_page_ = right.GetPageId();
+  }
+  auto right_page = right.GetPageId();
+  separator.resize(inner_entry_size_);
+  std::memcpy(separator.data() + entry_key_size_, &right_page, sizeof(page_id_t));
+  auto left_page = node.GetPageId();
+  UnpinNode(node, true);
+  UnpinNode(right, true);
+  if (depth > 0) {
+    InsertIntoNode(path, child_idxes, fences, depth - 1, child_idxes[depth - 1] + 1, separator.data());
+    return;
+  }
+  // the root is split, the tree grows by a level
+  auto              root = NewNode(level + 1);
+  std::vector<char> first(inner_entry_size_, 0);
+  std::memcpy(first.data() + entry_key_size_, &left_page, sizeof(page_id_t));
+  root.InsertEntry(0, first.data());
+  root.InsertEntry(1, separator.data());
+  header_.root_page_ = root.GetPageId();
+  header_.height_++;
+  UnpinNode(root, true);
+  WriteHeader();
+}
+
+void BPTreeIndex::Rebalance(const std::vector<page_id_t> &path, const std::vector<size_t> &child_idxes,
+    const std::vector<Fences> &fences, size_t depth)
+{
+  auto node = FetchNode(path[depth]);
+  if (depth == 0) {
+    // the root has no minimum, the tree shrinks when it is an empty leaf or an inner node with a single child
+    if (node.IsLeaf() && node.GetEntryNum() == 0) {
+      header_.root_page_ = INVALID_PAGE_ID;
+      header_.height_    = 0;
+      FreeNode(node);
+    } else if (!node.IsLeaf() && node.GetEntryNum() == 1) {
+      header_.root_page_ = GetChild(node, 0);
+      header_.height_--;
+      FreeNode(node);
+    } else {
+      UnpinNode(node, false);
+    }
+    return;
+  }
+  auto parent = FetchNode(path[depth - 1]);
+  if (node.GetUsedSize() >= NODE_SIZE / 2 || parent.GetEntryNum() == 1) {
+    UnpinNode(node, false);
+    UnpinNode(parent, false);
+    return;
+  }
+  // the node is rebalanced with its left sibling, or the right one if it is the first child. The sibling is unlatched
+  // once it is modified, since the parent stays latched, a search reaching it through the leaf chain sees it either
+  // before or after the modification, and the node after it is still latched
+  auto  idx          = child_idxes[depth - 1];
+  auto  right_idx    = idx > 0 ? idx : idx + 1;
+  auto  sibling      = FetchNodeExclusive(GetChild(parent, idx > 0 ? idx - 1 : idx + 1));
+  auto &left         = idx > 0 ? sibling : node;
+  auto &right        = idx > 0 ? node : sibling;
+  auto  left_fences  = GetChildFences(parent, fences[depth - 1], right_idx - 1);
+  auto  right_fences = GetChildFences(parent, fences[depth - 1], right_idx);
+  auto  is_leaf      = node.IsLeaf();
+  auto  entry_size   = is_leaf ? leaf_entry_size_ : inner_entry_size_;
+  // the separator becomes the key of the first entry of the right inner node
+  auto entries       = ReadEntries(left);
+  auto right_entries = ReadEntries(right);
+  if (!is_leaf) {
+    std::memcpy(right_entries.data(), right_fences.low_.data(), entry_key_size_);
+  }
+  auto left_num = entries.size() / entry_size;
+  entries.insert(entries.end(), right_entries.begin(), right_entries.end());
+  Fences merged{left_fences.low_, right_fences.high_};
+  if (GetNodeSize(entries.data(), entries.size() / entry_size, entry_size, GetNodePrefixSize(merged)) <= NODE_SIZE) {
+    Merge(left, right, parent, right_idx, entries, merged);
+    UnlatchNode(sibling);
+    UnpinNode(parent, true);
+    Rebalance(path, child_idxes, fences, depth - 1);
+    return;
+  }
+  // the entries are redistributed evenly if the new separator fits in the parent in place of the old one, which may be
+  // shorter
+  std::vector<char> separator;
+  auto              split_num = SplitEntries(entries, is_leaf, merged, separator);
+  auto              modified  = false;
+  if (split_num > 0 && split_num != left_num) {
+    std::vector<char> old_entry(inner_entry_size_);
+    std::vector<char> new_entry(separator);
+    parent.ReadEntry(right_idx, old_entry.data());
+    new_entry.resize(inner_entry_size_);
+    std::memcpy(new_entry.data() + entry_key_size_, old_entry.data() + entry_key_size_, sizeof(page_id_t));
+    if (parent.GetStoredSize(new_entry.data()) <= parent.GetFreeSize() + parent.GetStoredSize(old_entry.data())) {
+      BuildNode(left, {merged.low_, separator}, entries.data(), split_num);
+      BuildNode(right,
+          {separator, merged.high_},
+          entries.data() + split_num * entry_size,
+          entries.size() / entry_size - split_num);
+      parent.RemoveEntries(right_idx, 1);
+      parent.InsertEntry(right_idx, new_entry.data());
+      modified = true;
+    }
+  }
+  UnpinNode(sibling, modified);
+  UnlatchNode(sibling);
+  UnpinNode(node, modified);
+  UnpinNode(parent, modified);
+}
+
+void BPTreeIndex::Merge(Node &left, Node &right, Node &parent, size_t right_idx, const std::vector<char> &entries,
+    const Fences &fences)
+{
+  BuildNode(left, fences, entries.data(), entries.size() / (left.IsLeaf() ? leaf_entry_size_ : inner_entry_size_));
+  if (left.IsLeaf()) {
+    left.GetHeader()->next_page_ = right.GetHeader()->next_page_;
+    if (left.GetHeader()->next_page_ != INVALID_PAGE_ID) {
+      SetPrevPage(left.GetHeader()->next_page_, left.GetPageId());
+    }
+  }
+  parent.RemoveEntries(right_idx, 1);
+  UnpinNode(left, true);
+  FreeNode(right);
+}
+
+auto BPTreeIndex::NewNode(size_t level) -> Node
+{
+  page_id_t page_id;
+  Page     *page;
+  if (header_.first_free_page_ != INVALID_PAGE_ID) {
+    page_id                  = header_.first_free_page_;
+    page                     = FetchPage(page_id, true);
+    header_.first_free_page_ = page->GetNextFreePageId();
+  } else {
+    page_id = static_cast<page_id_t>(header_.page_num_++);
+    page    = FetchPage(page_id, true);
+  }
+  // the node is not latched, since it is reachable only after its parent or previous leaf, which are latched, is
+  // modified, and a search that read the page before it was freed fails to validate the parent
+  std::memset(page->GetData(), 0, PAGE_SIZE);
+  page->SetNextFreePageId(INVALID_PAGE_ID);
+  *reinterpret_cast<BPTreeNodeHeader *>(page->GetData() + PAGE_HEADER_SIZE) = BPTreeNodeHeader{level};
+  WriteHeader();
+  return {page, key_size_, level == 0 ? leaf_entry_size_ : inner_entry_size_, header_.compress_keys_};
+}
+
+auto BPTreeIndex::FetchPage(page_id_t page_id, bool wait) -> Page *
+{
+  while (true) {
+    try {
+      return buffer_pool_manager_->FetchPage(index_id_, page_id);
+    } catch (WSDBException_ &e) {
+      if (e.type_ != WSDB_NO_FREE_FRAME) {
+        throw;
+      }
+      if (!wait) {
+        return nullptr;
+      }
+    }
+    std::this_thread::yield();
+  }
+}
+
+auto BPTreeIndex::FetchNode(page_id_t page_id) -> Node
+{
+  auto page  = FetchPage(page_id, true);
+  auto level = reinterpret_cast<BPTreeNodeHeader *>(page->GetData() + PAGE_HEADER_SIZE)->level_;
+  return {page, key_size_, level == 0 ? leaf_entry_size_ : inner_entry_size_, header_.compress_keys_};
+}
+
+auto BPTreeIndex::FetchNodeExclusive(page_id_t page_id) -> Node
+{
+  auto node = FetchNode(page_id);
+  LatchExclusive(node.GetPage());
+  return node;
+}
+
+void BPTreeIndex::LatchExclusive(Page *page)
+{
+  if (std::find(latched_pages_.begin(), latched_pages_.end(), page) != latched_pages_.end()) {
+    return;
+  }
+  // the page is pinned once more until it is unlatched
+  FetchPage(page->GetPageId(), true);
+  page->GetLatch().LockExclusive();
+  latched_pages_.push_back(page);
+}
+
+void BPTreeIndex::SetPrevPage(page_id_t page_id, page_id_t prev_page)
+{
+  auto page = FetchPage(page_id, true);
+  auto own  = std::find(latched_pages_.begin(), latched_pages_.end(), page) != latched_pages_.end();
+  if (!own) {
+    page->GetLatch().LockExclusive();
+  }
+  reinterpret_cast<BPTreeNodeHeader *>(page->GetData() + PAGE_HEADER_SIZE)->prev_page_ = prev_page;
+  if (!own) {
+    page->GetLatch().UnlockExclusive();
+  }
+  buffer_pool_manager_->UnpinPage(index_id_, page_id, true);
+}
+
+void BPTreeIndex::UnlatchNode(const Node &node)
+{
+  auto it = std::find(latched_pages_.begin(), latched_pages_.end(), node.GetPage());
+  WSDB_ASSERT(it != latched_pages_.end(), "unlatch a node not latched");
+  latched_pages_.erase(it);
+  node.GetPage()->GetLatch().UnlockExclusive();
+  buffer_pool_manager_->UnpinPage(index_id_, node.GetPageId(), false);
+}
+
+void BPTreeIndex::UnlatchNodes(size_t keep_num)
+{
+  if (root_latched_) {
+    root_latch_.UnlockExclusive();
+    root_latched_ = false;
+  }
+  auto num = latched_pages_.size() - keep_num;
+  for (size_t i = 0; i < num; ++i) {
+    latched_pages_[i]->GetLatch().UnlockExclusive();
+    buffer_pool_manager_->UnpinPage(index_id_, latched_pages_[i]->GetPageId(), false);
+  }
+  latched_pages_.erase(latched_pages_.begin(), latched_pages_.begin() + static_cast<std::ptrdiff_t>(num));
+}
+
+void BPTreeIndex::UnpinNode(const Node &node, bool is_dirty)
+{
+  buffer_pool_manager_->UnpinPage(index_id_, node.GetPageId(), is_dirty);
+}
+
+void BPTreeIndex::FreeNode(Node &node)
+{
+  node.SetEntryNum(0);
+  node.GetPage()->SetNextFreePageId(header_.first_free_page_);
+  header_.first_free_page_ = node.GetPageId();
+  UnpinNode(node, true);
+  WriteHeader();
+}
+
+void BPTreeIndex::WriteHeader()
+{
+  auto page = FetchPage(FILE_HEADER_PAGE_ID, true);
+  std::memcpy(page->GetData() + INDEX_HEADER_SIZE, &header_, sizeof(BPTreeHeader));
+  buffer_pool_manager_->UnpinPage(index_id_, FILE_HEADER_PAGE_ID, true);
+}
+
+}  // namespace wsdb
@@ -19,21 +19,371 @@
 // Created by ziqi on 2024/7/28.
 //
 
+/**
+ * B+tree index on normalized keys stored in the pages of the index file, with compressed keys and optimistic latch
+ * coupling on the hybrid latches of the pages
+ */
+
 #ifndef WSDB_INDEX_BP_TREE_H
 #define WSDB_INDEX_BP_TREE_H
 
+#include <algorithm>
+#include <mutex>
+#include <optional>
 #include "index_abstract.h"
+#include "system/handle/key_encoder.h"
 
 namespace wsdb {
+
+struct BPTreeHeader
+{
+  page_id_t root_page_{INVALID_PAGE_ID};
+  page_id_t first_free_page_{INVALID_PAGE_ID};
+  size_t    page_num_{0};  // 0 if the index file is just created
+  size_t    height_{0};    // 0 if the tree is empty, 1 if the root is a leaf
+  bool      compress_keys_{true};
+};
+
+struct BPTreeNodeHeader
+{
+  size_t    level_{0};  // 0 for leaves
+  page_id_t prev_page_{INVALID_PAGE_ID};
+  page_id_t next_page_{INVALID_PAGE_ID};
+  uint16_t  prefix_size_{0};           // the prefix is stored at the end of the page
+  uint16_t  entry_offset_{PAGE_SIZE};  // the entries are stored from the offset to the prefix
+};
+
+struct BPTreeSlot
+{
+  uint16_t offset_;    // offset of the entry in the page
+  uint16_t key_size_;  // size of the key stored in the entry, without the prefix and the trailing zeros
+};
+
 class BPTreeIndex : public Index
 {
 public:
-  void Insert(const Record &key, const RID &rid) override;
+  /**
+   * @param compress_keys whether the keys of the nodes are compressed if the index file is just created, an existing
+   * tree keeps the layout in its header
+   */
+  BPTreeIndex(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, idx_id_t index_id,
+      RecordSchema *key_schema, RecordSchema *include_schema, bool compress_keys = true);
+
+  /**
+   * insert an entry, throw WSDB_RECORD_EXISTS if the key is already indexed with the rid
+   */
+  void Insert(const Record &key, const RID &rid, const Record *include = nullptr) override;
 
+  /**
+   * delete an entry, throw WSDB_RECORD_MISS if the key is not indexed with the rid
+   */
   void Delete(const Record &key, const RID &rid) override;
 
+  auto Search(const Record &key, size_t cmp_field_num) -> std::vector<RID> override;
+
+  /**
+   * descend to the leaf of the low bound, and collect the entries along the leaf chain until the high bound
+   */
+  auto SearchRange(const IndexBound &low, const IndexBound &high) -> std::vector<RID> override;
+
+  /**
+   * collect the entries as SearchRange, and decode their keys and included fields into records
+   */
+  auto SearchRangeRecords(const IndexBound &low, const IndexBound &high, const RecordSchema *schema)
+      -> std::vector<RecordUptr> override;
+
+  /**
+   * build the tree bottom-up from the records in key order, records of equal keys may come in any order
+   */
+  void BulkLoad(const std::function<RecordUptr()> &next, double fill_factor) override;
+
+  [[nodiscard]] auto GetHeader() const -> const BPTreeHeader & { return header_; }
+
+private:
+  /// @brief Bounds of the keys and rids of the entries of a node, [low_, high_), an empty bound is unbounded
+  struct Fences
+  {
+    std::vector<char> low_;
+    std::vector<char> high_;
+  };
+
+  /// @brief A node of the tree in a pinned page, whose entries are read and written uncompressed
+  class Node
+  {
+  public:
+    Node(Page *page, size_t key_size, size_t entry_size, bool trim_keys)
+        : page_(page), key_size_(key_size), entry_size_(entry_size), trim_keys_(trim_keys)
+    {}
+
+    [[nodiscard]] auto GetPage() const -> Page * { return page_; }
+
+    [[nodiscard]] auto GetPageId() const -> page_id_t { return page_->GetPageId(); }
+
+    [[nodiscard]] auto GetHeader() const -> BPTreeNodeHeader *
+    {
+      return reinterpret_cast<BPTreeNodeHeader *>(page_->GetData() + PAGE_HEADER_SIZE);
+    }
+
+    [[nodiscard]] auto IsLeaf() const -> bool { return GetHeader()->level_ == 0; }
+
+    [[nodiscard]] auto GetEntryNum() const -> size_t { return page_->GetRecordNum(); }
+
+    /// number of slots the page can hold, which bounds the entry number read optimistically from the page
+    [[nodiscard]] auto GetCapacity() const -> size_t
+    {
+      return (PAGE_SIZE - PAGE_HEADER_SIZE - sizeof(BPTreeNodeHeader)) / sizeof(BPTreeSlot);
+    }
+
+    void SetEntryNum(size_t entry_num) { page_->SetRecordNum(entry_num); }
+
+    [[nodiscard]] auto GetPrefixSize() const -> size_t
+    {
+      return std::min<size_t>(GetHeader()->prefix_size_, key_size_);
+    }
+
+    /// bytes taken by the slots, the entries and the prefix
+    [[nodiscard]] auto GetUsedSize() const -> size_t;
+
+    [[nodiscard]] auto GetFreeSize() const -> size_t;
+
+    /// bytes the entry takes with its slot if it is stored in the node
+    [[nodiscard]] auto GetStoredSize(const char *entry) const -> size_t;
+
+    /**
+     * compare the first len bytes of the key and rid of the entry at idx with the target
+     */
+    [[nodiscard]] auto Compare(size_t idx, const char *target, size_t len) const -> int;
+
+    /**
+     * @return the rid of the entry at idx, which is followed by the child or the included fields
+     */
+    [[nodiscard]] auto GetRID(size_t idx) const -> char *;
+
+    /// copy the entry at idx uncompressed into dst
+    void ReadEntry(size_t idx, char *dst) const;
+
+    /**
+     * insert an entry before the entry at idx, the key must start with the prefix of the node and the entry must fit
+     * in the free space
+     */
+    void InsertEntry(size_t idx, const char *entry);
+
+    /**
+     * remove num entries from the entry at idx, the entries after them in the page are moved to fill the space
+     */
+    void RemoveEntries(size_t idx, size_t num);
+
+    /// remove all the entries and set the prefix of the keys
+    void Reset(const char *prefix, size_t prefix_size);
+
+  private:
+    [[nodiscard]] auto GetSlot(size_t idx) const -> BPTreeSlot *;
+
+    /// the stored entry at idx and the size of its key, clamped into the page
+    [[nodiscard]] auto GetStoredEntry(size_t idx, size_t prefix_size, size_t &key_size) const -> char *;
+
+    Page  *page_;
+    size_t key_size_;
+    size_t entry_size_;  // size of an uncompressed entry
+    bool   trim_keys_;   // whether the trailing zeros of the keys are left out
+  };
+
+  /// @brief Packs the entries of a level of a bulk loaded tree into new nodes from left to right
+  class LevelBuilder
+  {
+  public:
+    LevelBuilder(BPTreeIndex *tree, size_t level, double fill_factor);
+
+    /// unpin the last node if the build is interrupted
+    ~LevelBuilder();
+
+    /**
+     * append an entry after the entries appended before, a new node is started if the last one is filled
+     */
+    void Append(const char *entry);
+
+    /**
+     * balance the last node with the one before it if it is below half full
+     * @return the entries of the level above, i.e. the separator of each node with the node as the child
+     */
+    auto Finish() -> std::vector<char>;
+
+  private:
+    /**
+     * write the pending entries before next into a new node, the last ones are kept pending for the next node if they
+     * do not fit with the prefix of the fences, which is known only once the next entry is appended
+     */
+    void Flush(const char *next);
+
+    /// write the first num pending entries into a new node after the last one
+    void WriteNode(const Fences &fences, size_t num);
+
+    BPTreeIndex        *tree_;
+    size_t              level_;
+    size_t              entry_size_;
+    size_t              fill_size_;
+    std::vector<char>   low_;             // low fence of the pending entries
+    std::vector<char>   entries_;         // entries of the node being filled
+    size_t              prefix_size_{0};  // prefix with which the size of the pending entries is estimated
+    size_t              size_{0};         // estimated size of the node of the pending entries
+    std::optional<Node> node_;            // the last node, pinned
+    std::vector<char>   node_low_;        // low fence of the last node
+    std::vector<char>   parent_entries_;
+  };
+
+  static void EncodeRID(const RID &rid, char *dst);
+
+  [[nodiscard]] static auto DecodeRID(const char *src) -> RID;
+
+  /// bytes of the largest entry of the node with its slot, i.e. an entry without compression
+  [[nodiscard]] auto GetMaxStoredSize(const Node &node) const -> size_t;
+
+  [[nodiscard]] auto GetChild(const Node &node, size_t idx) const -> page_id_t;
+
+  /// length of the common prefix of the keys of the fences, which is shared by the keys of the node
+  [[nodiscard]] auto GetNodePrefixSize(const Fences &fences) const -> size_t;
+
+  /// fences of the child at idx of the node
+  [[nodiscard]] auto GetChildFences(const Node &node, const Fences &fences, size_t idx) const -> Fences;
+
+  /// bytes taken by the entries with their slots and the prefix if they are stored in a node
+  [[nodiscard]] auto GetNodeSize(const char *entries, size_t num, size_t entry_size, size_t prefix_size) const
+      -> size_t;
+
+  [[nodiscard]] auto ReadEntries(const Node &node) const -> std::vector<char>;
+
+  /**
+   * remove the entries of the node, and store the entries with the prefix of the fences, which must fit in the node
+   */
+  void BuildNode(Node &node, const Fences &fences, const char *entries, size_t num) const;
+
+  /**
+   * @return key and rid separating the entries of two adjacent nodes, i.e. greater than last and not greater than
+   * first, which is truncated for leaves, or the key and rid of first for inner nodes
+   */
+  [[nodiscard]] auto MakeSeparator(const char *last, const char *first, bool is_leaf) const -> std::vector<char>;
+
+  /**
+   * choose where to split the entries into two nodes of about the same size within the fences
+   * @param separator the separator of the two nodes
+   * @return number of the entries of the left node, or 0 if they do not fit in two nodes
+   */
+  auto SplitEntries(const std::vector<char> &entries, bool is_leaf, const Fences &fences,
+      std::vector<char> &separator) const -> size_t;
+
+  /**
+   * @return index of the first entry from begin whose first len bytes are not less than the target
+   */
+  [[nodiscard]] auto LowerBound(const Node &node, size_t begin, const char *target, size_t len) const -> size_t;
+
+  /**
+   * @return index of the first entry from begin whose first len bytes are greater than the target
+   */
+  [[nodiscard]] auto UpperBound(const Node &node, size_t begin, const char *target, size_t len) const -> size_t;
+
+  /**
+   * descend to the leaf of the low bound, and pass the entries along the leaf chain until the high bound to collect,
+   * while their leaves are latched shared
+   */
+  void ScanRange(const IndexBound &low, const IndexBound &high, const std::function<void(const char *)> &collect);
+
+  /// write the included fields of the record into the entry after its key and rid
+  void EncodeInclude(const Record &include, char *entry) const;
+
+  /// length of the normalized key of the first cmp_field_num fields
+  [[nodiscard]] auto GetPrefixLength(size_t cmp_field_num) const -> size_t;
+
+  /**
+   * descend from the root to the leaf that holds the first entry not less than, or greater than if upper, the first
+   * len bytes of target, reading the inner nodes optimistically, and latch the leaf shared or exclusive
+   * @param leaf the latched and pinned leaf, or nullopt if the tree is empty
+   * @return false if a concurrent modification is detected, and the descent should be restarted
+   */
+  auto FindLeafOptimistic(const char *target, size_t len, bool upper, bool exclusive, std::optional<Node> &leaf)
+      -> bool;
+
+  void UnlatchLeaf(const Node &leaf, bool exclusive, bool is_dirty);
+
+  /**
+   * descend from the root to the leaf that should hold the entry, latching the nodes exclusively, the latches of the
+   * ancestors of a node are released if the insertion or deletion does not propagate above it
+   * @param entry key and rid of the entry
+   * @param path pages from the root to the leaf
+   * @param child_idxes index of the entry of each inner node on the path pointing to the next page
+   * @param fences fences of each node on the path
+   */
+  void FindLeaf(const char *entry, bool is_insert, std::vector<page_id_t> &path, std::vector<size_t> &child_idxes,
+      std::vector<Fences> &fences);
+
+  /**
+   * insert an entry into the node at depth of the path, and split the node if the entry does not fit
+   */
+  void InsertIntoNode(const std::vector<page_id_t> &path, const std::vector<size_t> &child_idxes,
+      const std::vector<Fences> &fences, size_t depth, size_t idx, const char *entry);
+
+  /**
+   * merge the node at depth of the path with a sibling, or redistribute their entries, if it is below half full
+   */
+  void Rebalance(const std::vector<page_id_t> &path, const std::vector<size_t> &child_idxes,
+      const std::vector<Fences> &fences, size_t depth);
+
+  /**
+   * store the entries of left and right in left within the fences and free right, right is the child at right_idx of
+   * parent
+   */
+  void Merge(Node &left, Node &right, Node &parent, size_t right_idx, const std::vector<char> &entries,
+      const Fences &fences);
+
+  /**
+   * allocate a node from the free pages or the end of the file, the page is pinned and latched exclusively
+   */
+  auto NewNode(size_t level) -> Node;
+
+  /**
+   * fetch a page of the index, if all the frames are pinned, wait for one to be unpinned or return nullptr
+   */
+  auto FetchPage(page_id_t page_id, bool wait) -> Page *;
+
+  auto FetchNode(page_id_t page_id) -> Node;
+
+  /**
+   * fetch the node and latch it exclusively for the pessimistic modification if it has not been latched
+   */
+  auto FetchNodeExclusive(page_id_t page_id) -> Node;
+
+  void LatchExclusive(Page *page);
+
+  /// set the previous leaf of a leaf, which is latched only for the update if the modification has not latched it
+  void SetPrevPage(page_id_t page_id, page_id_t prev_page);
+
+  /**
+   * release the latch of a node latched by FetchNodeExclusive before the pessimistic modification finishes, so that
+   * it does not keep the frame pinned
+   */
+  void UnlatchNode(const Node &node);
+
+  /**
+   * release the root latch and the latches of the pessimistic modification except the last keep_num ones
+   */
+  void UnlatchNodes(size_t keep_num);
+
+  void UnpinNode(const Node &node, bool is_dirty);
+
+  void FreeNode(Node &node);
+
+  void WriteHeader();
 
-  BPTreeIndex(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, idx_id_t index_id, RecordSchema *key_schema);
+  KeyEncoder          key_encoder_;
+  size_t              key_size_;          // size of the normalized key
+  size_t              include_size_;      // size of the null map and the data of the included fields
+  size_t              entry_key_size_;    // key and rid, which order the entries and separate the nodes
+  size_t              leaf_entry_size_;   // key, rid and included fields
+  size_t              inner_entry_size_;  // key, rid and child page id
+  BPTreeHeader        header_;
+  HybridLatch         root_latch_;           // protects the root page id and the height of the header
+  std::mutex          smo_latch_;            // serializes pessimistic modifications, and protects the members below
+  std::vector<Page *> latched_pages_;        // pages latched exclusively by the pessimistic modification
+  bool                root_latched_{false};  // whether the pessimistic modification holds the root latch
 };
 }  // namespace wsdb
 
@@ -21,15 +21,454 @@
 
 #include "index_hash.h"
 
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <string_view>
+#include <thread>
+
 namespace wsdb {
 
-// FIXME: HashIndex initialization should include more information, such as bucket size, etc.
+// a directory page holds a power of two slots, so that the slots of a directory larger than a page fill whole pages
+static constexpr size_t DIR_SLOT_NUM = 512;
+
+static_assert(PAGE_HEADER_SIZE + DIR_SLOT_NUM * sizeof(page_id_t) <= PAGE_SIZE);
+
+static constexpr size_t BUCKET_ENTRY_OFFSET = PAGE_HEADER_SIZE + sizeof(HashBucketHeader);
+
+static auto GetDirSlots(Page *page) -> page_id_t *
+{
+  return reinterpret_cast<page_id_t *>(page->GetData() + PAGE_HEADER_SIZE);
+}
+
+static void EncodeRID(const RID &rid, char *dst)
+{
+  auto page_id = rid.PageID();
+  auto slot_id = rid.SlotID();
+  std::memcpy(dst, &page_id, sizeof(page_id_t));
+  std::memcpy(dst + sizeof(page_id_t), &slot_id, sizeof(slot_id_t));
+}
+
+static auto DecodeRID(const char *src) -> RID
+{
+  page_id_t page_id;
+  slot_id_t slot_id;
+  std::memcpy(&page_id, src, sizeof(page_id_t));
+  std::memcpy(&slot_id, src + sizeof(page_id_t), sizeof(slot_id_t));
+  return {page_id, slot_id};
+}
+
 HashIndex::HashIndex(
     DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, idx_id_t index_id, RecordSchema *key_schema)
-    : Index(disk_manager, buffer_pool_manager, IndexType::HASH, index_id, key_schema)
+    : Index(disk_manager, buffer_pool_manager, IndexType::HASH, index_id, key_schema, nullptr),
+      key_encoder_(key_schema, key_schema, false),
+      key_size_(key_encoder_.GetKeySize()),
+      entry_size_(key_size_ + sizeof(page_id_t) + sizeof(slot_id_t)),
+      bucket_max_entry_num_((PAGE_SIZE - BUCKET_ENTRY_OFFSET) / entry_size_)
 {
-  WSDB_THROW(WSDB_NOT_IMPLEMENTED, "");
+  // a split should be able to separate the entries of a full bucket
+  if (bucket_max_entry_num_ < 2) {
+    WSDB_THROW(WSDB_RECLEN_ERROR, fmt::format("index key of {} bytes", key_size_));
+  }
+  // the ids of the directory pages are kept in the file header page after the header
+  auto max_dir_page_num = (PAGE_SIZE - INDEX_HEADER_SIZE - sizeof(HashHeader)) / sizeof(page_id_t);
+  max_global_depth_     = std::bit_width(DIR_SLOT_NUM) - 1 + std::bit_width(max_dir_page_num) - 1;
+
+  auto page = FetchPage(FILE_HEADER_PAGE_ID);
+  std::memcpy(&header_, page->GetData() + INDEX_HEADER_SIZE, sizeof(HashHeader));
+  auto dir_slots = reinterpret_cast<page_id_t *>(page->GetData() + INDEX_HEADER_SIZE + sizeof(HashHeader));
+  dir_pages_.assign(dir_slots, dir_slots + header_.dir_page_num_);
+  UnpinPage(page, false);
+  if (header_.page_num_ == 0) {
+    header_               = HashHeader{};
+    header_.page_num_     = FILE_HEADER_PAGE_ID + 1;
+    auto dir              = NewPage();
+    auto bucket           = NewPage();
+    GetDirSlots(dir)[0]   = bucket->GetPageId();
+    dir_pages_            = {dir->GetPageId()};
+    header_.dir_page_num_ = 1;
+    UnpinPage(bucket, true);
+    UnpinPage(dir, true);
+    WriteHeader();
+  }
 }
-void HashIndex::Insert(const Record &key, const RID &rid) {}
-void HashIndex::Delete(const Record &key, const RID &rid) {}
-}  // namespace wsdb
\ No newline at end of file
+
+void HashIndex::Insert(const Record &key, const RID &rid, [[maybe_unused]] const Record *include)
+{
+  std::vector<char> entry(entry_size_);
+  key_encoder_.Encode(key, entry.data());
+  EncodeRID(rid, entry.data() + key_size_);
+  auto             hash = Hash(entry.data());
+  std::unique_lock lock(latch_);
+  while (true) {
+    auto slot        = hash & (GetSlotNum() - 1);
+    auto bucket      = GetBucket(slot);
+    auto local_depth = size_t{0};
+    auto full        = true;
+    // whether a split can separate the new entry from some entry of the bucket, which is false if all the entries
+    // have the same hash as the new one on the bits that the directory can use
+    auto separable = false;
+    auto mask      = (size_t{1} << max_global_depth_) - 1;
+    for (auto page_id = bucket; page_id != INVALID_PAGE_ID;) {
+      auto page   = FetchPage(page_id);
+      auto num    = page->GetRecordNum();
+      local_depth = GetBucketHeader(page)->local_depth_;
+      for (size_t i = 0; i < num; ++i) {
+        auto other = GetEntry(page, i);
+        if (std::memcmp(other, entry.data(), entry_size_) == 0) {
+          UnpinPage(page, false);
+          WSDB_THROW(WSDB_RECORD_EXISTS, fmt::format("rid ({}, {})", rid.PageID(), rid.SlotID()));
+        }
+        separable = separable || ((Hash(other) ^ hash) & mask) >> local_depth != 0;
+      }
+      full    = full && num == bucket_max_entry_num_;
+      page_id = GetBucketHeader(page)->overflow_page_;
+      UnpinPage(page, false);
+    }
+    if (!full || !separable) {
+      AppendEntry(bucket, entry.data());
+      return;
+    }
+    SplitBucket(slot);
+  }
+}
+
+void HashIndex::Delete(const Record &key, const RID &rid)
+{
+  std::vector<char> entry(entry_size_);
+  key_encoder_.Encode(key, entry.data());
+  EncodeRID(rid, entry.data() + key_size_);
+  std::unique_lock lock(latch_);
+  auto             slot = Hash(entry.data()) & (GetSlotNum() - 1);
+  Page            *prev = nullptr;
+  auto             page = FetchPage(GetBucket(slot));
+  size_t           idx  = 0;
+  while (true) {
+    auto num = page->GetRecordNum();
+    for (idx = 0; idx < num && std::memcmp(GetEntry(page, idx), entry.data(), entry_size_) != 0; ++idx) {}
+    if (idx < num) {
+      break;
+    }
+    auto next = GetBucketHeader(page)->overflow_page_;
+    if (prev != nullptr) {
+      UnpinPage(prev, false);
+    }
+    if (next == INVALID_PAGE_ID) {
+      UnpinPage(page, false);
+      WSDB_THROW(WSDB_RECORD_MISS, fmt::format("rid ({}, {})", rid.PageID(), rid.SlotID()));
+    }
+    prev = page;
+    page = FetchPage(next);
+  }
+  // entries are not ordered, the hole is filled by the last entry of the page
+  auto num = page->GetRecordNum() - 1;
+  std::memcpy(GetEntry(page, idx), GetEntry(page, num), entry_size_);
+  page->SetRecordNum(num);
+  if (prev != nullptr) {
+    // unlink the empty overflow page
+    if (num == 0) {
+      GetBucketHeader(prev)->overflow_page_ = GetBucketHeader(page)->overflow_page_;
+      FreePage(page);
+      UnpinPage(prev, true);
+      return;
+    }
+    UnpinPage(prev, false);
+    UnpinPage(page, true);
+    return;
+  }
+  auto next = GetBucketHeader(page)->overflow_page_;
+  if (num == 0 && next != INVALID_PAGE_ID) {
+    // the primary page of the bucket takes the entries of the first overflow page
+    auto overflow = FetchPage(next);
+    num           = overflow->GetRecordNum();
+    std::memcpy(GetEntry(page, 0), GetEntry(overflow, 0), num * entry_size_);
+    page->SetRecordNum(num);
+    GetBucketHeader(page)->overflow_page_ = GetBucketHeader(overflow)->overflow_page_;
+    FreePage(overflow);
+  }
+  UnpinPage(page, true);
+  if (num == 0) {
+    MergeBucket(slot);
+  }
+}
+
+auto HashIndex::Search(const Record &key, size_t cmp_field_num) -> std::vector<RID>
+{
+  if (cmp_field_num < key_schema_->GetFieldCount()) {
+    WSDB_THROW(WSDB_NOT_IMPLEMENTED, "hash index searched by a prefix of the key");
+  }
+  std::vector<char> target(key_size_);
+  key_encoder_.Encode(key, target.data());
+  std::shared_lock lock(latch_);
+  return SearchKey(target.data());
+}
+
+auto HashIndex::SearchRange(const IndexBound &low, const IndexBound &high) -> std::vector<RID>
+{
+  auto field_num = key_schema_->GetFieldCount();
+  if (low.key_ != nullptr && high.key_ != nullptr && low.inclusive_ && high.inclusive_ &&
+      low.cmp_field_num_ >= field_num && high.cmp_field_num_ >= field_num) {
+    std::vector<char> low_key(key_size_);
+    std::vector<char> high_key(key_size_);
+    key_encoder_.Encode(*low.key_, low_key.data());
+    key_encoder_.Encode(*high.key_, high_key.data());
+    if (low_key == high_key) {
+      std::shared_lock lock(latch_);
+      return SearchKey(low_key.data());
+    }
+  }
+  WSDB_THROW(WSDB_NOT_IMPLEMENTED, "hash index searched by a range of keys");
+}
+
+auto HashIndex::Hash(const char *key) const -> size_t { return std::hash<std::string_view>{}({key, key_size_}); }
+
+auto HashIndex::GetEntry(Page *page, size_t idx) const -> char *
+{
+  return page->GetData() + BUCKET_ENTRY_OFFSET + idx * entry_size_;
+}
+
+auto HashIndex::GetBucketHeader(Page *page) -> HashBucketHeader *
+{
+  return reinterpret_cast<HashBucketHeader *>(page->GetData() + PAGE_HEADER_SIZE);
+}
+
+auto HashIndex::SearchKey(const char *key) -> std::vector<RID>
+{
+  std::vector<RID> rids;
+  for (auto page_id = GetBucket(Hash(key) & (GetSlotNum() - 1)); page_id != INVALID_PAGE_ID;) {
+    auto page = FetchPage(page_id);
+    auto num  = page->GetRecordNum();
+    for (size_t i = 0; i < num; ++i) {
+      if (std::memcmp(GetEntry(page, i), key, key_size_) == 0) {
+        rids.push_back(DecodeRID(GetEntry(page, i) + key_size_));
+      }
+    }
+    page_id = GetBucketHeader(page)->overflow_page_;
+    UnpinPage(page, false);
+  }
+  std::sort(rids.begin(), rids.end(), [](const RID &a, const RID &b) {
+    return a.PageID() < b.PageID() || (a.PageID() == b.PageID() && a.SlotID() < b.SlotID());
+  });
+  return rids;
+}
+
+auto HashIndex::GetBucket(size_t slot) -> page_id_t
+{
+  auto page   = FetchPage(dir_pages_[slot / DIR_SLOT_NUM]);
+  auto bucket = GetDirSlots(page)[slot % DIR_SLOT_NUM];
+  UnpinPage(page, false);
+  return bucket;
+}
+
+void HashIndex::SetBucket(size_t slot, size_t local_depth, page_id_t bucket)
+{
+  auto  step = size_t{1} << local_depth;
+  Page *page = nullptr;
+  for (auto i = slot & (step - 1); i < GetSlotNum(); i += step) {
+    auto dir_page = dir_pages_[i / DIR_SLOT_NUM];
+    if (page == nullptr || page->GetPageId() != dir_page) {
+      if (page != nullptr) {
+        UnpinPage(page, true);
+      }
+      page = FetchPage(dir_page);
+    }
+    GetDirSlots(page)[i % DIR_SLOT_NUM] = bucket;
+  }
+  UnpinPage(page, true);
+}
+
+void HashIndex::AppendEntry(page_id_t bucket, const char *entry)
+{
+  auto page = FetchPage(bucket);
+  while (page->GetRecordNum() == bucket_max_entry_num_) {
+    auto next = GetBucketHeader(page)->overflow_page_;
+    if (next == INVALID_PAGE_ID) {
+      auto overflow                           = NewPage();
+      GetBucketHeader(overflow)->local_depth_ = GetBucketHeader(page)->local_depth_;
+      GetBucketHeader(page)->overflow_page_   = overflow->GetPageId();
+      UnpinPage(page, true);
+      page = overflow;
+      break;
+    }
+    UnpinPage(page, false);
+    page = FetchPage(next);
+  }
+  auto num = page->GetRecordNum();
+  std::memcpy(GetEntry(page, num), entry, entry_size_);
+  page->SetRecordNum(num + 1);
+  UnpinPage(page, true);
+}
+
+void HashIndex::SplitBucket(size_t slot)
+{
+  auto page        = FetchPage(GetBucket(slot));
+  auto local_depth = GetBucketHeader(page)->local_depth_;
+  if (local_depth == header_.global_depth_) {
+    DoubleDirectory();
+  }
+  // take all the entries out of the bucket, and free its overflow pages
+  std::vector<char> entries(page->GetRecordNum() * entry_size_);
+  std::memcpy(entries.data(), GetEntry(page, 0), entries.size());
+  for (auto next = GetBucketHeader(page)->overflow_page_; next != INVALID_PAGE_ID;) {
+    auto overflow = FetchPage(next);
+    entries.insert(entries.end(), GetEntry(overflow, 0), GetEntry(overflow, overflow->GetRecordNum()));
+    next = GetBucketHeader(overflow)->overflow_page_;
+    FreePage(overflow);
+  }
+  page->SetRecordNum(0);
+  *GetBucketHeader(page) = HashBucketHeader{local_depth + 1};
+  auto bucket            = page->GetPageId();
+  UnpinPage(page, true);
+  // the split image takes the slots whose bit of the old local depth is set
+  auto image                           = NewPage();
+  GetBucketHeader(image)->local_depth_ = local_depth + 1;
+  auto image_bucket                    = image->GetPageId();
+  UnpinPage(image, true);
+  auto step = size_t{1} << local_depth;
+  SetBucket((slot & (step - 1)) | step, local_depth + 1, image_bucket);
+  for (size_t offset = 0; offset < entries.size(); offset += entry_size_) {
+    auto entry = entries.data() + offset;
+    AppendEntry((Hash(entry) & step) != 0 ? image_bucket : bucket, entry);
+  }
+}
+
+void HashIndex::MergeBucket(size_t slot)
+{
+  while (true) {
+    auto page        = FetchPage(GetBucket(slot));
+    auto local_depth = GetBucketHeader(page)->local_depth_;
+    if (local_depth == 0 || page->GetRecordNum() != 0) {
+      UnpinPage(page, false);
+      break;
+    }
+    auto image_bucket = GetBucket(slot ^ (size_t{1} << (local_depth - 1)));
+    auto image        = FetchPage(image_bucket);
+    if (GetBucketHeader(image)->local_depth_ != local_depth) {
+      UnpinPage(image, false);
+      UnpinPage(page, false);
+      break;
+    }
+    GetBucketHeader(image)->local_depth_ = local_depth - 1;
+    UnpinPage(image, true);
+    FreePage(page);
+    SetBucket(slot, local_depth - 1, image_bucket);
+  }
+  ShrinkDirectory();
+}
+
+void HashIndex::DoubleDirectory()
+{
+  auto slot_num = GetSlotNum();
+  if (slot_num < DIR_SLOT_NUM) {
+    auto page  = FetchPage(dir_pages_[0]);
+    auto slots = GetDirSlots(page);
+    std::copy(slots, slots + slot_num, slots + slot_num);
+    UnpinPage(page, true);
+  } else {
+    auto dir_page_num = dir_pages_.size();
+    for (size_t i = 0; i < dir_page_num; ++i) {
+      auto src = FetchPage(dir_pages_[i]);
+      auto dst = NewPage();
+      std::memcpy(GetDirSlots(dst), GetDirSlots(src), DIR_SLOT_NUM * sizeof(page_id_t));
+      dir_pages_.push_back(dst->GetPageId());
+      UnpinPage(src, false);
+      UnpinPage(dst, true);
+    }
+  }
+  header_.global_depth_++;
+  header_.dir_page_num_ = dir_pages_.size();
+  WriteHeader();
+}
+
+void HashIndex::ShrinkDirectory()
+{
+  auto shrunk = false;
+  while (header_.global_depth_ > 0) {
+    auto half = GetSlotNum() / 2;
+    auto same = true;
+    if (half < DIR_SLOT_NUM) {
+      auto page  = FetchPage(dir_pages_[0]);
+      auto slots = GetDirSlots(page);
+      same       = std::equal(slots, slots + half, slots + half);
+      UnpinPage(page, false);
+    } else {
+      auto half_page_num = dir_pages_.size() / 2;
+      for (size_t i = 0; same && i < half_page_num; ++i) {
+        auto low  = FetchPage(dir_pages_[i]);
+        auto high = FetchPage(dir_pages_[i + half_page_num]);
+        same      = std::memcmp(GetDirSlots(low), GetDirSlots(high), DIR_SLOT_NUM * sizeof(page_id_t)) == 0;
+        UnpinPage(low, false);
+        UnpinPage(high, false);
+      }
+      for (size_t i = 0; same && i < half_page_num; ++i) {
+        FreePage(FetchPage(dir_pages_.back()));
+        dir_pages_.pop_back();
+      }
+    }
+    if (!same) {
+      break;
+    }
+    header_.global_depth_--;
+    header_.dir_page_num_ = dir_pages_.size();
+    shrunk                = true;
+  }
+  if (shrunk) {
+    WriteHeader();
+  }
+}
+
+auto HashIndex::NewPage() -> Page *
+{
+  Page *page;
+  if (header_.first_free_page_ != INVALID_PAGE_ID) {
+    page                     = FetchPage(header_.first_free_page_);
+    header_.first_free_page_ = page->GetNextFreePageId();
+  } else {
+    page = FetchPage(static_cast<page_id_t>(header_.page_num_++));
+  }
+  std::memset(page->GetData(), 0, PAGE_SIZE);
+  page->SetNextFreePageId(INVALID_PAGE_ID);
+  *GetBucketHeader(page) = HashBucketHeader{};
+  WriteHeader();
+  return page;
+}
+
+auto HashIndex::FetchPage(page_id_t page_id) -> Page *
+{
+  // concurrent searches may pin all the frames for a while
+  while (true) {
+    try {
+      return buffer_pool_manager_->FetchPage(index_id_, page_id);
+    } catch (WSDBException_ &e) {
+      if (e.type_ != WSDB_NO_FREE_FRAME) {
+        throw;
+      }
+    }
+    std::this_thread::yield();
+  }
+}
+
+void HashIndex::UnpinPage(Page *page, bool is_dirty)
+{
+  buffer_pool_manager_->UnpinPage(index_id_, page->GetPageId(), is_dirty);
+}
+
+void HashIndex::FreePage(Page *page)
+{
+  page->SetRecordNum(0);
+  page->SetNextFreePageId(header_.first_free_page_);
+  header_.first_free_page_ = page->GetPageId();
+  UnpinPage(page, true);
+  WriteHeader();
+}
+
+void HashIndex::WriteHeader()
+{
+  auto page = FetchPage(FILE_HEADER_PAGE_ID);
+  auto data = page->GetData() + INDEX_HEADER_SIZE;
+  std::memcpy(data, &header_, sizeof(HashHeader));
+  std::memcpy(data + sizeof(HashHeader), dir_pages_.data(), dir_pages_.size() * sizeof(page_id_t));
+  UnpinPage(page, true);
+}
+
+}  // namespace wsdb
@@ -19,21 +19,130 @@
 // Created by ziqi on 2024/7/28.
 //
 
+/**
+ * Extendible hash index stored in the pages of the index file, only whole keys can be looked up since the hash of a
+ * prefix does not locate the bucket
+ */
+
 #ifndef WSDB_INDEX_HASH_H
 #define WSDB_INDEX_HASH_H
 
+#include <shared_mutex>
 #include "index_abstract.h"
+#include "system/handle/key_encoder.h"
 
 namespace wsdb {
 
+struct HashHeader
+{
+  size_t    global_depth_{0};
+  size_t    page_num_{0};  // 0 if the index file is just created
+  page_id_t first_free_page_{INVALID_PAGE_ID};
+  size_t    dir_page_num_{0};
+};
+
+struct HashBucketHeader
+{
+  size_t    local_depth_{0};
+  page_id_t overflow_page_{INVALID_PAGE_ID};  // next page of the chain of the bucket
+};
+
 class HashIndex : public Index
 {
 public:
-  HashIndex(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, idx_id_t index_id, RecordSchema *key_schema);
+  HashIndex(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, idx_id_t index_id,
+      RecordSchema *key_schema);
 
-  void Insert(const Record &key, const RID &rid) override;
+  /**
+   * insert an entry, throw WSDB_RECORD_EXISTS if the key is already indexed with the rid, a hash index has no
+   * included fields
+   */
+  void Insert(const Record &key, const RID &rid, const Record *include = nullptr) override;
 
+  /**
+   * delete an entry, throw WSDB_RECORD_MISS if the key is not indexed with the rid
+   */
   void Delete(const Record &key, const RID &rid) override;
+
+  /**
+   * find the records of the key, throw WSDB_NOT_IMPLEMENTED if cmp_field_num does not cover the whole key
+   * @return rids of the matched records ordered by page and slot
+   */
+  auto Search(const Record &key, size_t cmp_field_num) -> std::vector<RID> override;
+
+  /**
+   * only the range of a single key, i.e. both bounds are the same whole key and inclusive, is supported, throw
+   * WSDB_NOT_IMPLEMENTED otherwise
+   */
+  auto SearchRange(const IndexBound &low, const IndexBound &high) -> std::vector<RID> override;
+
+  [[nodiscard]] auto GetHeader() const -> const HashHeader & { return header_; }
+
+private:
+  [[nodiscard]] auto Hash(const char *key) const -> size_t;
+
+  [[nodiscard]] auto GetSlotNum() const -> size_t { return size_t{1} << header_.global_depth_; }
+
+  [[nodiscard]] auto GetEntry(Page *page, size_t idx) const -> char *;
+
+  [[nodiscard]] static auto GetBucketHeader(Page *page) -> HashBucketHeader *;
+
+  /**
+   * collect the rids of the entries of the normalized key
+   */
+  auto SearchKey(const char *key) -> std::vector<RID>;
+
+  auto GetBucket(size_t slot) -> page_id_t;
+
+  /**
+   * point the slots of the bucket of local depth at slot to the bucket
+   */
+  void SetBucket(size_t slot, size_t local_depth, page_id_t bucket);
+
+  /**
+   * append an entry to the first page of the chain of the bucket with a free slot, a new overflow page is chained
+   * if all the pages are full
+   */
+  void AppendEntry(page_id_t bucket, const char *entry);
+
+  /**
+   * split the bucket of the slot into two buckets by the bit of its local depth, double the directory if needed
+   */
+  void SplitBucket(size_t slot);
+
+  /**
+   * merge the empty bucket of the slot into its split image while they have the same local depth
+   */
+  void MergeBucket(size_t slot);
+
+  void DoubleDirectory();
+
+  /**
+   * halve the directory while the two halves of it point to the same buckets
+   */
+  void ShrinkDirectory();
+
+  /**
+   * allocate a page from the free pages or the end of the file, the page is pinned
+   */
+  auto NewPage() -> Page *;
+
+  auto FetchPage(page_id_t page_id) -> Page *;
+
+  void UnpinPage(Page *page, bool is_dirty);
+
+  void FreePage(Page *page);
+
+  void WriteHeader();
+
+  KeyEncoder             key_encoder_;
+  size_t                 key_size_;    // size of the normalized key
+  size_t                 entry_size_;  // key and rid
+  size_t                 bucket_max_entry_num_;
+  size_t                 max_global_depth_;
+  HashHeader             header_;
+  std::vector<page_id_t> dir_pages_;
+  std::shared_mutex      latch_;  // shared by searches, exclusive for modifications
 };
 
 }  // namespace wsdb
@@ -75,19 +75,16 @@ void DatabaseHandle::Open()
     // read index type
     IndexType index_type;
     disk_manager_->ReadFile(db_fd, reinterpret_cast<char *>(&index_type), sizeof(IndexType), 0, SEEK_CUR);
-    // create index handle
-    // TODO: remove try catch below if IndexManager and indexes are implemented
+    if (!DiskManager::FileExists(FILE_NAME(db_name_, index_name, IDX_SUFFIX))) {
+      continue;
+    }
+    // an index whose file header cannot be parsed, e.g. created by an older version, is dropped so that it can be
+    // created again
     try {
-      auto idx_hdl                    = idx_mgr_->OpenIndex(db_name_, index_name, index_type);
-      indexes_[idx_hdl->GetIndexId()] = std::move(idx_hdl);
-      // update tab_idx_map_
-      auto table_id = indexes_[idx_hdl->GetIndexId()]->GetTableId();
-      if (tab_idx_map_.find(table_id) == tab_idx_map_.end())
-        tab_idx_map_[table_id] = std::list<idx_id_t>();
-      tab_idx_map_[table_id].push_back(idx_hdl->GetIndexId());
+      OpenIndex(index_name, index_type);
     } catch (WSDBException_ &e) {
-      if (e.type_ != WSDB_NOT_IMPLEMENTED)
-        throw;
+      WSDB_LOG(fmt::format("drop index {} of type {}: {}", index_name, IndexTypeToString(index_type), e.what()));
+      idx_mgr_->DropIndex(db_name_, index_name);
     }
   }
   disk_manager_->CloseFile(db_fd);
@@ -176,22 +173,109 @@ void DatabaseHandle::DropTable(const std::string &tab_name)
   tables_.erase(tid);
   for (auto &idx_id : tab_idx_map_[tid]) {
     auto index = indexes_[idx_id].get();
+    // the name is read from the index file, get it before closing
+    auto index_name = index->GetIndexName();
     idx_mgr_->CloseIndex(*index);
-    idx_mgr_->DropIndex(db_name_, index->GetIndexName());
+    idx_mgr_->DropIndex(db_name_, index_name);
     indexes_.erase(idx_id);
   }
   tab_idx_map_.erase(tid);
   FlushMeta();
 }
 
-void DatabaseHandle::CreateIndex(const std::string &tab_name, const RecordSchema &key_schema, IndexType idx_type)
+void DatabaseHandle::CreateIndex(const std::string &tab_name, const RecordSchema &key_schema, IndexType idx_type,
+    const RecordSchema *include_schema, const std::function<void(IndexHandle &)> &load)
+{
+  auto tab = GetTable(tab_name);
+  if (tab == nullptr) {
+    WSDB_THROW(WSDB_TABLE_MISS, tab_name);
+  }
+  auto index_name = MakeIndexName(tab_name, key_schema);
+  if (GetIndex(index_name) != nullptr) {
+    WSDB_THROW(WSDB_INDEX_EXIST, index_name);
+  }
+  idx_mgr_->CreateIndex(db_name_, index_name, tab_name, key_schema, idx_type, include_schema);
+  IndexHandleUptr idx_hdl;
+  try {
+    idx_hdl = idx_mgr_->OpenIndex(db_name_, index_name, tab->GetTableId());
+    if (load != nullptr) {
+      load(*idx_hdl);
+    } else {
+      FillIndex(*tab, *idx_hdl);
+    }
+  } catch (WSDBException_ &e) {
+    if (idx_hdl != nullptr) {
+      idx_mgr_->CloseIndex(*idx_hdl);
+    }
+    idx_mgr_->DropIndex(db_name_, index_name);
+    throw;
+  }
+  auto iid      = idx_hdl->GetIndexId();
+  indexes_[iid] = std::move(idx_hdl);
+  tab_idx_map_[tab->GetTableId()].push_back(iid);
+  FlushMeta();
+}
+
+void DatabaseHandle::OpenIndex(const std::string &index_name, IndexType idx_type)
+{
+  auto tab_name = idx_mgr_->GetTableName(db_name_, index_name);
+  auto tab      = GetTable(tab_name);
+  if (tab == nullptr) {
+    WSDB_THROW(WSDB_TABLE_MISS, tab_name);
+  }
+  auto idx_hdl = idx_mgr_->OpenIndex(db_name_, index_name, tab->GetTableId());
+  try {
+    if (idx_hdl->GetIndexType() != idx_type) {
+      WSDB_THROW(WSDB_FILE_READ_ERROR, fmt::format("index type {}", IndexTypeToString(idx_hdl->GetIndexType())));
+    }
+    for (const auto &field : idx_hdl->GetEntrySchema().GetFields()) {
+      if (tab->GetSchema().GetFieldIndex(tab->GetTableId(), field.field_.field_name_) ==
+          tab->GetSchema().GetFieldCount()) {
+        WSDB_THROW(WSDB_FIELD_MISS, field.field_.field_name_);
+      }
+    }
+    if (idx_type == IndexType::ART) {
+      FillIndex(*tab, *idx_hdl);
+    }
+  } catch (WSDBException_ &e) {
+    idx_mgr_->CloseIndex(*idx_hdl);
+    throw;
+  }
+  auto iid      = idx_hdl->GetIndexId();
+  indexes_[iid] = std::move(idx_hdl);
+  tab_idx_map_[tab->GetTableId()].push_back(iid);
+}
+
+void DatabaseHandle::FillIndex(TableHandle &tab, IndexHandle &index)
 {
-  WSDB_THROW(WSDB_NOT_IMPLEMENTED, "");
+  for (auto pid = FILE_HEADER_PAGE_ID + 1; pid < static_cast<page_id_t>(tab.GetTableHeader().page_num_); ++pid) {
+    for (const auto &record : tab.GetPageRecords(pid, nullptr, nullptr, nullptr)) {
+      index.InsertRecord(*record);
+    }
+  }
 }
 
 void DatabaseHandle::DropIndex(const std::string &idx_name)
 {
-  WSDB_THROW(WSDB_NOT_IMPLEMENTED, "");
+  auto index = GetIndex(idx_name);
+  if (index == nullptr) {
+    WSDB_THROW(WSDB_INDEX_MISS, idx_name);
+  }
+  auto iid = index->GetIndexId();
+  tab_idx_map_[index->GetTableId()].remove(iid);
+  idx_mgr_->CloseIndex(*index);
+  idx_mgr_->DropIndex(db_name_, idx_name);
+  indexes_.erase(iid);
+  FlushMeta();
+}
+
+auto DatabaseHandle::MakeIndexName(const std::string &tab_name, const RecordSchema &key_schema) -> std::string
+{
+  auto index_name = tab_name;
+  for (const auto &field : key_schema.GetFields()) {
+    index_name += "_" + field.field_.field_name_;
+  }
+  return index_name;
 }
 
 auto DatabaseHandle::GetTable(const std::string &tab_name) -> TableHandle *
@@ -220,6 +304,16 @@ auto DatabaseHandle::GetIndex(idx_id_t iid) -> IndexHandle *
   return indexes_[iid].get();
 }
 
+auto DatabaseHandle::GetIndex(const std::string &idx_name) -> IndexHandle *
+{
+  for (auto &index : indexes_) {
+    if (index.second->GetIndexName() == idx_name) {
+      return index.second.get();
+    }
+  }
+  return nullptr;
+}
+
 auto DatabaseHandle::GetIndexes(table_id_t tid) -> std::list<IndexHandle *>
 {
   WSDB_ASSERT(tid != INVALID_TABLE_ID, std::to_string(tid));
@@ -46,10 +46,25 @@ public:
 
   void DropTable(const std::string &tab_name);
 
-  void CreateIndex(const std::string &tab_name, const RecordSchema &key_schema, IndexType idx_type);
+  /**
+   * create an index on the key fields of a table and insert the records of the table into it
+   * @param tab_name
+   * @param key_schema fields of the table
+   * @param idx_type
+   * @param include_schema fields of the table stored in the index entries besides the key, nullptr if there is none
+   * @param load fills the new index with the records of the table, they are inserted one by one in the order of the
+   * table if not given
+   */
+  void CreateIndex(const std::string &tab_name, const RecordSchema &key_schema, IndexType idx_type,
+      const RecordSchema *include_schema = nullptr, const std::function<void(IndexHandle &)> &load = nullptr);
 
   void DropIndex(const std::string &idx_name);
 
+  /**
+   * an index is named by its table and key fields, e.g. the index of table t on (a, b) is t_a_b
+   */
+  static auto MakeIndexName(const std::string &tab_name, const RecordSchema &key_schema) -> std::string;
+
   [[nodiscard]] auto GetName() const -> std::string { return db_name_; }
 
   auto GetTable(const std::string &tab_name) -> TableHandle *;
@@ -60,6 +75,11 @@ public:
 
   auto GetIndex(idx_id_t iid) -> IndexHandle *;
 
+  /**
+   * @return nullptr if there is no index of the name
+   */
+  auto GetIndex(const std::string &idx_name) -> IndexHandle *;
+
   auto GetIndexes(table_id_t tid) -> std::list<IndexHandle *>;
 
   auto GetIndexes(const std::string &tab_name) -> std::list<IndexHandle *>;
@@ -73,6 +93,15 @@ public:
   std::atomic<int> ref_cnt_;
 
 private:
+  /**
+   * open an index listed in the .db file by the IndexHeader of its file, an ART index is filled with the records of
+   * its table since it keeps its entries in memory
+   */
+  void OpenIndex(const std::string &index_name, IndexType idx_type);
+
+  /// insert the records of the table into the index one by one in the order of the table
+  static void FillIndex(TableHandle &tab, IndexHandle &index);
+
   std::string db_name_;
 
   DiskManager *disk_manager_;
@@ -20,39 +20,177 @@
 //
 
 #include "index_handle.h"
+#include "key_encoder.h"
+
+#include <algorithm>
+#include <cstring>
 
 namespace wsdb {
 IndexHandle::IndexHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, table_id_t tid,
-    idx_id_t iid, IndexType index_type)
+    idx_id_t iid, RecordSchemaUptr key_schema, IndexType index_type, RecordSchemaUptr include_schema)
     : disk_manager_(disk_manager),
       buffer_pool_manager_(buffer_pool_manager),
       table_id_(tid),
       index_id_(iid),
-      index_(nullptr)
+      index_(nullptr),
+      key_schema_(std::move(key_schema)),
+      include_schema_(std::move(include_schema)),
+      entry_num_(0)
 {
-  // FIXME: index information should be parsed here, not just pass the index id into the index
-  // TODO(ziqi): parse index information from FILE_HEADER_PAGE here, including index key schema, index specific
-  // information, etc.
+  auto entry_fields = key_schema_->GetFields();
+  if (include_schema_ != nullptr) {
+    entry_fields.insert(entry_fields.end(), include_schema_->GetFields().begin(), include_schema_->GetFields().end());
+  }
+  entry_schema_ = std::make_unique<RecordSchema>(entry_fields);
+  // the schemas and the type are parsed from the IndexHeader by IndexManager::OpenIndex, and the index reads the
+  // header of its structure from the rest of the file header page
   switch (index_type) {
     case IndexType::BPTREE: {
-      // bpt_param = ParseBPTreeIndex();
-      index_ = new BPTreeIndex(disk_manager, buffer_pool_manager, iid, key_schema_.get());
+      index_ = new BPTreeIndex(disk_manager, buffer_pool_manager, iid, key_schema_.get(), include_schema_.get());
       break;
     }
     case IndexType::HASH: {
-      // hash_param = ParseHashIndex();
+      if (include_schema_ != nullptr) {
+        WSDB_THROW(WSDB_UNSUPPORTED_OP, "included fields of a hash index");
+      }
       index_ = new HashIndex(disk_manager, buffer_pool_manager, iid, key_schema_.get());
       break;
     }
+    case IndexType::ART: {
+      index_ = new ARTIndex(disk_manager, buffer_pool_manager, iid, key_schema_.get(), include_schema_.get());
+      break;
+    }
     default: WSDB_FETAL(fmt::format("{}", static_cast<int>(index_type)));
   }
 }
 
-void IndexHandle::InsertRecord(const Record &rec) {}
+void IndexHandle::InsertRecord(const Record &rec)
+{
+  if (include_schema_ == nullptr) {
+    index_->Insert(Record(key_schema_.get(), rec), rec.GetRID());
+  } else {
+    Record include(include_schema_.get(), rec);
+    index_->Insert(Record(key_schema_.get(), rec), rec.GetRID(), &include);
+  }
+  entry_num_++;
+}
+
+void IndexHandle::DeleteRecord(const Record &rec)
+{
+  index_->Delete(Record(key_schema_.get(), rec), rec.GetRID());
+  entry_num_--;
+}
+
+void IndexHandle::UpdateRecord(const Record &old_rec, const Record &new_rec)
+{
+  if (!IsEntryChanged(old_rec, new_rec)) {
+    return;
+  }
+  DeleteRecord(old_rec);
+  InsertRecord(new_rec);
+}
+
+void IndexHandle::InsertRecords(const std::vector<const Record *> &recs)
+{
+  auto sorted = recs;
+  SortByKey(sorted);
+  for (auto rec : sorted) {
+    InsertRecord(*rec);
+  }
+}
+
+void IndexHandle::DeleteRecords(const std::vector<const Record *> &recs)
+{
+  auto sorted = recs;
+  SortByKey(sorted);
+  for (auto rec : sorted) {
+    DeleteRecord(*rec);
+  }
+}
+
+void IndexHandle::UpdateRecords(const std::vector<std::pair<const Record *, const Record *>> &updates)
+{
+  std::vector<const Record *> old_recs;
+  std::vector<const Record *> new_recs;
+  for (const auto &[old_rec, new_rec] : updates) {
+    if (IsEntryChanged(*old_rec, *new_rec)) {
+      old_recs.push_back(old_rec);
+      new_recs.push_back(new_rec);
+    }
+  }
+  // all the old entries are deleted first, since a new key may be the old key of another record
+  DeleteRecords(old_recs);
+  InsertRecords(new_recs);
+}
+
+auto IndexHandle::IsEntryChanged(const Record &old_rec, const Record &new_rec) const -> bool
+{
+  if (old_rec.GetRID() != new_rec.GetRID() ||
+      !(Record(key_schema_.get(), old_rec) == Record(key_schema_.get(), new_rec))) {
+    return true;
+  }
+  return include_schema_ != nullptr &&
+         !(Record(include_schema_.get(), old_rec) == Record(include_schema_.get(), new_rec));
+}
+
+void IndexHandle::SortByKey(std::vector<const Record *> &recs) const
+{
+  // the buckets of a hash index are not in key order
+  if (recs.size() < 2 || GetIndexType() == IndexType::HASH) {
+    return;
+  }
+  // the keys are normalized once instead of comparing the values of the records for each pair
+  KeyEncoder          encoder(recs.front()->GetSchema(), key_schema_.get(), false);
+  auto                key_size = encoder.GetKeySize();
+  std::vector<char>   keys(recs.size() * key_size);
+  std::vector<size_t> order(recs.size());
+  for (size_t i = 0; i < recs.size(); ++i) {
+    encoder.Encode(*recs[i], keys.data() + i * key_size);
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+    auto cmp = std::memcmp(keys.data() + lhs * key_size, keys.data() + rhs * key_size, key_size);
+    if (cmp != 0) {
+      return cmp < 0;
+    }
+    auto lrid = recs[lhs]->GetRID();
+    auto rrid = recs[rhs]->GetRID();
+    return std::make_pair(lrid.PageID(), lrid.SlotID()) < std::make_pair(rrid.PageID(), rrid.SlotID());
+  });
+  std::vector<const Record *> sorted(recs.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    sorted[i] = recs[order[i]];
+  }
+  recs = std::move(sorted);
+}
+
+auto IndexHandle::Search(const Record &key, size_t cmp_field_num) -> std::vector<RID>
+{
+  return index_->Search(key, cmp_field_num);
+}
+
+auto IndexHandle::SearchRange(const IndexBound &low, const IndexBound &high) -> std::vector<RID>
+{
+  return index_->SearchRange(low, high);
+}
 
-void IndexHandle::DeleteRecord(const Record &rec) {}
+auto IndexHandle::SearchRangeRecords(const IndexBound &low, const IndexBound &high) -> std::vector<RecordUptr>
+{
+  return index_->SearchRangeRecords(low, high, entry_schema_.get());
+}
 
-void IndexHandle::UpdateRecord(const Record &old_rec, const Record &new_rec) {}
+void IndexHandle::BulkLoad(const std::function<RecordUptr()> &next, double fill_factor)
+{
+  size_t loaded = 0;
+  index_->BulkLoad(
+      [&next, &loaded]() {
+        auto rec = next();
+        loaded += rec == nullptr ? 0 : 1;
+        return rec;
+      },
+      fill_factor);
+  entry_num_ += loaded;
+}
 
 IndexHandle::~IndexHandle() { delete index_; }
 }  // namespace wsdb
\ No newline at end of file
@@ -23,12 +23,14 @@
 #define WSDB_INDEX_HANDLE_H
 #include "storage/index/index.h"
 
+#include <atomic>
+
 namespace wsdb {
 class IndexHandle
 {
 public:
   IndexHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, table_id_t tid, idx_id_t iid,
-      IndexType index_type);
+      RecordSchemaUptr key_schema, IndexType index_type, RecordSchemaUptr include_schema = nullptr);
 
   ~IndexHandle();
 
@@ -45,12 +47,63 @@ public:
   void DeleteRecord(const Record &rec);
 
   /**
-   * update the old record to the new record in the index, rid is recorded in new_rec
+   * update the old record to the new record in the index, rid is recorded in new_rec. nothing is done if neither the
+   * key nor the included fields are changed
    * @param old_rec
    * @param new_rec
    */
   void UpdateRecord(const Record &old_rec, const Record &new_rec);
 
+  /**
+   * insert the records of a statement into the index in the order of their keys, so that the pages of an ordered
+   * index are visited once in key order instead of in the order of the records
+   * @param recs records of the same schema
+   */
+  void InsertRecords(const std::vector<const Record *> &recs);
+
+  /**
+   * delete a batch of records of a statement from the index in the order of their keys, see InsertRecords
+   * @param recs records of the same schema
+   */
+  void DeleteRecords(const std::vector<const Record *> &recs);
+
+  /**
+   * update a batch of records of a statement in the index, the old entries are deleted and then the new ones are
+   * inserted in the order of their keys. the pairs changing neither the key nor the included fields are skipped
+   * @param updates pairs of the old record and the new record
+   */
+  void UpdateRecords(const std::vector<std::pair<const Record *, const Record *>> &updates);
+
+  /**
+   * find the records whose keys match the first cmp_field_num fields of the given key
+   * @param key record of the index key schema
+   * @param cmp_field_num
+   * @return rids of the matched records
+   */
+  auto Search(const Record &key, size_t cmp_field_num) -> std::vector<RID>;
+
+  /**
+   * @param low
+   * @param high
+   * @return rids of the records whose keys are in the range between low and high
+   */
+  auto SearchRange(const IndexBound &low, const IndexBound &high) -> std::vector<RID>;
+
+  /**
+   * @param low
+   * @param high
+   * @return records of the entry schema built from the entries whose keys are in the range between low and high,
+   * without reading the table
+   */
+  auto SearchRangeRecords(const IndexBound &low, const IndexBound &high) -> std::vector<RecordUptr>;
+
+  /**
+   * fill the empty index with the records of the table, see Index::BulkLoad
+   * @param next returns the next record of the table, in the order of the key if the index is ordered
+   * @param fill_factor
+   */
+  void BulkLoad(const std::function<RecordUptr()> &next, double fill_factor);
+
   [[nodiscard]] auto GetTableId() const -> table_id_t { return table_id_; }
 
   [[nodiscard]] auto GetIndexId() const -> idx_id_t { return index_id_; }
@@ -62,18 +115,38 @@ public:
   auto GetIndexName() const -> const std::string
   {
     auto file_name = disk_manager_->GetFileName(index_id_);
-    return file_name.substr(0, file_name.size() - IDX_SUFFIX.size());
+    return OBJNAME_FROM_FILENAME(file_name);
   }
 
+  /// number of the entries inserted through the handle, kept in the IndexHeader when the index is closed
+  [[nodiscard]] auto GetEntryNum() const -> size_t { return entry_num_; }
+
+  void SetEntryNum(size_t entry_num) { entry_num_ = entry_num; }
+
   auto GetKeySchema() const -> const RecordSchema & { return *key_schema_; }
 
+  /// fields stored in the entries besides the key, nullptr if there is none
+  auto GetIncludeSchema() const -> const RecordSchema * { return include_schema_.get(); }
+
+  /// the key fields followed by the included fields, i.e. the fields a scan can read from the index alone
+  auto GetEntrySchema() const -> const RecordSchema & { return *entry_schema_; }
+
 private:
-  DiskManager       *disk_manager_;
-  BufferPoolManager *buffer_pool_manager_;
-  table_id_t         table_id_;
-  idx_id_t           index_id_;
-  Index             *index_;
-  RecordSchemaUptr   key_schema_;
+  /// whether the entry of the record in the index is changed by the update
+  [[nodiscard]] auto IsEntryChanged(const Record &old_rec, const Record &new_rec) const -> bool;
+
+  /// sort the records by key and rid if the index is ordered
+  void SortByKey(std::vector<const Record *> &recs) const;
+
+  DiskManager        *disk_manager_;
+  BufferPoolManager  *buffer_pool_manager_;
+  table_id_t          table_id_;
+  idx_id_t            index_id_;
+  Index              *index_;
+  RecordSchemaUptr    key_schema_;
+  RecordSchemaUptr    include_schema_;
+  RecordSchemaUptr    entry_schema_;
+  std::atomic<size_t> entry_num_;
 };
 
 DEFINE_UNIQUE_PTR(IndexHandle);
@@ -0,0 +1,154 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+#include "key_encoder.h"
+
+#include <cstring>
+
+namespace wsdb {
+
+static void StoreBigEndian(uint32_t value, char *dst)
+{
+  for (int i = 3; i >= 0; --i) {
+    dst[i] = static_cast<char>(value & 0xff);
+    value >>= 8;
+  }
+}
+
+static auto LoadBigEndian(const char *src) -> uint32_t
+{
+  uint32_t value = 0;
+  for (int i = 0; i < 4; ++i) {
+    value = value << 8 | static_cast<uint8_t>(src[i]);
+  }
+  return value;
+}
+
+KeyEncoder::KeyEncoder(const RecordSchema *schema, const RecordSchema *key_schema, bool is_desc) : is_desc_(is_desc)
+{
+  for (const auto &rtfield : key_schema->GetFields()) {
+    auto idx = schema->GetRTFieldIndex(rtfield);
+    if (idx == schema->GetFieldCount()) {
+      WSDB_THROW(WSDB_FIELD_MISS, rtfield.ToString());
+    }
+    auto &field = schema->GetFieldAt(idx).field_;
+    fields_.push_back({field.field_type_, field.field_size_, idx, schema->GetFieldOffset(idx)});
+    key_size_ += 1 + field.field_size_;
+  }
+}
+
+void KeyEncoder::Encode(const Record &record, char *key) const
+{
+  auto dst = key;
+  for (const auto &field : fields_) {
+    if (BitMap::GetBit(record.GetNullMap(), field.rec_idx_)) {
+      std::memset(dst, 0, 1 + field.size_);
+    } else {
+      dst[0] = 1;
+      EncodeField(field, record.GetData() + field.rec_offset_, dst + 1);
+    }
+    dst += 1 + field.size_;
+  }
+  if (is_desc_) {
+    for (size_t i = 0; i < key_size_; ++i) {
+      key[i] = static_cast<char>(~key[i]);
+    }
+  }
+}
+
+void KeyEncoder::Decode(const char *key, char *null_map, char *data) const
+{
+  std::vector<char> inverted;
+  if (is_desc_) {
+    inverted.assign(key, key + key_size_);
+    for (auto &byte : inverted) {
+      byte = static_cast<char>(~byte);
+    }
+    key = inverted.data();
+  }
+  auto src = key;
+  for (const auto &field : fields_) {
+    auto is_null = src[0] == 0;
+    BitMap::SetBit(null_map, field.rec_idx_, is_null);
+    if (is_null) {
+      std::memset(data + field.rec_offset_, 0, field.size_);
+    } else {
+      DecodeField(field, src + 1, data + field.rec_offset_);
+    }
+    src += 1 + field.size_;
+  }
+}
+
+void KeyEncoder::EncodeField(const KeyField &field, const char *data, char *key)
+{
+  switch (field.type_) {
+    case TYPE_INT: {
+      int32_t value;
+      std::memcpy(&value, data, sizeof(int32_t));
+      StoreBigEndian(static_cast<uint32_t>(value) ^ 0x80000000U, key);
+      break;
+    }
+    case TYPE_FLOAT: {
+      float value;
+      std::memcpy(&value, data, sizeof(float));
+      if (value == 0.0f) {
+        value = 0.0f;
+      }
+      uint32_t bits;
+      std::memcpy(&bits, &value, sizeof(float));
+      StoreBigEndian((bits & 0x80000000U) != 0 ? ~bits : bits | 0x80000000U, key);
+      break;
+    }
+    case TYPE_BOOL: key[0] = static_cast<char>(*data != 0); break;
+    case TYPE_STRING: {
+      auto len = strnlen(data, field.size_);
+      std::memcpy(key, data, len);
+      std::memset(key + len, 0, field.size_ - len);
+      break;
+    }
+    default: WSDB_THROW(WSDB_UNSUPPORTED_OP, FieldTypeToString(field.type_));
+  }
+}
+
+void KeyEncoder::DecodeField(const KeyField &field, const char *key, char *data)
+{
+  switch (field.type_) {
+    case TYPE_INT: {
+      auto value = static_cast<int32_t>(LoadBigEndian(key) ^ 0x80000000U);
+      std::memcpy(data, &value, sizeof(int32_t));
+      break;
+    }
+    case TYPE_FLOAT: {
+      auto bits = LoadBigEndian(key);
+      bits      = (bits & 0x80000000U) != 0 ? bits & ~0x80000000U : ~bits;
+      std::memcpy(data, &bits, sizeof(float));
+      break;
+    }
+    case TYPE_BOOL:
+      std::memset(data, 0, field.size_);
+      data[0] = key[0];
+      break;
+    case TYPE_STRING: std::memcpy(data, key, field.size_); break;
+    default: WSDB_THROW(WSDB_UNSUPPORTED_OP, FieldTypeToString(field.type_));
+  }
+}
+
+}  // namespace wsdb
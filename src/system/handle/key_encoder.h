@@ -0,0 +1,102 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+#ifndef WSDB_KEY_ENCODER_H
+#define WSDB_KEY_ENCODER_H
+
+#include <string_view>
+#include "record_handle.h"
+
+namespace wsdb {
+
+/**
+ * Encode the key fields of a record into a normalized key, i.e. a fixed-size byte string whose memcmp order is the
+ * order of Record::Compare over the key fields, so keys can be compared, sorted byte by byte and hashed without
+ * building Values. Each field is encoded as a null flag byte followed by field_size_ bytes:
+ * - null: flag 0 and zero bytes, so nulls come first as in Record::Compare
+ * - int: big-endian with the sign bit flipped
+ * - float: big-endian IEEE bits, all bits flipped for negative values and the sign bit flipped otherwise,
+ *   -0.0 is encoded as 0.0 since they are equal
+ * - bool: one byte
+ * - string: the bytes before the first '\0', padded with zeros
+ * For a descending order all the bytes of the key are inverted.
+ */
+class KeyEncoder
+{
+public:
+  KeyEncoder() = delete;
+
+  /**
+   * @param schema schema of the records to encode
+   * @param key_schema key fields, should be a subset of schema
+   * @param is_desc
+   */
+  KeyEncoder(const RecordSchema *schema, const RecordSchema *key_schema, bool is_desc);
+
+  [[nodiscard]] auto GetKeySize() const -> size_t { return key_size_; }
+
+  /**
+   * Encode the key of a record
+   * @param record record under the schema of the encoder
+   * @param key buffer of at least GetKeySize() bytes
+   */
+  void Encode(const Record &record, char *key) const;
+
+  /**
+   * Decode a normalized key back into the key fields of a record, the other fields are left untouched. Strings are
+   * restored up to their first '\0' and -0.0 is restored as 0.0
+   * @param key key encoded by this encoder
+   * @param null_map null map of a record under the schema of the encoder
+   * @param data data of a record under the schema of the encoder
+   */
+  void Decode(const char *key, char *null_map, char *data) const;
+
+  /**
+   * Hash a normalized key, the hash join, its join filter and the hash aggregate all hash their keys by it
+   * @param key
+   * @param key_size
+   */
+  [[nodiscard]] static auto Hash(const char *key, size_t key_size) -> size_t
+  {
+    return std::hash<std::string_view>{}(std::string_view(key, key_size));
+  }
+
+private:
+  struct KeyField
+  {
+    FieldType type_;
+    size_t    size_;
+    size_t    rec_idx_;     // index of the field in the record
+    size_t    rec_offset_;  // offset of the field in the record data
+  };
+
+  static void EncodeField(const KeyField &field, const char *data, char *key);
+
+  static void DecodeField(const KeyField &field, const char *key, char *data);
+
+  std::vector<KeyField> fields_;
+  size_t                key_size_{0};
+  bool                  is_desc_;
+};
+
+}  // namespace wsdb
+
+#endif  // WSDB_KEY_ENCODER_H
@@ -35,6 +35,10 @@ void PageHandle::WriteSlot(size_t slot_id, const char *null_map, const char *dat
 }
 
 void PageHandle::ReadSlot(size_t slot_id, char *null_map, char *data) { WSDB_THROW(WSDB_EXCEPTION_EMPTY, ""); }
+void PageHandle::ReadSlotFields(size_t slot_id, const std::vector<size_t> &field_ids, char *null_map, char *data)
+{
+  WSDB_THROW(WSDB_EXCEPTION_EMPTY, "");
+}
 auto PageHandle::ReadChunk(const RecordSchema *chunk_schema) -> ChunkUptr { WSDB_THROW(WSDB_EXCEPTION_EMPTY, ""); }
 
 NAryPageHandle::NAryPageHandle(const TableHeader *tab_hdr, Page *page)
@@ -106,6 +110,23 @@ void PAXPageHandle::ReadSlot(size_t slot_id, char *null_map, char *data) {
   }
 }
 
+void PAXPageHandle::ReadSlotFields(size_t slot_id, const std::vector<size_t> &field_ids, char *null_map, char *data)
+{
+  WSDB_ASSERT(slot_id < tab_hdr_->rec_per_page_, "slot_id out of range");
+  WSDB_ASSERT(BitMap::GetBit(bitmap_, slot_id) == true, "slot is empty");
+  // only the stripes of the required fields are touched
+  const char *slot_null_map   = slots_mem_ + slot_id * tab_hdr_->nullmap_size_;
+  size_t      null_map_offset = tab_hdr_->nullmap_size_ * tab_hdr_->rec_per_page_;
+  size_t      data_offset     = 0;
+  for (size_t i = 0; i < field_ids.size(); ++i) {
+    size_t field_idx  = field_ids[i];
+    size_t field_size = schema_->GetFieldAt(field_idx).field_.field_size_;
+    memcpy(data + data_offset, slots_mem_ + null_map_offset + offsets_[field_idx] + field_size * slot_id, field_size);
+    BitMap::SetBit(null_map, i, BitMap::GetBit(slot_null_map, field_idx));
+    data_offset += field_size;
+  }
+}
+
 auto PAXPageHandle::ReadChunk(const RecordSchema *chunk_schema) -> ChunkUptr
 {
   std::vector<ArrayValueSptr> col_arrs;
@@ -45,6 +45,16 @@ public:
 
   virtual void ReadSlot(size_t slot_id, char *null_map, char *data);
 
+  /**
+   * Read only some fields of a record, the fields are packed into data in the order of field_ids, and the n-th bit of
+   * null_map is the null flag of field_ids[n]
+   * @param slot_id
+   * @param field_ids indexes of the fields in the table schema
+   * @param null_map
+   * @param data
+   */
+  virtual void ReadSlotFields(size_t slot_id, const std::vector<size_t> &field_ids, char *null_map, char *data);
+
   virtual auto ReadChunk(const RecordSchema *chunk_schema) -> ChunkUptr;
 
   virtual ~PageHandle() = default;
@@ -96,6 +106,8 @@ public:
 
   void ReadSlot(size_t slot_id, char *null_map, char *data) override;
 
+  void ReadSlotFields(size_t slot_id, const std::vector<size_t> &field_ids, char *null_map, char *data) override;
+
   auto ReadChunk(const RecordSchema *chunk_schema) -> ChunkUptr override;
 
 private:
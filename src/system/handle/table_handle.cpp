@@ -29,7 +29,8 @@ TableHandle::TableHandle(DiskManager *disk_manager, BufferPoolManager *buffer_po
       disk_manager_(disk_manager),
       buffer_pool_manager_(buffer_pool_manager),
       schema_(std::move(schema)),
-      storage_model_(storage_model)
+      storage_model_(storage_model),
+      zone_map_(schema_.get())
 {
   // set table id for table handle;
   schema_->SetTableId(table_id_);
@@ -72,6 +73,58 @@ auto TableHandle::GetChunk(page_id_t pid, const RecordSchema *chunk_schema) -> C
   return cnk;
 }
 
+auto TableHandle::GetPageRecords(page_id_t pid, const RecordSchema *out_schema, const RecordSchema *filter_schema,
+    const std::function<bool(const Record &)> &filter) -> std::vector<RecordUptr>
+{
+  if (out_schema == nullptr) {
+    out_schema = schema_.get();
+  }
+  if (filter_schema == nullptr) {
+    filter_schema = schema_.get();
+  }
+  // columns can be read separately only when they are stored in stripes
+  bool by_field = storage_model_ == PAX_MODEL;
+  auto out_ids  = by_field ? GetFieldIds(*out_schema) : std::vector<size_t>{};
+  auto flt_ids  = by_field && filter ? GetFieldIds(*filter_schema) : std::vector<size_t>{};
+  auto nullmap  = std::make_unique<char[]>(tab_hdr_.nullmap_size_);
+  auto data     = std::make_unique<char[]>(tab_hdr_.rec_size_);
+
+  std::vector<RecordUptr> records;
+  auto                    pg_hdl = FetchPageHandle(pid);
+  try {
+    auto bitmap = pg_hdl->GetBitmap();
+    for (auto sid = BitMap::FindFirst(bitmap, tab_hdr_.rec_per_page_, 0, true); sid < tab_hdr_.rec_per_page_;
+         sid      = BitMap::FindFirst(bitmap, tab_hdr_.rec_per_page_, sid + 1, true)) {
+      RID rid(pid, static_cast<slot_id_t>(sid));
+      if (!by_field) {
+        pg_hdl->ReadSlot(sid, nullmap.get(), data.get());
+        Record rec(schema_.get(), nullmap.get(), data.get(), rid);
+        if (filter && !filter(rec)) {
+          continue;
+        }
+        records.push_back(out_schema == schema_.get() ? std::make_unique<Record>(std::move(rec))
+                                                      : std::make_unique<Record>(out_schema, rec));
+        records.back()->SetRID(rid);
+        continue;
+      }
+      if (filter) {
+        pg_hdl->ReadSlotFields(sid, flt_ids, nullmap.get(), data.get());
+        if (!filter(Record(filter_schema, nullmap.get(), data.get(), rid))) {
+          continue;
+        }
+      }
+      // late materialization, the rest of the columns are read only for the records passing the filter
+      pg_hdl->ReadSlotFields(sid, out_ids, nullmap.get(), data.get());
+      records.push_back(std::make_unique<Record>(out_schema, nullmap.get(), data.get(), rid));
+    }
+  } catch (...) {
+    buffer_pool_manager_->UnpinPage(table_id_, pid, false);
+    throw;
+  }
+  buffer_pool_manager_->UnpinPage(table_id_, pid, false);
+  return records;
+}
+
 auto TableHandle::InsertRecord(const Record &record) -> RID { 
   //WSDB_STUDENT_TODO(l1, t3); 
   PageHandleUptr pageHandle = CreatePageHandle();
@@ -83,6 +136,7 @@ auto TableHandle::InsertRecord(const Record &record) -> RID {
 
   BitMap::SetBit(bitmap, sid, true);
   Page* page = pageHandle->GetPage();
+  zone_map_.AddRecord(page->GetPageId(), record);
   size_t rn = page->GetRecordNum();
   rn += 1;
   page->SetRecordNum(rn);
@@ -118,6 +172,7 @@ void TableHandle::InsertRecord(const RID &rid, const Record &record)
 
   BitMap::SetBit(bitmap, sid, true);
   Page* page = pageHandle->GetPage();
+  zone_map_.AddRecord(page->GetPageId(), record);
   size_t rn = page->GetRecordNum();
   rn += 1;
   page->SetRecordNum(rn);
@@ -140,6 +195,11 @@ void TableHandle::DeleteRecord(const RID &rid) {
     WSDB_THROW(WSDB_RECORD_MISS, "record not exists");
   }
 
+  auto nullmap = std::make_unique<char[]>(tab_hdr_.nullmap_size_);
+  auto data    = std::make_unique<char[]>(tab_hdr_.rec_size_);
+  pageHandle->ReadSlot(sid, nullmap.get(), data.get());
+  zone_map_.RemoveRecord(pid, Record(schema_.get(), nullmap.get(), data.get(), rid));
+
   BitMap::SetBit(bitmap, sid, false);
   Page* page = pageHandle->GetPage();
   size_t rn = page->GetRecordNum();
@@ -167,7 +227,13 @@ void TableHandle::UpdateRecord(const RID &rid, const Record &record) {
     buffer_pool_manager_->UnpinPage(table_id_, pid, false);
     WSDB_THROW(WSDB_RECORD_MISS, "record not exists");
   }
-  
+
+  auto nullmap = std::make_unique<char[]>(tab_hdr_.nullmap_size_);
+  auto data    = std::make_unique<char[]>(tab_hdr_.rec_size_);
+  pageHandle->ReadSlot(sid, nullmap.get(), data.get());
+  zone_map_.RemoveRecord(pid, Record(schema_.get(), nullmap.get(), data.get(), rid));
+  zone_map_.AddRecord(pid, record);
+
   pageHandle->WriteSlot(sid, record.GetNullMap(), record.GetData(), true);
 
   buffer_pool_manager_->UnpinPage(table_id_, pid, true);
@@ -208,6 +274,16 @@ auto TableHandle::WrapPageHandle(Page *page) -> PageHandleUptr
   }
 }
 
+auto TableHandle::GetFieldIds(const RecordSchema &schema) const -> std::vector<size_t>
+{
+  std::vector<size_t> field_ids;
+  field_ids.reserve(schema.GetFieldCount());
+  for (const auto &field : schema.GetFields()) {
+    field_ids.push_back(schema_->GetRTFieldIndex(field));
+  }
+  return field_ids;
+}
+
 auto TableHandle::GetTableId() const -> table_id_t { return table_id_; }
 
 auto TableHandle::GetTableHeader() const -> const TableHeader & { return tab_hdr_; }
@@ -262,4 +338,18 @@ auto TableHandle::HasField(const std::string &field_name) const -> bool
   return schema_->HasField(table_id_, field_name);
 }
 
+auto TableHandle::GetZoneMap() const -> const ZoneMap & { return zone_map_; }
+
+auto TableHandle::GetZoneMap() -> ZoneMap & { return zone_map_; }
+
+void TableHandle::RebuildZoneMap()
+{
+  zone_map_.Clear();
+  for (auto pid = FILE_HEADER_PAGE_ID + 1; pid < static_cast<page_id_t>(tab_hdr_.page_num_); ++pid) {
+    for (const auto &record : GetPageRecords(pid, nullptr, nullptr, nullptr)) {
+      zone_map_.AddRecord(pid, *record);
+    }
+  }
+}
+
 }  // namespace wsdb
\ No newline at end of file
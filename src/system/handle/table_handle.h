@@ -21,12 +21,14 @@
 
 #ifndef WSDB_TABLE_HANDLE_H
 #define WSDB_TABLE_HANDLE_H
+#include <functional>
 #include <utility>
 
 #include "../../../common/micro.h"
 #include "common/page.h"
 #include "storage/storage.h"
 #include "page_handle.h"
+#include "zone_map.h"
 
 namespace wsdb {
 
@@ -60,6 +62,19 @@ public:
    */
   auto GetChunk(page_id_t pid, const RecordSchema *chunk_schema) -> ChunkUptr;
 
+  /**
+   * Get all records in a page with a single fetch, used by sequential scans.
+   * Only the columns in out_schema are materialized. For pax tables, the columns in filter_schema are read first and
+   * the rest of the columns are read only for the records passing the filter
+   * @param pid
+   * @param out_schema subset of the table schema, nullptr means all columns
+   * @param filter_schema subset of the table schema that the filter reads, nullptr means all columns
+   * @param filter nullptr means no filter
+   * @return records in slot order
+   */
+  auto GetPageRecords(page_id_t pid, const RecordSchema *out_schema, const RecordSchema *filter_schema,
+      const std::function<bool(const Record &)> &filter) -> std::vector<RecordUptr>;
+
   /**
    * Insert a record into the table
    * 1. create a page handle using CreatePageHandle
@@ -121,6 +136,15 @@ public:
 
   [[nodiscard]] auto HasField(const std::string &field_name) const -> bool;
 
+  [[nodiscard]] auto GetZoneMap() const -> const ZoneMap &;
+
+  [[nodiscard]] auto GetZoneMap() -> ZoneMap &;
+
+  /**
+   * Rebuild the zone map by scanning the whole table, used when the zone map file is missing or out of date
+   */
+  void RebuildZoneMap();
+
 private:
   /**
    * Fetch the page handle by page id
@@ -148,6 +172,13 @@ private:
    */
   auto WrapPageHandle(Page *page) -> PageHandleUptr;
 
+  /**
+   * Get the indexes of the fields of a sub schema in the table schema
+   * @param schema
+   * @return
+   */
+  auto GetFieldIds(const RecordSchema &schema) const -> std::vector<size_t>;
+
 private:
   TableHeader tab_hdr_;
   table_id_t  table_id_;
@@ -169,6 +200,9 @@ private:
   // ...
   // | field_m_1, field_m_2, ... , field_m_n |
   std::vector<size_t> field_offset_;
+
+  // per page min/max summaries of the columns, maintained by insert, update and delete
+  ZoneMap zone_map_;
 };
 
 DEFINE_UNIQUE_PTR(TableHandle);
@@ -0,0 +1,195 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+#include "zone_map.h"
+
+namespace wsdb {
+
+ZoneMap::ZoneMap(const RecordSchema *schema) : schema_(schema) {}
+
+void ZoneMap::AddRecord(page_id_t pid, const Record &record)
+{
+  auto &zone = GetZone(pid);
+  zone.rec_num_++;
+  rec_num_++;
+  for (size_t i = 0; i < schema_->GetFieldCount(); ++i) {
+    auto value = record.GetValueAt(i);
+    if (value->IsNull()) {
+      zone.null_nums_[i]++;
+      continue;
+    }
+    zone.mins_[i] = Value::Min(zone.mins_[i], value);
+    zone.maxs_[i] = Value::Max(zone.maxs_[i], value);
+  }
+}
+
+void ZoneMap::RemoveRecord(page_id_t pid, const Record &record)
+{
+  auto &zone = GetZone(pid);
+  WSDB_ASSERT(zone.rec_num_ > 0, fmt::format("zone of page {} is empty", pid));
+  zone.rec_num_--;
+  rec_num_--;
+  if (zone.rec_num_ == 0) {
+    ResetZone(zone);
+    return;
+  }
+  for (size_t i = 0; i < schema_->GetFieldCount(); ++i) {
+    if (BitMap::GetBit(record.GetNullMap(), i)) {
+      zone.null_nums_[i]--;
+    }
+  }
+}
+
+auto ZoneMap::MayMatch(page_id_t pid, const ConditionVec &conds) const -> bool
+{
+  if (pid < 0 || static_cast<size_t>(pid) >= zones_.size()) {
+    return true;
+  }
+  const auto &zone = zones_[pid];
+  if (zone.rec_num_ == 0) {
+    return false;
+  }
+  return std::all_of(
+      conds.begin(), conds.end(), [this, &zone](const Condition &cond) { return CondMayMatch(zone, cond); });
+}
+
+void ZoneMap::Clear()
+{
+  zones_.clear();
+  rec_num_ = 0;
+}
+
+auto ZoneMap::Serialize() const -> std::string
+{
+  size_t      nullmap_size = BITMAP_SIZE(schema_->GetFieldCount());
+  size_t      rec_size     = schema_->GetRecordLength();
+  size_t      page_num     = zones_.size();
+  std::string data;
+  data.reserve(sizeof(size_t) + page_num * (sizeof(size_t) * (schema_->GetFieldCount() + 1) +
+                                                2 * (nullmap_size + rec_size)));
+  data.append(reinterpret_cast<const char *>(&page_num), sizeof(size_t));
+  for (const auto &zone : zones_) {
+    data.append(reinterpret_cast<const char *>(&zone.rec_num_), sizeof(size_t));
+    data.append(reinterpret_cast<const char *>(zone.null_nums_.data()), sizeof(size_t) * zone.null_nums_.size());
+    Record min_rec(schema_, zone.mins_, INVALID_RID);
+    Record max_rec(schema_, zone.maxs_, INVALID_RID);
+    data.append(min_rec.GetNullMap(), nullmap_size).append(min_rec.GetData(), rec_size);
+    data.append(max_rec.GetNullMap(), nullmap_size).append(max_rec.GetData(), rec_size);
+  }
+  return data;
+}
+
+auto ZoneMap::Deserialize(const std::string &data) -> bool
+{
+  Clear();
+  size_t field_num    = schema_->GetFieldCount();
+  size_t nullmap_size = BITMAP_SIZE(field_num);
+  size_t rec_size     = schema_->GetRecordLength();
+  size_t zone_size    = sizeof(size_t) * (field_num + 1) + 2 * (nullmap_size + rec_size);
+  size_t page_num     = 0;
+  if (data.size() < sizeof(size_t)) {
+    return false;
+  }
+  memcpy(&page_num, data.data(), sizeof(size_t));
+  if (data.size() < sizeof(size_t) + page_num * zone_size) {
+    return false;
+  }
+  const char *cursor = data.data() + sizeof(size_t);
+  zones_.resize(page_num);
+  for (auto &zone : zones_) {
+    memcpy(&zone.rec_num_, cursor, sizeof(size_t));
+    cursor += sizeof(size_t);
+    zone.null_nums_.resize(field_num);
+    memcpy(zone.null_nums_.data(), cursor, sizeof(size_t) * field_num);
+    cursor += sizeof(size_t) * field_num;
+    Record min_rec(schema_, cursor, cursor + nullmap_size, INVALID_RID);
+    cursor += nullmap_size + rec_size;
+    Record max_rec(schema_, cursor, cursor + nullmap_size, INVALID_RID);
+    cursor += nullmap_size + rec_size;
+    zone.mins_.resize(field_num);
+    zone.maxs_.resize(field_num);
+    for (size_t i = 0; i < field_num; ++i) {
+      zone.mins_[i] = min_rec.GetValueAt(i);
+      zone.maxs_[i] = max_rec.GetValueAt(i);
+    }
+    rec_num_ += zone.rec_num_;
+  }
+  return true;
+}
+
+auto ZoneMap::GetZone(page_id_t pid) -> PageZone &
+{
+  WSDB_ASSERT(pid >= 0, fmt::format("invalid page id {}", pid));
+  while (zones_.size() <= static_cast<size_t>(pid)) {
+    zones_.emplace_back();
+    ResetZone(zones_.back());
+  }
+  return zones_[pid];
+}
+
+void ZoneMap::ResetZone(PageZone &zone) const
+{
+  zone.rec_num_ = 0;
+  zone.null_nums_.assign(schema_->GetFieldCount(), 0);
+  zone.mins_.clear();
+  zone.maxs_.clear();
+  for (const auto &field : schema_->GetFields()) {
+    zone.mins_.push_back(ValueFactory::CreateNullValue(field.field_.field_type_));
+    zone.maxs_.push_back(ValueFactory::CreateNullValue(field.field_.field_type_));
+  }
+}
+
+auto ZoneMap::CondMayMatch(const PageZone &zone, const Condition &cond) const -> bool
+{
+  if (cond.GetRhsType() != kValue) {
+    return true;
+  }
+  auto idx = schema_->GetRTFieldIndex(cond.GetLCol());
+  auto val = cond.GetRVal();
+  if (idx == schema_->GetFieldCount() || val == nullptr || val->IsNull()) {
+    return true;
+  }
+  auto min = zone.mins_[idx];
+  auto max = zone.maxs_[idx];
+  if (min->IsNull()) {
+    // all values in the page are null, only null != value holds
+    return cond.GetOp() == OP_NE;
+  }
+  auto is_num = [](FieldType type) { return type == TYPE_INT || type == TYPE_FLOAT; };
+  if (min->GetType() != val->GetType() && !(is_num(min->GetType()) && is_num(val->GetType()))) {
+    // leave the type error to the evaluation of the condition
+    return true;
+  }
+  // compare in the same way as ConditionExpr
+  ValueFactory::AlignTypes(min, val);
+  ValueFactory::AlignTypes(max, val);
+  switch (cond.GetOp()) {
+    case OP_EQ: return !(*val < *min) && !(*val > *max);
+    case OP_NE: return zone.null_nums_[idx] > 0 || !(*min == *val && *max == *val);
+    case OP_LT: return *min < *val;
+    case OP_LE: return *min <= *val;
+    case OP_GT: return *max > *val;
+    case OP_GE: return *max >= *val;
+    default: return true;
+  }
+}
+
+}  // namespace wsdb
@@ -0,0 +1,110 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+#ifndef WSDB_ZONE_MAP_H
+#define WSDB_ZONE_MAP_H
+
+#include "common/condition.h"
+#include "record_handle.h"
+
+namespace wsdb {
+
+/**
+ * Per page summaries of the columns of a table, scans use them to skip pages that cannot contain qualified records.
+ * For each page and column, the minimum and maximum non-null value and the number of nulls are kept. Min and max are
+ * only widened by insertions and updates, so they always cover the values in the page but may be looser after
+ * deletions, until the page becomes empty.
+ */
+class ZoneMap
+{
+public:
+  ZoneMap() = delete;
+
+  explicit ZoneMap(const RecordSchema *schema);
+
+  /**
+   * Widen the zone of page pid with a record inserted into the page
+   * @param pid
+   * @param record record under the table schema
+   */
+  void AddRecord(page_id_t pid, const Record &record);
+
+  /**
+   * Remove a record from the zone of page pid, the zone is reset when the page becomes empty
+   * @param pid
+   * @param record record under the table schema
+   */
+  void RemoveRecord(page_id_t pid, const Record &record);
+
+  /**
+   * Check whether page pid may contain a record satisfying all the conditions, conditions that cannot be checked by the
+   * zone map, e.g. comparisons between columns, are treated as satisfied
+   * @param pid
+   * @param conds
+   * @return false if no record in the page can satisfy the conditions
+   */
+  [[nodiscard]] auto MayMatch(page_id_t pid, const ConditionVec &conds) const -> bool;
+
+  /// Number of records summarized by the zone map
+  [[nodiscard]] auto GetRecordNum() const -> size_t { return rec_num_; }
+
+  void Clear();
+
+  /**
+   * Serialize the zone map, format:
+   * | page_num | rec_num_1 | null_num_1_1, ..., null_num_1_m | min record_1 | max record_1 | ... | rec_num_n | ...
+   * min and max records are stored as | nullmap | data | under the table schema, a null field means there is no non-null
+   * value in the page
+   * @return
+   */
+  [[nodiscard]] auto Serialize() const -> std::string;
+
+  /**
+   * Load the zone map from the serialized data
+   * @param data
+   * @return false if the data is corrupted, the zone map is cleared in this case
+   */
+  auto Deserialize(const std::string &data) -> bool;
+
+private:
+  struct PageZone
+  {
+    size_t                 rec_num_{0};
+    std::vector<size_t>    null_nums_;
+    std::vector<ValueSptr> mins_;
+    std::vector<ValueSptr> maxs_;
+  };
+
+  auto GetZone(page_id_t pid) -> PageZone &;
+
+  void ResetZone(PageZone &zone) const;
+
+  [[nodiscard]] auto CondMayMatch(const PageZone &zone, const Condition &cond) const -> bool;
+
+private:
+  const RecordSchema   *schema_;
+  std::vector<PageZone> zones_;
+  size_t                rec_num_{0};
+};
+
+}  // namespace wsdb
+
+#endif  // WSDB_ZONE_MAP_H
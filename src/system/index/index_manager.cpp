@@ -21,25 +21,165 @@
 
 #include "index_manager.h"
 
+#include <cstring>
+#include <string_view>
+
 namespace wsdb {
 void IndexManager::CreateIndex(const std::string &db_name, const std::string &index_name,
-    const wsdb::RecordSchema &schema, wsdb::IndexType index_type)
+    const std::string &table_name, const RecordSchema &key_schema, IndexType index_type,
+    const RecordSchema *include_schema)
 {
-  WSDB_THROW(WSDB_NOT_IMPLEMENTED, "");
+  if (key_schema.GetFieldCount() == 0) {
+    WSDB_THROW(WSDB_RECLEN_ERROR, index_name);
+  }
+  IndexHeader header;
+  header.index_type_        = index_type;
+  header.key_field_num_     = key_schema.GetFieldCount();
+  header.include_field_num_ = include_schema == nullptr ? 0 : include_schema->GetFieldCount();
+  // the fields follow the header and the table name, they are arranged as the fields of a table:
+  // field_name1:field_type1:field_size1:field_name2:field_type2:field_size2:...
+  std::vector<char> page(PAGE_SIZE, 0);
+  size_t            offset = 0;
+  auto              write  = [&](const void *src, size_t size) {
+    if (offset + size > INDEX_HEADER_SIZE) {
+      WSDB_THROW(WSDB_RECLEN_ERROR, fmt::format("header of index {}", index_name));
+    }
+    std::memcpy(page.data() + offset, src, size);
+    offset += size;
+  };
+  auto write_fields = [&](const RecordSchema &schema) {
+    for (size_t i = 0; i < schema.GetFieldCount(); ++i) {
+      const FieldSchema &field = schema.GetFieldAt(i).field_;
+      write(field.field_name_.c_str(), field.field_name_.size() + 1);
+      write(&field.field_type_, sizeof(FieldType));
+      write(&field.field_size_, sizeof(size_t));
+    }
+  };
+  write(&header, sizeof(IndexHeader));
+  write(table_name.c_str(), table_name.size() + 1);
+  write_fields(key_schema);
+  if (include_schema != nullptr) {
+    write_fields(*include_schema);
+  }
+  DiskManager::CreateFile(FILE_NAME(db_name, index_name, IDX_SUFFIX));
+  auto index_file = disk_manager_->OpenFile(FILE_NAME(db_name, index_name, IDX_SUFFIX));
+  disk_manager_->WritePage(index_file, FILE_HEADER_PAGE_ID, page.data());
+  disk_manager_->CloseFile(index_file);
 }
 
 void IndexManager::DropIndex(const std::string &db_name, const std::string &index_name)
 {
-  WSDB_THROW(WSDB_NOT_IMPLEMENTED, "");
+  DiskManager::DestroyFile(FILE_NAME(db_name, index_name, IDX_SUFFIX));
+}
+
+auto IndexManager::GetTableName(const std::string &db_name, const std::string &index_name) -> std::string
+{
+  auto                 index_file = disk_manager_->OpenFile(FILE_NAME(db_name, index_name, IDX_SUFFIX));
+  std::string          table_name;
+  std::vector<RTField> key_fields;
+  std::vector<RTField> include_fields;
+  try {
+    ReadIndexHeader(index_file, table_name, key_fields, include_fields);
+  } catch (WSDBException_ &e) {
+    disk_manager_->CloseFile(index_file);
+    throw;
+  }
+  disk_manager_->CloseFile(index_file);
+  return table_name;
 }
-IndexHandleUptr IndexManager::OpenIndex(const std::string &db_name, const std::string &index_name, IndexType index_type)
+
+auto IndexManager::ReadIndexHeader(idx_id_t index_file, std::string &table_name, std::vector<RTField> &key_fields,
+    std::vector<RTField> &include_fields) -> IndexHeader
+{
+  std::vector<char> page(PAGE_SIZE, 0);
+  disk_manager_->ReadPage(index_file, FILE_HEADER_PAGE_ID, page.data());
+  IndexHeader header;
+  std::memcpy(&header, page.data(), sizeof(IndexHeader));
+  // a corrupted header must not make the names run out of the part of the page kept for it
+  const char *cursor = page.data() + sizeof(IndexHeader);
+  const char *end    = page.data() + INDEX_HEADER_SIZE;
+  auto        check  = [&](size_t size) {
+    if (cursor + size > end) {
+      WSDB_THROW(WSDB_FILE_READ_ERROR, fmt::format("header of index {}", disk_manager_->GetFileName(index_file)));
+    }
+  };
+  auto read_name = [&]() {
+    auto len = strnlen(cursor, end - cursor);
+    check(len + 1);
+    std::string name(cursor, len);
+    cursor += len + 1;
+    return name;
+  };
+  auto read_fields = [&](size_t num, std::vector<RTField> &fields) {
+    check(num);  // a field takes more than one byte, which also bounds the number of fields
+    for (size_t i = 0; i < num; ++i) {
+      FieldSchema field;
+      field.field_name_ = read_name();
+      check(sizeof(FieldType) + sizeof(size_t));
+      std::memcpy(&field.field_type_, cursor, sizeof(FieldType));
+      cursor += sizeof(FieldType);
+      std::memcpy(&field.field_size_, cursor, sizeof(size_t));
+      cursor += sizeof(size_t);
+      fields.push_back({.field_ = field});
+    }
+  };
+  table_name = read_name();
+  read_fields(header.key_field_num_, key_fields);
+  read_fields(header.include_field_num_, include_fields);
+  if (key_fields.empty() || std::string_view(IndexTypeToString(header.index_type_)) == "NONE") {
+    WSDB_THROW(WSDB_FILE_READ_ERROR, fmt::format("header of index {}", disk_manager_->GetFileName(index_file)));
+  }
+  return header;
+}
+
+IndexHandleUptr IndexManager::OpenIndex(const std::string &db_name, const std::string &index_name, table_id_t tid)
 {
-  WSDB_THROW(WSDB_NOT_IMPLEMENTED, "");
+  auto index_file = disk_manager_->OpenFile(FILE_NAME(db_name, index_name, IDX_SUFFIX));
+  try {
+    std::string          table_name;
+    std::vector<RTField> key_fields;
+    std::vector<RTField> include_fields;
+    auto                 header = ReadIndexHeader(index_file, table_name, key_fields, include_fields);
+    for (auto &field : key_fields) {
+      field.field_.table_id_ = tid;
+    }
+    for (auto &field : include_fields) {
+      field.field_.table_id_ = tid;
+    }
+    auto index_handle = std::make_unique<IndexHandle>(disk_manager_,
+        buffer_pool_manager_,
+        tid,
+        index_file,
+        std::make_unique<RecordSchema>(key_fields),
+        header.index_type_,
+        include_fields.empty() ? nullptr : std::make_unique<RecordSchema>(include_fields));
+    // the entries of an ART index are kept in memory, it is empty until it is filled again
+    if (header.index_type_ != IndexType::ART) {
+      index_handle->SetEntryNum(header.entry_num_);
+    }
+    return index_handle;
+  } catch (WSDBException_ &e) {
+    buffer_pool_manager_->DeleteAllPages(index_file);
+    disk_manager_->CloseFile(index_file);
+    throw;
+  }
 }
 
 void IndexManager::CloseIndex(const IndexHandle &index_handle)
 {
-  WSDB_THROW(WSDB_NOT_IMPLEMENTED, "");
+  auto index_file = index_handle.GetIndexId();
+  buffer_pool_manager_->FlushAllPages(index_file);
+  buffer_pool_manager_->DeleteAllPages(index_file);
+  // the index structure writes the rest of the file header page through the buffer pool, so the page is updated after
+  // it is flushed
+  std::vector<char> page(PAGE_SIZE, 0);
+  IndexHeader       header;
+  disk_manager_->ReadPage(index_file, FILE_HEADER_PAGE_ID, page.data());
+  std::memcpy(&header, page.data(), sizeof(IndexHeader));
+  header.entry_num_ = index_handle.GetEntryNum();
+  std::memcpy(page.data(), &header, sizeof(IndexHeader));
+  disk_manager_->WritePage(index_file, FILE_HEADER_PAGE_ID, page.data());
+  disk_manager_->CloseFile(index_file);
 }
 
 }  // namespace wsdb
@@ -24,6 +24,7 @@
 #include "system/handle/index_handle.h"
 #include "system/handle/record_handle.h"
 namespace wsdb {
+
 class IndexManager
 {
 public:
@@ -35,16 +36,55 @@ public:
 
   ~IndexManager() = default;
 
-  void CreateIndex(
-      const std::string &db_name, const std::string &index_name, const RecordSchema &schema, IndexType index_type);
+  /**
+   * create the index file, and write the IndexHeader and the schemas into its file header page, the index initializes
+   * the header of its structure when it is opened
+   * file header page: | IndexHeader | table name | key fields | included fields | ... | header of the index structure |
+   * where a field is stored as | field name | field type | field size | like the fields of a table, and the names end
+   * with '\0'
+   * @param db_name
+   * @param index_name
+   * @param table_name table of the index
+   * @param key_schema fields of the table in the index key
+   * @param index_type
+   * @param include_schema fields of the table stored in the entries besides the key, nullptr if there is none
+   */
+  void CreateIndex(const std::string &db_name, const std::string &index_name, const std::string &table_name,
+      const RecordSchema &key_schema, IndexType index_type, const RecordSchema *include_schema = nullptr);
 
   void DropIndex(const std::string &db_name, const std::string &index_name);
 
-  IndexHandleUptr OpenIndex(const std::string &db_name, const std::string &index_name, IndexType index_type);
+  /**
+   * @return name of the table of the index, read from the file header page
+   */
+  auto GetTableName(const std::string &db_name, const std::string &index_name) -> std::string;
+
+  /**
+   * open the index by the type and the schemas in its file header page
+   * @param db_name
+   * @param index_name
+   * @param tid table of the index, the fields of the schemas belong to it
+   * @return
+   */
+  IndexHandleUptr OpenIndex(const std::string &db_name, const std::string &index_name, table_id_t tid);
 
+  /**
+   * flush the pages of the index, write the number of its entries into the IndexHeader and close its file
+   */
   void CloseIndex(const IndexHandle &index_handle);
 
 private:
+  /**
+   * read the file header page of the index
+   * @param index_file
+   * @param[out] table_name
+   * @param[out] key_fields
+   * @param[out] include_fields
+   * @return
+   */
+  auto ReadIndexHeader(idx_id_t index_file, std::string &table_name, std::vector<RTField> &key_fields,
+      std::vector<RTField> &include_fields) -> IndexHeader;
+
   DiskManager       *disk_manager_;
   BufferPoolManager *buffer_pool_manager_;
 };
@@ -27,6 +27,7 @@
 #include "system.h"
 #include "../common/net/net.h"
 #include "context.h"
+#include "concurrency/task_scheduler.h"
 
 namespace wsdb {
 SystemManager::SystemManager() = default;
@@ -172,9 +173,19 @@ void SystemManager::ClientHandler(int client_fd)
         net_controller_->SendOK(client_fd);
       } else {
         /// plan is not a db plan
-        plan           = optimizer_->Optimize(plan, context.db_);
-        auto exec_tree = executor_->Translate(plan, context.db_);
-        executor_->Execute(exec_tree, &context);
+        // the tasks spawned by the executors belong to the statement, they are cancelled when it fails, before the
+        // executors are destroyed, so that their queued tasks are skipped instead of run
+        TaskGroup            query_tasks(TaskPriority::NORMAL, nullptr);
+        TaskScope            query_scope(&query_tasks);
+        AbstractExecutorUptr exec_tree;
+        try {
+          plan      = optimizer_->Optimize(plan, context.db_);
+          exec_tree = executor_->Translate(plan, context.db_);
+          executor_->Execute(exec_tree, &context);
+        } catch (...) {
+          query_tasks.Cancel();
+          throw;
+        }
       }
       // commit transaction if this is a single sql statement
       if (!txn.IsExplicit()) {
@@ -20,6 +20,9 @@
 //
 
 #include "table_manager.h"
+
+#include <filesystem>
+
 #include "common/page.h"
 
 namespace wsdb {
@@ -54,6 +57,9 @@ void TableManager::CreateTable(
 void TableManager::DropTable(const std::string &db_name, const std::string &table_name)
 {
   DiskManager::DestroyFile(FILE_NAME(db_name, table_name, TAB_SUFFIX));
+  if (DiskManager::FileExists(FILE_NAME(db_name, table_name, ZMP_SUFFIX))) {
+    DiskManager::DestroyFile(FILE_NAME(db_name, table_name, ZMP_SUFFIX));
+  }
 }
 
 TableHandleUptr TableManager::OpenTable(
@@ -83,13 +89,17 @@ TableHandleUptr TableManager::OpenTable(
   }
   schema = std::make_unique<RecordSchema>(fields);
   delete[] file_hdr_data;
-  return std::make_unique<TableHandle>(disk_manager_, buffer_pool_manager_, table_file, header, schema, storage_model);
+  auto table_handle =
+      std::make_unique<TableHandle>(disk_manager_, buffer_pool_manager_, table_file, header, schema, storage_model);
+  ReadZoneMap(db_name, table_name, *table_handle);
+  return table_handle;
 }
 
 void TableManager::CloseTable(const std::string &db_name, const TableHandle &table_handle)
 {
   // 1. write table header to the zero page
   WriteTableHeader(table_handle.GetTableId(), table_handle.GetTableHeader(), table_handle.GetSchema());
+  WriteZoneMap(db_name, table_handle);
   // 2. flush all pages to disk
   buffer_pool_manager_->FlushAllPages(table_handle.GetTableId());
   // delete all pages
@@ -111,6 +121,39 @@ void TableManager::WriteTableHeader(table_id_t tid, const TableHeader &header, c
   }
 }
 
+void TableManager::ReadZoneMap(const std::string &db_name, const std::string &table_name, TableHandle &table_handle)
+{
+  auto  zmp_file_name = FILE_NAME(db_name, table_name, ZMP_SUFFIX);
+  auto &zone_map      = table_handle.GetZoneMap();
+  if (DiskManager::FileExists(zmp_file_name)) {
+    std::string data(std::filesystem::file_size(zmp_file_name), '\0');
+    auto        zmp_file = disk_manager_->OpenFile(zmp_file_name);
+    disk_manager_->ReadFile(zmp_file, data.data(), data.size(), 0, SEEK_SET);
+    disk_manager_->CloseFile(zmp_file);
+    // the file is only valid until the table is modified, e.g. an update changes the values but not the number of
+    // records, so it is removed once loaded and written again when the table is closed. a file left by a table that
+    // was not closed properly is thus never read
+    DiskManager::DestroyFile(zmp_file_name);
+    if (zone_map.Deserialize(data) && zone_map.GetRecordNum() == table_handle.GetTableHeader().rec_num_) {
+      return;
+    }
+  }
+  table_handle.RebuildZoneMap();
+}
+
+void TableManager::WriteZoneMap(const std::string &db_name, const TableHandle &table_handle)
+{
+  auto zmp_file_name = FILE_NAME(db_name, table_handle.GetTableName(), ZMP_SUFFIX);
+  if (DiskManager::FileExists(zmp_file_name)) {
+    DiskManager::DestroyFile(zmp_file_name);
+  }
+  DiskManager::CreateFile(zmp_file_name);
+  auto data     = table_handle.GetZoneMap().Serialize();
+  auto zmp_file = disk_manager_->OpenFile(zmp_file_name);
+  disk_manager_->WriteFile(zmp_file, data.data(), data.size(), SEEK_SET);
+  disk_manager_->CloseFile(zmp_file);
+}
+
 auto TableManager::GetTableId(const std::string &db_name, const std::string &table_name) -> table_id_t
 {
   return disk_manager_->GetFileId(FILE_NAME(db_name, table_name, TAB_SUFFIX));
@@ -49,6 +49,17 @@ public:
 private:
   void WriteTableHeader(table_id_t tid, const TableHeader &header, const RecordSchema &schema);
 
+  /**
+   * Load the zone map of the table from its side file and remove the file, rebuild the zone map by scanning the table
+   * if the file is missing or does not match the table. The file is written again by CloseTable
+   * @param db_name
+   * @param table_name
+   * @param table_handle
+   */
+  void ReadZoneMap(const std::string &db_name, const std::string &table_name, TableHandle &table_handle);
+
+  void WriteZoneMap(const std::string &db_name, const TableHandle &table_handle);
+
 private:
   DiskManager       *disk_manager_;
   BufferPoolManager *buffer_pool_manager_;
@@ -0,0 +1,221 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+#include "concurrency/task_scheduler.h"
+
+#include "../config.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(TaskSchedulerTest, Basic)
+{
+  wsdb::TaskScheduler scheduler(4);
+  ASSERT_EQ(scheduler.GetWorkerNum(), 4);
+
+  SUB_TEST(RunAll)
+  {
+    std::atomic<int> sum{0};
+    wsdb::TaskGroup  group(wsdb::TaskPriority::NORMAL, nullptr, &scheduler);
+    for (int i = 1; i <= 1000; ++i) {
+      group.Submit([&sum, i]() { sum += i; });
+    }
+    group.Wait();
+    ASSERT_EQ(sum, 500500);
+  }
+
+  // tasks waiting for their sub tasks must not exhaust the workers
+  SUB_TEST(NestedWait)
+  {
+    std::atomic<int> count{0};
+    wsdb::TaskGroup  group(wsdb::TaskPriority::NORMAL, nullptr, &scheduler);
+    for (int i = 0; i < 16; ++i) {
+      group.Submit([&count, &scheduler]() {
+        wsdb::TaskGroup sub_group(wsdb::TaskPriority::NORMAL, wsdb::TaskGroup::Current(), &scheduler);
+        for (int j = 0; j < 16; ++j) {
+          sub_group.Submit([&count]() { count++; });
+        }
+        sub_group.Wait();
+      });
+    }
+    group.Wait();
+    ASSERT_EQ(count, 256);
+  }
+
+  SUB_TEST(Exception)
+  {
+    wsdb::TaskGroup group(wsdb::TaskPriority::NORMAL, nullptr, &scheduler);
+    group.Submit([]() { throw std::runtime_error("task failed"); });
+    ASSERT_THROW(group.Wait(), std::runtime_error);
+    ASSERT_TRUE(group.IsCancelled());
+  }
+}
+
+TEST(TaskSchedulerTest, Cancel)
+{
+  wsdb::TaskScheduler scheduler(1);
+  std::atomic<bool>   started{false};
+  std::atomic<bool>   release{false};
+  std::atomic<int>    count{0};
+
+  wsdb::TaskGroup blocker(wsdb::TaskPriority::NORMAL, nullptr, &scheduler);
+  blocker.Submit([&]() {
+    started = true;
+    while (!release) {
+      std::this_thread::yield();
+    }
+  });
+  while (!started) {
+    std::this_thread::yield();
+  }
+
+  // the only worker is busy, so none of the tasks below can start before the cancellation
+  wsdb::TaskGroup parent(wsdb::TaskPriority::NORMAL, nullptr, &scheduler);
+  wsdb::TaskGroup child(wsdb::TaskPriority::NORMAL, &parent, &scheduler);
+  for (int i = 0; i < 10; ++i) {
+    child.Submit([&count]() { count++; });
+  }
+  parent.Cancel();
+  ASSERT_TRUE(child.IsCancelled());
+  release = true;
+  child.Wait();
+  blocker.Wait();
+  ASSERT_EQ(count, 0);
+}
+
+TEST(TaskSchedulerTest, Priority)
+{
+  wsdb::TaskScheduler scheduler(1);
+  std::atomic<bool>   started{false};
+  std::atomic<bool>   release{false};
+  std::atomic<int>    done{0};
+  std::vector<int>    order;
+
+  wsdb::TaskGroup blocker(wsdb::TaskPriority::NORMAL, nullptr, &scheduler);
+  blocker.Submit([&]() {
+    started = true;
+    while (!release) {
+      std::this_thread::yield();
+    }
+  });
+  while (!started) {
+    std::this_thread::yield();
+  }
+
+  wsdb::TaskGroup low(wsdb::TaskPriority::LOW, nullptr, &scheduler);
+  wsdb::TaskGroup high(wsdb::TaskPriority::HIGH, nullptr, &scheduler);
+  // only the worker runs the tasks, so the order needs no latch
+  low.Submit([&]() {
+    order.push_back(2);
+    done++;
+  });
+  high.Submit([&]() {
+    order.push_back(1);
+    done++;
+  });
+  release = true;
+  // wait without helping so that the worker decides the order
+  while (done < 2) {
+    std::this_thread::yield();
+  }
+  ASSERT_EQ(order, std::vector<int>({1, 2}));
+}
+
+TEST(TaskSchedulerTest, RunOwnPendingTask)
+{
+  wsdb::TaskScheduler scheduler(1);
+  std::atomic<bool>   started{false};
+  std::atomic<bool>   release{false};
+  std::vector<int>    order;
+
+  wsdb::TaskGroup blocker(wsdb::TaskPriority::NORMAL, nullptr, &scheduler);
+  blocker.Submit([&]() {
+    started = true;
+    while (!release) {
+      std::this_thread::yield();
+    }
+  });
+  while (!started) {
+    std::this_thread::yield();
+  }
+
+  // the only worker is busy, so the tasks below are run by this thread only
+  wsdb::TaskGroup own(wsdb::TaskPriority::HIGH, nullptr, &scheduler);
+  wsdb::TaskGroup other(wsdb::TaskPriority::HIGH, nullptr, &scheduler);
+  other.Submit([&order]() { order.push_back(0); });
+  own.Submit([&order]() { order.push_back(1); });
+  own.Submit([&order]() { order.push_back(2); });
+  ASSERT_TRUE(own.RunOwnPendingTask());
+  ASSERT_TRUE(own.RunOwnPendingTask());
+  ASSERT_FALSE(own.RunOwnPendingTask());
+  ASSERT_EQ(order, std::vector<int>({1, 2}));
+  release = true;
+  other.Wait();
+  blocker.Wait();
+}
+
+TEST(TaskSchedulerTest, WaitOwnTasks)
+{
+  wsdb::TaskScheduler scheduler(1);
+  std::atomic<bool>   started{false};
+  std::atomic<bool>   release{false};
+  std::atomic<bool>   other_started{false};
+  std::atomic<int>    count{0};
+
+  wsdb::TaskGroup blocker(wsdb::TaskPriority::NORMAL, nullptr, &scheduler);
+  blocker.Submit([&]() {
+    started = true;
+    while (!release) {
+      std::this_thread::yield();
+    }
+  });
+  while (!started) {
+    std::this_thread::yield();
+  }
+
+  // the task of the other group blocks until the wait below returns, so the waiter must not run it
+  wsdb::TaskGroup own(wsdb::TaskPriority::NORMAL, nullptr, &scheduler);
+  wsdb::TaskGroup other(wsdb::TaskPriority::NORMAL, nullptr, &scheduler);
+  other.Submit([&]() {
+    other_started = true;
+    while (!release) {
+      std::this_thread::yield();
+    }
+  });
+  for (int i = 0; i < 10; ++i) {
+    own.Submit([&count]() { count++; });
+  }
+  own.Wait();
+  ASSERT_EQ(count, 10);
+  ASSERT_FALSE(other_started);
+  release = true;
+  other.Wait();
+  blocker.Wait();
+  ASSERT_TRUE(other_started);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
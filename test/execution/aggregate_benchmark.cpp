@@ -0,0 +1,150 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+/**
+ * Benchmark of the parallel aggregation over the stock table of test/sql, generated in place.
+ * The number of stock rows is set by the environment variable WSDB_BENCH_ROWS (200000 by default),
+ * e.g. WSDB_BENCH_ROWS=10000000 ./aggregate_benchmark
+ */
+
+#include "execution_fixture.h"
+#include "concurrency/task_scheduler.h"
+#include "execution/executor_aggregate.h"
+#include "execution/executor_seqscan.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <unordered_set>
+
+#include "gtest/gtest.h"
+using namespace wsdb;
+
+class AggregateBenchmark : public ExecutionTest
+{
+protected:
+  /**
+   * count(*), sum, avg and max of a field of the table grouped by the group fields with 1, 2, 4, ... workers up to the
+   * number of cores, check the number of groups and of aggregated records and print the time of each run
+   * @param buffer_size the memory of the groups, smaller than the groups to spill the records of the other groups
+   */
+  void RunAggregate(TableHandle *table, const std::vector<std::string> &group_keys, const std::string &agg_key,
+      size_t expected_groups, size_t buffer_size = AGGREGATE_BUFFER_SIZE)
+  {
+    const auto          &schema = table->GetSchema();
+    std::vector<RTField> group_fields;
+    for (const auto &key : group_keys) {
+      group_fields.push_back(schema.GetFieldByName(table->GetTableId(), key));
+    }
+    auto                 agg_field = schema.GetFieldByName(table->GetTableId(), agg_key);
+    std::vector<RTField> agg_fields{MakeAggField(MakeField("", TYPE_INT, 4), AGG_COUNT_STAR),
+        MakeAggField(agg_field, AGG_SUM),
+        MakeAggField(agg_field, AGG_AVG),
+        MakeAggField(agg_field, AGG_MAX)};
+    std::string group_str;
+    for (const auto &key : group_keys) {
+      group_str += group_str.empty() ? key : ", " + key;
+    }
+    auto max_workers = TaskScheduler::GetInstance()->GetWorkerNum();
+    for (size_t workers = 1;; workers = std::min(workers * 2, max_workers)) {
+      auto   agg   = std::make_unique<AggregateExecutor>(std::make_unique<SeqScanExecutor>(table),
+          std::make_unique<RecordSchema>(agg_fields),
+          std::make_unique<RecordSchema>(group_fields),
+          workers,
+          buffer_size);
+      auto   start = std::chrono::steady_clock::now();
+      size_t groups = 0;
+      size_t rows   = 0;
+      for (agg->Init(); !agg->IsEnd(); agg->Next()) {
+        groups++;
+        rows += std::dynamic_pointer_cast<IntValue>(agg->GetRecord()->GetValueAt(group_keys.size()))->Get();
+      }
+      auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+      ASSERT_EQ(groups, expected_groups);
+      ASSERT_EQ(rows, table->GetTableHeader().rec_num_);
+      std::cout << fmt::format("{} group by [{}], {} KB buffer: {} groups, {} workers, {} ms, {:.2f} M records/s\n",
+          table->GetTableName(),
+          group_str,
+          buffer_size / 1024,
+          groups,
+          workers,
+          ms.count(),
+          static_cast<double>(rows) / 1000.0 / std::max(static_cast<double>(ms.count()), 1.0));
+      if (workers == max_workers) {
+        break;
+      }
+    }
+  }
+};
+
+TEST_F(AggregateBenchmark, Stock)
+{
+  std::vector<RTField> fields{
+      MakeField("s_i_id", TYPE_INT, 4), MakeField("s_w_id", TYPE_INT, 4), MakeField("s_quantity", TYPE_INT, 4)};
+  for (int i = 1; i <= 10; ++i) {
+    fields.push_back(MakeField(fmt::format("s_dist_{:02}", i), TYPE_STRING, 24));
+  }
+  fields.push_back(MakeField("s_ytd", TYPE_FLOAT, 4));
+  fields.push_back(MakeField("s_order_cnt", TYPE_INT, 4));
+  fields.push_back(MakeField("s_remote_cnt", TYPE_INT, 4));
+  fields.push_back(MakeField("s_data", TYPE_STRING, 50));
+  auto stock = CreateTable("bench_stock", fields);
+
+  std::mt19937                          rng(2024);
+  std::uniform_real_distribution<float> ytd(0, 1000);
+  auto                                  stock_rows = GetBenchRows();
+  // few groups of warehouses, and as many groups of items as a third of the rows
+  std::unordered_set<int>  w_ids;
+  std::unordered_set<int>  i_ids;
+  std::unordered_set<long> w_i_ids;
+  for (size_t i = 0; i < stock_rows; ++i) {
+    auto                   i_id = static_cast<int>(rng() % std::max(stock_rows / 3, static_cast<size_t>(1)));
+    auto                   w_id = static_cast<int>(rng() % 100);
+    std::vector<ValueSptr> values{ValueFactory::CreateIntValue(i_id),
+        ValueFactory::CreateIntValue(w_id),
+        ValueFactory::CreateIntValue(static_cast<int>(rng() % 101))};
+    for (int d = 0; d < 10; ++d) {
+      auto dist = RandomString(rng, 24);
+      values.push_back(ValueFactory::CreateStringValue(dist.c_str(), dist.size()));
+    }
+    auto data = RandomString(rng, 50);
+    values.push_back(ValueFactory::CreateFloatValue(ytd(rng)));
+    values.push_back(ValueFactory::CreateIntValue(static_cast<int>(rng() % 101)));
+    values.push_back(ValueFactory::CreateIntValue(static_cast<int>(rng() % 101)));
+    values.push_back(ValueFactory::CreateStringValue(data.c_str(), data.size()));
+    stock->InsertRecord(Record(&stock->GetSchema(), values, INVALID_RID));
+    w_ids.insert(w_id);
+    i_ids.insert(i_id);
+    w_i_ids.insert(static_cast<long>(w_id) << 32 | i_id);
+  }
+  RunAggregate(stock, {}, "s_quantity", 1);
+  RunAggregate(stock, {"s_w_id"}, "s_quantity", w_ids.size());
+  RunAggregate(stock, {"s_i_id"}, "s_ytd", i_ids.size());
+  RunAggregate(stock, {"s_w_id", "s_i_id"}, "s_order_cnt", w_i_ids.size());
+  // a few thousand groups of items fit in memory, the partitions of the first level are partitioned again
+  RunAggregate(stock, {"s_i_id"}, "s_ytd", i_ids.size(), AGGREGATE_BUFFER_SIZE / 256);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,184 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+/**
+ * Fixture shared by the tests and benchmarks of the executors: tables are created in TEST_DIR through a table manager
+ * of their own, and the run files of the executors are written to TMP_DIR.
+ */
+
+#ifndef WSDB_TEST_EXECUTION_FIXTURE_H
+#define WSDB_TEST_EXECUTION_FIXTURE_H
+
+#include "../config.h"
+#include "common/config.h"
+#include "execution/executor_seqscan.h"
+#include "storage/storage.h"
+#include "system/table/table_manager.h"
+
+#include <cstdlib>
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <random>
+
+#include "gtest/gtest.h"
+
+namespace wsdb {
+
+/// number of rows of the benchmarks, set by the environment variable WSDB_BENCH_ROWS
+inline auto GetBenchRows() -> size_t
+{
+  auto rows = std::getenv("WSDB_BENCH_ROWS");
+  return rows == nullptr ? 200000 : std::stoul(rows);
+}
+
+inline auto MakeField(const std::string &name, FieldType type, size_t size) -> RTField
+{
+  RTField f;
+  f.field_.field_name_ = name;
+  f.field_.field_type_ = type;
+  f.field_.field_size_ = size;
+  return f;
+}
+
+inline auto MakeAggField(RTField field, AggType agg_type) -> RTField
+{
+  field.is_agg_   = true;
+  field.agg_type_ = agg_type;
+  return field;
+}
+
+inline auto RandomString(std::mt19937 &rng, size_t len) -> std::string
+{
+  static const std::string chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+  std::string              str(len, ' ');
+  for (auto &c : str) {
+    c = chars[rng() % chars.size()];
+  }
+  return str;
+}
+
+class ExecutionTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    if (!std::filesystem::exists(TEST_DIR)) {
+      std::filesystem::create_directory(TEST_DIR);
+    }
+    if (!std::filesystem::exists(TMP_DIR)) {
+      std::filesystem::create_directory(TMP_DIR);
+    }
+    disk_manager_        = std::make_unique<DiskManager>();
+    buffer_pool_manager_ = std::make_unique<BufferPoolManager>(disk_manager_.get(), nullptr);
+    table_manager_       = std::make_unique<TableManager>(disk_manager_.get(), buffer_pool_manager_.get());
+  }
+
+  auto CreateTable(const std::string &name, const std::vector<RTField> &fields) -> TableHandle *
+  {
+    if (std::filesystem::exists(FILE_NAME(TEST_DIR, name, TAB_SUFFIX))) {
+      std::filesystem::remove(FILE_NAME(TEST_DIR, name, TAB_SUFFIX));
+    }
+    RecordSchema schema(fields);
+    table_manager_->CreateTable(TEST_DIR, name, schema, NARY_MODEL);
+    tables_.push_back(table_manager_->OpenTable(TEST_DIR, name, NARY_MODEL));
+    return tables_.back().get();
+  }
+
+  static auto Field(TableHandle *tab, const std::string &name) -> RTField
+  {
+    return tab->GetSchema().GetFieldByName(tab->GetTableId(), name);
+  }
+
+  /// the values of the record separated by commas, to compare the records of different executors
+  static auto RecordString(const Record &record) -> std::string
+  {
+    std::string str;
+    for (size_t i = 0; i < record.GetSchema()->GetFieldCount(); ++i) {
+      str += record.GetValueAt(i)->ToString() + ",";
+    }
+    return str;
+  }
+
+  static auto Scan(TableHandle *tab) -> std::vector<RecordUptr>
+  {
+    std::vector<RecordUptr> records;
+    SeqScanExecutor         scan(tab);
+    for (scan.Init(); !scan.IsEnd(); scan.Next()) {
+      records.push_back(scan.GetRecord());
+    }
+    return records;
+  }
+
+  /**
+   * the sorted strings of the records of left joined with right by a plain nested loop, outer join pads the left
+   * records without a match with nulls
+   */
+  static auto NestedLoopJoin(TableHandle *left, TableHandle *right, JoinType join_type,
+      const std::function<bool(const Record &, const Record &)> &match) -> std::vector<std::string>
+  {
+    auto                     lrecs = Scan(left);
+    auto                     rrecs = Scan(right);
+    Record                   null_right(&right->GetSchema());
+    std::vector<std::string> records;
+    for (const auto &lrec : lrecs) {
+      bool matched = false;
+      for (const auto &rrec : rrecs) {
+        if (match(*lrec, *rrec)) {
+          records.push_back(RecordString(*lrec) + RecordString(*rrec));
+          matched = true;
+        }
+      }
+      if (!matched && join_type == OUTER_JOIN) {
+        records.push_back(RecordString(*lrec) + RecordString(null_right));
+      }
+    }
+    std::sort(records.begin(), records.end());
+    return records;
+  }
+
+  /**
+   * run the executor twice and check that each run outputs the expected records in any order, the run files and hash
+   * tables of the executors are created again when they are run again
+   * @param expected sorted strings of the expected records
+   */
+  static void CheckOutput(AbstractExecutor &executor, const std::vector<std::string> &expected)
+  {
+    for (int round = 0; round < 2; ++round) {
+      std::vector<std::string> out;
+      for (executor.Init(); !executor.IsEnd(); executor.Next()) {
+        out.push_back(RecordString(*executor.GetRecord()));
+      }
+      std::sort(out.begin(), out.end());
+      ASSERT_EQ(out.size(), expected.size()) << "round " << round;
+      ASSERT_EQ(out, expected) << "round " << round;
+    }
+  }
+
+  std::unique_ptr<DiskManager>              disk_manager_;
+  std::unique_ptr<BufferPoolManager>        buffer_pool_manager_;
+  std::unique_ptr<TableManager>             table_manager_;
+  std::vector<std::unique_ptr<TableHandle>> tables_;
+};
+
+}  // namespace wsdb
+
+#endif  // WSDB_TEST_EXECUTION_FIXTURE_H
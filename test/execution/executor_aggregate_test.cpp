@@ -0,0 +1,217 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+#include "execution_fixture.h"
+#include "execution/executor_aggregate.h"
+#include "execution/executor_seqscan.h"
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+using namespace wsdb;
+
+// a few hundred groups, the records of the other groups are partitioned once and every partition fits
+static constexpr size_t SPILL_BUFFER_SIZE = 64 * 1024;
+// about ten groups, the partitions of the first level are partitioned again
+static constexpr size_t RECURSIVE_BUFFER_SIZE = 2 * 1024;
+
+class AggregateTest : public ExecutionTest
+{
+protected:
+  /// aggregates of a group computed on Values
+  struct Expected
+  {
+    std::vector<ValueSptr> group_;
+    int64_t                count_star_{0};
+    int64_t                count_v_{0};
+    int64_t                sum_v_{0};
+    ValueSptr              min_v_{ValueFactory::CreateNullValue(TYPE_INT)};
+    ValueSptr              max_s_{ValueFactory::CreateNullValue(TYPE_STRING)};
+    int64_t                count_f_{0};
+    double                 sum_f_{0};
+  };
+
+  /**
+   * g takes group_num values and is null in some rows, v is a small int null in some rows, f is a multiple of 0.5 so
+   * that its sums are exact whatever the order of the records
+   */
+  auto CreateRows(size_t rows, int group_num) -> TableHandle *
+  {
+    auto tab = CreateTable("agg_rows",
+        {MakeField("g", TYPE_INT, 4),
+            MakeField("h", TYPE_STRING, 8),
+            MakeField("v", TYPE_INT, 4),
+            MakeField("s", TYPE_STRING, 8),
+            MakeField("f", TYPE_FLOAT, 4)});
+    std::mt19937 rng(11);
+    for (size_t i = 0; i < rows; ++i) {
+      ValueSptr g = i % 31 == 0 ? ValueFactory::CreateNullValue(TYPE_INT)
+                                : ValueFactory::CreateIntValue(static_cast<int>(rng() % group_num));
+      ValueSptr v = i % 7 == 0 ? ValueFactory::CreateNullValue(TYPE_INT)
+                               : ValueFactory::CreateIntValue(static_cast<int>(rng() % 101) - 50);
+      auto      h = std::string(1, static_cast<char>('a' + rng() % 2));
+      auto      s = RandomString(rng, 1 + rng() % 7);
+      std::vector<ValueSptr> values{g,
+          ValueFactory::CreateStringValue(h.c_str(), h.size()),
+          v,
+          ValueFactory::CreateStringValue(s.c_str(), s.size()),
+          ValueFactory::CreateFloatValue(static_cast<float>(rng() % 200) / 2 - 50)};
+      tab->InsertRecord(Record(&tab->GetSchema(), values, INVALID_RID));
+    }
+    return tab;
+  }
+
+  /**
+   * count(*), count(v), sum(v), min(v), max(s) and avg(f) grouped by the group fields, compared with the aggregates
+   * computed on the Values of the records
+   */
+  void CheckAggregate(TableHandle *tab, const std::vector<std::string> &group_names, size_t worker_num,
+      size_t buffer_size)
+  {
+    std::vector<RTField> group_fields;
+    std::vector<size_t>  group_idxes;
+    for (const auto &name : group_names) {
+      group_fields.push_back(Field(tab, name));
+      group_idxes.push_back(tab->GetSchema().GetFieldIndex(tab->GetTableId(), name));
+    }
+    std::map<std::string, Expected> groups;
+    for (const auto &record : Scan(tab)) {
+      std::string key;
+      for (auto idx : group_idxes) {
+        key += record->GetValueAt(idx)->ToString() + ",";
+      }
+      auto &group = groups[key];
+      if (group.count_star_ == 0) {
+        for (auto idx : group_idxes) {
+          group.group_.push_back(record->GetValueAt(idx));
+        }
+      }
+      group.count_star_++;
+      auto v = record->GetValueAt(2);
+      if (!v->IsNull()) {
+        group.count_v_++;
+        group.sum_v_ += std::dynamic_pointer_cast<IntValue>(v)->Get();
+      }
+      group.min_v_ = Value::Min(group.min_v_, v);
+      group.max_s_ = Value::Max(group.max_s_, record->GetValueAt(3));
+      group.count_f_++;
+      group.sum_f_ += std::dynamic_pointer_cast<FloatValue>(record->GetValueAt(4))->Get();
+    }
+    // without group fields there is one record, even for no record at all
+    if (group_names.empty() && groups.empty()) {
+      groups[""] = Expected{};
+    }
+    std::vector<std::string> expected;
+    for (const auto &[key, group] : groups) {
+      std::string str;
+      for (const auto &value : group.group_) {
+        str += value->ToString() + ",";
+      }
+      auto sum_v = group.count_v_ == 0 ? ValueFactory::CreateNullValue(TYPE_INT)
+                                       : ValueFactory::CreateIntValue(static_cast<int>(group.sum_v_));
+      auto avg_f = group.count_f_ == 0
+                       ? ValueFactory::CreateNullValue(TYPE_FLOAT)
+                       : ValueFactory::CreateFloatValue(static_cast<float>(group.sum_f_ / group.count_f_));
+      str += fmt::format("{},{},{},{},{},{},",
+          group.count_star_,
+          group.count_v_,
+          sum_v->ToString(),
+          group.min_v_->ToString(),
+          group.max_s_->ToString(),
+          avg_f->ToString());
+      expected.push_back(str);
+    }
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<RTField> agg_fields{MakeAggField(MakeField("", TYPE_INT, 4), AGG_COUNT_STAR),
+        MakeAggField(Field(tab, "v"), AGG_COUNT),
+        MakeAggField(Field(tab, "v"), AGG_SUM),
+        MakeAggField(Field(tab, "v"), AGG_MIN),
+        MakeAggField(Field(tab, "s"), AGG_MAX),
+        MakeAggField(Field(tab, "f"), AGG_AVG)};
+    AggregateExecutor agg(std::make_unique<SeqScanExecutor>(tab),
+        std::make_unique<RecordSchema>(agg_fields),
+        std::make_unique<RecordSchema>(group_fields),
+        worker_num,
+        buffer_size);
+    SCOPED_TRACE(fmt::format("{} workers, buffer size {}", worker_num, buffer_size));
+    CheckOutput(agg, expected);
+  }
+
+  void CheckGroupings(TableHandle *tab, size_t worker_num, size_t buffer_size)
+  {
+    CheckAggregate(tab, {}, worker_num, buffer_size);
+    CheckAggregate(tab, {"g"}, worker_num, buffer_size);
+    CheckAggregate(tab, {"g", "h"}, worker_num, buffer_size);
+  }
+};
+
+TEST_F(AggregateTest, InMemory)
+{
+  auto tab = CreateRows(5000, 500);
+  CheckGroupings(tab, 1, AGGREGATE_BUFFER_SIZE);
+}
+
+TEST_F(AggregateTest, EmptyChild)
+{
+  auto tab = CreateRows(0, 10);
+  CheckGroupings(tab, 1, AGGREGATE_BUFFER_SIZE);
+  CheckGroupings(tab, 4, AGGREGATE_BUFFER_SIZE);
+}
+
+TEST_F(AggregateTest, SpillPartitions)
+{
+  auto tab = CreateRows(5000, 500);
+  CheckGroupings(tab, 1, SPILL_BUFFER_SIZE);
+}
+
+TEST_F(AggregateTest, RecursivePartitions)
+{
+  auto tab = CreateRows(5000, 500);
+  CheckGroupings(tab, 1, RECURSIVE_BUFFER_SIZE);
+}
+
+/// a single group fits, the partitions are split down to the last level, which is aggregated in memory
+TEST_F(AggregateTest, LastLevel)
+{
+  auto tab = CreateRows(500, 30);
+  CheckGroupings(tab, 1, 1);
+}
+
+/// the partial groups of the workers do not fit in the small buffers, the records of the other groups are spilled by the
+/// workers and merged per radix partition
+TEST_F(AggregateTest, Parallel)
+{
+  auto tab = CreateRows(5000, 500);
+  CheckGroupings(tab, 4, AGGREGATE_BUFFER_SIZE);
+  CheckGroupings(tab, 4, SPILL_BUFFER_SIZE);
+  CheckGroupings(tab, 4, RECURSIVE_BUFFER_SIZE);
+  CheckGroupings(tab, 4, 1);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,92 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+#include "execution_fixture.h"
+#include "concurrency/task_scheduler.h"
+#include "execution/executor_gather.h"
+#include "execution/executor_seqscan.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+using namespace wsdb;
+
+class GatherTest : public ExecutionTest
+{
+protected:
+  /// a table of many morsels, the id of the i-th record is i
+  auto CreateNumbers(size_t rows) -> TableHandle *
+  {
+    auto tab = CreateTable("gather_numbers", {MakeField("id", TYPE_INT, 4), MakeField("pad", TYPE_STRING, 100)});
+    for (size_t i = 0; i < rows; ++i) {
+      std::vector<ValueSptr> values{
+          ValueFactory::CreateIntValue(static_cast<int>(i)), ValueFactory::CreateStringValue("pad", 3)};
+      tab->InsertRecord(Record(&tab->GetSchema(), values, INVALID_RID));
+    }
+    return tab;
+  }
+};
+
+TEST_F(GatherTest, SameAsSerialScan)
+{
+  auto tab = CreateNumbers(20000);
+  SeqScanExecutor  serial(tab);
+  std::vector<RID> expected;
+  for (serial.Init(); !serial.IsEnd(); serial.Next()) {
+    expected.push_back(serial.GetRecord()->GetRID());
+  }
+  auto scan = std::make_unique<SeqScanExecutor>(tab);
+  ASSERT_GT(scan->GetMorselNum(), 4);
+  GatherExecutor   gather(std::move(scan), 4);
+  std::vector<RID> rids;
+  for (gather.Init(); !gather.IsEnd(); gather.Next()) {
+    rids.push_back(gather.GetRecord()->GetRID());
+  }
+  ASSERT_EQ(rids, expected);
+}
+
+/**
+ * the morsel tasks are skipped once the group of the query is cancelled, the consumer must fail instead of waiting for
+ * them forever
+ */
+TEST_F(GatherTest, CancelledQuery)
+{
+  auto      tab = CreateNumbers(20000);
+  TaskGroup query(TaskPriority::NORMAL, nullptr);
+  bool      cancelled = false;
+  query.Submit([&]() {
+    GatherExecutor gather(std::make_unique<SeqScanExecutor>(tab), 4);
+    query.Cancel();
+    try {
+      for (gather.Init(); !gather.IsEnd(); gather.Next()) {}
+    } catch (WSDBException_ &e) {
+      cancelled = e.type_ == WSDB_TASK_CANCELLED;
+    }
+  });
+  query.Wait();
+  ASSERT_TRUE(cancelled);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
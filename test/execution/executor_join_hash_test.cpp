@@ -0,0 +1,157 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+#include "execution_fixture.h"
+#include "execution/executor_join_hash.h"
+#include "execution/executor_seqscan.h"
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+using namespace wsdb;
+
+// about 100 build records, the build side is partitioned once and every partition fits
+static constexpr size_t SPILL_BUFFER_SIZE = 16 * 1024;
+// about 6 build records, the partitions of the first level are partitioned again
+static constexpr size_t RECURSIVE_BUFFER_SIZE = 2 * 1024;
+
+class HashJoinTest : public ExecutionTest
+{
+protected:
+  /**
+   * a table whose k takes key_num values, k is null in some rows
+   * @param null_every every null_every-th row has a null k, 0 for no null
+   */
+  auto CreateRows(const std::string &name, size_t rows, int key_num, size_t null_every, unsigned seed)
+      -> TableHandle *
+  {
+    auto tab = CreateTable(
+        name, {MakeField("id", TYPE_INT, 4), MakeField("k", TYPE_INT, 4), MakeField("pad", TYPE_STRING, 20)});
+    std::mt19937 rng(seed);
+    for (size_t i = 0; i < rows; ++i) {
+      ValueSptr k = null_every != 0 && i % null_every == 0
+                        ? ValueFactory::CreateNullValue(TYPE_INT)
+                        : ValueFactory::CreateIntValue(static_cast<int>(rng() % static_cast<unsigned>(key_num)));
+      auto      pad = RandomString(rng, 20);
+      std::vector<ValueSptr> values{
+          ValueFactory::CreateIntValue(static_cast<int>(i)), k, ValueFactory::CreateStringValue(pad.c_str(), 20)};
+      tab->InsertRecord(Record(&tab->GetSchema(), values, INVALID_RID));
+    }
+    return tab;
+  }
+
+  /**
+   * join left and right on k by hash join and compare the joined records with the ones of a nested loop over the
+   * tables, keys are equal as in the conditions of the other joins (a null key matches null keys only), and outer
+   * join pads the left records without a match with nulls
+   */
+  void CheckJoin(TableHandle *left, TableHandle *right, JoinType join_type, bool build_left, size_t worker_num,
+      size_t buffer_size)
+  {
+    auto expected = NestedLoopJoin(
+        left, right, join_type, [](const Record &l, const Record &r) { return *l.GetValueAt(1) == *r.GetValueAt(1); });
+
+    auto key_schema = [](TableHandle *tab) {
+      return std::make_unique<RecordSchema>(std::vector<RTField>{Field(tab, "k")});
+    };
+    HashJoinExecutor join(join_type,
+        std::make_unique<SeqScanExecutor>(left),
+        std::make_unique<SeqScanExecutor>(right),
+        key_schema(left),
+        key_schema(right),
+        build_left,
+        worker_num,
+        nullptr,
+        buffer_size);
+    CheckOutput(join, expected);
+  }
+
+  /// run every join type on both build sides
+  void CheckJoins(TableHandle *left, TableHandle *right, size_t worker_num, size_t buffer_size)
+  {
+    for (auto join_type : {INNER_JOIN, OUTER_JOIN}) {
+      for (bool build_left : {false, true}) {
+        SCOPED_TRACE(fmt::format("{} build_left {}", JoinTypeToString(join_type), build_left));
+        CheckJoin(left, right, join_type, build_left, worker_num, buffer_size);
+      }
+    }
+  }
+};
+
+TEST_F(HashJoinTest, InMemory)
+{
+  auto left  = CreateRows("hj_left", 400, 300, 17, 1);
+  auto right = CreateRows("hj_right", 400, 600, 23, 2);
+  CheckJoins(left, right, 1, HASH_JOIN_BUFFER_SIZE);
+}
+
+TEST_F(HashJoinTest, AllKeysNull)
+{
+  auto left  = CreateRows("hj_left", 40, 10, 1, 1);
+  auto right = CreateRows("hj_right", 40, 10, 1, 2);
+  CheckJoins(left, right, 1, HASH_JOIN_BUFFER_SIZE);
+  CheckJoins(left, right, 1, RECURSIVE_BUFFER_SIZE);
+}
+
+TEST_F(HashJoinTest, EmptyInput)
+{
+  auto left  = CreateRows("hj_left", 500, 100, 17, 1);
+  auto right = CreateRows("hj_right", 0, 100, 0, 2);
+  CheckJoins(left, right, 1, HASH_JOIN_BUFFER_SIZE);
+  CheckJoins(right, left, 1, HASH_JOIN_BUFFER_SIZE);
+}
+
+TEST_F(HashJoinTest, ForcedSpill)
+{
+  auto left  = CreateRows("hj_left", 400, 300, 17, 1);
+  auto right = CreateRows("hj_right", 400, 600, 23, 2);
+  CheckJoins(left, right, 1, SPILL_BUFFER_SIZE);
+}
+
+TEST_F(HashJoinTest, RecursivePartition)
+{
+  auto left  = CreateRows("hj_left", 400, 300, 17, 1);
+  auto right = CreateRows("hj_right", 400, 600, 23, 2);
+  CheckJoins(left, right, 1, RECURSIVE_BUFFER_SIZE);
+}
+
+/// the records of a single key cannot be split, they are joined in memory after the last partitioning level
+TEST_F(HashJoinTest, SkewedKey)
+{
+  auto left  = CreateRows("hj_left", 100, 2, 0, 1);
+  auto right = CreateRows("hj_right", 50, 3, 0, 2);
+  CheckJoins(left, right, 1, RECURSIVE_BUFFER_SIZE);
+}
+
+TEST_F(HashJoinTest, Parallel)
+{
+  auto left  = CreateRows("hj_left", 400, 300, 17, 1);
+  auto right = CreateRows("hj_right", 400, 600, 23, 2);
+  CheckJoins(left, right, 4, HASH_JOIN_BUFFER_SIZE);
+  CheckJoins(left, right, 4, RECURSIVE_BUFFER_SIZE);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,160 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+#include "execution_fixture.h"
+#include "execution/executor_join_nestedloop.h"
+#include "execution/executor_seqscan.h"
+#include "expr/compiled_condition.h"
+#include "expr/condition_expr.h"
+
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+using namespace wsdb;
+
+// block sizes are swept by this step, smaller than an outer record, so that every number of records per block is run
+static constexpr size_t BLOCK_SIZE_STEP = 16;
+
+class NestedLoopJoinTest : public ExecutionTest
+{
+protected:
+  /// a table whose k takes key_num values from base, k is null in some rows
+  auto CreateRows(const std::string &name, size_t rows, int base, int key_num, unsigned seed) -> TableHandle *
+  {
+    auto         tab = CreateTable(name, {MakeField("id", TYPE_INT, 4), MakeField("k", TYPE_INT, 4)});
+    std::mt19937 rng(seed);
+    for (size_t i = 0; i < rows; ++i) {
+      ValueSptr k = i % 11 == 0 ? ValueFactory::CreateNullValue(TYPE_INT)
+                                : ValueFactory::CreateIntValue(base + static_cast<int>(rng() % key_num));
+      std::vector<ValueSptr> values{ValueFactory::CreateIntValue(static_cast<int>(i)), k};
+      tab->InsertRecord(Record(&tab->GetSchema(), values, INVALID_RID));
+    }
+    return tab;
+  }
+
+  /**
+   * join left and right on left.k = right.k, and on left.id < right.id as well if with_range, with blocks of
+   * block_size bytes, and compare the joined records with the ones of a plain nested loop over the tables
+   */
+  void CheckJoin(TableHandle *left, TableHandle *right, JoinType join_type, bool with_range, size_t block_size)
+  {
+    auto expected = NestedLoopJoin(left, right, join_type, [with_range](const Record &l, const Record &r) {
+      return *l.GetValueAt(1) == *r.GetValueAt(1) && (!with_range || *l.GetValueAt(0) < *r.GetValueAt(0));
+    });
+
+    ConditionVec conds;
+    conds.emplace_back(OP_EQ, Field(left, "k"), Field(right, "k"));
+    if (with_range) {
+      conds.emplace_back(OP_LT, Field(left, "id"), Field(right, "id"));
+    }
+    NestedLoopJoinExecutor join(join_type,
+        std::make_unique<SeqScanExecutor>(left),
+        std::make_unique<SeqScanExecutor>(right),
+        std::move(conds),
+        block_size);
+    SCOPED_TRACE(fmt::format("{} block size {}", JoinTypeToString(join_type), block_size));
+    CheckOutput(join, expected);
+  }
+
+  /// run both join types with blocks from one record to more than the whole left table
+  void CheckBlockSizes(TableHandle *left, TableHandle *right, bool with_range)
+  {
+    // an outer record is charged with its data and less than 64 bytes of bookkeeping
+    auto max_block_size = (left->GetSchema().GetRecordLength() + 64) * (Scan(left).size() + 2);
+    for (size_t block_size = 1; block_size <= max_block_size; block_size += BLOCK_SIZE_STEP) {
+      for (auto join_type : {INNER_JOIN, OUTER_JOIN}) {
+        CheckJoin(left, right, join_type, with_range, block_size);
+        if (HasFatalFailure()) {
+          return;
+        }
+      }
+    }
+    CheckJoin(left, right, INNER_JOIN, with_range, NESTED_LOOP_BLOCK_SIZE);
+    CheckJoin(left, right, OUTER_JOIN, with_range, NESTED_LOOP_BLOCK_SIZE);
+  }
+};
+
+TEST_F(NestedLoopJoinTest, BlockBoundaries)
+{
+  // the keys of the left table are half out of the range of the right table, so outer join pads many records
+  auto left  = CreateRows("nlj_left", 40, 0, 20, 1);
+  auto right = CreateRows("nlj_right", 30, 10, 20, 2);
+  CheckBlockSizes(left, right, false);
+}
+
+TEST_F(NestedLoopJoinTest, CompiledConditions)
+{
+  auto left  = CreateRows("nlj_left", 40, 0, 8, 1);
+  auto right = CreateRows("nlj_right", 30, 0, 8, 2);
+  CheckBlockSizes(left, right, true);
+}
+
+TEST_F(NestedLoopJoinTest, EmptyInput)
+{
+  auto left  = CreateRows("nlj_left", 10, 0, 5, 1);
+  auto right = CreateRows("nlj_right", 0, 0, 5, 2);
+  CheckBlockSizes(left, right, false);
+  CheckBlockSizes(right, left, false);
+}
+
+/// an int compared with a float, either of them null, gives the same result as the conditions evaluated on Values
+TEST_F(NestedLoopJoinTest, MixedNumericTypes)
+{
+  auto tab = CreateTable("nlj_mixed", {MakeField("i", TYPE_INT, 4), MakeField("f", TYPE_FLOAT, 4)});
+  for (auto i : {std::optional<int>(), std::optional<int>(-1), std::optional<int>(0), std::optional<int>(1)}) {
+    for (auto f : {std::optional<float>(), std::optional<float>(-1), std::optional<float>(0), std::optional<float>(0.5),
+             std::optional<float>(1)}) {
+      std::vector<ValueSptr> values{
+          i.has_value() ? ValueFactory::CreateIntValue(*i) : ValueFactory::CreateNullValue(TYPE_INT),
+          f.has_value() ? ValueFactory::CreateFloatValue(*f) : ValueFactory::CreateNullValue(TYPE_FLOAT)};
+      tab->InsertRecord(Record(&tab->GetSchema(), values, INVALID_RID));
+    }
+  }
+  std::vector<ValueSptr> int_values{ValueFactory::CreateIntValue(0), ValueFactory::CreateNullValue(TYPE_INT)};
+  std::vector<ValueSptr> float_values{
+      ValueFactory::CreateFloatValue(0), ValueFactory::CreateFloatValue(0.5), ValueFactory::CreateNullValue(TYPE_FLOAT)};
+  auto records = Scan(tab);
+  for (auto op : {OP_EQ, OP_NE, OP_LT, OP_LE, OP_GT, OP_GE}) {
+    ConditionVec conds{{op, Field(tab, "i"), Field(tab, "f")}, {op, Field(tab, "f"), Field(tab, "i")}};
+    for (auto &value : float_values) {
+      conds.emplace_back(op, Field(tab, "i"), value);
+    }
+    for (auto &value : int_values) {
+      conds.emplace_back(op, Field(tab, "f"), value);
+    }
+    for (const auto &cond : conds) {
+      SCOPED_TRACE(cond.ToString());
+      CompiledCondition compiled({cond}, &tab->GetSchema(), nullptr);
+      for (const auto &record : records) {
+        ASSERT_EQ(compiled.Eval(*record), ConditionExpr::Eval({cond}, *record))
+            << record->GetValueAt(0)->ToString() << ", " << record->GetValueAt(1)->ToString();
+      }
+    }
+  }
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,189 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+#include "execution_fixture.h"
+#include "execution/executor_seqscan.h"
+#include "execution/executor_sort.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+using namespace wsdb;
+
+// small enough for the rows of the tests to be sorted in tens of runs, which takes two levels of merge
+static constexpr size_t SMALL_SORT_BUFFER_SIZE = 16 * 1024;
+
+class SortTest : public ExecutionTest
+{
+protected:
+  /// k repeats and is null in some rows, s is random
+  auto CreateRows(size_t rows) -> TableHandle *
+  {
+    auto tab = CreateTable("sort_rows",
+        {MakeField("id", TYPE_INT, 4),
+            MakeField("k", TYPE_INT, 4),
+            MakeField("s", TYPE_STRING, 16),
+            MakeField("f", TYPE_FLOAT, 4)});
+    std::mt19937 rng(42);
+    for (size_t i = 0; i < rows; ++i) {
+      auto      str = RandomString(rng, 1 + rng() % 15);
+      ValueSptr k   = i % 37 == 0 ? ValueFactory::CreateNullValue(TYPE_INT)
+                                  : ValueFactory::CreateIntValue(static_cast<int>(rng() % 1000) - 500);
+      std::vector<ValueSptr> values{ValueFactory::CreateIntValue(static_cast<int>(i)),
+          k,
+          ValueFactory::CreateStringValue(str.c_str(), str.size()),
+          ValueFactory::CreateFloatValue(static_cast<float>(rng() % 2000) / 8 - 125)};
+      tab->InsertRecord(Record(&tab->GetSchema(), values, INVALID_RID));
+    }
+    return tab;
+  }
+
+  auto GetKeyFields(TableHandle *tab, const std::vector<std::string> &key_names) -> std::vector<RTField>
+  {
+    std::vector<RTField> key_fields;
+    for (const auto &name : key_names) {
+      key_fields.push_back(tab->GetSchema().GetFieldByName(tab->GetTableId(), name));
+    }
+    return key_fields;
+  }
+
+  /**
+   * sort the table and check that the records come out in the order of Record::Compare over the key fields, and
+   * that each record of the table comes out once
+   */
+  void CheckSort(TableHandle *tab, const std::vector<std::string> &key_names, bool is_desc, size_t worker_num,
+      size_t buffer_size)
+  {
+    auto         key_fields = GetKeyFields(tab, key_names);
+    RecordSchema key_schema(key_fields);
+    SortExecutor sort(std::make_unique<SeqScanExecutor>(tab),
+        std::make_unique<RecordSchema>(key_fields),
+        is_desc,
+        worker_num,
+        buffer_size);
+    std::vector<size_t> expected;
+    SeqScanExecutor     scan(tab);
+    for (scan.Init(); !scan.IsEnd(); scan.Next()) {
+      expected.push_back(scan.GetRecord()->GetRID().GetHash());
+    }
+    std::sort(expected.begin(), expected.end());
+    // the result must not change when the sort is run again
+    for (int round = 0; round < 2; ++round) {
+      std::vector<size_t> rids;
+      RecordUptr          prev_key;
+      for (sort.Init(); !sort.IsEnd(); sort.Next()) {
+        auto key = std::make_unique<Record>(&key_schema, *sort.GetRecord());
+        if (prev_key != nullptr) {
+          auto cmp = Record::Compare(*prev_key, *key);
+          ASSERT_TRUE(is_desc ? cmp >= 0 : cmp <= 0) << "row " << rids.size();
+        }
+        prev_key = std::move(key);
+        rids.push_back(sort.GetRecord()->GetRID().GetHash());
+      }
+      std::sort(rids.begin(), rids.end());
+      ASSERT_EQ(rids, expected);
+    }
+  }
+};
+
+TEST_F(SortTest, InMemory)
+{
+  auto tab = CreateRows(5000);
+  CheckSort(tab, {"k", "s"}, false, 1, SORT_BUFFER_SIZE);
+  CheckSort(tab, {"k", "s"}, true, 1, SORT_BUFFER_SIZE);
+}
+
+TEST_F(SortTest, ParallelInMemory)
+{
+  auto tab = CreateRows(5000);
+  CheckSort(tab, {"s"}, false, 4, SORT_BUFFER_SIZE);
+  CheckSort(tab, {"k", "f"}, true, 4, SORT_BUFFER_SIZE);
+}
+
+TEST_F(SortTest, MergeSeveralRuns)
+{
+  auto tab = CreateRows(20000);
+  CheckSort(tab, {"k", "s"}, false, 1, SMALL_SORT_BUFFER_SIZE);
+  CheckSort(tab, {"k", "s"}, true, 1, SMALL_SORT_BUFFER_SIZE);
+}
+
+TEST_F(SortTest, ParallelMergeSeveralRuns)
+{
+  auto tab = CreateRows(20000);
+  CheckSort(tab, {"s"}, false, 4, SMALL_SORT_BUFFER_SIZE);
+  CheckSort(tab, {"k", "f"}, true, 4, SMALL_SORT_BUFFER_SIZE);
+}
+
+/**
+ * keys whose normalized bytes are tricky for the radix sort: negative and signed zero floats, strings that are prefixes
+ * of each other, empty strings and nulls, each repeated so that the buckets are larger than the insertion sort limit
+ */
+TEST_F(SortTest, NormalizedKeyEdgeCases)
+{
+  auto tab = CreateTable("sort_edges",
+      {MakeField("i", TYPE_INT, 4), MakeField("f", TYPE_FLOAT, 4), MakeField("s", TYPE_STRING, 8)});
+  std::vector<ValueSptr> ints{ValueFactory::CreateNullValue(TYPE_INT),
+      ValueFactory::CreateIntValue(std::numeric_limits<int>::min()),
+      ValueFactory::CreateIntValue(-1),
+      ValueFactory::CreateIntValue(0),
+      ValueFactory::CreateIntValue(1),
+      ValueFactory::CreateIntValue(std::numeric_limits<int>::max())};
+  std::vector<ValueSptr> floats{ValueFactory::CreateNullValue(TYPE_FLOAT),
+      ValueFactory::CreateFloatValue(-1e30F),
+      ValueFactory::CreateFloatValue(-1.5F),
+      ValueFactory::CreateFloatValue(-0.0F),
+      ValueFactory::CreateFloatValue(0.0F),
+      ValueFactory::CreateFloatValue(1e-30F),
+      ValueFactory::CreateFloatValue(2.5F)};
+  std::vector<ValueSptr> strs{ValueFactory::CreateNullValue(TYPE_STRING),
+      ValueFactory::CreateStringValue("", 0),
+      ValueFactory::CreateStringValue("a", 1),
+      ValueFactory::CreateStringValue("ab", 2),
+      ValueFactory::CreateStringValue("abcdefgh", 8),
+      ValueFactory::CreateStringValue("b", 1)};
+  std::mt19937 rng(7);
+  for (size_t i = 0; i < 3000; ++i) {
+    std::vector<ValueSptr> values{ints[rng() % ints.size()], floats[rng() % floats.size()], strs[rng() % strs.size()]};
+    tab->InsertRecord(Record(&tab->GetSchema(), values, INVALID_RID));
+  }
+  for (bool is_desc : {false, true}) {
+    CheckSort(tab, {"f"}, is_desc, 1, SORT_BUFFER_SIZE);
+    CheckSort(tab, {"s", "i"}, is_desc, 1, SORT_BUFFER_SIZE);
+    CheckSort(tab, {"i", "f", "s"}, is_desc, 1, SORT_BUFFER_SIZE);
+    CheckSort(tab, {"f", "s"}, is_desc, 1, SMALL_SORT_BUFFER_SIZE);
+  }
+}
+
+/// a buffer smaller than a record still sorts, one record per run
+TEST_F(SortTest, TinyBuffer)
+{
+  auto tab = CreateRows(300);
+  CheckSort(tab, {"k"}, false, 1, 1);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,124 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+#include "execution_fixture.h"
+#include "execution/executor_seqscan.h"
+#include "execution/executor_topn.h"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "gtest/gtest.h"
+using namespace wsdb;
+
+class TopNTest : public ExecutionTest
+{
+protected:
+  /// k has many ties and some nulls
+  auto CreateRows(size_t rows) -> TableHandle *
+  {
+    auto tab = CreateTable("topn_rows", {MakeField("id", TYPE_INT, 4), MakeField("k", TYPE_INT, 4)});
+    std::mt19937 rng(3);
+    for (size_t i = 0; i < rows; ++i) {
+      ValueSptr k = i % 29 == 0 ? ValueFactory::CreateNullValue(TYPE_INT)
+                                : ValueFactory::CreateIntValue(static_cast<int>(rng() % 200));
+      std::vector<ValueSptr> values{ValueFactory::CreateIntValue(static_cast<int>(i)), k};
+      tab->InsertRecord(Record(&tab->GetSchema(), values, INVALID_RID));
+    }
+    return tab;
+  }
+
+  static auto KeyString(const Record &key) -> std::string
+  {
+    std::string str;
+    for (size_t i = 0; i < key.GetSchema()->GetFieldCount(); ++i) {
+      str += key.GetValueAt(i)->ToString() + ",";
+    }
+    return str;
+  }
+
+  /**
+   * the keys of the first limit records of the table in the key order must be the keys of the output, in order, and
+   * the output records must be distinct records of the table
+   */
+  void CheckTopN(TableHandle *tab, const std::vector<std::string> &key_names, bool is_desc, size_t limit)
+  {
+    std::vector<RTField> key_fields;
+    for (const auto &name : key_names) {
+      key_fields.push_back(tab->GetSchema().GetFieldByName(tab->GetTableId(), name));
+    }
+    RecordSchema            key_schema(key_fields);
+    std::vector<RecordUptr> keys;
+    SeqScanExecutor         scan(tab);
+    for (scan.Init(); !scan.IsEnd(); scan.Next()) {
+      keys.push_back(std::make_unique<Record>(&key_schema, *scan.GetRecord()));
+    }
+    std::sort(keys.begin(), keys.end(), [is_desc](const RecordUptr &lhs, const RecordUptr &rhs) {
+      auto cmp = Record::Compare(*lhs, *rhs);
+      return is_desc ? cmp > 0 : cmp < 0;
+    });
+    std::vector<std::string> expected;
+    for (size_t i = 0; i < std::min(limit, keys.size()); ++i) {
+      expected.push_back(KeyString(*keys[i]));
+    }
+    TopNExecutor top_n(
+        std::make_unique<SeqScanExecutor>(tab), std::make_unique<RecordSchema>(key_fields), is_desc, limit);
+    for (int round = 0; round < 2; ++round) {
+      std::vector<std::string> out;
+      std::set<size_t>         rids;
+      for (top_n.Init(); !top_n.IsEnd(); top_n.Next()) {
+        out.push_back(KeyString(Record(&key_schema, *top_n.GetRecord())));
+        ASSERT_TRUE(rids.insert(top_n.GetRecord()->GetRID().GetHash()).second);
+      }
+      ASSERT_EQ(out, expected) << "limit " << limit << (is_desc ? " desc" : "");
+    }
+  }
+};
+
+TEST_F(TopNTest, Limits)
+{
+  auto tab = CreateRows(3000);
+  for (size_t limit : {0, 1, 10, 199, 3000, 5000}) {
+    CheckTopN(tab, {"k"}, false, limit);
+    CheckTopN(tab, {"k"}, true, limit);
+  }
+}
+
+TEST_F(TopNTest, CompositeKey)
+{
+  auto tab = CreateRows(3000);
+  CheckTopN(tab, {"k", "id"}, false, 100);
+  CheckTopN(tab, {"k", "id"}, true, 100);
+}
+
+TEST_F(TopNTest, EmptyChild)
+{
+  auto tab = CreateRows(0);
+  CheckTopN(tab, {"k"}, false, 10);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,160 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+/**
+ * Benchmark of the parallel hash join of the stock and item tables of test/sql, generated in place.
+ * The number of stock rows is set by the environment variable WSDB_BENCH_ROWS (200000 by default), item has half as
+ * many rows, so that half of the stock rows have no matching item, e.g. WSDB_BENCH_ROWS=10000000 ./hash_join_benchmark
+ */
+
+#include "execution_fixture.h"
+#include "concurrency/task_scheduler.h"
+#include "execution/executor_join_hash.h"
+#include "execution/executor_seqscan.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+#include "gtest/gtest.h"
+using namespace wsdb;
+
+class HashJoinBenchmark : public ExecutionTest
+{
+protected:
+  /**
+   * join the left table with the right one on the key fields with 1, 2, 4, ... workers up to the number of cores,
+   * check the number of joined records and print the time of each run
+   * @param buffer_size the memory of the build side, smaller than the build side to run Grace hash join
+   */
+  void RunJoin(TableHandle *left, TableHandle *right, const std::string &left_key, const std::string &right_key,
+      JoinType join_type, bool build_left, size_t expected_rows, size_t buffer_size = HASH_JOIN_BUFFER_SIZE)
+  {
+    auto max_workers = TaskScheduler::GetInstance()->GetWorkerNum();
+    for (size_t workers = 1;; workers = std::min(workers * 2, max_workers)) {
+      auto join  = std::make_unique<HashJoinExecutor>(join_type,
+          std::make_unique<SeqScanExecutor>(left),
+          std::make_unique<SeqScanExecutor>(right),
+          std::make_unique<RecordSchema>(
+              std::vector<RTField>{left->GetSchema().GetFieldByName(left->GetTableId(), left_key)}),
+          std::make_unique<RecordSchema>(
+              std::vector<RTField>{right->GetSchema().GetFieldByName(right->GetTableId(), right_key)}),
+          build_left,
+          workers,
+          nullptr,
+          buffer_size);
+      auto start = std::chrono::steady_clock::now();
+      size_t rows = 0;
+      for (join->Init(); !join->IsEnd(); join->Next()) {
+        rows++;
+      }
+      auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+      ASSERT_EQ(rows, expected_rows);
+      std::cout << fmt::format("{} {} {} on {} = {}, build {}, {} KB buffer: {} rows, {} workers, {} ms\n",
+          left->GetTableName(),
+          JoinTypeToString(join_type),
+          right->GetTableName(),
+          left_key,
+          right_key,
+          build_left ? "left" : "right",
+          buffer_size / 1024,
+          rows,
+          workers,
+          ms.count());
+      if (workers == max_workers) {
+        break;
+      }
+    }
+  }
+};
+
+TEST_F(HashJoinBenchmark, StockItem)
+{
+  auto item = CreateTable("bench_item",
+      {MakeField("i_id", TYPE_INT, 4),
+          MakeField("i_im_id", TYPE_INT, 4),
+          MakeField("i_name", TYPE_STRING, 24),
+          MakeField("i_price", TYPE_FLOAT, 4),
+          MakeField("i_data", TYPE_STRING, 50)});
+  std::vector<RTField> fields{
+      MakeField("s_i_id", TYPE_INT, 4), MakeField("s_w_id", TYPE_INT, 4), MakeField("s_quantity", TYPE_INT, 4)};
+  for (int i = 1; i <= 10; ++i) {
+    fields.push_back(MakeField(fmt::format("s_dist_{:02}", i), TYPE_STRING, 24));
+  }
+  fields.push_back(MakeField("s_ytd", TYPE_FLOAT, 4));
+  fields.push_back(MakeField("s_order_cnt", TYPE_INT, 4));
+  fields.push_back(MakeField("s_remote_cnt", TYPE_INT, 4));
+  fields.push_back(MakeField("s_data", TYPE_STRING, 50));
+  auto stock = CreateTable("bench_stock", fields);
+
+  std::mt19937                          rng(2024);
+  std::uniform_real_distribution<float> price(0, 1000);
+  auto                                  stock_rows = GetBenchRows();
+  auto                                  item_rows  = stock_rows / 2;
+  for (size_t i = 0; i < item_rows; ++i) {
+    auto name = RandomString(rng, 24);
+    auto data = RandomString(rng, 50);
+    item->InsertRecord(Record(&item->GetSchema(),
+        {ValueFactory::CreateIntValue(static_cast<int>(i)),
+            ValueFactory::CreateIntValue(static_cast<int>(rng() % 10001)),
+            ValueFactory::CreateStringValue(name.c_str(), name.size()),
+            ValueFactory::CreateFloatValue(price(rng)),
+            ValueFactory::CreateStringValue(data.c_str(), data.size())},
+        INVALID_RID));
+  }
+  // stock rows with an item, and items without any stock row
+  size_t            matched_rows = 0;
+  std::vector<bool> item_matched(item_rows, false);
+  for (size_t i = 0; i < stock_rows; ++i) {
+    auto                   i_id = rng() % stock_rows;
+    std::vector<ValueSptr> values{ValueFactory::CreateIntValue(static_cast<int>(i_id)),
+        ValueFactory::CreateIntValue(static_cast<int>(rng() % 10001)),
+        ValueFactory::CreateIntValue(static_cast<int>(rng() % 101))};
+    for (int d = 0; d < 10; ++d) {
+      auto dist = RandomString(rng, 24);
+      values.push_back(ValueFactory::CreateStringValue(dist.c_str(), dist.size()));
+    }
+    auto data = RandomString(rng, 50);
+    values.push_back(ValueFactory::CreateFloatValue(price(rng)));
+    values.push_back(ValueFactory::CreateIntValue(static_cast<int>(rng() % 101)));
+    values.push_back(ValueFactory::CreateIntValue(static_cast<int>(rng() % 101)));
+    values.push_back(ValueFactory::CreateStringValue(data.c_str(), data.size()));
+    stock->InsertRecord(Record(&stock->GetSchema(), values, INVALID_RID));
+    if (i_id < item_rows) {
+      matched_rows++;
+      item_matched[i_id] = true;
+    }
+  }
+  auto unmatched_items = static_cast<size_t>(std::count(item_matched.begin(), item_matched.end(), false));
+  RunJoin(stock, item, "s_i_id", "i_id", INNER_JOIN, false, matched_rows);
+  RunJoin(stock, item, "s_i_id", "i_id", INNER_JOIN, true, matched_rows);
+  RunJoin(stock, item, "s_i_id", "i_id", OUTER_JOIN, false, stock_rows);
+  RunJoin(item, stock, "i_id", "s_i_id", OUTER_JOIN, true, matched_rows + unmatched_items);
+  // about a twentieth of the items fit in memory, the partitions of the first level are partitioned again
+  RunJoin(stock, item, "s_i_id", "i_id", INNER_JOIN, false, matched_rows, item_rows * 200 / 20);
+  RunJoin(stock, item, "s_i_id", "i_id", OUTER_JOIN, false, stock_rows, item_rows * 200 / 20);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,163 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+/**
+ * Benchmark of the parallel sort on the dbcourse and stock tables of test/sql, generated in place.
+ * The number of rows is set by the environment variable WSDB_BENCH_ROWS (200000 by default), set it to tens of millions
+ * to exercise the external sort, e.g. WSDB_BENCH_ROWS=20000000 ./sort_benchmark
+ */
+
+#include "execution_fixture.h"
+#include "concurrency/task_scheduler.h"
+#include "execution/executor_seqscan.h"
+#include "execution/executor_sort.h"
+#include "system/handle/key_encoder.h"
+
+#include <chrono>
+#include <random>
+
+#include "gtest/gtest.h"
+using namespace wsdb;
+
+class SortBenchmark : public ExecutionTest
+{
+protected:
+  /**
+   * sort the table by the key fields with 1, 2, 4, ... workers up to the number of cores, check the order and print
+   * the time of each run
+   */
+  void RunSort(TableHandle *tab, const std::vector<std::string> &key_names, bool is_desc)
+  {
+    std::vector<RTField> key_fields;
+    for (const auto &name : key_names) {
+      key_fields.push_back(tab->GetSchema().GetFieldByName(tab->GetTableId(), name));
+    }
+    RecordSchema key_schema(key_fields);
+    KeyEncoder   encoder(&tab->GetSchema(), &key_schema, is_desc);
+    auto         max_workers = TaskScheduler::GetInstance()->GetWorkerNum();
+    for (size_t workers = 1;; workers = std::min(workers * 2, max_workers)) {
+      auto sort  = std::make_unique<SortExecutor>(std::make_unique<SeqScanExecutor>(tab),
+          std::make_unique<RecordSchema>(key_fields),
+          is_desc,
+          workers);
+      auto start = std::chrono::steady_clock::now();
+      sort->Init();
+      size_t            rows = 0;
+      std::vector<char> prev_key(encoder.GetKeySize()), key(encoder.GetKeySize());
+      for (; !sort->IsEnd(); sort->Next()) {
+        encoder.Encode(*sort->GetRecord(), key.data());
+        ASSERT_TRUE(rows == 0 || std::memcmp(prev_key.data(), key.data(), key.size()) <= 0);
+        std::swap(prev_key, key);
+        rows++;
+      }
+      auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+      ASSERT_EQ(rows, GetBenchRows());
+      std::string keys;
+      for (const auto &name : key_names) {
+        keys += (keys.empty() ? "" : ", ") + name;
+      }
+      std::cout << fmt::format("{} order by {}{}: {} rows, {} workers, {} ms\n",
+          tab->GetTableName(),
+          keys,
+          is_desc ? " desc" : "",
+          rows,
+          workers,
+          ms.count());
+      if (workers == max_workers) {
+        break;
+      }
+    }
+  }
+};
+
+TEST_F(SortBenchmark, DBCourse)
+{
+  auto tab = CreateTable("bench_dbcourse",
+      {MakeField("id", TYPE_INT, 4),
+          MakeField("name", TYPE_STRING, 20),
+          MakeField("age", TYPE_INT, 4),
+          MakeField("address", TYPE_STRING, 50),
+          MakeField("gpa", TYPE_FLOAT, 4),
+          MakeField("l1_score", TYPE_FLOAT, 4),
+          MakeField("l2_score", TYPE_FLOAT, 4)});
+  std::mt19937                          rng(2024);
+  std::uniform_real_distribution<float> gpa(0, 5), score(40, 100);
+  auto                                  null_or = [&rng](ValueSptr value) {
+    // l1_score, l2_score and address have 5% chance to be null
+    return rng() % 20 == 0 ? ValueFactory::CreateNullValue(value->GetType()) : value;
+  };
+  for (size_t i = 0; i < GetBenchRows(); ++i) {
+    auto name    = RandomString(rng, 3 + rng() % 8);
+    auto address = RandomString(rng, 5 + rng() % 10);
+    tab->InsertRecord(Record(&tab->GetSchema(),
+        {ValueFactory::CreateIntValue(static_cast<int>(i + 1)),
+            ValueFactory::CreateStringValue(name.c_str(), name.size()),
+            ValueFactory::CreateIntValue(static_cast<int>(10 + rng() % 41)),
+            null_or(ValueFactory::CreateStringValue(address.c_str(), address.size())),
+            ValueFactory::CreateFloatValue(gpa(rng)),
+            null_or(ValueFactory::CreateFloatValue(score(rng))),
+            null_or(ValueFactory::CreateFloatValue(score(rng)))},
+        INVALID_RID));
+  }
+  RunSort(tab, {"gpa"}, true);
+  RunSort(tab, {"address", "age"}, false);
+  RunSort(tab, {"l1_score", "l2_score", "id"}, false);
+}
+
+TEST_F(SortBenchmark, Stock)
+{
+  std::vector<RTField> fields{
+      MakeField("s_i_id", TYPE_INT, 4), MakeField("s_w_id", TYPE_INT, 4), MakeField("s_quantity", TYPE_INT, 4)};
+  for (int i = 1; i <= 10; ++i) {
+    fields.push_back(MakeField(fmt::format("s_dist_{:02}", i), TYPE_STRING, 24));
+  }
+  fields.push_back(MakeField("s_ytd", TYPE_FLOAT, 4));
+  fields.push_back(MakeField("s_order_cnt", TYPE_INT, 4));
+  fields.push_back(MakeField("s_remote_cnt", TYPE_INT, 4));
+  fields.push_back(MakeField("s_data", TYPE_STRING, 50));
+  auto                                  tab = CreateTable("bench_stock", fields);
+  std::mt19937                          rng(2024);
+  std::uniform_real_distribution<float> ytd(0, 1000);
+  for (size_t i = 0; i < GetBenchRows(); ++i) {
+    std::vector<ValueSptr> values{ValueFactory::CreateIntValue(static_cast<int>(i)),
+        ValueFactory::CreateIntValue(static_cast<int>(rng() % 10001)),
+        ValueFactory::CreateIntValue(static_cast<int>(rng() % 101))};
+    for (int d = 0; d < 10; ++d) {
+      auto dist = RandomString(rng, 24);
+      values.push_back(ValueFactory::CreateStringValue(dist.c_str(), dist.size()));
+    }
+    auto data = RandomString(rng, 50);
+    values.push_back(ValueFactory::CreateFloatValue(ytd(rng)));
+    values.push_back(ValueFactory::CreateIntValue(static_cast<int>(rng() % 101)));
+    values.push_back(ValueFactory::CreateIntValue(static_cast<int>(rng() % 101)));
+    values.push_back(ValueFactory::CreateStringValue(data.c_str(), data.size()));
+    tab->InsertRecord(Record(&tab->GetSchema(), values, INVALID_RID));
+  }
+  RunSort(tab, {"s_ytd"}, false);
+  RunSort(tab, {"s_w_id", "s_quantity"}, true);
+  RunSort(tab, {"s_dist_01"}, false);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,197 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+#include "../config.h"
+#include "common/config.h"
+#include "execution/executor.h"
+#include "optimizer/optimizer.h"
+#include "parser/parser.h"
+#include "plan/planner.h"
+#include "storage/storage.h"
+#include "system/handle/database_handle.h"
+#include "system/index/index_manager.h"
+#include "system/table/table_manager.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+using namespace wsdb;
+
+static const std::string DB_NAME = "optimizer_test_db";
+
+/// statements are parsed, planned and optimized as the server does, and run by the executors in the test
+class OptimizerTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    std::filesystem::remove_all(DB_NAME);
+    std::filesystem::create_directory(DB_NAME);
+    if (!std::filesystem::exists(TMP_DIR)) {
+      std::filesystem::create_directory(TMP_DIR);
+    }
+    disk_manager_        = std::make_unique<DiskManager>();
+    buffer_pool_manager_ = std::make_unique<BufferPoolManager>(disk_manager_.get(), nullptr);
+    table_manager_       = std::make_unique<TableManager>(disk_manager_.get(), buffer_pool_manager_.get());
+    index_manager_       = std::make_unique<IndexManager>(disk_manager_.get(), buffer_pool_manager_.get());
+    DiskManager::CreateFile(FILE_NAME(DB_NAME, DB_NAME, DB_SUFFIX));
+    db_ = std::make_unique<DatabaseHandle>(DB_NAME, disk_manager_.get(), table_manager_.get(), index_manager_.get());
+    db_->ref_cnt_ = 1;
+    db_->Open();
+  }
+
+  void TearDown() override
+  {
+    db_->Close();
+    std::filesystem::remove_all(DB_NAME);
+  }
+
+  auto Plan(const std::string &sql) -> std::shared_ptr<AbstractPlan>
+  {
+    return Optimizer::Optimize(Planner::PlanAST(Parser::Parse(sql), db_.get()), db_.get());
+  }
+
+  /// run a DDL or DML statement
+  void Execute(const std::string &sql)
+  {
+    auto executor = Executor::Translate(Planner::PlanAST(Parser::Parse(sql), db_.get()), db_.get());
+    executor->Next();
+  }
+
+  /// run a query and return the sorted values of the records separated by commas
+  auto Query(const std::string &sql) -> std::vector<std::string>
+  {
+    auto                     executor = Executor::Translate(Plan(sql), db_.get());
+    std::vector<std::string> records;
+    for (executor->Init(); !executor->IsEnd(); executor->Next()) {
+      std::string str;
+      auto        record = executor->GetRecord();
+      for (size_t i = 0; i < record->GetSchema()->GetFieldCount(); ++i) {
+        str += record->GetValueAt(i)->ToString() + ",";
+      }
+      records.push_back(str);
+    }
+    std::sort(records.begin(), records.end());
+    return records;
+  }
+
+  static auto FindJoin(const std::shared_ptr<AbstractPlan> &plan) -> std::shared_ptr<JoinPlan>
+  {
+    if (auto join = std::dynamic_pointer_cast<JoinPlan>(plan)) {
+      return join;
+    }
+    if (auto proj = std::dynamic_pointer_cast<ProjectPlan>(plan)) {
+      return FindJoin(proj->child_);
+    }
+    return nullptr;
+  }
+
+  std::unique_ptr<DiskManager>       disk_manager_;
+  std::unique_ptr<BufferPoolManager> buffer_pool_manager_;
+  std::unique_ptr<TableManager>      table_manager_;
+  std::unique_ptr<IndexManager>      index_manager_;
+  std::unique_ptr<DatabaseHandle>    db_;
+};
+
+/// a few outer rows probe an index of a large inner table, unless the query chooses another strategy
+TEST_F(OptimizerTest, IndexJoin)
+{
+  Execute("CREATE TABLE t1 (id int, k int);");
+  Execute("CREATE TABLE t2 (id int, k int, pad char(200));");
+  for (int i = 0; i < 10; ++i) {
+    Execute(fmt::format("INSERT INTO t1 VALUES ({}, {});", i, i * 7));
+  }
+  for (int i = 0; i < 3000; ++i) {
+    Execute(fmt::format("INSERT INTO t2 VALUES ({}, {}, 'p');", i, i % 100));
+  }
+  Execute("CREATE INDEX t2(k);");
+
+  auto expected = Query("SELECT * FROM t1, t2 WHERE t1.k = t2.k USING HASH_JOIN;");
+  // every key of t1 is below 100 and matches 30 rows of t2
+  ASSERT_EQ(expected.size(), 300);
+  for (const auto &sql : {"SELECT * FROM t1, t2 WHERE t1.k = t2.k;", "SELECT * FROM t1, t2 WHERE t2.k = t1.k;"}) {
+    SCOPED_TRACE(sql);
+    auto join = FindJoin(Plan(sql));
+    ASSERT_NE(join, nullptr);
+    ASSERT_EQ(join->strategy_, INDEX_NESTED_LOOP);
+    // the swapped condition reads the left column from the outer table
+    ASSERT_EQ(join->conds_.size(), 1);
+    ASSERT_EQ(join->conds_[0].GetLCol().field_.table_id_, db_->GetTable("t1")->GetTableId());
+    ASSERT_EQ(Query(sql), expected);
+  }
+
+  // the strategy given by USING is kept
+  auto sort_merge = FindJoin(Plan("SELECT * FROM t1, t2 WHERE t2.k = t1.k USING SORT_MERGE_JOIN;"));
+  ASSERT_NE(sort_merge, nullptr);
+  ASSERT_EQ(sort_merge->strategy_, SORT_MERGE);
+  for (const auto &[sql, strategy] : std::vector<std::pair<std::string, JoinStrategy>>{
+           {"SELECT * FROM t1, t2 WHERE t2.k = t1.k USING NESTED_LOOP_JOIN;", NESTED_LOOP},
+           {"SELECT * FROM t1, t2 WHERE t2.k = t1.k USING HASH_JOIN;", HASH}}) {
+    SCOPED_TRACE(sql);
+    auto join = FindJoin(Plan(sql));
+    ASSERT_NE(join, nullptr);
+    ASSERT_EQ(join->strategy_, strategy);
+    ASSERT_EQ(Query(sql), expected);
+  }
+}
+
+/// only the inputs read once are scanned by several workers
+TEST_F(OptimizerTest, ParallelScan)
+{
+  Execute("CREATE TABLE t1 (id int, k int, pad char(200));");
+  Execute("CREATE TABLE t2 (id int, k int, pad char(200));");
+  for (int i = 0; i < 3000; ++i) {
+    Execute(fmt::format("INSERT INTO t1 VALUES ({}, {}, 'p');", i, i % 100));
+    Execute(fmt::format("INSERT INTO t2 VALUES ({}, {}, 'p');", i, i % 100));
+  }
+  auto is_parallel = std::thread::hardware_concurrency() > 1;
+
+  // the nested loop join scans its right input again for every block of left records
+  auto nested_loop = FindJoin(Plan("SELECT * FROM t1, t2 WHERE t1.k = t2.k USING NESTED_LOOP_JOIN;"));
+  ASSERT_NE(nested_loop, nullptr);
+  ASSERT_EQ(nested_loop->strategy_, NESTED_LOOP);
+  ASSERT_EQ(std::dynamic_pointer_cast<GatherPlan>(nested_loop->left_) != nullptr, is_parallel);
+  ASSERT_EQ(std::dynamic_pointer_cast<GatherPlan>(nested_loop->right_), nullptr);
+
+  auto hash = FindJoin(Plan("SELECT * FROM t1, t2 WHERE t1.k = t2.k USING HASH_JOIN;"));
+  ASSERT_NE(hash, nullptr);
+  ASSERT_EQ(hash->strategy_, HASH);
+  ASSERT_EQ(std::dynamic_pointer_cast<GatherPlan>(hash->left_) != nullptr, is_parallel);
+  ASSERT_EQ(std::dynamic_pointer_cast<GatherPlan>(hash->right_) != nullptr, is_parallel);
+
+  // the sorts below the sort merge join read their inputs once
+  auto sort_merge = FindJoin(Plan("SELECT * FROM t1, t2 WHERE t1.k = t2.k USING SORT_MERGE_JOIN;"));
+  ASSERT_NE(sort_merge, nullptr);
+  ASSERT_EQ(sort_merge->strategy_, SORT_MERGE);
+  auto right_sort = std::dynamic_pointer_cast<SortPlan>(sort_merge->right_);
+  ASSERT_NE(right_sort, nullptr);
+  ASSERT_EQ(std::dynamic_pointer_cast<GatherPlan>(right_sort->child_) != nullptr, is_parallel);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,73 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+#include "parser/parser.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+using namespace wsdb;
+
+/// the keywords of CREATE INDEX name tables and columns elsewhere, with the case they are written in
+TEST(ParserTest, KeywordNames)
+{
+  auto create = std::dynamic_pointer_cast<ast::CreateTable>(Parser::Parse("CREATE TABLE hash (btree int, Bptree int);"));
+  ASSERT_NE(create, nullptr);
+  ASSERT_EQ(create->tab_name_, "hash");
+  std::vector<std::string> col_names;
+  for (const auto &field : create->fields_) {
+    col_names.push_back(std::dynamic_pointer_cast<ast::ColDef>(field)->col_name_);
+  }
+  ASSERT_EQ(col_names, std::vector<std::string>({"btree", "Bptree"}));
+
+  auto index = std::dynamic_pointer_cast<ast::CreateIndex>(Parser::Parse("CREATE INDEX hash(btree) USING HASH;"));
+  ASSERT_NE(index, nullptr);
+  ASSERT_EQ(index->tab_name_, "hash");
+  ASSERT_EQ(index->col_names_, std::vector<std::string>({"btree"}));
+  ASSERT_EQ(index->index_type_, IndexType::HASH);
+
+  auto covering =
+      std::dynamic_pointer_cast<ast::CreateIndex>(Parser::Parse("CREATE INDEX t(include) INCLUDE (Include, hash);"));
+  ASSERT_NE(covering, nullptr);
+  ASSERT_EQ(covering->col_names_, std::vector<std::string>({"include"}));
+  ASSERT_EQ(covering->include_names_, std::vector<std::string>({"Include", "hash"}));
+
+  auto art = std::dynamic_pointer_cast<ast::CreateIndex>(Parser::Parse("CREATE INDEX art(Art) USING ART;"));
+  ASSERT_NE(art, nullptr);
+  ASSERT_EQ(art->tab_name_, "art");
+  ASSERT_EQ(art->col_names_, std::vector<std::string>({"Art"}));
+  ASSERT_EQ(art->index_type_, IndexType::ART);
+
+  auto select =
+      std::dynamic_pointer_cast<ast::SelectStmt>(Parser::Parse("SELECT hash.btree FROM hash WHERE Bptree = 1;"));
+  ASSERT_NE(select, nullptr);
+  ASSERT_EQ(select->cols.size(), 1);
+  ASSERT_EQ(select->cols[0]->tab_name, "hash");
+  ASSERT_EQ(select->cols[0]->col_name, "btree");
+  ASSERT_EQ(select->conds.size(), 1);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
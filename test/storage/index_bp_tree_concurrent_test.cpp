@@ -0,0 +1,372 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+/**
+ * Stress test and benchmark of concurrent accesses to the B+tree index. The key k is indexed with the rid (k, 0), so
+ * the rids of a scan are ordered by key. The number of keys is set by the environment variable WSDB_BENCH_ROWS (20000
+ * by default), e.g. WSDB_BENCH_ROWS=1000000 ./index_bp_tree_concurrent_test
+ * The compression benchmark compares the height, the pages and the lookup latency of trees with and without key
+ * compression.
+ */
+
+#include "../config.h"
+#include "common/types.h"
+#include "storage/storage.h"
+#include "storage/index/index_bp_tree.h"
+#include "system/handle/index_handle.h"
+#include "system/index/index_manager.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+using namespace wsdb;
+
+static auto GetBenchRows() -> int
+{
+  auto rows = std::getenv("WSDB_BENCH_ROWS");
+  return rows == nullptr ? 20000 : std::stoi(rows);
+}
+
+static auto GetThreadNum() -> size_t { return std::max<size_t>(std::thread::hardware_concurrency(), 4); }
+
+class BPTreeConcurrentTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    if (!std::filesystem::exists(TEST_DIR)) {
+      std::filesystem::create_directory(TEST_DIR);
+    }
+    disk_manager_        = std::make_unique<DiskManager>();
+    buffer_pool_manager_ = std::make_unique<BufferPoolManager>(disk_manager_.get(), nullptr);
+    index_manager_       = std::make_unique<IndexManager>(disk_manager_.get(), buffer_pool_manager_.get());
+    // a padding field makes the nodes small, so that the tree has several levels and splits and merges often
+    std::vector<RTField> fields(2);
+    fields[0].field_ = {.table_id_ = 0, .field_name_ = "k", .field_size_ = 4, .field_type_ = TYPE_INT};
+    fields[1].field_ = {.table_id_ = 0, .field_name_ = "pad", .field_size_ = 100, .field_type_ = TYPE_STRING};
+    key_schema_      = std::make_unique<RecordSchema>(fields);
+  }
+
+  void TearDown() override
+  {
+    if (index_ != nullptr) {
+      index_manager_->CloseIndex(*index_);
+      index_manager_->DropIndex(TEST_DIR, index_name_);
+    }
+  }
+
+  void CreateIndex()
+  {
+    if (std::filesystem::exists(FILE_NAME(TEST_DIR, index_name_, IDX_SUFFIX))) {
+      std::filesystem::remove(FILE_NAME(TEST_DIR, index_name_, IDX_SUFFIX));
+    }
+    index_manager_->CreateIndex(TEST_DIR, index_name_, "t", *key_schema_, IndexType::BPTREE);
+    index_ = index_manager_->OpenIndex(TEST_DIR, index_name_, 0);
+  }
+
+  void DropIndex()
+  {
+    index_manager_->CloseIndex(*index_);
+    index_manager_->DropIndex(TEST_DIR, index_name_);
+    index_ = nullptr;
+  }
+
+  [[nodiscard]] auto MakeKey(int k) const -> Record
+  {
+    // the padding is filled, since the zeros at the end of a key are not stored in the nodes
+    static const std::string pad(100, '.');
+    std::vector<ValueSptr>   values{ValueFactory::CreateIntValue(k), ValueFactory::CreateStringValue(pad.c_str(), 100)};
+    return {key_schema_.get(), values, INVALID_RID};
+  }
+
+  void Insert(int k) { index_->GetIndex()->Insert(MakeKey(k), RID(k, 0)); }
+
+  void Delete(int k) { index_->GetIndex()->Delete(MakeKey(k), RID(k, 0)); }
+
+  auto Search(int k) -> std::vector<RID> { return index_->GetIndex()->Search(MakeKey(k), 1); }
+
+  auto SearchRange(int lo, int hi) -> std::vector<RID>
+  {
+    auto       low_key  = MakeKey(lo);
+    auto       high_key = MakeKey(hi);
+    IndexBound low{.key_ = &low_key, .cmp_field_num_ = 1, .inclusive_ = true};
+    IndexBound high{.key_ = &high_key, .cmp_field_num_ = 1, .inclusive_ = true};
+    return index_->GetIndex()->SearchRange(low, high);
+  }
+
+  std::unique_ptr<DiskManager>       disk_manager_;
+  std::unique_ptr<BufferPoolManager> buffer_pool_manager_;
+  std::unique_ptr<IndexManager>      index_manager_;
+  RecordSchemaUptr                   key_schema_;
+  std::string                        index_name_ = "index_bp_tree_concurrent";
+  IndexHandleUptr                    index_;
+};
+
+/**
+ * the even keys are inserted before and never modified, while writers insert and delete the odd keys of their own,
+ * and readers check that the scans are ordered and see all the even keys
+ */
+TEST_F(BPTreeConcurrentTest, Stress)
+{
+  CreateIndex();
+  auto key_num    = GetBenchRows();
+  auto writer_num = GetThreadNum();
+  auto reader_num = writer_num / 2;
+  for (int k = 0; k < key_num; k += 2) {
+    Insert(k);
+  }
+
+  std::atomic<size_t>      errors{0};
+  std::atomic<size_t>      finished_writers{0};
+  std::vector<int>         remaining;  // odd keys left by the writers
+  std::mutex               remaining_mutex;
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < writer_num; ++t) {
+    threads.emplace_back([&, t]() {
+      std::mt19937     rng(t);
+      std::vector<int> keys;
+      for (auto k = static_cast<int>(2 * t + 1); k < key_num; k += static_cast<int>(2 * writer_num)) {
+        keys.push_back(k);
+      }
+      std::shuffle(keys.begin(), keys.end(), rng);
+      for (auto k : keys) {
+        Insert(k);
+        if (Search(k).size() != 1) {
+          errors++;
+        }
+      }
+      // delete the keys in a random order, half of them
+      std::shuffle(keys.begin(), keys.end(), rng);
+      auto half = keys.size() / 2;
+      for (size_t i = 0; i < half; ++i) {
+        Delete(keys[i]);
+        if (!Search(keys[i]).empty()) {
+          errors++;
+        }
+      }
+      std::lock_guard lock(remaining_mutex);
+      remaining.insert(remaining.end(), keys.begin() + static_cast<std::ptrdiff_t>(half), keys.end());
+      finished_writers++;
+    });
+  }
+  for (size_t t = 0; t < reader_num; ++t) {
+    threads.emplace_back([&, t]() {
+      std::mt19937 rng(writer_num + t);
+      while (finished_writers < writer_num) {
+        int  lo    = static_cast<int>(rng() % key_num);
+        int  hi    = lo + 200;
+        auto upper = std::min(hi, key_num - 1);
+        auto rids  = SearchRange(lo, hi);
+        int  even  = 0;
+        for (size_t i = 0; i < rids.size(); ++i) {
+          if (rids[i].PageID() < lo || rids[i].PageID() > hi || (i > 0 && rids[i - 1].PageID() >= rids[i].PageID())) {
+            errors++;
+          }
+          even += rids[i].PageID() % 2 == 0 ? 1 : 0;
+        }
+        if (even != (upper - upper % 2 - (lo + lo % 2)) / 2 + 1) {
+          errors++;
+        }
+        auto k = static_cast<int>(rng() % key_num) & ~1;
+        if (Search(k).size() != 1) {
+          errors++;
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(errors, 0);
+
+  // the index holds exactly the even keys and the remaining odd keys
+  for (int k = 0; k < key_num; k += 2) {
+    remaining.push_back(k);
+  }
+  std::sort(remaining.begin(), remaining.end());
+  auto rids = index_->GetIndex()->SearchRange({}, {});
+  ASSERT_EQ(rids.size(), remaining.size());
+  for (size_t i = 0; i < rids.size(); ++i) {
+    ASSERT_EQ(rids[i], RID(remaining[i], 0));
+  }
+  // concurrent deletion of all the keys, which shrinks the tree to empty
+  threads.clear();
+  for (size_t t = 0; t < writer_num; ++t) {
+    threads.emplace_back([&, t]() {
+      for (auto i = t; i < remaining.size(); i += writer_num) {
+        Delete(remaining[i]);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ASSERT_TRUE(index_->GetIndex()->SearchRange({}, {}).empty());
+}
+
+/**
+ * run a mix of 80% point searches, 10% insertions and 10% deletions with 1, 2, 4, ... threads, and print the
+ * throughput of each run
+ */
+TEST_F(BPTreeConcurrentTest, Throughput)
+{
+  auto key_num    = GetBenchRows();
+  auto max_thread = GetThreadNum();
+  for (size_t thread_num = 1;; thread_num = std::min(thread_num * 2, max_thread)) {
+    CreateIndex();
+    // the even keys are preloaded, each thread inserts and deletes its own odd keys
+    for (int k = 0; k < key_num; k += 2) {
+      Insert(k);
+    }
+    auto                     op_num = static_cast<size_t>(key_num) * 2 / thread_num;
+    std::atomic<size_t>      errors{0};
+    std::vector<std::thread> threads;
+    auto                     start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < thread_num; ++t) {
+      threads.emplace_back([&, t]() {
+        std::mt19937     rng(t);
+        std::vector<int> inserted;
+        auto             next = static_cast<int>(2 * t + 1);
+        for (size_t i = 0; i < op_num; ++i) {
+          auto op = rng() % 10;
+          if (op == 0 && next < key_num) {
+            Insert(next);
+            inserted.push_back(next);
+            next += static_cast<int>(2 * thread_num);
+          } else if (op == 1 && !inserted.empty()) {
+            std::swap(inserted[rng() % inserted.size()], inserted.back());
+            Delete(inserted.back());
+            inserted.pop_back();
+          } else if (Search(static_cast<int>(rng() % key_num) & ~1).size() != 1) {
+            errors++;
+          }
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    ASSERT_EQ(errors, 0);
+    std::cout << fmt::format("{} keys, {} threads: {} ops in {} ms, {:.0f} ops/s\n",
+        key_num,
+        thread_num,
+        op_num * thread_num,
+        ms.count(),
+        static_cast<double>(op_num * thread_num) * 1000 / std::max<int64_t>(ms.count(), 1));
+    DropIndex();
+    if (thread_num == max_thread) {
+      break;
+    }
+  }
+}
+
+/**
+ * load the keys of IndexHandle.BPTreeCompression, strings of different lengths sharing a long prefix, into a tree
+ * without key compression and a compressed one, and print the height, the pages and the average latency of point
+ * searches and of range scans of RANGE_SIZE keys of each
+ */
+TEST_F(BPTreeConcurrentTest, Compression)
+{
+  static constexpr int RANGE_SIZE = 100;
+  std::vector<RTField> fields(1);
+  fields[0].field_ = {.table_id_ = 0, .field_name_ = "s", .field_size_ = 64, .field_type_ = TYPE_STRING};
+  RecordSchema key_schema(fields);
+  auto         make_key = [&](int n) {
+    auto                   str = fmt::format("user_{:08d}{}", n, std::string(n % 7, 'x'));
+    std::vector<ValueSptr> values{ValueFactory::CreateStringValue(str.c_str(), str.size())};
+    return Record(&key_schema, values, INVALID_RID);
+  };
+  auto             key_num = GetBenchRows();
+  std::vector<int> keys(key_num);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::mt19937 rng(0);
+  std::shuffle(keys.begin(), keys.end(), rng);
+  std::vector<Record> search_keys;
+  for (auto n : keys) {
+    search_keys.push_back(make_key(n));
+  }
+  // ranges [lo, lo + RANGE_SIZE) of the keys, which are ordered by n
+  std::vector<int>    range_los;
+  std::vector<Record> range_bounds;
+  for (int i = 0; i < std::max(key_num / RANGE_SIZE, 1); ++i) {
+    range_los.push_back(static_cast<int>(rng() % std::max(key_num - RANGE_SIZE + 1, 1)));
+    range_bounds.push_back(make_key(range_los.back()));
+    range_bounds.push_back(make_key(range_los.back() + RANGE_SIZE));
+  }
+
+  std::vector<BPTreeHeader> headers;
+  for (bool compress_keys : {false, true}) {
+    if (std::filesystem::exists(FILE_NAME(TEST_DIR, index_name_, IDX_SUFFIX))) {
+      std::filesystem::remove(FILE_NAME(TEST_DIR, index_name_, IDX_SUFFIX));
+    }
+    index_manager_->CreateIndex(TEST_DIR, index_name_, "t", key_schema, IndexType::BPTREE);
+    // the tree is opened directly, since an index handle always opens a new tree with compression
+    auto fid = disk_manager_->OpenFile(FILE_NAME(TEST_DIR, index_name_, IDX_SUFFIX));
+    {
+      BPTreeIndex tree(disk_manager_.get(), buffer_pool_manager_.get(), fid, &key_schema, nullptr, compress_keys);
+      for (auto n : keys) {
+        tree.Insert(make_key(n), RID(n, 0));
+      }
+      auto start = std::chrono::steady_clock::now();
+      for (const auto &key : search_keys) {
+        ASSERT_EQ(tree.Search(key, 1).size(), 1U);
+      }
+      auto point_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+      start         = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < range_los.size(); ++i) {
+        IndexBound low{.key_ = &range_bounds[2 * i], .cmp_field_num_ = 1, .inclusive_ = true};
+        IndexBound high{.key_ = &range_bounds[2 * i + 1], .cmp_field_num_ = 1, .inclusive_ = false};
+        auto       expected = std::min(RANGE_SIZE, key_num - range_los[i]);
+        ASSERT_EQ(tree.SearchRange(low, high).size(), static_cast<size_t>(expected));
+      }
+      auto range_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+      headers.push_back(tree.GetHeader());
+      std::cout << fmt::format("{} keys, {}: height {}, {} pages, point search {:.2f} us, range scan {:.2f} us\n",
+          key_num,
+          compress_keys ? "compressed" : "uncompressed",
+          tree.GetHeader().height_,
+          tree.GetHeader().page_num_,
+          static_cast<double>(point_ns.count()) / 1000 / static_cast<double>(search_keys.size()),
+          static_cast<double>(range_ns.count()) / 1000 / static_cast<double>(range_los.size()));
+    }
+    buffer_pool_manager_->FlushAllPages(fid);
+    buffer_pool_manager_->DeleteAllPages(fid);
+    disk_manager_->CloseFile(fid);
+    index_manager_->DropIndex(TEST_DIR, index_name_);
+  }
+  ASSERT_LE(headers[1].height_, headers[0].height_);
+  ASSERT_LT(headers[1].page_num_, headers[0].page_num_);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
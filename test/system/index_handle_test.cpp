@@ -0,0 +1,796 @@
+//
+// Created by agent on 2026/10/19.
+//
+
+#include "../config.h"
+#include "common/types.h"
+#include "storage/storage.h"
+#include "system/handle/index_handle.h"
+#include "storage/index/index_bp_tree.h"
+#include "storage/index/index_hash.h"
+#include "system/index/index_manager.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <numeric>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+using namespace wsdb;
+
+static auto MakeKeySchema() -> RecordSchemaUptr
+{
+  std::vector<RTField> fields(2);
+  fields[0].field_ = {.table_id_ = 0, .field_name_ = "i", .field_size_ = 4, .field_type_ = TYPE_INT};
+  // a long string field makes the nodes small, so that the tree grows several levels
+  fields[1].field_ = {.table_id_ = 0, .field_name_ = "s", .field_size_ = 200, .field_type_ = TYPE_STRING};
+  return std::make_unique<RecordSchema>(fields);
+}
+
+static auto MakeKey(const RecordSchema &schema, int i, const std::string &s) -> Record
+{
+  // the string is filled up, since the zeros padding a short string are not stored in the nodes
+  auto                   filled = s + std::string(150, '.');
+  std::vector<ValueSptr> values{
+      ValueFactory::CreateIntValue(i), ValueFactory::CreateStringValue(filled.c_str(), filled.size())};
+  return {&schema, values, INVALID_RID};
+}
+
+TEST(IndexHandle, BPTree)
+{
+  auto        disk_manager        = std::make_unique<DiskManager>();
+  auto        buffer_pool_manager = std::make_unique<BufferPoolManager>(disk_manager.get(), nullptr);
+  auto        index_manager       = std::make_unique<IndexManager>(disk_manager.get(), buffer_pool_manager.get());
+  std::string index_name          = "index_handle_bptree";
+  if (!std::filesystem::exists(TEST_DIR))
+    std::filesystem::create_directory(TEST_DIR);
+  if (std::filesystem::exists(FILE_NAME(TEST_DIR, index_name, IDX_SUFFIX)))
+    std::filesystem::remove(FILE_NAME(TEST_DIR, index_name, IDX_SUFFIX));
+  auto key_schema = MakeKeySchema();
+  index_manager->CreateIndex(TEST_DIR, index_name, "t", *key_schema, IndexType::BPTREE);
+  auto idx = index_manager->OpenIndex(TEST_DIR, index_name, 0);
+  ASSERT_EQ(idx->GetIndexName(), index_name);
+  ASSERT_EQ(idx->GetIndexType(), IndexType::BPTREE);
+
+  std::mt19937                                                         rng(0);
+  std::map<std::pair<int, std::string>, std::set<std::pair<int, int>>> entries;
+  size_t                                                               entry_num = 0;
+  auto check = [&]() {
+    for (const auto &[key, rids] : entries) {
+      auto res = idx->Search(MakeKey(*key_schema, key.first, key.second), 2);
+      ASSERT_EQ(res.size(), rids.size());
+      auto it = rids.begin();
+      for (const auto &rid : res) {
+        // entries of equal keys are ordered by rid
+        ASSERT_EQ(rid, RID(it->first, it->second));
+        ++it;
+      }
+    }
+    // search by the prefix of the key
+    for (int i = 0; i < 100; ++i) {
+      size_t num = 0;
+      for (auto it = entries.lower_bound({i, ""}); it != entries.end() && it->first.first == i; ++it) {
+        num += it->second.size();
+      }
+      ASSERT_EQ(idx->Search(MakeKey(*key_schema, i, ""), 1).size(), num);
+    }
+    // search the range (lo, hi] of the first field, and [lo, hi) of both fields
+    for (int n = 0; n < 20; ++n) {
+      int        lo       = static_cast<int>(rng() % 100);
+      int        hi       = lo + static_cast<int>(rng() % 20);
+      auto       low_key  = MakeKey(*key_schema, lo, "5");
+      auto       high_key = MakeKey(*key_schema, hi, "5");
+      IndexBound low{.key_ = &low_key, .cmp_field_num_ = 1, .inclusive_ = false};
+      IndexBound high{.key_ = &high_key, .cmp_field_num_ = 1, .inclusive_ = true};
+      size_t     num1     = 0;
+      size_t     num2     = 0;
+      for (const auto &[key, rids] : entries) {
+        if (key.first > lo && key.first <= hi) {
+          num1 += rids.size();
+        }
+        if (key >= std::make_pair(lo, std::string("5")) && key < std::make_pair(hi, std::string("5"))) {
+          num2 += rids.size();
+        }
+      }
+      ASSERT_EQ(idx->SearchRange(low, high).size(), num1);
+      low  = {.key_ = &low_key, .cmp_field_num_ = 2, .inclusive_ = true};
+      high = {.key_ = &high_key, .cmp_field_num_ = 2, .inclusive_ = false};
+      ASSERT_EQ(idx->SearchRange(low, high).size(), num2);
+    }
+    ASSERT_EQ(idx->SearchRange({}, {}).size(), entry_num);
+  };
+  for (int round = 0; round < 3; ++round) {
+    // insert
+    for (int n = 0; n < 1000; ++n) {
+      int  i = static_cast<int>(rng() % 100);
+      auto s = std::to_string(rng() % 10);
+      RID  rid(static_cast<page_id_t>(rng() % 1000 + 1), static_cast<slot_id_t>(rng() % 64));
+      auto key = MakeKey(*key_schema, i, s);
+      if (entries[{i, s}].insert({rid.PageID(), rid.SlotID()}).second) {
+        idx->GetIndex()->Insert(key, rid);
+        ++entry_num;
+      } else {
+        ASSERT_THROW(idx->GetIndex()->Insert(key, rid), WSDBException_);
+      }
+    }
+    check();
+    // delete
+    for (int n = 0; n < 600 && entry_num > 0; ++n) {
+      auto it = entries.begin();
+      std::advance(it, rng() % entries.size());
+      if (it->second.empty()) {
+        continue;
+      }
+      auto rid_it = it->second.begin();
+      std::advance(rid_it, rng() % it->second.size());
+      auto key = MakeKey(*key_schema, it->first.first, it->first.second);
+      RID  rid(rid_it->first, rid_it->second);
+      idx->GetIndex()->Delete(key, rid);
+      ASSERT_THROW(idx->GetIndex()->Delete(key, rid), WSDBException_);
+      it->second.erase(rid_it);
+      --entry_num;
+    }
+    check();
+  }
+  // delete all
+  for (auto &[key, rids] : entries) {
+    for (const auto &rid : rids) {
+      idx->GetIndex()->Delete(MakeKey(*key_schema, key.first, key.second), RID(rid.first, rid.second));
+    }
+    rids.clear();
+  }
+  entry_num = 0;
+  check();
+  index_manager->CloseIndex(*idx);
+  index_manager->DropIndex(TEST_DIR, index_name);
+}
+
+TEST(IndexHandle, BPTreeBulkLoad)
+{
+  auto disk_manager        = std::make_unique<DiskManager>();
+  auto buffer_pool_manager = std::make_unique<BufferPoolManager>(disk_manager.get(), nullptr);
+  auto index_manager       = std::make_unique<IndexManager>(disk_manager.get(), buffer_pool_manager.get());
+  if (!std::filesystem::exists(TEST_DIR))
+    std::filesystem::create_directory(TEST_DIR);
+  auto key_schema = MakeKeySchema();
+  auto open_index = [&](const std::string &index_name) {
+    if (std::filesystem::exists(FILE_NAME(TEST_DIR, index_name, IDX_SUFFIX)))
+      std::filesystem::remove(FILE_NAME(TEST_DIR, index_name, IDX_SUFFIX));
+    index_manager->CreateIndex(TEST_DIR, index_name, "t", *key_schema, IndexType::BPTREE);
+    return index_manager->OpenIndex(TEST_DIR, index_name, 0);
+  };
+  auto drop_index = [&](IndexHandleUptr &idx, const std::string &index_name) {
+    index_manager->CloseIndex(*idx);
+    index_manager->DropIndex(TEST_DIR, index_name);
+  };
+
+  // records in key order, the rids of equal keys are not ordered
+  std::mt19937                                   rng(0);
+  std::vector<std::tuple<int, std::string, RID>> records;
+  for (int n = 0; n < 3000; ++n) {
+    records.emplace_back(static_cast<int>(rng() % 500),
+        std::to_string(rng() % 3),
+        RID(static_cast<page_id_t>(n / 64 + 1), static_cast<slot_id_t>(n % 64)));
+  }
+  std::shuffle(records.begin(), records.end(), rng);
+  std::stable_sort(records.begin(), records.end(), [](const auto &lhs, const auto &rhs) {
+    return std::tie(std::get<0>(lhs), std::get<1>(lhs)) < std::tie(std::get<0>(rhs), std::get<1>(rhs));
+  });
+  auto make_next = [&](size_t num) {
+    return [&, num, cursor = size_t{0}]() mutable -> RecordUptr {
+      if (cursor == num) {
+        return nullptr;
+      }
+      const auto &[i, s, rid] = records[cursor++];
+      auto record             = std::make_unique<Record>(MakeKey(*key_schema, i, s));
+      record->SetRID(rid);
+      return record;
+    };
+  };
+  auto check = [&](IndexHandle &idx, const std::vector<std::tuple<int, std::string, RID>> &expected) {
+    auto sorted = expected;
+    std::sort(sorted.begin(), sorted.end(), [](const auto &lhs, const auto &rhs) {
+      const auto &[li, ls, lrid] = lhs;
+      const auto &[ri, rs, rrid] = rhs;
+      return std::make_tuple(li, ls, lrid.PageID(), lrid.SlotID()) <
+             std::make_tuple(ri, rs, rrid.PageID(), rrid.SlotID());
+    });
+    auto rids = idx.SearchRange({}, {});
+    ASSERT_EQ(rids.size(), sorted.size());
+    for (size_t n = 0; n < rids.size(); ++n) {
+      ASSERT_EQ(rids[n], std::get<2>(sorted[n]));
+    }
+    for (int i = 0; i < 500; i += 7) {
+      auto num = std::count_if(sorted.begin(), sorted.end(), [i](const auto &rec) { return std::get<0>(rec) == i; });
+      ASSERT_EQ(idx.Search(MakeKey(*key_schema, i, ""), 1).size(), static_cast<size_t>(num));
+    }
+  };
+
+  // a tree inserted one by one in random order is larger than the packed ones
+  auto random_idx = open_index("index_handle_bulk_random");
+  auto shuffled   = records;
+  std::shuffle(shuffled.begin(), shuffled.end(), rng);
+  for (const auto &[i, s, rid] : shuffled) {
+    random_idx->GetIndex()->Insert(MakeKey(*key_schema, i, s), rid);
+  }
+  auto random_page_num = dynamic_cast<BPTreeIndex *>(random_idx->GetIndex())->GetHeader().page_num_;
+  drop_index(random_idx, "index_handle_bulk_random");
+
+  size_t prev_page_num = 0;
+  for (double fill_factor : {0.5, 0.9, 1.0}) {
+    auto idx = open_index("index_handle_bulk");
+    idx->BulkLoad(make_next(records.size()), fill_factor);
+    check(*idx, records);
+    const auto &header = dynamic_cast<BPTreeIndex *>(idx->GetIndex())->GetHeader();
+    ASSERT_GT(header.height_, 2);
+    if (prev_page_num != 0) {
+      ASSERT_LT(header.page_num_, prev_page_num);
+    }
+    prev_page_num = header.page_num_;
+    // the packed tree is modified as usual
+    auto expected = records;
+    for (int n = 0; n < 500; ++n) {
+      auto pos                = rng() % expected.size();
+      const auto &[i, s, rid] = expected[pos];
+      idx->GetIndex()->Delete(MakeKey(*key_schema, i, s), rid);
+      expected.erase(expected.begin() + static_cast<std::ptrdiff_t>(pos));
+    }
+    for (int n = 0; n < 500; ++n) {
+      int  i = static_cast<int>(rng() % 500);
+      auto s = std::to_string(rng() % 3);
+      RID  rid(static_cast<page_id_t>(n + 1000), 0);
+      idx->GetIndex()->Insert(MakeKey(*key_schema, i, s), rid);
+      expected.emplace_back(i, s, rid);
+    }
+    check(*idx, expected);
+    drop_index(idx, "index_handle_bulk");
+  }
+  ASSERT_LT(prev_page_num, random_page_num);
+
+  // a table without records leaves the tree empty
+  auto idx = open_index("index_handle_bulk");
+  idx->BulkLoad(make_next(0), 0.9);
+  ASSERT_TRUE(idx->SearchRange({}, {}).empty());
+  idx->GetIndex()->Insert(MakeKey(*key_schema, 1, "1"), RID(1, 1));
+  ASSERT_EQ(idx->Search(MakeKey(*key_schema, 1, "1"), 2).size(), 1);
+  drop_index(idx, "index_handle_bulk");
+
+  // a child failing with any exception leaves the tree empty and unlatched
+  auto fail_idx  = open_index("index_handle_bulk_fail");
+  auto fail_next = [next = make_next(records.size()), num = 0]() mutable -> RecordUptr {
+    if (++num > 1000) {
+      throw std::runtime_error("child failed");
+    }
+    return next();
+  };
+  ASSERT_THROW(fail_idx->BulkLoad(fail_next, 0.9), std::runtime_error);
+  fail_idx->GetIndex()->Insert(MakeKey(*key_schema, 1, "1"), RID(1, 1));
+  ASSERT_EQ(fail_idx->SearchRange({}, {}).size(), 1);
+  drop_index(fail_idx, "index_handle_bulk_fail");
+}
+
+TEST(IndexHandle, Hash)
+{
+  auto        disk_manager        = std::make_unique<DiskManager>();
+  auto        buffer_pool_manager = std::make_unique<BufferPoolManager>(disk_manager.get(), nullptr);
+  auto        index_manager       = std::make_unique<IndexManager>(disk_manager.get(), buffer_pool_manager.get());
+  std::string index_name          = "index_handle_hash";
+  if (!std::filesystem::exists(TEST_DIR))
+    std::filesystem::create_directory(TEST_DIR);
+  if (std::filesystem::exists(FILE_NAME(TEST_DIR, index_name, IDX_SUFFIX)))
+    std::filesystem::remove(FILE_NAME(TEST_DIR, index_name, IDX_SUFFIX));
+  auto key_schema = MakeKeySchema();
+  index_manager->CreateIndex(TEST_DIR, index_name, "t", *key_schema, IndexType::HASH);
+  auto idx = index_manager->OpenIndex(TEST_DIR, index_name, 0);
+  ASSERT_EQ(idx->GetIndexType(), IndexType::HASH);
+  auto hash_index = dynamic_cast<HashIndex *>(idx->GetIndex());
+  ASSERT_NE(hash_index, nullptr);
+
+  std::mt19937                                                         rng(0);
+  std::map<std::pair<int, std::string>, std::set<std::pair<int, int>>> entries;
+  auto check = [&]() {
+    for (const auto &[key, rids] : entries) {
+      auto record = MakeKey(*key_schema, key.first, key.second);
+      auto res    = idx->Search(record, 2);
+      ASSERT_EQ(res.size(), rids.size());
+      auto it = rids.begin();
+      for (const auto &rid : res) {
+        // rids of a key are ordered by page and slot
+        ASSERT_EQ(rid, RID(it->first, it->second));
+        ++it;
+      }
+      IndexBound bound{.key_ = &record, .cmp_field_num_ = 2, .inclusive_ = true};
+      ASSERT_EQ(idx->SearchRange(bound, bound).size(), rids.size());
+    }
+  };
+  // the entries of a key with many rids are chained in overflow pages, since splits cannot separate them
+  for (int n = 0; n < 3000; ++n) {
+    int  i = n % 50 == 0 ? 0 : static_cast<int>(rng() % 1000);
+    auto s = n % 50 == 0 ? std::string("0") : std::to_string(rng() % 10);
+    RID  rid(static_cast<page_id_t>(rng() % 1000 + 1), static_cast<slot_id_t>(rng() % 64));
+    auto key = MakeKey(*key_schema, i, s);
+    if (entries[{i, s}].insert({rid.PageID(), rid.SlotID()}).second) {
+      idx->GetIndex()->Insert(key, rid);
+    } else {
+      ASSERT_THROW(idx->GetIndex()->Insert(key, rid), WSDBException_);
+    }
+  }
+  check();
+  ASSERT_GT(hash_index->GetHeader().global_depth_, 0);
+  // only the whole key can be looked up
+  auto key = MakeKey(*key_schema, 0, "0");
+  ASSERT_THROW(idx->Search(key, 1), WSDBException_);
+  ASSERT_THROW(idx->SearchRange({}, {}), WSDBException_);
+  // delete all, the buckets are merged and the directory shrinks to a single slot
+  for (auto &[key, rids] : entries) {
+    for (const auto &rid : rids) {
+      idx->GetIndex()->Delete(MakeKey(*key_schema, key.first, key.second), RID(rid.first, rid.second));
+      ASSERT_THROW(idx->GetIndex()->Delete(MakeKey(*key_schema, key.first, key.second), RID(rid.first, rid.second)),
+          WSDBException_);
+    }
+    rids.clear();
+  }
+  check();
+  ASSERT_EQ(hash_index->GetHeader().global_depth_, 0);
+  index_manager->CloseIndex(*idx);
+  index_manager->DropIndex(TEST_DIR, index_name);
+}
+
+TEST(IndexHandle, BPTreeCovering)
+{
+  auto        disk_manager        = std::make_unique<DiskManager>();
+  auto        buffer_pool_manager = std::make_unique<BufferPoolManager>(disk_manager.get(), nullptr);
+  auto        index_manager       = std::make_unique<IndexManager>(disk_manager.get(), buffer_pool_manager.get());
+  std::string index_name          = "index_handle_covering";
+  if (!std::filesystem::exists(TEST_DIR))
+    std::filesystem::create_directory(TEST_DIR);
+  if (std::filesystem::exists(FILE_NAME(TEST_DIR, index_name, IDX_SUFFIX)))
+    std::filesystem::remove(FILE_NAME(TEST_DIR, index_name, IDX_SUFFIX));
+  // the key and the included fields are a subset of the table fields, in another order
+  std::vector<RTField> fields(6);
+  fields[0].field_ = {.table_id_ = 0, .field_name_ = "pad", .field_size_ = 100, .field_type_ = TYPE_STRING};
+  fields[1].field_ = {.table_id_ = 0, .field_name_ = "b", .field_size_ = 1, .field_type_ = TYPE_BOOL};
+  fields[2].field_ = {.table_id_ = 0, .field_name_ = "f", .field_size_ = 4, .field_type_ = TYPE_FLOAT};
+  fields[3].field_ = {.table_id_ = 0, .field_name_ = "i", .field_size_ = 4, .field_type_ = TYPE_INT};
+  fields[4].field_ = {.table_id_ = 0, .field_name_ = "s", .field_size_ = 8, .field_type_ = TYPE_STRING};
+  fields[5].field_ = {.table_id_ = 0, .field_name_ = "n", .field_size_ = 4, .field_type_ = TYPE_INT};
+  RecordSchema schema(fields);
+  RecordSchema key_schema({fields[3], fields[2]});
+  RecordSchema include_schema({fields[5], fields[1], fields[4]});
+  index_manager->CreateIndex(TEST_DIR, index_name, "t", key_schema, IndexType::BPTREE, &include_schema);
+  auto idx = index_manager->OpenIndex(TEST_DIR, index_name, 0);
+  ASSERT_EQ(idx->GetEntrySchema().GetFieldCount(), 5);
+
+  std::mt19937 rng(0);
+  auto         make_record = [&](int n) {
+    auto maybe_null = [&](ValueSptr value, FieldType type) {
+      return rng() % 10 == 0 ? ValueFactory::CreateNullValue(type) : std::move(value);
+    };
+    auto                   s = std::string(1 + rng() % 8, static_cast<char>('a' + rng() % 26));
+    std::vector<ValueSptr> values{ValueFactory::CreateStringValue("pad", 3),
+        maybe_null(ValueFactory::CreateBoolValue(rng() % 2 == 0), TYPE_BOOL),
+        maybe_null(ValueFactory::CreateFloatValue(static_cast<float>(rng() % 200) * 0.25f - 25.5f), TYPE_FLOAT),
+        maybe_null(ValueFactory::CreateIntValue(static_cast<int>(rng() % 100) - 50), TYPE_INT),
+        ValueFactory::CreateStringValue(s.c_str(), s.size()),
+        maybe_null(ValueFactory::CreateIntValue(static_cast<int>(rng())), TYPE_INT)};
+    return Record(&schema, values, RID(static_cast<page_id_t>(n / 64 + 1), static_cast<slot_id_t>(n % 64)));
+  };
+  // the records built from the entries are the key and included fields of the table records, in key and rid order
+  auto check = [&](std::vector<Record> expected, const IndexBound &low, const IndexBound &high) {
+    std::sort(expected.begin(), expected.end(), [&](const Record &lhs, const Record &rhs) {
+      auto cmp = Record::Compare(Record(&key_schema, lhs), Record(&key_schema, rhs));
+      return cmp != 0 ? cmp < 0
+                      : std::make_pair(lhs.GetRID().PageID(), lhs.GetRID().SlotID()) <
+                            std::make_pair(rhs.GetRID().PageID(), rhs.GetRID().SlotID());
+    });
+    auto records = idx->SearchRangeRecords(low, high);
+    ASSERT_EQ(records.size(), expected.size());
+    for (size_t n = 0; n < records.size(); ++n) {
+      ASSERT_TRUE(*records[n] == Record(&idx->GetEntrySchema(), expected[n]));
+      ASSERT_EQ(records[n]->GetRID(), expected[n].GetRID());
+    }
+  };
+
+  std::vector<Record> records;
+  for (int n = 0; n < 1500; ++n) {
+    records.push_back(make_record(n));
+    idx->InsertRecord(records.back());
+  }
+  check(records, {}, {});
+  // i in [-10, 10)
+  std::vector<ValueSptr> low_values{ValueFactory::CreateIntValue(-10), ValueFactory::CreateNullValue(TYPE_FLOAT)};
+  std::vector<ValueSptr> high_values{ValueFactory::CreateIntValue(10), ValueFactory::CreateNullValue(TYPE_FLOAT)};
+  Record                 low_key(&key_schema, low_values, INVALID_RID);
+  Record                 high_key(&key_schema, high_values, INVALID_RID);
+  IndexBound             low{.key_ = &low_key, .cmp_field_num_ = 1, .inclusive_ = true};
+  IndexBound             high{.key_ = &high_key, .cmp_field_num_ = 1, .inclusive_ = false};
+  std::vector<Record>    in_range;
+  std::copy_if(records.begin(), records.end(), std::back_inserter(in_range), [](const Record &rec) {
+    auto i = rec.GetValueAt(3);
+    return !i->IsNull() && !(*i < *ValueFactory::CreateIntValue(-10)) && *i < *ValueFactory::CreateIntValue(10);
+  });
+  check(in_range, low, high);
+  // updating an included field replaces the entry
+  for (int n = 0; n < 600; ++n) {
+    auto pos    = rng() % records.size();
+    auto record = make_record(static_cast<int>(pos));
+    idx->UpdateRecord(records[pos], record);
+    records[pos] = std::move(record);
+  }
+  for (int n = 0; n < 600; ++n) {
+    idx->DeleteRecord(records.back());
+    records.pop_back();
+  }
+  check(records, {}, {});
+  index_manager->CloseIndex(*idx);
+  index_manager->DropIndex(TEST_DIR, index_name);
+
+  // a bulk loaded index stores the included fields as well
+  auto sorted = records;
+  std::stable_sort(sorted.begin(), sorted.end(), [&](const Record &lhs, const Record &rhs) {
+    return Record::Compare(Record(&key_schema, lhs), Record(&key_schema, rhs)) < 0;
+  });
+  index_manager->CreateIndex(TEST_DIR, index_name, "t", key_schema, IndexType::BPTREE, &include_schema);
+  idx = index_manager->OpenIndex(TEST_DIR, index_name, 0);
+  idx->BulkLoad(
+      [&, cursor = size_t{0}]() mutable -> RecordUptr {
+        if (cursor == sorted.size()) {
+          return nullptr;
+        }
+        return std::make_unique<Record>(sorted[cursor++]);
+      },
+      0.9);
+  check(records, {}, {});
+  index_manager->CloseIndex(*idx);
+  index_manager->DropIndex(TEST_DIR, index_name);
+
+  // a hash index has no included fields
+  index_manager->CreateIndex(TEST_DIR, index_name, "t", key_schema, IndexType::HASH, &include_schema);
+  ASSERT_THROW(index_manager->OpenIndex(TEST_DIR, index_name, 0), WSDBException_);
+  index_manager->DropIndex(TEST_DIR, index_name);
+}
+
+TEST(IndexHandle, BPTreeCompression)
+{
+  auto        disk_manager        = std::make_unique<DiskManager>();
+  auto        buffer_pool_manager = std::make_unique<BufferPoolManager>(disk_manager.get(), nullptr);
+  auto        index_manager       = std::make_unique<IndexManager>(disk_manager.get(), buffer_pool_manager.get());
+  std::string index_name          = "index_handle_compression";
+  if (!std::filesystem::exists(TEST_DIR))
+    std::filesystem::create_directory(TEST_DIR);
+  if (std::filesystem::exists(FILE_NAME(TEST_DIR, index_name, IDX_SUFFIX)))
+    std::filesystem::remove(FILE_NAME(TEST_DIR, index_name, IDX_SUFFIX));
+  // keys of different lengths sharing a long prefix, which is stored once per node
+  std::vector<RTField> fields(1);
+  fields[0].field_ = {.table_id_ = 0, .field_name_ = "s", .field_size_ = 64, .field_type_ = TYPE_STRING};
+  RecordSchema key_schema(fields);
+  index_manager->CreateIndex(TEST_DIR, index_name, "t", key_schema, IndexType::BPTREE);
+  auto idx  = index_manager->OpenIndex(TEST_DIR, index_name, 0);
+  auto tree = dynamic_cast<BPTreeIndex *>(idx->GetIndex());
+  ASSERT_NE(tree, nullptr);
+
+  auto make_string = [](int n) { return fmt::format("user_{:08d}{}", n, std::string(n % 7, 'x')); };
+  auto make_key    = [&](const std::string &s) {
+    std::vector<ValueSptr> values{ValueFactory::CreateStringValue(s.c_str(), s.size())};
+    return Record(&key_schema, values, INVALID_RID);
+  };
+  std::mt19937     rng(0);
+  std::vector<int> keys(10000);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::shuffle(keys.begin(), keys.end(), rng);
+  std::map<std::string, RID> entries;
+  for (auto n : keys) {
+    RID rid(n + 1, n % 64);
+    tree->Insert(make_key(make_string(n)), rid);
+    entries.emplace(make_string(n), rid);
+  }
+  // an uncompressed leaf holds about 50 entries, which would make the tree 3 levels high
+  ASSERT_EQ(tree->GetHeader().height_, 2U);
+  auto check = [&]() {
+    auto rids = tree->SearchRange({}, {});
+    ASSERT_EQ(rids.size(), entries.size());
+    auto it = entries.begin();
+    for (const auto &rid : rids) {
+      ASSERT_EQ(rid, it->second);
+      ++it;
+    }
+    for (int n = 0; n < 10000; n += 7) {
+      ASSERT_EQ(tree->Search(make_key(make_string(n)), 1).size(), entries.count(make_string(n)));
+    }
+    // a bound shorter than the keys is padded with zeros, which sort before the longer keys
+    auto       low_key  = make_key("user_0000");
+    auto       high_key = make_key("user_00001");
+    IndexBound low{.key_ = &low_key, .cmp_field_num_ = 1, .inclusive_ = true};
+    IndexBound high{.key_ = &high_key, .cmp_field_num_ = 1, .inclusive_ = false};
+    ASSERT_EQ(tree->SearchRange(low, high).size(),
+        static_cast<size_t>(std::distance(entries.lower_bound("user_0000"), entries.lower_bound("user_00001"))));
+  };
+  check();
+  // deleting most of the keys merges and redistributes the entries of different sizes
+  std::shuffle(keys.begin(), keys.end(), rng);
+  for (size_t n = 0; n < keys.size() * 9 / 10; ++n) {
+    tree->Delete(make_key(make_string(keys[n])), entries.at(make_string(keys[n])));
+    entries.erase(make_string(keys[n]));
+  }
+  check();
+  index_manager->CloseIndex(*idx);
+  index_manager->DropIndex(TEST_DIR, index_name);
+}
+
+TEST(IndexHandle, BatchMaintenance)
+{
+  auto        disk_manager        = std::make_unique<DiskManager>();
+  auto        buffer_pool_manager = std::make_unique<BufferPoolManager>(disk_manager.get(), nullptr);
+  auto        index_manager       = std::make_unique<IndexManager>(disk_manager.get(), buffer_pool_manager.get());
+  std::string index_name          = "index_handle_batch";
+  if (!std::filesystem::exists(TEST_DIR))
+    std::filesystem::create_directory(TEST_DIR);
+  if (std::filesystem::exists(FILE_NAME(TEST_DIR, index_name, IDX_SUFFIX)))
+    std::filesystem::remove(FILE_NAME(TEST_DIR, index_name, IDX_SUFFIX));
+  std::vector<RTField> fields(3);
+  fields[0].field_ = {.table_id_ = 0, .field_name_ = "i", .field_size_ = 4, .field_type_ = TYPE_INT};
+  fields[1].field_ = {.table_id_ = 0, .field_name_ = "s", .field_size_ = 8, .field_type_ = TYPE_STRING};
+  fields[2].field_ = {.table_id_ = 0, .field_name_ = "n", .field_size_ = 4, .field_type_ = TYPE_INT};
+  RecordSchema schema(fields);
+  RecordSchema key_schema({fields[0]});
+  RecordSchema include_schema({fields[2]});
+  index_manager->CreateIndex(TEST_DIR, index_name, "t", key_schema, IndexType::BPTREE, &include_schema);
+  auto idx = index_manager->OpenIndex(TEST_DIR, index_name, 0);
+
+  auto make_record = [&](int pos, int i, const std::string &s, int n) {
+    std::vector<ValueSptr> values{ValueFactory::CreateIntValue(i),
+        ValueFactory::CreateStringValue(s.c_str(), s.size()),
+        ValueFactory::CreateIntValue(n)};
+    return std::make_unique<Record>(&schema, values, RID(pos / 64 + 1, pos % 64));
+  };
+  // the entries of the index are the (i, n, rid) of the records in the order of i and rid
+  auto check = [&](const std::vector<RecordUptr> &records) {
+    std::vector<std::tuple<int, int, int, int>> expected;
+    for (const auto &rec : records) {
+      auto i = std::stoi(rec->GetValueAt(0)->ToString());
+      auto n = std::stoi(rec->GetValueAt(2)->ToString());
+      expected.emplace_back(i, rec->GetRID().PageID(), rec->GetRID().SlotID(), n);
+    }
+    std::sort(expected.begin(), expected.end());
+    auto entries = idx->SearchRangeRecords({}, {});
+    ASSERT_EQ(entries.size(), expected.size());
+    for (size_t pos = 0; pos < entries.size(); ++pos) {
+      auto [i, page_id, slot_id, n] = expected[pos];
+      ASSERT_EQ(entries[pos]->GetValueAt(0)->ToString(), std::to_string(i));
+      ASSERT_EQ(entries[pos]->GetValueAt(1)->ToString(), std::to_string(n));
+      ASSERT_EQ(entries[pos]->GetRID(), RID(page_id, slot_id));
+    }
+  };
+
+  std::mt19937                rng(0);
+  std::vector<RecordUptr>     records;
+  std::vector<const Record *> recs;
+  for (int pos = 0; pos < 3000; ++pos) {
+    records.push_back(make_record(pos, static_cast<int>(rng() % 500), "s", static_cast<int>(rng() % 10)));
+    recs.push_back(records.back().get());
+  }
+  idx->InsertRecords(recs);
+  check(records);
+  // update the field out of the index, the included field or the key of the records
+  std::vector<RecordUptr>                                new_records;
+  std::vector<std::pair<const Record *, const Record *>> updates;
+  for (int pos = 0; pos < 3000; ++pos) {
+    auto i = std::stoi(records[pos]->GetValueAt(0)->ToString());
+    auto n = std::stoi(records[pos]->GetValueAt(2)->ToString());
+    switch (pos % 3) {
+      case 0: new_records.push_back(make_record(pos, i, "t", n)); break;
+      case 1: new_records.push_back(make_record(pos, i, "s", n + 1)); break;
+      default: new_records.push_back(make_record(pos, static_cast<int>(rng() % 500), "s", n));
+    }
+    updates.emplace_back(records[pos].get(), new_records.back().get());
+  }
+  idx->UpdateRecords(updates);
+  records = std::move(new_records);
+  check(records);
+  // delete every other record
+  recs.clear();
+  for (size_t pos = 0; pos < records.size(); pos += 2) {
+    recs.push_back(records[pos].get());
+  }
+  idx->DeleteRecords(recs);
+  std::vector<RecordUptr> remaining;
+  for (size_t pos = 1; pos < records.size(); pos += 2) {
+    remaining.push_back(std::move(records[pos]));
+  }
+  check(remaining);
+  index_manager->CloseIndex(*idx);
+  index_manager->DropIndex(TEST_DIR, index_name);
+}
+
+TEST(IndexHandle, ART)
+{
+  auto disk_manager        = std::make_unique<DiskManager>();
+  auto buffer_pool_manager = std::make_unique<BufferPoolManager>(disk_manager.get(), nullptr);
+  auto index_manager       = std::make_unique<IndexManager>(disk_manager.get(), buffer_pool_manager.get());
+  if (!std::filesystem::exists(TEST_DIR))
+    std::filesystem::create_directory(TEST_DIR);
+  std::vector<RTField> fields(3);
+  fields[0].field_ = {.table_id_ = 0, .field_name_ = "i", .field_size_ = 4, .field_type_ = TYPE_INT};
+  fields[1].field_ = {.table_id_ = 0, .field_name_ = "s", .field_size_ = 32, .field_type_ = TYPE_STRING};
+  fields[2].field_ = {.table_id_ = 0, .field_name_ = "n", .field_size_ = 4, .field_type_ = TYPE_INT};
+  RecordSchema schema(fields);
+  RecordSchema key_schema({fields[0], fields[1]});
+  RecordSchema include_schema({fields[2]});
+  // the B+tree with the same entries gives the expected results
+  auto open_index = [&](const std::string &index_name, IndexType index_type) {
+    if (std::filesystem::exists(FILE_NAME(TEST_DIR, index_name, IDX_SUFFIX)))
+      std::filesystem::remove(FILE_NAME(TEST_DIR, index_name, IDX_SUFFIX));
+    index_manager->CreateIndex(TEST_DIR, index_name, "t", key_schema, index_type, &include_schema);
+    return index_manager->OpenIndex(TEST_DIR, index_name, 0);
+  };
+  auto art    = open_index("index_handle_art", IndexType::ART);
+  auto bptree = open_index("index_handle_art_expected", IndexType::BPTREE);
+  ASSERT_EQ(art->GetIndexType(), IndexType::ART);
+
+  std::mt19937 rng(0);
+  // the last byte of the ints takes all the values, and the strings share prefixes longer than the ones kept in the
+  // nodes
+  auto make_record = [&](int pos) {
+    auto s = std::string(rng() % 3, 'a') + "shared_by_the_keys_" + std::to_string(rng() % 20);
+    std::vector<ValueSptr> values{ValueFactory::CreateIntValue(static_cast<int>(rng() % 600) - 300),
+        ValueFactory::CreateStringValue(s.c_str(), s.size()),
+        ValueFactory::CreateIntValue(static_cast<int>(rng()))};
+    return std::make_unique<Record>(&schema, values, RID(pos / 64 + 1, pos % 64));
+  };
+  auto check = [&]() {
+    ASSERT_EQ(art->SearchRange({}, {}), bptree->SearchRange({}, {}));
+    auto expected = bptree->SearchRangeRecords({}, {});
+    auto records  = art->SearchRangeRecords({}, {});
+    ASSERT_EQ(records.size(), expected.size());
+    for (size_t i = 0; i < records.size(); ++i) {
+      ASSERT_TRUE(*records[i] == Record(&art->GetEntrySchema(), *expected[i]));
+      ASSERT_EQ(records[i]->GetRID(), expected[i]->GetRID());
+    }
+    for (int n = 0; n < 100; ++n) {
+      auto low_rec  = make_record(0);
+      auto high_rec = make_record(0);
+      auto low_key  = Record(&key_schema, *low_rec);
+      auto high_key = Record(&key_schema, *high_rec);
+      ASSERT_EQ(art->Search(low_key, 1 + n % 2), bptree->Search(low_key, 1 + n % 2));
+      IndexBound low{.key_ = &low_key, .cmp_field_num_ = 1 + rng() % 2, .inclusive_ = rng() % 2 == 0};
+      IndexBound high{.key_ = &high_key, .cmp_field_num_ = 1 + rng() % 2, .inclusive_ = rng() % 2 == 0};
+      ASSERT_EQ(art->SearchRange(low, high), bptree->SearchRange(low, high));
+      ASSERT_EQ(art->SearchRange(low, {}), bptree->SearchRange(low, {}));
+      ASSERT_EQ(art->SearchRange({}, high), bptree->SearchRange({}, high));
+    }
+  };
+
+  std::vector<RecordUptr> records;
+  int                     pos = 0;
+  for (int round = 0; round < 3; ++round) {
+    for (int n = 0; n < 1500; ++n) {
+      records.push_back(make_record(pos++));
+      art->InsertRecord(*records.back());
+      bptree->InsertRecord(*records.back());
+    }
+    ASSERT_THROW(art->InsertRecord(*records.back()), WSDBException_);
+    check();
+    // delete most of the records, so that the nodes shrink
+    std::shuffle(records.begin(), records.end(), rng);
+    for (size_t n = records.size() / 3; n < records.size(); ++n) {
+      art->DeleteRecord(*records[n]);
+      bptree->DeleteRecord(*records[n]);
+    }
+    records.resize(records.size() / 3);
+    ASSERT_THROW(art->DeleteRecord(*make_record(100000)), WSDBException_);
+    check();
+  }
+  for (const auto &record : records) {
+    art->DeleteRecord(*record);
+  }
+  ASSERT_TRUE(art->SearchRange({}, {}).empty());
+  index_manager->CloseIndex(*art);
+  index_manager->DropIndex(TEST_DIR, "index_handle_art");
+  index_manager->CloseIndex(*bptree);
+  index_manager->DropIndex(TEST_DIR, "index_handle_art_expected");
+}
+
+TEST(IndexHandle, Reopen)
+{
+  if (!std::filesystem::exists(TEST_DIR))
+    std::filesystem::create_directory(TEST_DIR);
+  std::vector<RTField> fields(3);
+  fields[0].field_ = {.table_id_ = 0, .field_name_ = "i", .field_size_ = 4, .field_type_ = TYPE_INT};
+  fields[1].field_ = {.table_id_ = 0, .field_name_ = "s", .field_size_ = 200, .field_type_ = TYPE_STRING};
+  fields[2].field_ = {.table_id_ = 0, .field_name_ = "f", .field_size_ = 4, .field_type_ = TYPE_FLOAT};
+  RecordSchema schema(fields);
+  RecordSchema key_schema({fields[1], fields[0]});
+  RecordSchema include_schema({fields[2]});
+
+  std::mt19937 rng(0);
+  auto         make_record = [&](int n) {
+    auto                   s = std::to_string(rng() % 100) + std::string(150, '.');
+    std::vector<ValueSptr> values{ValueFactory::CreateIntValue(static_cast<int>(rng() % 1000)),
+        ValueFactory::CreateStringValue(s.c_str(), s.size()),
+        ValueFactory::CreateFloatValue(static_cast<float>(n) * 0.5f)};
+    return Record(&schema, values, RID(static_cast<page_id_t>(n / 64 + 1), static_cast<slot_id_t>(n % 64)));
+  };
+  std::vector<Record> records;
+  for (int n = 0; n < 1200; ++n) {
+    records.push_back(make_record(n));
+  }
+
+  for (auto index_type : {IndexType::BPTREE, IndexType::HASH, IndexType::ART}) {
+    auto index_name = fmt::format("index_handle_reopen_{}", IndexTypeToString(index_type));
+    if (std::filesystem::exists(FILE_NAME(TEST_DIR, index_name, IDX_SUFFIX)))
+      std::filesystem::remove(FILE_NAME(TEST_DIR, index_name, IDX_SUFFIX));
+    auto include = index_type == IndexType::HASH ? nullptr : &include_schema;
+    {
+      auto disk_manager        = std::make_unique<DiskManager>();
+      auto buffer_pool_manager = std::make_unique<BufferPoolManager>(disk_manager.get(), nullptr);
+      auto index_manager       = std::make_unique<IndexManager>(disk_manager.get(), buffer_pool_manager.get());
+      index_manager->CreateIndex(TEST_DIR, index_name, "t", key_schema, index_type, include);
+      ASSERT_EQ(index_manager->GetTableName(TEST_DIR, index_name), "t");
+      auto idx = index_manager->OpenIndex(TEST_DIR, index_name, 0);
+      for (size_t n = 0; n < records.size(); ++n) {
+        idx->InsertRecord(records[n]);
+      }
+      for (size_t n = 0; n < records.size(); n += 3) {
+        idx->DeleteRecord(records[n]);
+      }
+      ASSERT_EQ(idx->GetEntryNum(), records.size() - records.size() / 3);
+      index_manager->CloseIndex(*idx);
+    }
+    // the type, the schemas and the structure of the index are read from its file by another system
+    auto disk_manager        = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(disk_manager.get(), nullptr);
+    auto index_manager       = std::make_unique<IndexManager>(disk_manager.get(), buffer_pool_manager.get());
+    ASSERT_EQ(index_manager->GetTableName(TEST_DIR, index_name), "t");
+    auto idx = index_manager->OpenIndex(TEST_DIR, index_name, 0);
+    ASSERT_EQ(idx->GetIndexType(), index_type);
+    ASSERT_EQ(idx->GetKeySchema().GetFieldCount(), 2);
+    for (size_t i = 0; i < key_schema.GetFieldCount(); ++i) {
+      ASSERT_EQ(idx->GetKeySchema().GetFieldAt(i).field_, key_schema.GetFieldAt(i).field_);
+    }
+    ASSERT_EQ(idx->GetIncludeSchema() == nullptr, include == nullptr);
+    if (include != nullptr) {
+      ASSERT_EQ(idx->GetIncludeSchema()->GetFieldCount(), 1);
+      ASSERT_EQ(idx->GetIncludeSchema()->GetFieldAt(0).field_.field_name_, "f");
+    }
+    // the entries of an ART index are in memory, which is filled again by the database
+    if (index_type == IndexType::ART) {
+      ASSERT_EQ(idx->GetEntryNum(), 0);
+      ASSERT_TRUE(idx->SearchRange({}, {}).empty());
+    } else {
+      ASSERT_EQ(idx->GetEntryNum(), records.size() - records.size() / 3);
+      for (size_t n = 0; n < records.size(); ++n) {
+        auto key = Record(&idx->GetKeySchema(), records[n]);
+        auto res = idx->Search(key, 2);
+        ASSERT_EQ(std::count(res.begin(), res.end(), records[n].GetRID()), n % 3 == 0 ? 0 : 1);
+      }
+      // the reopened index is modified as usual
+      for (size_t n = 0; n < records.size(); n += 3) {
+        idx->InsertRecord(records[n]);
+      }
+      ASSERT_THROW(idx->InsertRecord(records[0]), WSDBException_);
+      ASSERT_EQ(idx->GetEntryNum(), records.size());
+      if (index_type == IndexType::BPTREE) {
+        ASSERT_EQ(idx->SearchRange({}, {}).size(), records.size());
+      }
+    }
+    index_manager->CloseIndex(*idx);
+
+    // a file header page that is not an index header cannot be opened
+    std::vector<char> page(PAGE_SIZE, 0);
+    auto              index_file = disk_manager->OpenFile(FILE_NAME(TEST_DIR, index_name, IDX_SUFFIX));
+    disk_manager->WritePage(index_file, FILE_HEADER_PAGE_ID, page.data());
+    disk_manager->CloseFile(index_file);
+    ASSERT_THROW(index_manager->OpenIndex(TEST_DIR, index_name, 0), WSDBException_);
+    index_manager->DropIndex(TEST_DIR, index_name);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
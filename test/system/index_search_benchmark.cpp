@@ -0,0 +1,169 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+//
+// Created by agent on 2026/10/19.
+//
+
+/**
+ * Benchmark of point searches through IndexHandle::Search on the B+tree and the adaptive radix tree, and of building a
+ * B+tree by inserts and by bulk load. The number of int keys is set by the environment variable WSDB_BENCH_ROWS
+ * (200000 by default), e.g. WSDB_BENCH_ROWS=1000000 ./index_search_benchmark
+ */
+
+#include "../config.h"
+#include "common/types.h"
+#include "storage/storage.h"
+#include "system/handle/index_handle.h"
+#include "storage/index/index_bp_tree.h"
+#include "system/index/index_manager.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+using namespace wsdb;
+
+static auto GetBenchRows() -> int
+{
+  auto rows = std::getenv("WSDB_BENCH_ROWS");
+  return rows == nullptr ? 200000 : std::stoi(rows);
+}
+
+/**
+ * insert the same shuffled int keys into each index, search every key once in another order, and print the average
+ * latency of a search
+ */
+TEST(IndexSearchBenchmark, PointSearch)
+{
+  auto        disk_manager        = std::make_unique<DiskManager>();
+  auto        buffer_pool_manager = std::make_unique<BufferPoolManager>(disk_manager.get(), nullptr);
+  auto        index_manager       = std::make_unique<IndexManager>(disk_manager.get(), buffer_pool_manager.get());
+  std::string index_name          = "index_search_benchmark";
+  if (!std::filesystem::exists(TEST_DIR))
+    std::filesystem::create_directory(TEST_DIR);
+  std::vector<RTField> fields(1);
+  fields[0].field_ = {.table_id_ = 0, .field_name_ = "k", .field_size_ = 4, .field_type_ = TYPE_INT};
+  RecordSchema key_schema(fields);
+
+  auto             key_num = GetBenchRows();
+  std::vector<int> keys(key_num);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::mt19937 rng(0);
+  std::shuffle(keys.begin(), keys.end(), rng);
+  std::vector<Record> records;
+  for (auto k : keys) {
+    std::vector<ValueSptr> values{ValueFactory::CreateIntValue(k)};
+    records.emplace_back(&key_schema, values, RID(k / 64 + 1, k % 64));
+  }
+  std::vector<size_t> search_order(records.size());
+  std::iota(search_order.begin(), search_order.end(), 0);
+  std::shuffle(search_order.begin(), search_order.end(), rng);
+
+  for (auto index_type : {IndexType::BPTREE, IndexType::ART}) {
+    if (std::filesystem::exists(FILE_NAME(TEST_DIR, index_name, IDX_SUFFIX)))
+      std::filesystem::remove(FILE_NAME(TEST_DIR, index_name, IDX_SUFFIX));
+    index_manager->CreateIndex(TEST_DIR, index_name, "t", key_schema, index_type);
+    auto idx   = index_manager->OpenIndex(TEST_DIR, index_name, 0);
+    auto start = std::chrono::steady_clock::now();
+    for (const auto &record : records) {
+      idx->InsertRecord(record);
+    }
+    auto insert_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    start          = std::chrono::steady_clock::now();
+    for (auto i : search_order) {
+      auto rids = idx->Search(records[i], 1);
+      ASSERT_EQ(rids.size(), 1U);
+      ASSERT_EQ(rids[0], records[i].GetRID());
+    }
+    auto search_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    std::cout << fmt::format("{}: {} keys inserted in {} ms, point search {:.2f} us\n",
+        IndexTypeToString(index_type),
+        key_num,
+        insert_ms.count(),
+        static_cast<double>(search_ns.count()) / 1000 / static_cast<double>(search_order.size()));
+    index_manager->CloseIndex(*idx);
+    index_manager->DropIndex(TEST_DIR, index_name);
+  }
+}
+
+/**
+ * build a B+tree of the same keys by inserting them in random order and by bulk loading them in key order, check the
+ * entries of the packed tree, and print the time and the pages of each build
+ */
+TEST(IndexSearchBenchmark, BulkLoad)
+{
+  auto        disk_manager        = std::make_unique<DiskManager>();
+  auto        buffer_pool_manager = std::make_unique<BufferPoolManager>(disk_manager.get(), nullptr);
+  auto        index_manager       = std::make_unique<IndexManager>(disk_manager.get(), buffer_pool_manager.get());
+  std::string index_name          = "index_bulk_load_benchmark";
+  if (!std::filesystem::exists(TEST_DIR))
+    std::filesystem::create_directory(TEST_DIR);
+  std::vector<RTField> fields(1);
+  fields[0].field_ = {.table_id_ = 0, .field_name_ = "k", .field_size_ = 4, .field_type_ = TYPE_INT};
+  RecordSchema key_schema(fields);
+
+  auto             key_num = GetBenchRows();
+  std::vector<int> keys(key_num);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::mt19937 rng(0);
+  std::shuffle(keys.begin(), keys.end(), rng);
+  auto make_record = [&](int k) {
+    std::vector<ValueSptr> values{ValueFactory::CreateIntValue(k)};
+    return std::make_unique<Record>(&key_schema, values, RID(k / 64 + 1, k % 64));
+  };
+
+  for (bool bulk_load : {false, true}) {
+    if (std::filesystem::exists(FILE_NAME(TEST_DIR, index_name, IDX_SUFFIX)))
+      std::filesystem::remove(FILE_NAME(TEST_DIR, index_name, IDX_SUFFIX));
+    index_manager->CreateIndex(TEST_DIR, index_name, "t", key_schema, IndexType::BPTREE);
+    auto idx   = index_manager->OpenIndex(TEST_DIR, index_name, 0);
+    auto start = std::chrono::steady_clock::now();
+    if (bulk_load) {
+      idx->BulkLoad([&, k = 0]() mutable -> RecordUptr { return k == key_num ? nullptr : make_record(k++); }, 0.9);
+    } else {
+      for (auto k : keys) {
+        idx->InsertRecord(*make_record(k));
+      }
+    }
+    auto ms   = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    auto rids = idx->SearchRange({}, {});
+    ASSERT_EQ(rids.size(), static_cast<size_t>(key_num));
+    for (int k = 0; k < key_num; ++k) {
+      ASSERT_EQ(rids[k], RID(k / 64 + 1, k % 64));
+    }
+    const auto &header = dynamic_cast<BPTreeIndex *>(idx->GetIndex())->GetHeader();
+    std::cout << fmt::format("{}: {} keys in {} ms, {} pages, height {}\n",
+        bulk_load ? "bulk load" : "random inserts",
+        key_num,
+        ms.count(),
+        header.page_num_,
+        header.height_);
+    index_manager->CloseIndex(*idx);
+    index_manager->DropIndex(TEST_DIR, index_name);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
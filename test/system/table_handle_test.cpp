@@ -304,6 +304,141 @@ TEST(TableHandle, PAX_MultiThread)
   ASSERT_EQ(cnt, rids.size());
 }
 
+TEST(TableHandle, PAX_PageRecords)
+{
+  auto        disk_manager        = std::make_unique<DiskManager>();
+  auto        buffer_pool_manager = std::make_unique<BufferPoolManager>(disk_manager.get(), nullptr);
+  auto        table_manager       = std::make_unique<TableManager>(disk_manager.get(), buffer_pool_manager.get());
+  std::string table_name          = "table_handle_pax_page_records";
+  if (!std::filesystem::exists(TEST_DIR))
+    std::filesystem::create_directory(TEST_DIR);
+  if (std::filesystem::exists(FILE_NAME(TEST_DIR, table_name, TAB_SUFFIX)))
+    std::filesystem::remove(FILE_NAME(TEST_DIR, table_name, TAB_SUFFIX));
+  auto tbl_schema = GenTableSchema(10);
+  table_manager->CreateTable(TEST_DIR, table_name, *tbl_schema, PAX_MODEL);
+  auto tbl   = table_manager->OpenTable(TEST_DIR, table_name, PAX_MODEL);
+  tbl_schema = nullptr;
+  for (int i = 0; i < 1000; ++i) {
+    auto record = GenRecordUnderSchema(tbl->GetSchema());
+    auto rid    = tbl->InsertRecord(*record);
+    if (i % 3 == 0) {
+      tbl->DeleteRecord(rid);
+    }
+  }
+  // filter on the first column and output the last two columns
+  const auto          &tbl_fields = tbl->GetSchema().GetFields();
+  std::vector<RTField> out_fields(tbl_fields.end() - 2, tbl_fields.end());
+  auto                 filter_schema = std::make_unique<RecordSchema>(std::vector<RTField>{tbl_fields.front()});
+  auto                 out_schema    = std::make_unique<RecordSchema>(out_fields);
+  std::function<bool(const Record &)> filter = [](const Record &rec) {
+    return !rec.GetValueAt(0)->IsNull() && *rec.GetValueAt(0) > *ValueFactory::CreateIntValue(0);
+  };
+  std::vector<RecordUptr> expected;
+  for (auto rid = tbl->GetFirstRID(); rid != INVALID_RID; rid = tbl->GetNextRID(rid)) {
+    auto record = tbl->GetRecord(rid);
+    if (filter(Record(filter_schema.get(), *record))) {
+      expected.push_back(std::make_unique<Record>(out_schema.get(), *record));
+    }
+  }
+  size_t cursor = 0;
+  for (page_id_t pid = FILE_HEADER_PAGE_ID + 1; pid < static_cast<page_id_t>(tbl->GetTableHeader().page_num_); ++pid) {
+    auto records = tbl->GetPageRecords(pid, out_schema.get(), filter_schema.get(), filter);
+    for (const auto &record : records) {
+      ASSERT_LT(cursor, expected.size());
+      ASSERT_TRUE(*record == *expected[cursor]);
+      ASSERT_EQ(record->GetRID(), tbl->GetRecord(record->GetRID())->GetRID());
+      cursor++;
+    }
+  }
+  ASSERT_EQ(cursor, expected.size());
+  table_manager->CloseTable(TEST_DIR, *tbl);
+  table_manager->DropTable(TEST_DIR, table_name);
+}
+
+TEST(TableHandle, ZoneMap)
+{
+  auto        disk_manager        = std::make_unique<DiskManager>();
+  auto        buffer_pool_manager = std::make_unique<BufferPoolManager>(disk_manager.get(), nullptr);
+  auto        table_manager       = std::make_unique<TableManager>(disk_manager.get(), buffer_pool_manager.get());
+  std::string table_name          = "table_handle_zone_map";
+  if (!std::filesystem::exists(TEST_DIR))
+    std::filesystem::create_directory(TEST_DIR);
+  if (std::filesystem::exists(FILE_NAME(TEST_DIR, table_name, TAB_SUFFIX)))
+    table_manager->DropTable(TEST_DIR, table_name);
+  RTField id_field;
+  id_field.field_.field_name_ = "id";
+  id_field.field_.field_type_ = TYPE_INT;
+  id_field.field_.field_size_ = 4;
+  RTField pad_field;
+  pad_field.field_.field_name_ = "pad";
+  pad_field.field_.field_type_ = TYPE_STRING;
+  pad_field.field_.field_size_ = 100;
+  table_manager->CreateTable(TEST_DIR, table_name, RecordSchema({id_field, pad_field}), NARY_MODEL);
+  auto tbl = table_manager->OpenTable(TEST_DIR, table_name, NARY_MODEL);
+  // ids are inserted in ascending order, so each page holds a disjoint range
+  std::vector<RID> rids;
+  for (int i = 0; i < 1000; ++i) {
+    std::vector<ValueSptr> values{ValueFactory::CreateIntValue(i), ValueFactory::CreateNullValue(TYPE_STRING)};
+    rids.push_back(tbl->InsertRecord(Record(&tbl->GetSchema(), values, INVALID_RID)));
+  }
+  auto make_conds = [&tbl](CompOp op, int val) {
+    ValueSptr value = ValueFactory::CreateIntValue(val);
+    return ConditionVec{Condition(op, tbl->GetSchema().GetFieldAt(0), value)};
+  };
+  auto page_num    = static_cast<page_id_t>(tbl->GetTableHeader().page_num_);
+  auto check_pages = [&tbl, &rids, page_num](const ConditionVec &conds, const std::function<bool(int)> &pred) {
+    for (page_id_t pid = FILE_HEADER_PAGE_ID + 1; pid < page_num; ++pid) {
+      bool has_match = false;
+      for (size_t i = 0; i < rids.size(); ++i) {
+        has_match = has_match || (rids[i].PageID() == pid && pred(static_cast<int>(i)));
+      }
+      ASSERT_EQ(tbl->GetZoneMap().MayMatch(pid, conds), has_match);
+    }
+  };
+  check_pages(make_conds(OP_GT, 500), [](int id) { return id > 500; });
+  check_pages(make_conds(OP_LE, 37), [](int id) { return id <= 37; });
+  check_pages(make_conds(OP_EQ, 777), [](int id) { return id == 777; });
+  // null values never satisfy comparisons with non-null values except !=
+  ValueSptr str = ValueFactory::CreateStringValue("a", 1);
+  for (page_id_t pid = FILE_HEADER_PAGE_ID + 1; pid < page_num; ++pid) {
+    ASSERT_FALSE(tbl->GetZoneMap().MayMatch(pid, {Condition(OP_EQ, tbl->GetSchema().GetFieldAt(1), str)}));
+    ASSERT_TRUE(tbl->GetZoneMap().MayMatch(pid, {Condition(OP_NE, tbl->GetSchema().GetFieldAt(1), str)}));
+  }
+  // an emptied page matches nothing, and the zone map survives reopening the table
+  auto first_page = rids.front().PageID();
+  for (auto &rid : rids) {
+    if (rid.PageID() == first_page) {
+      tbl->DeleteRecord(rid);
+    }
+  }
+  ASSERT_FALSE(tbl->GetZoneMap().MayMatch(first_page, {}));
+  auto zone_data = tbl->GetZoneMap().Serialize();
+  table_manager->CloseTable(TEST_DIR, *tbl);
+  tbl = table_manager->OpenTable(TEST_DIR, table_name, NARY_MODEL);
+  ASSERT_EQ(tbl->GetZoneMap().Serialize(), zone_data);
+  ASSERT_FALSE(tbl->GetZoneMap().MayMatch(first_page, {}));
+  ASSERT_TRUE(tbl->GetZoneMap().MayMatch(rids.back().PageID(), make_conds(OP_EQ, 999)));
+  // the zone map file is removed while the table is open, so a table that is not closed properly rebuilds its zone
+  // map, e.g. after an update which keeps the number of records
+  ASSERT_FALSE(std::filesystem::exists(FILE_NAME(TEST_DIR, table_name, ZMP_SUFFIX)));
+  std::vector<ValueSptr> values{ValueFactory::CreateIntValue(5000), ValueFactory::CreateNullValue(TYPE_STRING)};
+  tbl->UpdateRecord(rids.back(), Record(&tbl->GetSchema(), values, rids.back()));
+  buffer_pool_manager->FlushAllPages(tbl->GetTableId());
+  {
+    auto other_disk_manager        = std::make_unique<DiskManager>();
+    auto other_buffer_pool_manager = std::make_unique<BufferPoolManager>(other_disk_manager.get(), nullptr);
+    auto other_table_manager =
+        std::make_unique<TableManager>(other_disk_manager.get(), other_buffer_pool_manager.get());
+    auto other_tbl = other_table_manager->OpenTable(TEST_DIR, table_name, NARY_MODEL);
+    ASSERT_TRUE(other_tbl->GetZoneMap().MayMatch(rids.back().PageID(), make_conds(OP_EQ, 5000)));
+    other_buffer_pool_manager->DeleteAllPages(other_tbl->GetTableId());
+    other_disk_manager->CloseFile(other_tbl->GetTableId());
+  }
+  table_manager->CloseTable(TEST_DIR, *tbl);
+  ASSERT_TRUE(std::filesystem::exists(FILE_NAME(TEST_DIR, table_name, ZMP_SUFFIX)));
+  table_manager->DropTable(TEST_DIR, table_name);
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);